@@ -1,19 +1,30 @@
 #include "shared/memory/basic_allocators.h"
 #include "shared/game/game_manager.h"
+#include "shared/game/thread_config.h"
 #include "shared/data/data_manager.h"
 #include "shared/apis/datetime/datetime_manager.h"
 #include "shared/apis/logging/log_manager.h"
 #include "shared/apis/logging/endpoints/std_out.h"
 #include "shared/apis/logging/endpoints/file.h"
 #include "shared/apis/windowing/window_manager.h"
+#include "shared/apis/windowing/null_window_manager.h"
 #include "shared/apis/graphics/graphics_manager_factory.h"
 #include "shared/apis/graphics/performance_settings.h"
 #include "shared/apis/file/file_manager.h"
 #include "shared/scene/scene_manager.h"
 #include "scene/scene_factory.h"
 #include "shared/utils/program_arguments.h"
+#include "shared/utils/strings.h"
+#include "shared/memory/allocation_sampler.h"
+#include "shared/memory/allocation_tags.h"
+#include "shared/diagnostics/tracer.h"
+#include "shared/diagnostics/metrics_exporter.h"
+#include "shared/diagnostics/sampling_profiler.h"
+#include "shared/diagnostics/spike_detector.h"
 
 #include <iostream>
+#include <memory>
+#include <optional>
 #include <vector>
 
 #include "version.h"
@@ -32,10 +43,28 @@ std::shared_ptr<data::data_manager> create_data_manager(const std::shared_ptr<ap
     return std::make_shared<data::data_manager>(data_path, file_manager, log_manager);
 }
 
-/// Creates the game manager
+/// Loads the threading config. The config is optional, so if there is none, each thread is only
+/// named. An invalid config throws, so the server does not run with a layout it was not configured with
+/// \param data_manager The data manager to load the config with
+/// \param log_manager The log manager to use
+/// \returns The threading config
+game::thread_config load_thread_config(const std::shared_ptr<data::data_manager>& data_manager,
+                                       const std::shared_ptr<apis::logging::ilog_manager>& log_manager) {
+    if (!game::thread_config::has_config(data_manager)) {
+        log_manager->log_message("No threading config found. Using the default thread layout.",
+                                 apis::logging::log_levels::info,
+                                 "Threading");
+        return {};
+    }
+
+    return game::thread_config(data_manager, log_manager);
+}
+
+/// Creates the game manager. If the `-headless` program argument is passed, or the graphics config's
+/// api is `null`, no window is created and nothing is rendered, so no display or GPU is needed
 /// \param arguments The program arguments
 /// \returns The created game manager
-game::game_manager create_game_manager(const utils::program_arguments& arguments) {
+std::unique_ptr<game::game_manager> create_game_manager(const utils::program_arguments& arguments) {
     auto datetime_manager = std::make_shared<apis::datetime::datetime_manager>();
 
     auto game_log_manager = std::make_shared<apis::logging::log_manager>(datetime_manager);
@@ -59,10 +88,22 @@ game::game_manager create_game_manager(const utils::program_arguments& arguments
     auto data_manager = create_data_manager(game_log_manager, executable_path);
 
     apis::graphics::config graphics_config(data_manager, game_log_manager);
-    apis::windowing::config windowing_config(data_manager, game_log_manager);
 
-    auto window_manager = std::make_shared<apis::windowing::window_manager>(
-        game_log_manager, graphics_config.api(), windowing_config);
+    if (arguments.has_argument("headless")) {
+        graphics_config.set_api(apis::graphics::apis::null);
+    }
+
+    std::shared_ptr<apis::windowing::iwindow_manager> window_manager;
+
+    if (graphics_config.api() == apis::graphics::apis::null) {
+        // there is no display, so SDL is not initialized
+        window_manager = std::make_shared<apis::windowing::null_window_manager>(game_log_manager);
+    } else {
+        apis::windowing::config windowing_config(data_manager, game_log_manager);
+
+        window_manager = std::make_shared<apis::windowing::window_manager>(
+            game_log_manager, graphics_config.api(), windowing_config);
+    }
 
     apis::graphics::application_information app_info {
         std::string(PROJECT_NAME) + " - Server",
@@ -88,25 +129,305 @@ game::game_manager create_game_manager(const utils::program_arguments& arguments
                                                                 scene::scene_types::loading,
                                                                 game_log_manager);
 
-    game::game_manager gm(executable_path,
-                          game_log_manager,
-                          window_manager,
-                          graphics_manager,
-                          scene_manager);
+    auto gm = std::make_unique<game::game_manager>(executable_path,
+                                                   game_log_manager,
+                                                   window_manager,
+                                                   graphics_manager,
+                                                   scene_manager);
+
+    gm->set_thread_config(load_thread_config(data_manager, game_log_manager));
+
     return gm;
 }
 
+/// Enables allocation sampling if it was requested with the `-allocation_sample_rate=<rate>`
+/// program argument. The sampling report is logged when the game manager shuts down
+/// \param arguments The program arguments
+void setup_allocation_sampling(const utils::program_arguments& arguments) {
+    auto sample_rate = arguments.get_argument("allocation_sample_rate");
+    if (!sample_rate) {
+        return;
+    }
+
+    auto rate = utils::to_int(*sample_rate);
+    if (!rate || *rate <= 0) {
+        std::cout << "Invalid allocation sample rate: " << *sample_rate << '\n';
+        return;
+    }
+
+    if (!memory::enable_allocation_sampling(static_cast<uint32_t>(*rate))) {
+        std::cout << "Failed to enable allocation sampling.\n";
+        return;
+    }
+
+    std::cout << "Sampling 1 in " << *rate << " allocations\n";
+}
+
+/// Sets the allocation budgets passed with the `-memory_budget=<tag>:<megabytes>,...` program
+/// argument, such as `-memory_budget=scene:256,graphics:512`. The game manager logs a warning each
+/// time a tag goes over its budget
+/// \param arguments The program arguments
+void setup_allocation_budgets(const utils::program_arguments& arguments) {
+    auto budgets_argument = arguments.get_argument("memory_budget");
+    if (!budgets_argument) {
+        return;
+    }
+
+    std::vector<std::pair<memory::allocation_tag, memory::megabytes>> budgets;
+
+    for (const auto& budget_argument : utils::split(",", *budgets_argument)) {
+        auto parts = utils::split(":", budget_argument);
+
+        auto tag = parts.size() == 2u ? memory::parse_allocation_tag(parts[0]) : std::nullopt;
+        auto budget = parts.size() == 2u ? utils::to_float(parts[1]) : std::nullopt;
+
+        // untagged allocations are not tracked per tag, so they cannot be budgeted
+        if (!tag || *tag == memory::allocation_tag::untagged || !budget || *budget <= 0.0f) {
+            std::cout << "Invalid memory budget: " << budget_argument << '\n';
+            return;
+        }
+
+        budgets.emplace_back(*tag, memory::megabytes(*budget));
+    }
+
+    if (budgets.empty()) {
+        std::cout << "Invalid memory budget: " << *budgets_argument << '\n';
+        return;
+    }
+
+    for (const auto& [tag, budget] : budgets) {
+        memory::set_allocation_budget(tag, budget);
+
+        std::cout << "Budgeting " << budget.get_value() << "MB for " << memory::to_string(tag) << " allocations\n";
+    }
+}
+
+/// Enables tracing if it was requested with the `-trace=<path>` program argument
+/// \param arguments The program arguments
+/// \returns The path to write the trace to, else empty if tracing was not requested
+std::filesystem::path setup_tracing(const utils::program_arguments& arguments) {
+    auto path = arguments.get_argument("trace");
+    if (!path || path->empty()) {
+        return {};
+    }
+
+    diagnostics::set_trace_thread_name("Main");
+    diagnostics::enable_tracing();
+
+    std::cout << "Tracing to " << *path << '\n';
+
+    return *path;
+}
+
+/// Writes the trace recorded since `setup_tracing`
+/// \param path The path to write the trace to. If this is empty, nothing is written
+void write_trace(const std::filesystem::path& path) {
+    if (path.empty()) {
+        return;
+    }
+
+    diagnostics::disable_tracing();
+
+    if (!diagnostics::write_trace(path)) {
+        std::cout << "Failed to write trace to " << path << '\n';
+    }
+}
+
+/// Starts the sampling profiler if it was requested with the `-profile=<path>` program argument.
+/// The CPU time between samples can be set in microseconds with `-profile_interval=<interval>`
+/// \param arguments The program arguments
+/// \returns The path to write the collapsed stacks to, else empty if profiling was not requested
+std::filesystem::path setup_sampling_profiler(const utils::program_arguments& arguments) {
+    auto path = arguments.get_argument("profile");
+    if (!path || path->empty()) {
+        return {};
+    }
+
+    std::chrono::microseconds interval {std::chrono::milliseconds(1)};
+
+    if (auto interval_argument = arguments.get_argument("profile_interval")) {
+        auto value = utils::to_int(*interval_argument);
+        if (!value || *value <= 0) {
+            std::cout << "Invalid profile interval: " << *interval_argument << '\n';
+            return {};
+        }
+
+        interval = std::chrono::microseconds(*value);
+    }
+
+    if (!diagnostics::start_sampling_profiler(interval)) {
+        std::cout << "Failed to start the sampling profiler.\n";
+        return {};
+    }
+
+    std::cout << "Profiling to " << *path << '\n';
+
+    return *path;
+}
+
+/// Stops the sampling profiler and writes the collapsed stacks recorded since `setup_sampling_profiler`
+/// \param path The path to write the collapsed stacks to. If this is empty, nothing is written
+void write_sampling_profile(const std::filesystem::path& path) {
+    if (path.empty()) {
+        return;
+    }
+
+    diagnostics::stop_sampling_profiler();
+
+    if (!diagnostics::write_collapsed_stacks(path)) {
+        std::cout << "Failed to write profile to " << path << '\n';
+    }
+}
+
+/// Sets up capturing frame spikes if it was requested with the `-spikes=<directory>` program
+/// argument. Frames taking longer than `-spike_threshold=<milliseconds>`, or a multiple of the
+/// median frame time, are captured. Tracing is switched to ring mode, so if `-trace` is also
+/// passed, only the most recent events are written to its trace
+/// \param arguments The program arguments
+/// \returns The settings of the spike detectors, else no value if spike capture was not requested
+std::optional<diagnostics::spike_detector_settings> setup_spike_detection(const utils::program_arguments& arguments) {
+    auto directory = arguments.get_argument("spikes");
+    if (!directory || directory->empty()) {
+        return {};
+    }
+
+    diagnostics::spike_detector_settings settings;
+    settings.output_directory = *directory;
+
+    if (auto threshold_argument = arguments.get_argument("spike_threshold")) {
+        auto value = utils::to_int(*threshold_argument);
+        if (!value || *value <= 0) {
+            std::cout << "Invalid spike threshold: " << *threshold_argument << '\n';
+            return {};
+        }
+
+        settings.threshold = std::chrono::milliseconds(*value);
+    }
+
+    std::error_code error;
+    std::filesystem::create_directories(settings.output_directory, error);
+    if (error) {
+        std::cout << "Failed to create spike capture directory: " << settings.output_directory << '\n';
+        return {};
+    }
+
+    diagnostics::set_trace_thread_name("Main");
+    diagnostics::set_trace_ring_mode(true);
+    diagnostics::enable_tracing();
+
+    return settings;
+}
+
+/// Sets the rate the scenes are run at if it was passed with the `-tick_rate=<ticks per second>`
+/// program argument
+/// \param arguments The program arguments
+/// \param gm The game manager to set the rate of
+void setup_tick_rate(const utils::program_arguments& arguments, game::game_manager& gm) {
+    auto tick_rate = arguments.get_argument("tick_rate");
+    if (!tick_rate) {
+        return;
+    }
+
+    auto rate = utils::to_int(*tick_rate);
+    if (!rate || *rate <= 0) {
+        std::cout << "Invalid tick rate: " << *tick_rate << '\n';
+        return;
+    }
+
+    game::fixed_timestep_settings settings;
+    settings.ticks_per_second = static_cast<uint32_t>(*rate);
+
+    if (!gm.set_fixed_timestep_settings(settings)) {
+        std::cout << "Failed to set the tick rate.\n";
+    }
+}
+
+/// Limits the frame rate if it was passed with the `-frame_rate=<frames per second>` program
+/// argument. If the `-adaptive_frames` program argument is passed, the graphics loop only renders
+/// when the logic loop has a new frame for it
+/// \param arguments The program arguments
+/// \param gm The game manager to limit the frame rate of
+void setup_frame_limiter(const utils::program_arguments& arguments, game::game_manager& gm) {
+    game::frame_limiter_settings settings;
+
+    if (auto frame_rate = arguments.get_argument("frame_rate")) {
+        auto rate = utils::to_int(*frame_rate);
+        if (!rate || *rate < 0) {
+            std::cout << "Invalid frame rate: " << *frame_rate << '\n';
+            return;
+        }
+
+        settings.frames_per_second = static_cast<uint32_t>(*rate);
+    }
+
+    auto graphics_settings = settings;
+    graphics_settings.is_adaptive = arguments.has_argument("adaptive_frames");
+
+    if (!gm.set_frame_limiter_settings(settings, graphics_settings)) {
+        std::cout << "Failed to set the frame limiter.\n";
+    }
+}
+
+/// Creates the metrics exporter if it was requested with the `-metrics` program argument. The
+/// metrics are written to `metrics/metrics.prom` and `metrics/metrics.jsonl` in the executable's
+/// directory, and are also served on the Unix socket passed with `-metrics_socket=<path>`
+/// \param arguments The program arguments
+/// \returns The started metrics exporter, else `nullptr` if it was not requested or failed to start
+std::unique_ptr<diagnostics::metrics_exporter> create_metrics_exporter(const utils::program_arguments& arguments) {
+    if (!arguments.has_argument("metrics")) {
+        return {};
+    }
+
+    auto metrics_path = arguments.get_executable_path().parent_path() / "metrics";
+
+    std::error_code error;
+    std::filesystem::create_directories(metrics_path, error);
+    if (error) {
+        std::cout << "Failed to create metrics directory: " << metrics_path << '\n';
+        return {};
+    }
+
+    diagnostics::metrics_exporter_settings settings;
+    settings.prometheus_path = metrics_path / "metrics.prom";
+    settings.json_lines_path = metrics_path / "metrics.jsonl";
+
+    if (auto socket_path = arguments.get_argument("metrics_socket")) {
+        settings.socket_path = *socket_path;
+    }
+
+    auto exporter = std::make_unique<diagnostics::metrics_exporter>(settings);
+    if (!exporter->start()) {
+        std::cout << "Failed to start metrics exporter.\n";
+        return {};
+    }
+
+    std::cout << "Exporting metrics to " << metrics_path << '\n';
+
+    return exporter;
+}
+
 /// Sets up and runs the game
 /// \param arguments The program arguments
 void run(const utils::program_arguments& arguments) {
     auto gm = create_game_manager(arguments);
 
-    if (!gm.initialize()) {
+    if (auto spike_detector_settings = setup_spike_detection(arguments)) {
+        if (!gm->enable_spike_detection(*spike_detector_settings)) {
+            std::cout << "Failed to enable spike detection.\n";
+        }
+    }
+
+    setup_tick_rate(arguments, *gm);
+    setup_frame_limiter(arguments, *gm);
+
+    auto metrics_exporter = create_metrics_exporter(arguments);
+
+    if (!gm->initialize()) {
         std::cout << "Failed to initialize game manager.\n";
         return;
     }
 
-    if (!gm.run()) {
+    if (!gm->run()) {
         std::cout << "Failed to run game manager.\n";
         return;
     }
@@ -139,8 +460,16 @@ int main(int argv, char* args[]) {
 
     utils::program_arguments pa(arguments);
 
+    setup_allocation_sampling(pa);
+    setup_allocation_budgets(pa);
+    auto trace_path = setup_tracing(pa);
+    auto profile_path = setup_sampling_profiler(pa);
+
     run(pa);
 
+    write_sampling_profile(profile_path);
+    write_trace(trace_path);
+
     std::cout << "Server complete.\n";
 
     return 0;
@@ -1,10 +1,16 @@
 #include "file_manager.h"
+#include "shared/jobs/job_system.h"
 
 #include <fstream>
+#include <future>
+#include <memory>
 #include <sstream>
 
 namespace pbr::shared::apis::file {
-    std::optional<std::vector<std::byte>> file_manager::read_file_bytes(const utils::uri& uri) const noexcept {
+    /// Returns the bytes of the file pointed to by the passed URI
+    /// \param uri The uri of the file to open
+    /// \returns The bytes of the file, else empty if the file was not found or an error occurred
+    static std::optional<std::vector<std::byte>> read_bytes(const utils::uri& uri) noexcept {
         // we are only supporting `file://` at the moment
         if (uri.scheme != "file") {
             return {};
@@ -34,17 +40,10 @@ namespace pbr::shared::apis::file {
         return bytes;
     }
 
-    std::future<std::optional<std::vector<std::byte>>> file_manager::read_file_bytes_async(
-        const utils::uri& uri) const noexcept {
-        auto f = std::async(std::launch::async, [this, uri](){
-            auto result = this->read_file_bytes(uri);
-            return result;
-        });
-
-        return f;
-    }
-
-    std::optional<std::string> file_manager::read_file_text(const utils::uri& uri) const noexcept {
+    /// Returns the text of the file pointed to by the passed URI
+    /// \param uri The uri of the file to open
+    /// \returns The text of the file, else empty if the file was not found or an error occurred
+    static std::optional<std::string> read_text(const utils::uri& uri) noexcept {
         // we are only supporting `file://` at the moment
         if (uri.scheme != "file") {
             return {};
@@ -63,12 +62,92 @@ namespace pbr::shared::apis::file {
         return ss.str();
     }
 
+    /// Reads a file in a job, rather than starting a thread for it. The read only captures the URI,
+    /// so the job does not depend on the file manager outliving it
+    /// \param read Reads the file
+    /// \param uri The uri of the file to read
+    /// \returns The future result of the read, which is always valid
+    template <typename T>
+    static std::future<std::optional<T>> read_async(std::optional<T> (*read)(const utils::uri&),
+                                                    const utils::uri& uri) noexcept {
+        std::shared_ptr<std::promise<std::optional<T>>> promise;
+        std::future<std::optional<T>> future;
+
+        try {
+            promise = std::make_shared<std::promise<std::optional<T>>>();
+            future = promise->get_future();
+        } catch (...) {
+            // there is no promise to fulfil, so read the file when the future is waited on instead
+            return std::async(std::launch::deferred, read, uri);
+        }
+
+        auto is_job_run {false};
+
+        try {
+            is_job_run = jobs::get_job_system().run([promise, read, uri]() {
+                promise->set_value(read(uri));
+            });
+        } catch (...) {
+        }
+
+        if (!is_job_run) {
+            promise->set_value(read(uri));
+        }
+
+        return future;
+    }
+
+    /// Reads a file in a job counted by a counter. The read only captures the URI and the result, so
+    /// the job does not depend on the file manager outliving it
+    /// \param read Reads the file
+    /// \param uri The uri of the file to read
+    /// \param result Set to the result of the read
+    /// \param counter The counter to count the read with
+    template <typename T>
+    static void read_async(std::optional<T> (*read)(const utils::uri&),
+                           const utils::uri& uri,
+                           std::optional<T>& result,
+                           jobs::job_counter& counter) noexcept {
+        auto is_job_run {false};
+
+        try {
+            is_job_run = jobs::get_job_system().run([read, uri, &result]() {
+                result = read(uri);
+            }, &counter);
+        } catch (...) {
+        }
+
+        if (!is_job_run) {
+            result = read(uri);
+        }
+    }
+
+    std::optional<std::vector<std::byte>> file_manager::read_file_bytes(const utils::uri& uri) const noexcept {
+        return read_bytes(uri);
+    }
+
+    std::future<std::optional<std::vector<std::byte>>> file_manager::read_file_bytes_async(
+        const utils::uri& uri) const noexcept {
+        return read_async(read_bytes, uri);
+    }
+
+    void file_manager::read_file_bytes_async(const utils::uri& uri,
+                                             std::optional<std::vector<std::byte>>& result,
+                                             jobs::job_counter& counter) const noexcept {
+        read_async(read_bytes, uri, result, counter);
+    }
+
+    std::optional<std::string> file_manager::read_file_text(const utils::uri& uri) const noexcept {
+        return read_text(uri);
+    }
+
     std::future<std::optional<std::string>> file_manager::read_file_text_async(const utils::uri& uri) const noexcept {
-        auto f = std::async(std::launch::async, [this, uri](){
-            auto result = this->read_file_text(uri);
-            return result;
-        });
+        return read_async(read_text, uri);
+    }
 
-        return f;
+    void file_manager::read_file_text_async(const utils::uri& uri,
+                                            std::optional<std::string>& result,
+                                            jobs::job_counter& counter) const noexcept {
+        read_async(read_text, uri, result, counter);
     }
 }
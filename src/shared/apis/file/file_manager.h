@@ -23,12 +23,26 @@ namespace pbr::shared::apis::file {
         std::optional<std::vector<std::byte>> read_file_bytes(const utils::uri& uri) const noexcept override;
 
         /// Returns the bytes of the file pointed to by the passed URI
+        /// The file is read in a job on the job system. The future must not be waited on from a job, as
+        /// the waiting worker would not run other jobs, so the read may never run. Jobs should read with
+        /// a counter instead
         /// \param uri The uri of the file to open
         /// \returns The bytes of the file pointed to by the passed URI. If this file was
         /// not found or an error occurred, an empty result is returned
         std::future<std::optional<std::vector<std::byte>>> read_file_bytes_async(
             const utils::uri& uri) const noexcept override;
 
+        /// Reads the bytes of the file pointed to by the passed URI in a job counted by a counter. If
+        /// the job cannot be run, the file is read before this returns
+        /// \param uri The uri of the file to open
+        /// \param result Set to the bytes of the file pointed to by the passed URI. If this file was
+        /// not found or an error occurred, it is set to an empty result. This must not be destroyed
+        /// until the counter has been waited on
+        /// \param counter The counter to count the read with
+        void read_file_bytes_async(const utils::uri& uri,
+                                   std::optional<std::vector<std::byte>>& result,
+                                   jobs::job_counter& counter) const noexcept override;
+
         /// Returns the lines of text in the file pointed to by the passed URI
         /// \param uri The uri of the file to open
         /// \returns The the lines of text in the file pointed to by the passed URI. If this file was
@@ -36,9 +50,23 @@ namespace pbr::shared::apis::file {
         std::optional<std::string> read_file_text(const utils::uri& uri) const noexcept override;
 
         /// Returns the lines of text in the file pointed to by the passed URI
+        /// The file is read in a job on the job system. The future must not be waited on from a job, as
+        /// the waiting worker would not run other jobs, so the read may never run. Jobs should read with
+        /// a counter instead
         /// \param uri The uri of the file to open
         /// \returns The the lines of text in the file pointed to by the passed URI. If this file was
         /// not found or an error occurred, an empty result is returned
         std::future<std::optional<std::string>> read_file_text_async(const utils::uri& uri) const noexcept override;
+
+        /// Reads the lines of text in the file pointed to by the passed URI in a job counted by a
+        /// counter. If the job cannot be run, the file is read before this returns
+        /// \param uri The uri of the file to open
+        /// \param result Set to the lines of text in the file pointed to by the passed URI. If this file
+        /// was not found or an error occurred, it is set to an empty result. This must not be destroyed
+        /// until the counter has been waited on
+        /// \param counter The counter to count the read with
+        void read_file_text_async(const utils::uri& uri,
+                                  std::optional<std::string>& result,
+                                  jobs::job_counter& counter) const noexcept override;
     };
 }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "shared/jobs/job_counter.h"
 #include "shared/memory/basic_allocators.h"
 #include "shared/utils/uri.h"
 
@@ -26,12 +27,27 @@ namespace pbr::shared::apis::file {
         virtual std::optional<std::vector<std::byte>> read_file_bytes(const utils::uri& uri) const noexcept = 0;
 
         /// Returns the bytes of the file pointed to by the passed URI
+        /// The file may be read in a job on the job system, so the future must not be waited on from a
+        /// job, as the waiting worker would not run other jobs, and the read may never run. Jobs should
+        /// read with a counter instead
         /// \param uri The uri of the file to open
         /// \returns The bytes of the file pointed to by the passed URI. If this file was
         /// not found or an error occurred, an empty result is returned
         virtual std::future<std::optional<std::vector<std::byte>>> read_file_bytes_async(
             const utils::uri& uri) const noexcept = 0;
 
+        /// Reads the bytes of the file pointed to by the passed URI in a job counted by a counter.
+        /// Waiting on the counter with `jobs::job_system::wait` runs other jobs, so this can be waited
+        /// on from a job
+        /// \param uri The uri of the file to open
+        /// \param result Set to the bytes of the file pointed to by the passed URI. If this file was
+        /// not found or an error occurred, it is set to an empty result. This must not be destroyed
+        /// until the counter has been waited on
+        /// \param counter The counter to count the read with
+        virtual void read_file_bytes_async(const utils::uri& uri,
+                                           std::optional<std::vector<std::byte>>& result,
+                                           jobs::job_counter& counter) const noexcept = 0;
+
         /// Returns the lines of text in the file pointed to by the passed URI
         /// \param uri The uri of the file to open
         /// \returns The the lines of text in the file pointed to by the passed URI. If this file was
@@ -39,9 +55,24 @@ namespace pbr::shared::apis::file {
         virtual std::optional<std::string> read_file_text(const utils::uri& uri) const noexcept = 0;
 
         /// Returns the lines of text in the file pointed to by the passed URI
+        /// The file may be read in a job on the job system, so the future must not be waited on from a
+        /// job, as the waiting worker would not run other jobs, and the read may never run. Jobs should
+        /// read with a counter instead
         /// \param uri The uri of the file to open
         /// \returns The the lines of text in the file pointed to by the passed URI. If this file was
         /// not found or an error occurred, an empty result is returned
         virtual std::future<std::optional<std::string>> read_file_text_async(const utils::uri& uri) const noexcept = 0;
+
+        /// Reads the lines of text in the file pointed to by the passed URI in a job counted by a
+        /// counter. Waiting on the counter with `jobs::job_system::wait` runs other jobs, so this can be
+        /// waited on from a job
+        /// \param uri The uri of the file to open
+        /// \param result Set to the lines of text in the file pointed to by the passed URI. If this file
+        /// was not found or an error occurred, it is set to an empty result. This must not be destroyed
+        /// until the counter has been waited on
+        /// \param counter The counter to count the read with
+        virtual void read_file_text_async(const utils::uri& uri,
+                                          std::optional<std::string>& result,
+                                          jobs::job_counter& counter) const noexcept = 0;
     };
 }
@@ -8,5 +8,8 @@ namespace pbr::shared::apis::graphics {
 
         /// Vulkan
         vulkan,
+
+        /// Nothing is rendered, for running without a display or GPU, such as on a dedicated server
+        null,
     };
 }
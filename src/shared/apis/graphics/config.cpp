@@ -13,6 +13,8 @@ namespace pbr::shared::apis::graphics {
             return apis::opengl;
         } else if (api_name == "vulkan") {
             return apis::vulkan;
+        } else if (api_name == "null") {
+            return apis::null;
         } else {
             return {};
         }
@@ -3,6 +3,7 @@
 #include "graphics_manager_factory.h"
 #include "opengl/graphics_manager.h"
 #include "vulkan/graphics_manager.h"
+#include "null/graphics_manager.h"
 
 namespace pbr::shared::apis::graphics {
     std::shared_ptr<igraphics_manager> graphics_manager_factory::create(
@@ -34,6 +35,10 @@ namespace pbr::shared::apis::graphics {
                                                                           performance_settings);
                 return manager;
             }
+            case apis::null: {
+                auto manager = std::make_shared<null::graphics_manager>(graphics_log_manager);
+                return manager;
+            }
             default: {
                 return {};
             }
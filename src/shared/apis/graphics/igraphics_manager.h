@@ -4,6 +4,7 @@
 
 #include "apis.h"
 #include "renderable_entities.h"
+#include "shared/diagnostics/phase_timings.h"
 
 namespace pbr::shared::apis::graphics {
     /// Provides an interface to the graphics manager. This manages the graphics API instance and rendering
@@ -38,9 +39,15 @@ namespace pbr::shared::apis::graphics {
         [[nodiscard]]
         virtual bool refresh_resources() noexcept = 0;
 
-        /// Submits the passed entities to be rendered by this frame
-        /// \param renderable_entities The entities to render
-        virtual void submit_renderable_entities(renderable_entities renderable_entities) noexcept = 0;
+        /// Returns the entities to fill for the next frame. They hold the entities of an earlier
+        /// frame, so should be cleared first, which keeps the memory allocated for them. Only the
+        /// submitting thread may use them, and only until `submit_renderable_entities` is called
+        /// \returns The entities to fill for the next frame
+        [[nodiscard]]
+        virtual renderable_entities& get_next_renderable_entities() noexcept = 0;
+
+        /// Submits the entities returned by `get_next_renderable_entities` to be rendered
+        virtual void submit_renderable_entities() noexcept = 0;
 
         /// Submits a frame for rendering
         virtual void submit_frame_for_render() noexcept = 0;
@@ -49,5 +56,17 @@ namespace pbr::shared::apis::graphics {
         /// \returns `true` if this should run on a separate thread, else `false`
         [[nodiscard]]
         virtual bool run_on_separate_thread() const noexcept = 0;
+
+        /// Returns if this graphics manager renders the frames submitted to it. If it does not, the
+        /// loop submitting frames has nothing to do between ticks, so it does not run at the frame rate
+        /// \returns `true` if this renders the submitted frames, else `false`
+        [[nodiscard]]
+        virtual bool renders_frames() const noexcept = 0;
+
+        /// Returns the times taken by each phase of submitting a frame for render
+        /// \returns The times taken by each phase of submitting a frame, else `nullptr` if they
+        /// are not recorded
+        [[nodiscard]]
+        virtual diagnostics::phase_timings* get_frame_phase_timings() noexcept = 0;
     };
 }
@@ -0,0 +1,32 @@
+#include "graphics_manager.h"
+
+namespace pbr::shared::apis::graphics::null {
+    bool graphics_manager::load_api(const std::filesystem::path&) noexcept {
+        return true;
+    }
+
+    bool graphics_manager::initialize() noexcept {
+        this->_log_manager->log_message("Initialized the null graphics manager. Nothing will be rendered.",
+                                        logging::log_levels::info,
+                                        "Graphics");
+
+        return true;
+    }
+
+    void graphics_manager::submit_renderable_entities() noexcept {
+        auto number_of_entities = static_cast<uint64_t>(
+            this->_renderable_entities.get_2d_renderable_entities().size());
+
+        this->_number_of_submitted_entities += number_of_entities;
+        diagnostics::get_counter_registry().add(this->_submitted_entities_counter,
+                                                static_cast<int64_t>(number_of_entities));
+
+        // the entities keep their memory for the next frame
+        this->_renderable_entities.clear();
+    }
+
+    void graphics_manager::submit_frame_for_render() noexcept {
+        ++this->_number_of_submitted_frames;
+        diagnostics::get_counter_registry().add(this->_submitted_frames_counter, 1);
+    }
+}
@@ -0,0 +1,122 @@
+#pragma once
+
+#include "shared/apis/logging/ilog_manager.h"
+#include "shared/apis/graphics/igraphics_manager.h"
+#include "shared/diagnostics/counter_registry.h"
+
+#include <cassert>
+#include <cstdint>
+
+namespace pbr::shared::apis::graphics::null {
+    /// A graphics manager that renders nothing, for running without a display or GPU, such as on a
+    /// dedicated server. Submitted entities and frames are counted, in the global counter registry
+    /// too, then discarded
+    class graphics_manager final : public igraphics_manager {
+    public:
+        /// Constructs this manager
+        /// \param log_manager The log manager to use
+        explicit graphics_manager(std::shared_ptr<logging::ilog_manager> log_manager)
+            : _log_manager(log_manager) {
+            assert((this->_log_manager));
+        }
+
+        ~graphics_manager() override = default;
+
+        /// Returns the api implemented by this manager
+        /// \returns The api implemented by this manager
+        [[nodiscard]]
+        apis implemented_api() const noexcept override {
+            return apis::null;
+        }
+
+        /// Does nothing, as there is no graphics api to load
+        /// \param executable_path The path of the main executable
+        /// \returns `true`
+        [[nodiscard]]
+        bool load_api(const std::filesystem::path& executable_path) noexcept override;
+
+        /// Initializes this manager
+        /// \returns `true` upon success, else `false`
+        [[nodiscard]]
+        bool initialize() noexcept override;
+
+        /// Does nothing, as there are no resources
+        /// \returns `true`
+        [[nodiscard]]
+        bool refresh_resources() noexcept override {
+            return true;
+        }
+
+        /// Returns the entities to fill for the next frame
+        /// \returns The entities to fill for the next frame
+        [[nodiscard]]
+        renderable_entities& get_next_renderable_entities() noexcept override {
+            // nothing reads the entities, so they are filled on the submitting thread, in place
+            return this->_renderable_entities;
+        }
+
+        /// Counts the entities returned by `get_next_renderable_entities`, then discards them
+        void submit_renderable_entities() noexcept override;
+
+        /// Counts the frame, as there is nothing to render
+        void submit_frame_for_render() noexcept override;
+
+        /// Returns if this graphics manager should run on a separate thread or not
+        /// \returns `false`, as rendering nothing does not need a thread
+        [[nodiscard]]
+        bool run_on_separate_thread() const noexcept override {
+            return false;
+        }
+
+        /// Returns if this graphics manager renders the frames submitted to it
+        /// \returns `false`, as nothing is rendered
+        [[nodiscard]]
+        bool renders_frames() const noexcept override {
+            return false;
+        }
+
+        /// Returns the times taken by each phase of submitting a frame for render
+        /// \returns `nullptr`, as they are not recorded
+        [[nodiscard]]
+        diagnostics::phase_timings* get_frame_phase_timings() noexcept override {
+            return nullptr;
+        }
+
+        /// Returns the number of entities submitted
+        /// \returns The number of entities submitted
+        [[nodiscard]]
+        uint64_t get_number_of_submitted_entities() const noexcept {
+            return this->_number_of_submitted_entities;
+        }
+
+        /// Returns the number of frames submitted for render
+        /// \returns The number of frames submitted for render
+        [[nodiscard]]
+        uint64_t get_number_of_submitted_frames() const noexcept {
+            return this->_number_of_submitted_frames;
+        }
+
+    private:
+        /// The log manager
+        std::shared_ptr<logging::ilog_manager> _log_manager;
+
+        /// The entities submitted for the next frame
+        renderable_entities _renderable_entities;
+
+        /// The number of entities submitted
+        uint64_t _number_of_submitted_entities {0u};
+
+        /// The number of frames submitted for render
+        uint64_t _number_of_submitted_frames {0u};
+
+        /// Counts the submitted entities in the global counter registry
+        diagnostics::counter_handle _submitted_entities_counter {
+            diagnostics::get_counter_registry().register_counter("graphics_submitted_entities")
+        };
+
+        /// Counts the submitted frames in the global counter registry
+        diagnostics::counter_handle _submitted_frames_counter {
+            diagnostics::get_counter_registry().register_counter("graphics_submitted_frames")
+        };
+    };
+}
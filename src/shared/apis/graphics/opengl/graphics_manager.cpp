@@ -139,9 +139,8 @@ namespace pbr::shared::apis::graphics::opengl {
         return true;
     }
 
-    void graphics_manager::submit_renderable_entities(renderable_entities renderable_entities) noexcept {
-        // OpenGL is single threaded, so no need for any mutexes here
-        this->_renderable_entities = renderable_entities;
+    void graphics_manager::submit_renderable_entities() noexcept {
+        // OpenGL is single threaded, so the entities were filled in place
     }
 
     std::shared_ptr<render_targets::texture> graphics_manager::render_target(float x, float y, float z, float w, float h) {
@@ -191,10 +190,18 @@ namespace pbr::shared::apis::graphics::opengl {
         auto texture_target2 = render_target(0.5f, 0.5f, -2.0f, 0.5f, 0.5f);
         auto texture_target3 = render_target(0.5f, 0.5f, -1.0f, 0.5f, 0.5f);
 
-        this->_compositor->render({ texture_target1, texture_target2, texture_target3 });
+        {
+            diagnostics::scoped_phase_timer phase_timer(this->_frame_phase_timings, frame_phases::render);
 
-        auto application_window = this->_window_manager->get_main_application_window();
-        application_window->update_display();
+            this->_compositor->render({ texture_target1, texture_target2, texture_target3 });
+        }
+
+        {
+            diagnostics::scoped_phase_timer phase_timer(this->_frame_phase_timings, frame_phases::present);
+
+            auto application_window = this->_window_manager->get_main_application_window();
+            application_window->update_display();
+        }
 
         CHECK_OPENGL_ERROR_NO_RETURN(this->_log_manager);
     }
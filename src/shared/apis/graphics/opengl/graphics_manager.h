@@ -71,9 +71,16 @@ namespace pbr::shared::apis::graphics::opengl {
         [[nodiscard]]
         bool refresh_resources() noexcept override;
 
-        /// Submits the passed entities to be rendered by this frame
-        /// \param renderable_entities The entities to render
-        void submit_renderable_entities(renderable_entities renderable_entities) noexcept override;
+        /// Returns the entities to fill for the next frame
+        /// \returns The entities to fill for the next frame
+        [[nodiscard]]
+        renderable_entities& get_next_renderable_entities() noexcept override {
+            // OpenGL is single threaded, so the entities are filled and rendered on the same thread
+            return this->_renderable_entities;
+        }
+
+        /// Submits the entities returned by `get_next_renderable_entities` to be rendered
+        void submit_renderable_entities() noexcept override;
 
         /// Submits a frame for rendering.
         /// All previously submitted renderable entities will be cleared after this frame is
@@ -87,7 +94,26 @@ namespace pbr::shared::apis::graphics::opengl {
             return false;
         }
 
+        /// Returns if this graphics manager renders the frames submitted to it
+        /// \returns `true`
+        [[nodiscard]]
+        bool renders_frames() const noexcept override {
+            return true;
+        }
+
+        /// Returns the times taken by each phase of submitting a frame for render
+        /// \returns The times taken by each phase of submitting a frame
+        [[nodiscard]]
+        diagnostics::phase_timings* get_frame_phase_timings() noexcept override {
+            return &this->_frame_phase_timings;
+        }
+
     private:
+        /// The phases of submitting a frame for render
+        enum frame_phases : size_t {
+            render,
+            present,
+        };
         /// The path of the shader list
         static inline const std::string shader_list_path = "graphics/shaders/list";
 
@@ -121,6 +147,9 @@ namespace pbr::shared::apis::graphics::opengl {
         /// The shader manager
         std::shared_ptr<shader_manager> _shader_manager;
 
+        /// The times taken by each phase of submitting a frame, indexed by `frame_phases`
+        diagnostics::phase_timings _frame_phase_timings {{"render", "present"}};
+
         /// Shuts down the graphics manager
         /// \returns `true` upon success, else `false`
         [[nodiscard]]
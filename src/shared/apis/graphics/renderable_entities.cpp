@@ -4,4 +4,8 @@ namespace pbr::shared::apis::graphics {
     void renderable_entities::submit(renderable_entity_2d entity) noexcept {
         this->_2d_renderable_entities.emplace_back(std::move(entity));
     }
-}
\ No newline at end of file
+
+    void renderable_entities::submit_previous(renderable_entity_2d entity) noexcept {
+        this->_previous_2d_renderable_entities.emplace_back(std::move(entity));
+    }
+}
@@ -1,18 +1,100 @@
 #pragma once
 
+#include <algorithm>
+#include <chrono>
 #include <vector>
 
 #include "renderable_entity_2d.h"
 
 namespace pbr::shared::apis::graphics {
-    /// Contains entities to be submitted for render
+    /// Contains entities to be submitted for render. The simulation runs at a fixed tick rate,
+    /// independent of the frame rate, so a frame holds the entities of the last two ticks, along
+    /// with the timing of the ticks. This is provided for renderers to interpolate between the
+    /// two, so movement can be smooth whatever the frame rate
     class renderable_entities {
     public:
         /// Submits a 2d renderable entity
         void submit(renderable_entity_2d entity) noexcept;
 
+        /// Submits a 2d renderable entity as it was in the previous tick. Entities are matched
+        /// to the current tick's entities by the order they are submitted in
+        void submit_previous(renderable_entity_2d entity) noexcept;
+
+        /// Removes all entities, keeping the memory allocated for them
+        void clear() noexcept {
+            this->_2d_renderable_entities.clear();
+            this->_previous_2d_renderable_entities.clear();
+            this->_tick_time = {};
+            this->_tick_duration = {};
+        }
+
+        /// Returns the 2d entities of the current tick
+        /// \returns The 2d entities of the current tick
+        [[nodiscard]]
+        const std::vector<renderable_entity_2d>& get_2d_renderable_entities() const noexcept {
+            return this->_2d_renderable_entities;
+        }
+
+        /// Returns the 2d entities of the previous tick
+        /// \returns The 2d entities of the previous tick
+        [[nodiscard]]
+        const std::vector<renderable_entity_2d>& get_previous_2d_renderable_entities() const noexcept {
+            return this->_previous_2d_renderable_entities;
+        }
+
+        /// Sets when the current tick was due and how long a tick lasts, so a renderer can work
+        /// out how far each frame it renders is between the previous tick and the current tick
+        /// \param tick_time The time the current tick was due
+        /// \param tick_duration The time between ticks
+        void set_tick_timing(std::chrono::steady_clock::time_point tick_time,
+                             std::chrono::nanoseconds tick_duration) noexcept {
+            this->_tick_time = tick_time;
+            this->_tick_duration = tick_duration;
+        }
+
+        /// Returns the time the current tick was due
+        /// \returns The time the current tick was due
+        [[nodiscard]]
+        std::chrono::steady_clock::time_point get_tick_time() const noexcept {
+            return this->_tick_time;
+        }
+
+        /// Returns the time between ticks
+        /// \returns The time between ticks, else zero if no tick timing was set
+        [[nodiscard]]
+        std::chrono::nanoseconds get_tick_duration() const noexcept {
+            return this->_tick_duration;
+        }
+
+        /// Returns how far a frame is between the previous tick and the current tick. This should
+        /// be called for each rendered frame with the time it is rendered at, as the entities may be
+        /// rendered many times before the next tick
+        /// \param now The time the frame is rendered at
+        /// \returns How far the frame is between the ticks, from `0.0`, the previous tick, to
+        /// `1.0`, the current tick. If no tick timing was set, this is `1.0`
+        [[nodiscard]]
+        float get_interpolation_alpha(std::chrono::steady_clock::time_point now) const noexcept {
+            if (this->_tick_duration.count() <= 0) {
+                return 1.0f;
+            }
+
+            auto alpha = static_cast<double>(std::chrono::nanoseconds(now - this->_tick_time).count()) /
+                         static_cast<double>(this->_tick_duration.count());
+
+            return static_cast<float>(std::clamp(alpha, 0.0, 1.0));
+        }
+
     private:
         /// The 2d renderable entities to render
         std::vector<renderable_entity_2d> _2d_renderable_entities;
+
+        /// The 2d renderable entities as they were in the previous tick
+        std::vector<renderable_entity_2d> _previous_2d_renderable_entities;
+
+        /// The time the current tick was due
+        std::chrono::steady_clock::time_point _tick_time;
+
+        /// The time between ticks, else zero if no tick timing was set
+        std::chrono::nanoseconds _tick_duration {0};
     };
 }
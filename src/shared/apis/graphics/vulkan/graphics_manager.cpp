@@ -1,5 +1,6 @@
 #include "graphics_manager.h"
 #include "shared/apis/windowing/application_window.h"
+#include "shared/diagnostics/tracer.h"
 
 #include <cstdlib>
 #include <SDL_vulkan.h>
@@ -237,30 +238,53 @@ namespace pbr::shared::apis::graphics::vulkan {
         return true;
     }
 
-    void graphics_manager::submit_renderable_entities(renderable_entities renderable_entities) noexcept {
-        std::unique_lock<std::shared_mutex> lock(this->_submit_renderable_entities_mutex);
+    void graphics_manager::submit_renderable_entities() noexcept {
+        diagnostics::trace_zone trace_zone("submit_renderable_entities", "graphics");
 
-        this->_renderable_entities = renderable_entities;
+        this->_renderable_entities.publish();
+
+        // link the logic thread's submission to the frame that renders it
+        if (diagnostics::is_tracing_enabled()) {
+            auto flow_id = diagnostics::begin_trace_flow("renderable_entities");
+            auto previous_flow_id = this->_renderable_entities_flow_id.exchange(flow_id, std::memory_order_relaxed);
+
+            // the previous entities were replaced before they were rendered
+            diagnostics::end_trace_flow("renderable_entities", previous_flow_id);
+        }
     }
 
     void graphics_manager::submit_frame_for_render() noexcept {
+        diagnostics::trace_zone trace_zone("submit_frame_for_render", "graphics");
+
         // wait until any blocking actions to finish, so we can start a render request
         auto in_flight_fence = this->_in_flight_fences[this->_current_frame].get_native_handle();
 
-        vkWaitForFences(this->_device->get_native_handle(),
-                        1,
-                        &in_flight_fence,
-                        VK_TRUE,
-                        UINT64_MAX);
+        {
+            diagnostics::trace_zone fence_trace_zone("wait_for_in_flight_fence", "graphics");
+            diagnostics::scoped_phase_timer phase_timer(this->_frame_phase_timings, frame_phases::fence_wait);
+
+            vkWaitForFences(this->_device->get_native_handle(),
+                            1,
+                            &in_flight_fence,
+                            VK_TRUE,
+                            UINT64_MAX);
+        }
 
         // get the next image to render into
         auto image_index {0u};
-        auto result = vkAcquireNextImageKHR(this->_device->get_native_handle(),
-                                            this->_swap_chain->get_native_handle(),
-                                            UINT64_MAX,
-                                            this->_image_available_semaphores[this->_current_frame].get_native_handle(),
-                                            VK_NULL_HANDLE,
-                                            &image_index);
+        VkResult result;
+
+        {
+            diagnostics::trace_zone acquire_trace_zone("acquire_next_image", "graphics");
+            diagnostics::scoped_phase_timer phase_timer(this->_frame_phase_timings, frame_phases::acquire);
+
+            result = vkAcquireNextImageKHR(this->_device->get_native_handle(),
+                                           this->_swap_chain->get_native_handle(),
+                                           UINT64_MAX,
+                                           this->_image_available_semaphores[this->_current_frame].get_native_handle(),
+                                           VK_NULL_HANDLE,
+                                           &image_index);
+        }
 
         if (result == VK_ERROR_OUT_OF_DATE_KHR) {
             if (!this->refresh_resources()) {
@@ -278,6 +302,9 @@ namespace pbr::shared::apis::graphics::vulkan {
 
         // check if a previous frame is using this image (i.e. there is its fence to wait on)
         if (this->_images_in_flight[image_index] != VK_NULL_HANDLE) {
+            diagnostics::trace_zone image_fence_trace_zone("wait_for_image_fence", "graphics");
+            diagnostics::scoped_phase_timer phase_timer(this->_frame_phase_timings, frame_phases::image_fence_wait);
+
             vkWaitForFences(this->_device->get_native_handle(),
                             1,
                             &this->_images_in_flight[image_index],
@@ -298,11 +325,19 @@ namespace pbr::shared::apis::graphics::vulkan {
             VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT
         };
 
-        if (!this->create_render_entities_command_buffers(image_index)) {
-            this->_log_manager->log_message("Failed to create render entities command buffers.",
-                                            logging::log_levels::error,
-                                            "Vulkan");
-            return;
+        {
+            diagnostics::trace_zone record_trace_zone("record_command_buffers", "graphics");
+            diagnostics::scoped_phase_timer phase_timer(this->_frame_phase_timings, frame_phases::record);
+
+            diagnostics::end_trace_flow("renderable_entities",
+                                        this->_renderable_entities_flow_id.exchange(0u, std::memory_order_relaxed));
+
+            if (!this->create_render_entities_command_buffers(image_index)) {
+                this->_log_manager->log_message("Failed to create render entities command buffers.",
+                                                logging::log_levels::error,
+                                                "Vulkan");
+                return;
+            }
         }
 
         auto command_buffer_to_submit = this->_command_buffers[image_index].get_native_handle();
@@ -331,14 +366,19 @@ namespace pbr::shared::apis::graphics::vulkan {
                       &fence_to_reset);
 
         // submit to the graphics queue
-        if (vkQueueSubmit(this->_graphics_queue->get_native_handle(),
-                          1,
-                          &submit_info,
-                          this->_in_flight_fences[this->_current_frame].get_native_handle()) != VK_SUCCESS) {
-            this->_log_manager->log_message("Failed to submit to graphics queue.",
-                                            logging::log_levels::error,
-                                            "Vulkan");
-            return;
+        {
+            diagnostics::trace_zone submit_trace_zone("queue_submit", "graphics");
+            diagnostics::scoped_phase_timer phase_timer(this->_frame_phase_timings, frame_phases::submit);
+
+            if (vkQueueSubmit(this->_graphics_queue->get_native_handle(),
+                              1,
+                              &submit_info,
+                              this->_in_flight_fences[this->_current_frame].get_native_handle()) != VK_SUCCESS) {
+                this->_log_manager->log_message("Failed to submit to graphics queue.",
+                                                logging::log_levels::error,
+                                                "Vulkan");
+                return;
+            }
         }
 
         VkPresentInfoKHR present_info {};
@@ -355,8 +395,13 @@ namespace pbr::shared::apis::graphics::vulkan {
         present_info.pImageIndices = &image_index;
         present_info.pResults = nullptr;
 
-        result = vkQueuePresentKHR(this->_present_queue->get_native_handle(),
-                                   &present_info);
+        {
+            diagnostics::trace_zone present_trace_zone("queue_present", "graphics");
+            diagnostics::scoped_phase_timer phase_timer(this->_frame_phase_timings, frame_phases::present);
+
+            result = vkQueuePresentKHR(this->_present_queue->get_native_handle(),
+                                       &present_info);
+        }
 
         if (result == VK_ERROR_OUT_OF_DATE_KHR ||
             result == VK_SUBOPTIMAL_KHR ||
@@ -379,12 +424,9 @@ namespace pbr::shared::apis::graphics::vulkan {
     }
 
     bool graphics_manager::create_render_entities_command_buffers(uint32_t image_index) noexcept {
-        // copy the data to avoid keeping the lock longer than needed
-        renderable_entities renderable_entities;
-        {
-            std::shared_lock<std::shared_mutex> lock(this->_submit_renderable_entities_mutex);
-            renderable_entities = this->_renderable_entities;
-        }
+        // render the latest submitted entities, or the last ones again if none have been submitted since
+        this->_renderable_entities.update();
+        [[maybe_unused]] const auto& renderable_entities = this->_renderable_entities.get_front_buffer();
 
         auto& buffer = this->_command_buffers[image_index];
 
@@ -18,10 +18,11 @@
 #include "framebuffer.h"
 #include "semaphore.h"
 #include "fence.h"
+#include "shared/utils/triple_buffer.h"
 
+#include <atomic>
 #include <memory>
 #include <string>
-#include <shared_mutex>
 
 namespace pbr::shared::apis::graphics::vulkan {
     /// Handles the Vulkan graphics API and rendering processes
@@ -75,9 +76,17 @@ namespace pbr::shared::apis::graphics::vulkan {
         [[nodiscard]]
         bool refresh_resources() noexcept override;
 
-        /// Submits the passed entities to be rendered by this frame
-        /// \param renderable_entities The entities to render
-        void submit_renderable_entities(renderable_entities renderable_entities) noexcept override;
+        /// Returns the entities to fill for the next frame. This must only be called by the
+        /// submitting thread
+        /// \returns The entities to fill for the next frame
+        [[nodiscard]]
+        renderable_entities& get_next_renderable_entities() noexcept override {
+            return this->_renderable_entities.get_back_buffer();
+        }
+
+        /// Submits the entities returned by `get_next_renderable_entities` to be rendered. This
+        /// does not wait for the render thread
+        void submit_renderable_entities() noexcept override;
 
         /// Submits a frame for rendering. In Vulkan, this simply submits a request for
         /// the frame to be rendered, the frame itself will be rendered when the driver
@@ -94,7 +103,30 @@ namespace pbr::shared::apis::graphics::vulkan {
             return true;
         }
 
+        /// Returns if this graphics manager renders the frames submitted to it
+        /// \returns `true`
+        [[nodiscard]]
+        bool renders_frames() const noexcept override {
+            return true;
+        }
+
+        /// Returns the times taken by each phase of submitting a frame for render
+        /// \returns The times taken by each phase of submitting a frame
+        [[nodiscard]]
+        diagnostics::phase_timings* get_frame_phase_timings() noexcept override {
+            return &this->_frame_phase_timings;
+        }
+
     private:
+        /// The phases of submitting a frame for render
+        enum frame_phases : size_t {
+            fence_wait,
+            acquire,
+            image_fence_wait,
+            record,
+            submit,
+            present,
+        };
         /// The log manager
         std::shared_ptr<logging::ilog_manager> _log_manager;
 
@@ -166,11 +198,22 @@ namespace pbr::shared::apis::graphics::vulkan {
         /// Do we need to rebuild the swap chain, for instance, if the viewport changed in size
         bool _signal_swap_chain_out_of_date {false};
 
-        /// Synchronizes submitting renderable entities
-        std::shared_mutex _submit_renderable_entities_mutex;
-
-        /// The entities to render
-        renderable_entities _renderable_entities;
+        /// Hands the entities to render from the submitting thread to the render thread
+        utils::triple_buffer<renderable_entities> _renderable_entities;
+
+        /// The trace flow linking the submitted renderable entities to the frame that renders them,
+        /// `0` if there is none
+        std::atomic_uint64_t _renderable_entities_flow_id {0u};
+
+        /// The times taken by each phase of submitting a frame, indexed by `frame_phases`
+        diagnostics::phase_timings _frame_phase_timings {{
+            "fence_wait",
+            "acquire",
+            "image_fence_wait",
+            "record",
+            "submit",
+            "present",
+        }};
 
         /// Sets the needed environment variables for Vulkan if they are not already set by the developer
         /// \param executable_path The path of the main executable
@@ -4,10 +4,19 @@
 #include <string>
 
 namespace pbr::shared::apis::logging::endpoints {
-    std::unordered_map<std::string, std::mutex> file::_mutexes;
+    std::unordered_map<std::string, diagnostics::tracked_mutex> file::_mutexes;
+    std::mutex file::_mutexes_mutex;
 
     void file::log(std::string_view message, log_levels) noexcept {
-        std::scoped_lock<std::mutex> lock(file::_mutexes[this->_path.generic_string()]);
+        diagnostics::tracked_mutex* mutex {nullptr};
+
+        {
+            // references to the map's values stay valid when other values are added
+            std::scoped_lock<std::mutex> mutexes_lock(file::_mutexes_mutex);
+            mutex = &file::_mutexes.try_emplace(this->_path.generic_string(), "log_file").first->second;
+        }
+
+        std::scoped_lock<diagnostics::tracked_mutex> lock(*mutex);
 
         std::ofstream fs(this->_path, std::ios_base::app);
         fs << message << '\n';
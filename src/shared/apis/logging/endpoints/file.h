@@ -2,6 +2,7 @@
 
 #include "shared/memory/basic_allocators.h"
 #include "shared/apis/logging/endpoint.h"
+#include "shared/diagnostics/tracked_mutex.h"
 
 #include <mutex>
 #include <unordered_map>
@@ -32,8 +33,11 @@ namespace pbr::shared::apis::logging::endpoints {
         void log(std::string_view message, log_levels level) noexcept override;
 
     private:
-        /// Protects concurrent access to specific files
-        static std::unordered_map<std::string, std::mutex> _mutexes;
+        /// Protects concurrent access to specific files. The mutexes share their counters
+        static std::unordered_map<std::string, diagnostics::tracked_mutex> _mutexes;
+
+        /// Protects concurrent access to `_mutexes`
+        static std::mutex _mutexes_mutex;
 
         /// The path of the file
         std::filesystem::path _path;
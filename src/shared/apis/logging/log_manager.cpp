@@ -1,4 +1,5 @@
 #include "log_manager.h"
+#include "shared/memory/allocation_tags.h"
 
 #include <sstream>
 
@@ -8,7 +9,7 @@ namespace pbr::shared::apis::logging {
             return false;
         }
 
-        std::scoped_lock<std::mutex> lock(this->_mutex);
+        std::scoped_lock<diagnostics::tracked_mutex> lock(this->_mutex);
 
         this->_endpoints.push_back(endpoint);
 
@@ -16,19 +17,19 @@ namespace pbr::shared::apis::logging {
     }
 
     const std::vector<std::shared_ptr<endpoint>>& log_manager::get_endpoints() const noexcept {
-        std::scoped_lock<std::mutex> lock(this->_mutex);
+        std::scoped_lock<diagnostics::tracked_mutex> lock(this->_mutex);
 
         return this->_endpoints;
     }
 
     void log_manager::set_log_level(const log_levels level) noexcept {
-        std::scoped_lock<std::mutex> lock(this->_mutex);
+        std::scoped_lock<diagnostics::tracked_mutex> lock(this->_mutex);
 
         this->_current_log_level = level;
     }
 
     log_levels log_manager::get_log_level() const noexcept {
-        std::scoped_lock<std::mutex> lock(this->_mutex);
+        std::scoped_lock<diagnostics::tracked_mutex> lock(this->_mutex);
 
         return this->_current_log_level;
     }
@@ -40,6 +41,8 @@ namespace pbr::shared::apis::logging {
             return;
         }
 
+        memory::scoped_allocation_tag allocation_tag(memory::allocation_tag::logging);
+
         // prefix: date time | level> message
         std::stringstream ss;
 
@@ -55,7 +58,7 @@ namespace pbr::shared::apis::logging {
 
         auto formatted_message = ss.str();
 
-        std::scoped_lock<std::mutex> lock(this->_mutex);
+        std::scoped_lock<diagnostics::tracked_mutex> lock(this->_mutex);
 
         for (const auto& e : this->_endpoints) {
             e->log(formatted_message, level);
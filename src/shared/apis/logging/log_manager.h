@@ -4,8 +4,8 @@
 #include "ilog_manager.h"
 #include "log_levels.h"
 #include "shared/apis/datetime/idatetime_manager.h"
+#include "shared/diagnostics/tracked_mutex.h"
 
-#include <mutex>
 #include <cassert>
 
 namespace pbr::shared::apis::logging {
@@ -53,7 +53,7 @@ namespace pbr::shared::apis::logging {
 
     private:
         /// Helps ensure logging is thread safe
-        mutable std::mutex _mutex;
+        mutable diagnostics::tracked_mutex _mutex {"log_manager"};
 
         /// The endpoints to log against
         std::vector<std::shared_ptr<endpoint>> _endpoints;
@@ -4,6 +4,7 @@
 #include "iconsole_window.h"
 #include "iapplication_window.h"
 
+#include <chrono>
 #include <memory>
 
 namespace pbr::shared::apis::windowing {
@@ -39,6 +40,13 @@ namespace pbr::shared::apis::windowing {
         [[nodiscard]]
         virtual bool update() noexcept = 0;
 
+        /// Waits until a window event is pending or a time has passed. The events are left to be
+        /// handled by `update`
+        /// \param time The latest time to wait until
+        /// \returns `true` if an event is pending, else `false`
+        [[nodiscard]]
+        virtual bool wait_for_events(std::chrono::steady_clock::time_point time) noexcept = 0;
+
         /// Returns true if the windowing system has a quit event
         /// \returns `true` if the windowing system has a quit event, else `false`
         [[nodiscard]]
@@ -0,0 +1,10 @@
+#include "null_application_window.h"
+
+namespace pbr::shared::apis::windowing {
+    bool null_application_window::set_size(pixels width, pixels height, bool) noexcept {
+        this->_size.width = width;
+        this->_size.height = height;
+
+        return true;
+    }
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "iapplication_window.h"
+
+namespace pbr::shared::apis::windowing {
+    /// An application window that is never shown, for running without a display, such as on a
+    /// dedicated server. It only remembers the size it is set to
+    class null_application_window final : public iapplication_window {
+    public:
+        /// Constructs this window
+        /// \param width The window width
+        /// \param height The window height
+        null_application_window(pixels width, pixels height) noexcept
+            : _size { width, height } {
+        }
+
+        ~null_application_window() override = default;
+
+        /// Returns the window size
+        /// \returns The window size
+        [[nodiscard]]
+        window_size get_size() const noexcept override {
+            return this->_size;
+        }
+
+        /// Sets the window size
+        /// \param width The window width
+        /// \param height The window height
+        /// \param fullscreen This is ignored
+        /// \returns `true`
+        [[nodiscard]]
+        bool set_size(pixels width, pixels height, bool fullscreen) noexcept override;
+
+        /// Does nothing, as there is no display to update
+        void update_display() noexcept override {
+        }
+
+    private:
+        /// The window size
+        window_size _size;
+    };
+}
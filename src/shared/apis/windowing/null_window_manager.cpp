@@ -0,0 +1,77 @@
+#include "null_window_manager.h"
+#include "null_application_window.h"
+
+#include <csignal>
+
+namespace pbr::shared::apis::windowing {
+    /// Set when the process is sent a signal to quit
+    static volatile std::sig_atomic_t g_has_quit_signal {0};
+
+    /// Handles the signals the process quits with
+    extern "C" void handle_quit_signal(int) {
+        g_has_quit_signal = 1;
+    }
+
+    bool null_window_manager::initialize() noexcept {
+        this->_log_manager->log_message("Initializing the null window manager...",
+                                        apis::logging::log_levels::info,
+                                        "Windowing");
+
+        g_has_quit_signal = 0;
+
+        if (!this->_are_signals_handled) {
+            this->_previous_interrupt_handler = std::signal(SIGINT, handle_quit_signal);
+            this->_previous_terminate_handler = std::signal(SIGTERM, handle_quit_signal);
+
+            if (this->_previous_interrupt_handler == SIG_ERR || this->_previous_terminate_handler == SIG_ERR) {
+                this->_log_manager->log_message("Failed to handle the quit signals.",
+                                                apis::logging::log_levels::error,
+                                                "Windowing");
+                return false;
+            }
+
+            this->_are_signals_handled = true;
+        }
+
+        this->_log_manager->log_message("Initialized the null window manager.",
+                                        apis::logging::log_levels::info,
+                                        "Windowing");
+        return true;
+    }
+
+    null_window_manager::~null_window_manager() {
+        if (this->_are_signals_handled) {
+            std::signal(SIGINT, this->_previous_interrupt_handler);
+            std::signal(SIGTERM, this->_previous_terminate_handler);
+        }
+    }
+
+    std::shared_ptr<iapplication_window> null_window_manager::create_application_window() noexcept {
+        try {
+            auto window = std::make_shared<null_application_window>(application_window_size.width,
+                                                                    application_window_size.height);
+
+            this->_application_windows.push_back(window);
+
+            return window;
+        } catch (...) {
+            return {};
+        }
+    }
+
+    bool null_window_manager::update() noexcept {
+        if (g_has_quit_signal && !this->_should_quit) {
+            this->_log_manager->log_message("Event: Quit signal received...",
+                                            apis::logging::log_levels::info,
+                                            "Windowing");
+
+            this->_should_quit = true;
+        }
+
+        return true;
+    }
+
+    bool null_window_manager::wait_for_events(std::chrono::steady_clock::time_point) noexcept {
+        return g_has_quit_signal && !this->_should_quit;
+    }
+}
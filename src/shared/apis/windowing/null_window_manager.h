@@ -0,0 +1,89 @@
+#pragma once
+
+#include "iwindow_manager.h"
+#include "shared/apis/logging/ilog_manager.h"
+
+#include <cassert>
+#include <vector>
+
+namespace pbr::shared::apis::windowing {
+    /// A window manager for running without a display, such as on a dedicated server. It does not
+    /// initialize SDL, and its windows are never shown. As there are no window events to quit
+    /// with, it quits when the process is sent `SIGINT` or `SIGTERM`
+    class null_window_manager final : public iwindow_manager {
+    public:
+        /// The size of the application windows
+        static constexpr window_size application_window_size {1280u, 720u};
+
+        /// Constructs this manager
+        /// \param log_manager The log manager
+        explicit null_window_manager(std::shared_ptr<apis::logging::ilog_manager> log_manager)
+            : _log_manager(log_manager) {
+            assert((this->_log_manager));
+        }
+
+        /// Destroys this manager, restoring the signal handlers it replaced
+        ~null_window_manager() override;
+
+        /// Initializes the window manager, handling the signals it quits with
+        /// \returns `true` upon success, else `false`
+        [[nodiscard]]
+        bool initialize() noexcept override;
+
+        /// Creates a console window
+        /// \returns `nullptr`, as the process' own console is used
+        [[nodiscard]]
+        std::shared_ptr<iconsole_window> create_console_window() noexcept override {
+            return {};
+        }
+
+        /// Creates an application window
+        /// \returns The created application window
+        [[nodiscard]]
+        std::shared_ptr<iapplication_window> create_application_window() noexcept override;
+
+        /// Returns the main application window
+        /// \returns The main application window, else `nullptr` is no application window has been created
+        [[nodiscard]]
+        std::shared_ptr<iapplication_window> get_main_application_window() const noexcept override {
+            return this->_application_windows.empty() ? nullptr : this->_application_windows[0];
+        }
+
+        /// Checks if the process has been sent a signal to quit
+        /// \returns `true`
+        [[nodiscard]]
+        bool update() noexcept override;
+
+        /// Returns straight away, as there are no window events to wait for. A quit signal is
+        /// handled by the next `update`
+        /// \returns `true` if the process has been sent a signal to quit, else `false`
+        [[nodiscard]]
+        bool wait_for_events(std::chrono::steady_clock::time_point) noexcept override;
+
+        /// Returns true if the process has been sent a signal to quit
+        /// \returns `true` if the process has been sent a signal to quit, else `false`
+        [[nodiscard]]
+        bool should_quit() const noexcept override {
+            return this->_should_quit;
+        }
+
+    private:
+        /// The log manager
+        std::shared_ptr<apis::logging::ilog_manager> _log_manager;
+
+        /// The created application windows
+        std::vector<std::shared_ptr<iapplication_window>> _application_windows;
+
+        /// Should the window manager quit?
+        bool _should_quit {false};
+
+        /// Are the quit signals handled by this manager?
+        bool _are_signals_handled {false};
+
+        /// The handler of `SIGINT` before this manager handled it
+        void (*_previous_interrupt_handler)(int) {nullptr};
+
+        /// The handler of `SIGTERM` before this manager handled it
+        void (*_previous_terminate_handler)(int) {nullptr};
+    };
+}
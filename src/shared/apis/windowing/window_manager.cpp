@@ -75,6 +75,16 @@ namespace pbr::shared::apis::windowing {
         return true;
     }
 
+    bool window_manager::wait_for_events(std::chrono::steady_clock::time_point time) noexcept {
+        auto timeout = std::chrono::duration_cast<std::chrono::milliseconds>(time - std::chrono::steady_clock::now());
+        if (timeout.count() <= 0) {
+            return SDL_PollEvent(nullptr) == 1;
+        }
+
+        // passing no event leaves the event in the queue for `update`
+        return SDL_WaitEventTimeout(nullptr, static_cast<int>(timeout.count())) == 1;
+    }
+
     bool window_manager::shutdown() noexcept {
         this->_log_manager->log_message("Shutting down the window manager...",
                                         apis::logging::log_levels::info,
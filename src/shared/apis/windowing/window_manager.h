@@ -54,6 +54,13 @@ namespace pbr::shared::apis::windowing {
         [[nodiscard]]
         bool update() noexcept override;
 
+        /// Waits until a window event is pending or a time has passed. SDL waits in whole
+        /// milliseconds, so this returns up to a millisecond before the time
+        /// \param time The latest time to wait until
+        /// \returns `true` if an event is pending, else `false`
+        [[nodiscard]]
+        bool wait_for_events(std::chrono::steady_clock::time_point time) noexcept override;
+
         /// Returns true if the windowing system has a quit event
         /// \returns `true` if the windowing system has a quit event, else `false`
         [[nodiscard]]
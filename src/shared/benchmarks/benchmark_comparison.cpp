@@ -0,0 +1,282 @@
+#include "benchmark_comparison.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+#include <string_view>
+
+namespace pbr::shared::benchmarks {
+    /// Returns the name of a verdict
+    /// \param verdict The verdict
+    /// \returns The name of the verdict
+    static std::string_view to_string(benchmark_verdict verdict) noexcept {
+        switch (verdict) {
+            case benchmark_verdict::unchanged: return "unchanged";
+            case benchmark_verdict::improved: return "improved";
+            case benchmark_verdict::regressed: return "REGRESSED";
+            case benchmark_verdict::added: return "added";
+            case benchmark_verdict::removed: return "removed";
+        }
+
+        return "";
+    }
+
+    double mann_whitney_u_test(const std::vector<double>& first, const std::vector<double>& second) {
+        if (first.empty() || second.empty()) {
+            return 1.0;
+        }
+
+        struct ranked_sample {
+            double value {0.0};
+            bool is_first {false};
+        };
+
+        std::vector<ranked_sample> samples;
+        samples.reserve(first.size() + second.size());
+
+        for (auto value : first) {
+            samples.push_back({ value, true });
+        }
+
+        for (auto value : second) {
+            samples.push_back({ value, false });
+        }
+
+        std::sort(samples.begin(), samples.end(), [](const auto& a, const auto& b) {
+            return a.value < b.value;
+        });
+
+        // tied samples share the mean of their ranks
+        auto first_rank_sum {0.0};
+        auto tie_correction {0.0};
+
+        for (size_t i {0u}; i < samples.size();) {
+            auto j = i;
+            while (j < samples.size() && samples[j].value == samples[i].value) {
+                ++j;
+            }
+
+            auto rank = (static_cast<double>(i + 1u) + static_cast<double>(j)) / 2.0;
+            auto ties = static_cast<double>(j - i);
+
+            for (auto k = i; k < j; ++k) {
+                if (samples[k].is_first) {
+                    first_rank_sum += rank;
+                }
+            }
+
+            tie_correction += ties * ties * ties - ties;
+            i = j;
+        }
+
+        auto n1 = static_cast<double>(first.size());
+        auto n2 = static_cast<double>(second.size());
+        auto n = n1 + n2;
+
+        auto u = first_rank_sum - n1 * (n1 + 1.0) / 2.0;
+        auto mean = n1 * n2 / 2.0;
+        auto variance = n1 * n2 / 12.0 * ((n + 1.0) - tie_correction / (n * (n - 1.0)));
+
+        if (variance <= 0.0) {
+            return 1.0;
+        }
+
+        auto z = std::max(std::abs(u - mean) - 0.5, 0.0) / std::sqrt(variance);
+
+        return std::erfc(z / std::sqrt(2.0));
+    }
+
+    /// The results of a benchmark across runs
+    struct benchmark_runs {
+        /// The median time of each run
+        std::vector<double> medians;
+
+        /// The mean allocations per iteration of the runs
+        double allocations_per_iteration {0.0};
+    };
+
+    /// Returns the median of values
+    /// \param values The values
+    /// \returns The median of the values, else `0.0` if there are none
+    static double get_median(std::vector<double> values) {
+        if (values.empty()) {
+            return 0.0;
+        }
+
+        std::sort(values.begin(), values.end());
+
+        auto middle = values.size() / 2u;
+
+        return values.size() % 2u == 1u ? values[middle] : (values[middle - 1u] + values[middle]) / 2.0;
+    }
+
+    /// Collects the results of a benchmark from runs
+    /// \param runs The runs
+    /// \param name The name of the benchmark
+    /// \returns The results of the benchmark, with no medians if no run has the benchmark
+    static benchmark_runs collect_runs(const std::vector<benchmark_run>& runs, const std::string& name) {
+        benchmark_runs collected;
+
+        for (const auto& run : runs) {
+            auto result = std::find_if(run.results.begin(), run.results.end(), [&name](const auto& candidate) {
+                return candidate.name == name;
+            });
+
+            if (result != run.results.end()) {
+                collected.medians.push_back(result->median);
+                collected.allocations_per_iteration += result->allocations_per_iteration;
+            }
+        }
+
+        if (!collected.medians.empty()) {
+            collected.allocations_per_iteration /= static_cast<double>(collected.medians.size());
+        }
+
+        return collected;
+    }
+
+    /// Returns the names of the benchmarks in runs
+    /// \param runs The runs
+    /// \returns The names, in the order they are first found
+    static std::vector<std::string> get_names(const std::vector<benchmark_run>& runs) {
+        std::vector<std::string> names;
+
+        for (const auto& run : runs) {
+            for (const auto& result : run.results) {
+                if (std::find(names.begin(), names.end(), result.name) == names.end()) {
+                    names.push_back(result.name);
+                }
+            }
+        }
+
+        return names;
+    }
+
+    std::vector<benchmark_comparison> compare_benchmarks(const std::vector<benchmark_run>& baseline,
+                                                         const std::vector<benchmark_run>& current,
+                                                         const benchmark_comparison_settings& settings) {
+        std::vector<benchmark_comparison> comparisons;
+
+        auto current_names = get_names(current);
+
+        for (const auto& name : current_names) {
+            auto current_runs = collect_runs(current, name);
+            auto baseline_runs = collect_runs(baseline, name);
+
+            benchmark_comparison comparison;
+            comparison.name = name;
+            comparison.current_median = get_median(current_runs.medians);
+            comparison.current_allocations = current_runs.allocations_per_iteration;
+            comparison.number_of_current_runs = current_runs.medians.size();
+            comparison.number_of_baseline_runs = baseline_runs.medians.size();
+
+            if (baseline_runs.medians.empty()) {
+                comparison.verdict = benchmark_verdict::added;
+                comparisons.push_back(std::move(comparison));
+                continue;
+            }
+
+            comparison.baseline_median = get_median(baseline_runs.medians);
+            comparison.baseline_allocations = baseline_runs.allocations_per_iteration;
+            comparison.p_value = mann_whitney_u_test(baseline_runs.medians, current_runs.medians);
+
+            if (comparison.baseline_median > 0.0) {
+                comparison.change = (comparison.current_median - comparison.baseline_median) / comparison.baseline_median;
+            }
+
+            comparison.has_allocation_regression =
+                comparison.current_allocations - comparison.baseline_allocations >= settings.allocation_tolerance;
+
+            auto is_significant = comparison.p_value < settings.significance_level &&
+                                  std::abs(comparison.change) >= settings.minimum_change;
+
+            if (comparison.has_allocation_regression || (is_significant && comparison.change > 0.0)) {
+                comparison.verdict = benchmark_verdict::regressed;
+            } else if (is_significant) {
+                comparison.verdict = benchmark_verdict::improved;
+            }
+
+            comparisons.push_back(std::move(comparison));
+        }
+
+        for (const auto& name : get_names(baseline)) {
+            if (std::find(current_names.begin(), current_names.end(), name) == current_names.end()) {
+                auto baseline_runs = collect_runs(baseline, name);
+
+                benchmark_comparison comparison;
+                comparison.name = name;
+                comparison.verdict = benchmark_verdict::removed;
+                comparison.baseline_median = get_median(baseline_runs.medians);
+                comparison.baseline_allocations = baseline_runs.allocations_per_iteration;
+                comparison.number_of_baseline_runs = baseline_runs.medians.size();
+
+                comparisons.push_back(std::move(comparison));
+            }
+        }
+
+        return comparisons;
+    }
+
+    bool can_time_change_be_significant(size_t number_of_baseline_runs,
+                                        size_t number_of_current_runs,
+                                        const benchmark_comparison_settings& settings) {
+        // the most significant difference is every current run being slower than every baseline run
+        return mann_whitney_u_test(std::vector<double>(number_of_baseline_runs, 0.0),
+                                   std::vector<double>(number_of_current_runs, 1.0)) < settings.significance_level;
+    }
+
+    bool is_comparable_with_this_build(const benchmark_run& run) noexcept {
+        return run.build_type == benchmark_runner::get_build_type();
+    }
+
+    bool has_regression(const std::vector<benchmark_comparison>& comparisons) noexcept {
+        return std::any_of(comparisons.begin(), comparisons.end(), [](const auto& comparison) {
+            return comparison.verdict == benchmark_verdict::regressed;
+        });
+    }
+
+    std::string to_table(const std::vector<benchmark_comparison>& comparisons) {
+        size_t name_width {std::string_view("benchmark").size()};
+        for (const auto& comparison : comparisons) {
+            name_width = std::max(name_width, comparison.name.size());
+        }
+
+        std::stringstream ss;
+        ss << std::fixed;
+
+        ss << std::left << std::setw(static_cast<int>(name_width)) << "benchmark" << std::right
+           << std::setw(14) << "baseline ns"
+           << std::setw(14) << "current ns"
+           << std::setw(10) << "change %"
+           << std::setw(10) << "p-value"
+           << std::setw(8) << "runs"
+           << std::setw(14) << "allocations"
+           << "  verdict"
+           << '\n';
+
+        for (const auto& comparison : comparisons) {
+            std::stringstream allocations;
+            allocations << std::fixed << std::setprecision(1)
+                        << comparison.baseline_allocations << "->" << comparison.current_allocations;
+
+            auto runs = std::to_string(comparison.number_of_baseline_runs) + "/" +
+                        std::to_string(comparison.number_of_current_runs);
+
+            ss << std::left << std::setw(static_cast<int>(name_width)) << comparison.name << std::right
+               << std::setprecision(1)
+               << std::setw(14) << comparison.baseline_median
+               << std::setw(14) << comparison.current_median
+               << std::showpos << std::setw(10) << comparison.change * 100.0 << std::noshowpos
+               << std::setprecision(4)
+               << std::setw(10) << comparison.p_value
+               << std::setw(8) << runs
+               << std::setw(14) << allocations.str()
+               << "  " << to_string(comparison.verdict)
+               << (comparison.has_allocation_regression ? " (allocations)" : "")
+               << '\n';
+        }
+
+        return ss.str();
+    }
+}
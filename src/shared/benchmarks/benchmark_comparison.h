@@ -0,0 +1,131 @@
+#pragma once
+
+#include "benchmark_runner.h"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace pbr::shared::benchmarks {
+    /// The settings used to compare benchmark results against a baseline
+    struct benchmark_comparison_settings {
+        /// The largest p-value, from the Mann-Whitney U test of the runs' median times, at which a
+        /// change in time is significant rather than noise. At this level, a change needs at least 4
+        /// runs each to be significant, and then nearly every run of one must be faster than every
+        /// run of the other
+        double significance_level {0.05};
+
+        /// The smallest relative change in the median time, such as `0.1` for 10%, that is reported.
+        /// A change must be both this large and significant. Smaller changes may be significant, but
+        /// are too small to matter
+        double minimum_change {0.1};
+
+        /// The largest increase in the number of allocations per iteration that is not a
+        /// regression. Allocation counts are not noisy, so this only allows for rounding
+        double allocation_tolerance {0.5};
+    };
+
+    /// The verdict of comparing a benchmark against its baseline
+    enum class benchmark_verdict {
+        unchanged,
+        improved,
+        regressed,
+        /// The benchmark is not in the baseline
+        added,
+        /// The benchmark is only in the baseline
+        removed,
+    };
+
+    /// The comparison of a benchmark against its baseline
+    struct benchmark_comparison {
+        /// The name of the benchmark
+        std::string name;
+
+        /// The verdict
+        benchmark_verdict verdict {benchmark_verdict::unchanged};
+
+        /// The median of the baseline runs' median times, in nanoseconds
+        double baseline_median {0.0};
+
+        /// The median of the current runs' median times, in nanoseconds
+        double current_median {0.0};
+
+        /// The relative change in the median time, such as `0.1` for 10% slower
+        double change {0.0};
+
+        /// The p-value of the Mann-Whitney U test of the runs' median times
+        double p_value {1.0};
+
+        /// The number of baseline runs of the benchmark
+        size_t number_of_baseline_runs {0u};
+
+        /// The number of current runs of the benchmark
+        size_t number_of_current_runs {0u};
+
+        /// The mean allocations per iteration of the baseline runs
+        double baseline_allocations {0.0};
+
+        /// The mean allocations per iteration of the current runs
+        double current_allocations {0.0};
+
+        /// Did the number of allocations per iteration regress?
+        bool has_allocation_regression {false};
+    };
+
+    /// Runs a two-sided Mann-Whitney U test of two sets of samples, using the normal approximation
+    /// with corrections for ties and continuity. This does not assume the samples are normally
+    /// distributed, which benchmark times rarely are
+    /// \param first The first set of samples
+    /// \param second The second set of samples
+    /// \returns The probability of the sets being at least this different if they were from the
+    /// same distribution, else `1.0` if either set is empty
+    [[nodiscard]]
+    double mann_whitney_u_test(const std::vector<double>& first, const std::vector<double>& second);
+
+    /// Compares the results of runs against those of baseline runs. Each run should be a separate
+    /// process, as every time in a process shifts together with its memory layout and the load of the
+    /// machine, by far more than the samples of a run vary. The samples of a run are therefore not
+    /// independent, so the runs' median times are compared instead. A benchmark regresses if its
+    /// runs are significantly slower and its median time is noticeably slower, or if it makes more
+    /// allocations per iteration, whatever its time
+    /// \param baseline The results of the baseline runs
+    /// \param current The results of the current runs
+    /// \param settings The settings to use
+    /// \returns The comparisons, in the order of the current results, followed by any benchmarks only
+    /// in the baseline
+    [[nodiscard]]
+    std::vector<benchmark_comparison> compare_benchmarks(const std::vector<benchmark_run>& baseline,
+                                                         const std::vector<benchmark_run>& current,
+                                                         const benchmark_comparison_settings& settings = {});
+
+    /// Returns if a change in time can be significant with a number of runs, as with too few runs,
+    /// even runs that are all slower are not significant
+    /// \param number_of_baseline_runs The number of baseline runs
+    /// \param number_of_current_runs The number of current runs
+    /// \param settings The settings to use
+    /// \returns `true` if a change in time can be significant, else `false`
+    [[nodiscard]]
+    bool can_time_change_be_significant(size_t number_of_baseline_runs,
+                                        size_t number_of_current_runs,
+                                        const benchmark_comparison_settings& settings = {});
+
+    /// Returns if the results of a run can be compared with the results of this build. Results from a
+    /// build of another type cannot, as the optimizations of the build change the times far more than
+    /// any regression
+    /// \param run The results of the run
+    /// \returns `true` if the results can be compared, else `false`
+    [[nodiscard]]
+    bool is_comparable_with_this_build(const benchmark_run& run) noexcept;
+
+    /// Returns if any comparison is a regression
+    /// \param comparisons The comparisons
+    /// \returns `true` if any comparison is a regression, else `false`
+    [[nodiscard]]
+    bool has_regression(const std::vector<benchmark_comparison>& comparisons) noexcept;
+
+    /// Formats comparisons as a human readable table
+    /// \param comparisons The comparisons to format
+    /// \returns The formatted comparisons
+    [[nodiscard]]
+    std::string to_table(const std::vector<benchmark_comparison>& comparisons);
+}
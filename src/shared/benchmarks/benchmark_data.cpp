@@ -0,0 +1,35 @@
+#include "benchmarks.h"
+
+#include <fstream>
+#include <stdexcept>
+
+namespace pbr::shared::benchmarks {
+    std::filesystem::path get_benchmark_data_path() {
+        static const auto path = []() {
+            auto data_path = std::filesystem::temp_directory_path() / "pbr_benchmarks";
+
+            std::filesystem::remove_all(data_path);
+            std::filesystem::create_directories(data_path);
+
+            return data_path;
+        }();
+
+        return path;
+    }
+
+    std::filesystem::path write_benchmark_data_file(const std::filesystem::path& relative_path,
+                                                    std::string_view contents) {
+        auto path = get_benchmark_data_path() / relative_path;
+
+        std::filesystem::create_directories(path.parent_path());
+
+        std::ofstream file(path, std::ios::out | std::ios::trunc);
+        file << contents;
+
+        if (!file.good()) {
+            throw std::runtime_error("Failed to write benchmark data file: " + path.generic_string());
+        }
+
+        return path;
+    }
+}
@@ -0,0 +1,256 @@
+#include "benchmark_runner.h"
+#include "shared/memory/basic_allocators.h"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <numeric>
+#include <sstream>
+
+namespace pbr::shared::benchmarks {
+    using clock = std::chrono::steady_clock;
+
+    /// Returns a quantile of sorted values, interpolating between the closest values
+    /// \param sorted_values The values, sorted in ascending order. This must not be empty
+    /// \param quantile The quantile, from `0.0` to `1.0`
+    /// \returns The quantile of the values
+    static double get_quantile(const std::vector<double>& sorted_values, double quantile) {
+        auto position = quantile * static_cast<double>(sorted_values.size() - 1u);
+        auto lower = static_cast<size_t>(std::floor(position));
+        auto upper = std::min(lower + 1u, sorted_values.size() - 1u);
+        auto fraction = position - static_cast<double>(lower);
+
+        return sorted_values[lower] + (sorted_values[upper] - sorted_values[lower]) * fraction;
+    }
+
+    /// Times a number of iterations of a benchmark
+    /// \param function Runs the benchmark
+    /// \param iterations The number of iterations to run
+    /// \returns The time taken
+    static clock::duration time_iterations(const benchmark_function& function, uint64_t iterations) {
+        auto start = clock::now();
+        function(iterations);
+        return clock::now() - start;
+    }
+
+    void benchmark_runner::add(std::string name, benchmark_function function) {
+        this->_benchmarks.push_back({ std::move(name), std::move(function) });
+    }
+
+    std::vector<std::string> benchmark_runner::get_names() const {
+        std::vector<std::string> names;
+
+        for (const auto& benchmark : this->_benchmarks) {
+            names.push_back(benchmark.name);
+        }
+
+        return names;
+    }
+
+    std::vector<benchmark_result> benchmark_runner::run(std::string_view filter) const {
+        std::vector<benchmark_result> results;
+
+        for (const auto& benchmark : this->_benchmarks) {
+            if (!filter.empty() && benchmark.name.find(filter) == std::string::npos) {
+                continue;
+            }
+
+            results.push_back(this->run(benchmark.name, benchmark.function));
+        }
+
+        return results;
+    }
+
+    benchmark_result benchmark_runner::run(std::string name, const benchmark_function& function) const {
+        benchmark_result result;
+        result.name = std::move(name);
+
+        // double the iterations until a sample lasts long enough, which also warms up the benchmark
+        uint64_t iterations {1u};
+        auto warm_up_end = clock::now() + this->_settings.warm_up_time;
+
+        while (true) {
+            auto time = time_iterations(function, iterations);
+
+            if (time >= this->_settings.sample_time) {
+                if (clock::now() >= warm_up_end) {
+                    break;
+                }
+            } else {
+                iterations *= 2u;
+            }
+        }
+
+        result.iterations_per_sample = iterations;
+
+        // reserve the samples first, so the only allocations counted are the benchmark's
+        result.samples.reserve(this->_settings.number_of_samples);
+
+        auto allocations_before = memory::get_thread_allocation_statistics();
+
+        for (size_t i {0u}; i < this->_settings.number_of_samples; ++i) {
+            auto time = std::chrono::duration<double, std::nano>(time_iterations(function, iterations));
+            result.samples.push_back(time.count() / static_cast<double>(iterations));
+        }
+
+        auto allocations_after = memory::get_thread_allocation_statistics();
+
+        auto total_iterations = static_cast<double>(iterations * this->_settings.number_of_samples);
+
+        result.allocations_per_iteration = static_cast<double>(allocations_after.number_of_allocations -
+                                                               allocations_before.number_of_allocations) /
+                                           total_iterations;
+        result.allocated_bytes_per_iteration = static_cast<double>(allocations_after.allocated_bytes.get_value() -
+                                                                   allocations_before.allocated_bytes.get_value()) /
+                                               total_iterations;
+
+        benchmark_runner::calculate_statistics(result);
+
+        return result;
+    }
+
+    void benchmark_runner::calculate_statistics(benchmark_result& result) {
+        if (result.samples.empty()) {
+            return;
+        }
+
+        auto sorted_samples = result.samples;
+        std::sort(sorted_samples.begin(), sorted_samples.end());
+
+        // Tukey's fences
+        auto first_quartile = get_quantile(sorted_samples, 0.25);
+        auto third_quartile = get_quantile(sorted_samples, 0.75);
+        auto interquartile_range = third_quartile - first_quartile;
+        auto lower_fence = first_quartile - 1.5 * interquartile_range;
+        auto upper_fence = third_quartile + 1.5 * interquartile_range;
+
+        std::vector<double> kept_samples;
+        std::copy_if(sorted_samples.begin(), sorted_samples.end(), std::back_inserter(kept_samples),
+                     [lower_fence, upper_fence](double sample) {
+                         return sample >= lower_fence && sample <= upper_fence;
+                     });
+
+        result.number_of_outliers = sorted_samples.size() - kept_samples.size();
+
+        auto count = static_cast<double>(kept_samples.size());
+        auto mean = std::accumulate(kept_samples.begin(), kept_samples.end(), 0.0) / count;
+
+        auto sum_of_squares {0.0};
+        for (auto sample : kept_samples) {
+            sum_of_squares += (sample - mean) * (sample - mean);
+        }
+
+        result.median = get_quantile(kept_samples, 0.5);
+        result.mean = mean;
+        result.standard_deviation = kept_samples.size() > 1u ? std::sqrt(sum_of_squares / (count - 1.0)) : 0.0;
+        result.min = kept_samples.front();
+        result.max = kept_samples.back();
+    }
+
+    std::string benchmark_runner::to_table(const std::vector<benchmark_result>& results) {
+        size_t name_width {std::string_view("benchmark").size()};
+        for (const auto& result : results) {
+            name_width = std::max(name_width, result.name.size());
+        }
+
+        std::stringstream ss;
+        ss << std::fixed << std::setprecision(1);
+
+        ss << std::left << std::setw(static_cast<int>(name_width)) << "benchmark" << std::right
+           << std::setw(14) << "median ns"
+           << std::setw(14) << "mean ns"
+           << std::setw(12) << "stddev %"
+           << std::setw(14) << "min ns"
+           << std::setw(14) << "max ns"
+           << std::setw(10) << "outliers"
+           << std::setw(14) << "allocations"
+           << '\n';
+
+        for (const auto& result : results) {
+            auto relative_standard_deviation = result.mean > 0.0 ? result.standard_deviation / result.mean * 100.0 : 0.0;
+
+            ss << std::left << std::setw(static_cast<int>(name_width)) << result.name << std::right
+               << std::setw(14) << result.median
+               << std::setw(14) << result.mean
+               << std::setw(12) << relative_standard_deviation
+               << std::setw(14) << result.min
+               << std::setw(14) << result.max
+               << std::setw(10) << result.number_of_outliers
+               << std::setw(14) << result.allocations_per_iteration
+               << '\n';
+        }
+
+        return ss.str();
+    }
+
+    std::string benchmark_runner::to_json(const std::vector<benchmark_result>& results) {
+        auto json_results = nlohmann::json::array();
+
+        for (const auto& result : results) {
+            json_results.push_back({
+                { "name", result.name },
+                { "iterations_per_sample", result.iterations_per_sample },
+                { "number_of_outliers", result.number_of_outliers },
+                { "median_ns", result.median },
+                { "mean_ns", result.mean },
+                { "standard_deviation_ns", result.standard_deviation },
+                { "min_ns", result.min },
+                { "max_ns", result.max },
+                { "allocations_per_iteration", result.allocations_per_iteration },
+                { "allocated_bytes_per_iteration", result.allocated_bytes_per_iteration },
+                { "samples_ns", result.samples },
+            });
+        }
+
+        nlohmann::json json {
+            { "build_type", get_build_type() },
+            { "benchmarks", json_results },
+        };
+
+        return json.dump(4);
+    }
+
+    std::optional<benchmark_run> benchmark_runner::from_json(std::string_view json) noexcept {
+        try {
+            auto parsed = nlohmann::json::parse(json);
+
+            benchmark_run run;
+            run.build_type = parsed.at("build_type").get<std::string>();
+
+            for (const auto& json_result : parsed.at("benchmarks")) {
+                benchmark_result result;
+                result.name = json_result.at("name").get<std::string>();
+                result.iterations_per_sample = json_result.at("iterations_per_sample").get<uint64_t>();
+                result.number_of_outliers = json_result.at("number_of_outliers").get<size_t>();
+                result.median = json_result.at("median_ns").get<double>();
+                result.mean = json_result.at("mean_ns").get<double>();
+                result.standard_deviation = json_result.at("standard_deviation_ns").get<double>();
+                result.min = json_result.at("min_ns").get<double>();
+                result.max = json_result.at("max_ns").get<double>();
+                result.allocations_per_iteration = json_result.value("allocations_per_iteration", 0.0);
+                result.allocated_bytes_per_iteration = json_result.value("allocated_bytes_per_iteration", 0.0);
+                result.samples = json_result.at("samples_ns").get<std::vector<double>>();
+
+                run.results.push_back(std::move(result));
+            }
+
+            return run;
+        } catch (...) {
+            return {};
+        }
+    }
+
+    std::string_view benchmark_runner::get_build_type() noexcept {
+#if defined(DEBUG)
+        return "DEBUG";
+#elif defined(RELEASE_WITH_DEBUG_INFO)
+        return "RELEASE_WITH_DEBUG_INFO";
+#elif defined(RELEASE)
+        return "RELEASE";
+#else
+        return "UNKNOWN";
+#endif
+    }
+}
@@ -0,0 +1,164 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace pbr::shared::benchmarks {
+    /// Stops the compiler from optimizing away the calculation of a value
+    /// \param value The value to keep
+    template <typename T>
+    inline void do_not_optimize(T&& value) noexcept {
+        asm volatile("" : : "g"(&value) : "memory");
+    }
+
+    /// The settings of a benchmark run
+    struct benchmark_settings {
+        /// How long each benchmark runs before it is measured, so caches, branch predictors and
+        /// allocators are warmed up
+        std::chrono::nanoseconds warm_up_time {std::chrono::milliseconds(100)};
+
+        /// The number of samples taken of each benchmark
+        size_t number_of_samples {30u};
+
+        /// The least time each sample takes. The number of iterations in a sample is chosen so the
+        /// timer's resolution and overhead are insignificant
+        std::chrono::nanoseconds sample_time {std::chrono::milliseconds(5)};
+    };
+
+    /// The result of a benchmark. Times are per iteration, in nanoseconds
+    struct benchmark_result {
+        /// The name of the benchmark
+        std::string name;
+
+        /// The number of iterations in each sample
+        uint64_t iterations_per_sample {0u};
+
+        /// The time of each sample, including outliers, in the order they were taken
+        std::vector<double> samples;
+
+        /// The number of samples rejected as outliers
+        size_t number_of_outliers {0u};
+
+        /// The median time, excluding outliers
+        double median {0.0};
+
+        /// The mean time, excluding outliers
+        double mean {0.0};
+
+        /// The standard deviation of the time, excluding outliers
+        double standard_deviation {0.0};
+
+        /// The shortest time, excluding outliers
+        double min {0.0};
+
+        /// The longest time, excluding outliers
+        double max {0.0};
+
+        /// The mean number of heap allocations made by an iteration
+        double allocations_per_iteration {0.0};
+
+        /// The mean number of bytes allocated by an iteration, including the allocators' headers
+        double allocated_bytes_per_iteration {0.0};
+    };
+
+    /// The results of a run of benchmarks, as written by `benchmark_runner::to_json`
+    struct benchmark_run {
+        /// The type of the build the benchmarks were run in, such as `RELEASE`
+        std::string build_type;
+
+        /// The results of the benchmarks
+        std::vector<benchmark_result> results;
+    };
+
+    /// Runs one iteration of a benchmark the passed number of times. Any setup should be done before
+    /// the function is added, so it is not measured
+    using benchmark_function = std::function<void(uint64_t iterations)>;
+
+    /// Runs micro-benchmarks. Each benchmark is warmed up, then timed over a number of samples, each
+    /// running enough iterations to last at least the sample time. Samples outside Tukey's fences,
+    /// 1.5 times the interquartile range beyond the quartiles, are rejected as outliers, as they are
+    /// usually caused by the rest of the system, such as the thread being preempted. The heap
+    /// allocations made by the calling thread are also counted, as unlike time, they are not noisy
+    class benchmark_runner {
+    public:
+        /// Constructs this runner
+        /// \param settings The settings to use
+        explicit benchmark_runner(benchmark_settings settings = {})
+            : _settings(settings) {
+        }
+
+        /// Adds a benchmark
+        /// \param name The name of the benchmark, in the form `<module>/<name>`
+        /// \param function Runs the benchmark
+        void add(std::string name, benchmark_function function);
+
+        /// Returns the names of the added benchmarks
+        /// \returns The names of the added benchmarks, in the order they were added
+        [[nodiscard]]
+        std::vector<std::string> get_names() const;
+
+        /// Runs the added benchmarks
+        /// \param filter Only benchmarks whose names contain this are run. If this is empty, every
+        /// benchmark is run
+        /// \returns The results of the benchmarks that were run, in the order they were added
+        [[nodiscard]]
+        std::vector<benchmark_result> run(std::string_view filter = "") const;
+
+        /// Runs a benchmark
+        /// \param name The name of the benchmark
+        /// \param function Runs the benchmark
+        /// \returns The result of the benchmark
+        [[nodiscard]]
+        benchmark_result run(std::string name, const benchmark_function& function) const;
+
+        /// Calculates the statistics of a result from its samples
+        /// \param result The result to calculate the statistics of
+        static void calculate_statistics(benchmark_result& result);
+
+        /// Formats results as a human readable table
+        /// \param results The results to format
+        /// \returns The formatted results
+        [[nodiscard]]
+        static std::string to_table(const std::vector<benchmark_result>& results);
+
+        /// Formats results as JSON, along with the type of this build
+        /// \param results The results to format
+        /// \returns The formatted results
+        [[nodiscard]]
+        static std::string to_json(const std::vector<benchmark_result>& results);
+
+        /// Parses results formatted by `to_json`
+        /// \param json The formatted results
+        /// \returns The parsed results and the type of the build they were run in, else empty if the
+        /// results could not be parsed
+        [[nodiscard]]
+        static std::optional<benchmark_run> from_json(std::string_view json) noexcept;
+
+        /// Returns the type of this build, as benchmarks from different build types cannot be compared
+        /// \returns The type of this build, such as `RELEASE`
+        [[nodiscard]]
+        static std::string_view get_build_type() noexcept;
+
+    private:
+        /// A benchmark added to this runner
+        struct added_benchmark {
+            /// The name of the benchmark
+            std::string name;
+
+            /// Runs the benchmark
+            benchmark_function function;
+        };
+
+        /// The settings
+        benchmark_settings _settings;
+
+        /// The added benchmarks
+        std::vector<added_benchmark> _benchmarks;
+    };
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "benchmark_runner.h"
+
+#include <filesystem>
+#include <string_view>
+
+namespace pbr::shared::benchmarks {
+    /// Returns the directory benchmark data files are written to. It is emptied the first time
+    /// this is called
+    /// \returns The directory benchmark data files are written to
+    [[nodiscard]]
+    std::filesystem::path get_benchmark_data_path();
+
+    /// Writes a data file used by a benchmark
+    /// \param relative_path The path of the file from `get_benchmark_data_path()`
+    /// \param contents The contents of the file
+    /// \returns The full path of the written file
+    std::filesystem::path write_benchmark_data_file(const std::filesystem::path& relative_path,
+                                                    std::string_view contents);
+
+    /// Adds the benchmarks of the `utils` module
+    /// \param runner The runner to add the benchmarks to
+    void add_utils_benchmarks(benchmark_runner& runner);
+
+    /// Adds the benchmarks of the `data` module
+    /// \param runner The runner to add the benchmarks to
+    void add_data_benchmarks(benchmark_runner& runner);
+
+    /// Adds the benchmarks of the `apis/logging` module
+    /// \param runner The runner to add the benchmarks to
+    void add_logging_benchmarks(benchmark_runner& runner);
+
+    /// Adds the benchmarks of the `diagnostics` module
+    /// \param runner The runner to add the benchmarks to
+    void add_diagnostics_benchmarks(benchmark_runner& runner);
+
+    /// Adds the benchmarks of the `memory` module
+    /// \param runner The runner to add the benchmarks to
+    void add_memory_benchmarks(benchmark_runner& runner);
+
+    /// Adds the benchmarks of the `resource` module
+    /// \param runner The runner to add the benchmarks to
+    void add_resource_benchmarks(benchmark_runner& runner);
+}
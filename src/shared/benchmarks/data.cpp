@@ -0,0 +1,69 @@
+#include "benchmarks.h"
+#include "shared/data/settings.h"
+#include "shared/data/data_manager.h"
+#include "shared/apis/datetime/datetime_manager.h"
+#include "shared/apis/logging/log_manager.h"
+#include "shared/apis/file/file_manager.h"
+
+#include <memory>
+
+namespace pbr::shared::benchmarks {
+    void add_data_benchmarks(benchmark_runner& runner) {
+        runner.add("data/settings_add", [](uint64_t iterations) {
+            data::settings settings;
+
+            for (uint64_t i {0u}; i < iterations; ++i) {
+                settings.add("width", 1920);
+                settings.add("title", std::string("Project Bird Racing"));
+                do_not_optimize(settings);
+            }
+        });
+
+        runner.add("data/settings_get", [](uint64_t iterations) {
+            data::settings settings;
+            settings.add("width", 1920);
+            settings.add("scale", 1.5f);
+            settings.add("title", std::string("Project Bird Racing"));
+
+            for (uint64_t i {0u}; i < iterations; ++i) {
+                auto width = settings.get_as_int("width");
+                auto scale = settings.get_as_float("scale");
+                auto title = settings.get("title");
+                do_not_optimize(width);
+                do_not_optimize(scale);
+                do_not_optimize(title);
+            }
+        });
+
+        write_benchmark_data_file("data/settings.json", R"({
+    "api": "vulkan",
+    "width": 1920,
+    "height": 1080,
+    "fullscreen": false,
+    "scale": 1.5,
+    "window": {
+        "title": "Project Bird Racing",
+        "x": 100,
+        "y": 100
+    },
+    "items": [
+        { "name": "first", "value": 1 },
+        { "name": "second", "value": 2 }
+    ]
+})");
+
+        auto datetime_manager = std::make_shared<apis::datetime::datetime_manager>();
+        auto log_manager = std::make_shared<apis::logging::log_manager>(datetime_manager);
+
+        auto data_manager = std::make_shared<data::data_manager>(get_benchmark_data_path() / "data",
+                                                                 std::make_shared<apis::file::file_manager>(),
+                                                                 log_manager);
+
+        runner.add("data/data_manager_read_settings", [data_manager](uint64_t iterations) {
+            for (uint64_t i {0u}; i < iterations; ++i) {
+                auto settings = data_manager->read_settings("settings");
+                do_not_optimize(settings);
+            }
+        });
+    }
+}
@@ -0,0 +1,76 @@
+#include "benchmarks.h"
+#include "shared/diagnostics/counter_set.h"
+#include "shared/diagnostics/tracer.h"
+#include "shared/diagnostics/tracked_mutex.h"
+
+#include <memory>
+#include <mutex>
+
+namespace pbr::shared::benchmarks {
+    void add_diagnostics_benchmarks(benchmark_runner& runner) {
+        runner.add("diagnostics/counter_set_increment_counter_handle", [](uint64_t iterations) {
+            diagnostics::counter_set counter_set;
+            auto handle = counter_set.register_counter("counter");
+
+            for (uint64_t i {0u}; i < iterations; ++i) {
+                counter_set.increment_counter(handle, 1);
+            }
+
+            do_not_optimize(counter_set);
+        });
+
+        runner.add("diagnostics/counter_set_increment_counter_key", [](uint64_t iterations) {
+            diagnostics::counter_set counter_set;
+            const std::string key {"counter"};
+
+            for (uint64_t i {0u}; i < iterations; ++i) {
+                counter_set.increment_counter(key, 1);
+            }
+
+            do_not_optimize(counter_set);
+        });
+
+        runner.add("diagnostics/counter_set_get_counter_for_duration", [](uint64_t iterations) {
+            diagnostics::counter_set counter_set;
+            const std::string key {"counter"};
+            int result {0};
+
+            for (uint64_t i {0u}; i < iterations; ++i) {
+                counter_set.get_counter_for_duration(key, std::chrono::seconds(1), result);
+            }
+
+            do_not_optimize(result);
+        });
+
+        runner.add("diagnostics/counter_set_get_average_for_duration", [](uint64_t iterations) {
+            diagnostics::counter_set counter_set;
+            const std::string key {"counter"};
+            float result {0.0f};
+
+            for (uint64_t i {0u}; i < iterations; ++i) {
+                counter_set.add_value_to_list(key, static_cast<int>(i % 100u));
+                counter_set.get_average_for_duration(key, std::chrono::milliseconds(1), result);
+            }
+
+            do_not_optimize(result);
+        });
+
+        runner.add("diagnostics/trace_zone_disabled", [](uint64_t iterations) {
+            diagnostics::disable_tracing();
+
+            for (uint64_t i {0u}; i < iterations; ++i) {
+                diagnostics::trace_zone zone("benchmark");
+                do_not_optimize(zone);
+            }
+        });
+
+        auto registry = std::make_shared<diagnostics::counter_registry>();
+        auto mutex = std::make_shared<diagnostics::tracked_mutex>("benchmark", *registry);
+
+        runner.add("diagnostics/tracked_mutex_uncontended", [registry, mutex](uint64_t iterations) {
+            for (uint64_t i {0u}; i < iterations; ++i) {
+                std::scoped_lock<diagnostics::tracked_mutex> lock(*mutex);
+            }
+        });
+    }
+}
@@ -0,0 +1,72 @@
+#include "benchmarks.h"
+#include "shared/apis/datetime/datetime_manager.h"
+#include "shared/apis/logging/log_manager.h"
+#include "shared/apis/logging/endpoints/file.h"
+#include "shared/apis/logging/endpoints/std_out.h"
+
+#include <iostream>
+#include <memory>
+#include <streambuf>
+
+namespace pbr::shared::benchmarks {
+    /// A stream buffer discarding everything written to it
+    class null_stream_buffer : public std::streambuf {
+    protected:
+        int_type overflow(int_type c) override {
+            return traits_type::not_eof(c);
+        }
+
+        std::streamsize xsputn(const char_type*, std::streamsize count) override {
+            return count;
+        }
+    };
+
+    /// Adds a benchmark logging a message to a single endpoint
+    /// \param runner The runner to add the benchmark to
+    /// \param name The name of the benchmark
+    /// \param endpoint The endpoint to log to, else `nullptr` to log to no endpoints
+    /// \param output_stream The stream the endpoint writes to, which discards its output while the
+    /// benchmark runs, else `nullptr` if the endpoint does not write to a stream
+    static void add_log_message_benchmark(benchmark_runner& runner,
+                                          std::string name,
+                                          const std::shared_ptr<apis::logging::endpoint>& endpoint,
+                                          std::ostream* output_stream = nullptr) {
+        auto datetime_manager = std::make_shared<apis::datetime::datetime_manager>();
+        auto log_manager = std::make_shared<apis::logging::log_manager>(datetime_manager);
+
+        if (endpoint && !log_manager->add_endpoint(endpoint)) {
+            throw std::runtime_error("Failed to add logging endpoint.");
+        }
+
+        auto discarding_buffer = std::make_shared<null_stream_buffer>();
+
+        runner.add(std::move(name), [log_manager, output_stream, discarding_buffer](uint64_t iterations) {
+            auto* previous_buffer = output_stream ? output_stream->rdbuf(discarding_buffer.get()) : nullptr;
+
+            for (uint64_t i {0u}; i < iterations; ++i) {
+                log_manager->log_message("Benchmarking a log message.",
+                                         apis::logging::log_levels::info,
+                                         "Benchmark");
+            }
+
+            if (output_stream) {
+                output_stream->rdbuf(previous_buffer);
+            }
+        });
+    }
+
+    void add_logging_benchmarks(benchmark_runner& runner) {
+        add_log_message_benchmark(runner, "logging/log_message_no_endpoints", nullptr);
+
+        auto log_path = get_benchmark_data_path() / "log.txt";
+        add_log_message_benchmark(runner,
+                                  "logging/log_message_file",
+                                  std::make_shared<apis::logging::endpoints::file>(log_path, true));
+
+        // `stdout` discards the messages, so this measures the endpoint rather than the terminal
+        add_log_message_benchmark(runner,
+                                  "logging/log_message_std_out",
+                                  std::make_shared<apis::logging::endpoints::std_out>(),
+                                  &std::cout);
+    }
+}
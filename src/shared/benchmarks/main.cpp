@@ -0,0 +1,181 @@
+#include "benchmark_comparison.h"
+#include "benchmarks.h"
+#include "shared/utils/program_arguments.h"
+#include "shared/utils/strings.h"
+
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <sstream>
+#include <vector>
+
+using namespace pbr::shared;
+
+/// Reads the results of runs written by `-json`. The runs must be comparable with this build
+/// \param paths The paths of the results, separated by commas
+/// \returns The runs, else empty if any could not be read or are from a different build type
+static std::optional<std::vector<benchmarks::benchmark_run>> read_runs(const std::string& paths) {
+    std::vector<benchmarks::benchmark_run> runs;
+
+    for (const auto& path : utils::split(",", paths)) {
+        std::ifstream file(path);
+        std::stringstream json;
+        json << file.rdbuf();
+
+        auto run = benchmarks::benchmark_runner::from_json(json.str());
+        if (!run) {
+            std::cerr << "Failed to read the results from " << path << '\n';
+            return {};
+        }
+
+        if (!benchmarks::is_comparable_with_this_build(*run)) {
+            std::cerr << "The results in " << path << " are from a " << run->build_type << " build, but this is a "
+                      << benchmarks::benchmark_runner::get_build_type()
+                      << " build, so they cannot be compared\n";
+            return {};
+        }
+
+        runs.push_back(std::move(*run));
+    }
+
+    if (runs.empty()) {
+        std::cerr << "No results to compare in: " << paths << '\n';
+        return {};
+    }
+
+    return runs;
+}
+
+/// Runs the benchmarks of the shared library. Benchmarks should be run in a `RELEASE` build.
+/// The supported program arguments are:
+/// `-filter=<text>` to only run benchmarks whose names contain the text,
+/// `-samples=<number>` to set the number of samples taken of each benchmark,
+/// `-json=<path>` to write the results as JSON to the path,
+/// `-list` to list the benchmarks without running them,
+/// `-baseline=<path>[,<path>...]` to compare the results against those written by `-json` in earlier
+/// runs, failing if any benchmark regressed, or if any results are from a different build type,
+/// `-current=<path>[,<path>...]` to compare the results written by `-json` in other runs against the
+/// baseline, rather than running the benchmarks,
+/// `-threshold=<percent>` to set the smallest change in a median time that is reported as a change,
+/// 10% by default.
+/// Every time in a run shifts together with the process' memory layout and the load of the machine,
+/// so times are compared across runs, each in its own process. For instance, alternate 5 runs of the
+/// build before a change with 5 runs of the build after it, writing the results of each with `-json`,
+/// then compare them with `-baseline` and `-current`. Alternating the runs means a slow period of the
+/// machine slows runs of both builds. With too few runs, only the allocations are compared
+int main(int argv, char* args[]) {
+    std::vector<std::string> arguments;
+    for (auto i {0}; i < argv; ++i) {
+        arguments.push_back(args[i]);
+    }
+
+    try {
+        utils::program_arguments pa(arguments);
+
+        benchmarks::benchmark_settings settings;
+
+        if (auto samples_argument = pa.get_argument("samples")) {
+            auto samples = utils::to_int(*samples_argument);
+            if (!samples || *samples <= 0) {
+                std::cerr << "Invalid number of samples: " << *samples_argument << '\n';
+                return 1;
+            }
+
+            settings.number_of_samples = static_cast<size_t>(*samples);
+        }
+
+        benchmarks::benchmark_comparison_settings comparison_settings;
+
+        if (auto threshold_argument = pa.get_argument("threshold")) {
+            auto threshold = utils::to_int(*threshold_argument);
+            if (!threshold || *threshold < 0) {
+                std::cerr << "Invalid threshold: " << *threshold_argument << '\n';
+                return 1;
+            }
+
+            comparison_settings.minimum_change = static_cast<double>(*threshold) / 100.0;
+        }
+
+        // load the results before running, so a bad path does not waste a run
+        std::optional<std::vector<benchmarks::benchmark_run>> baseline;
+
+        if (auto baseline_paths = pa.get_argument("baseline")) {
+            baseline = read_runs(*baseline_paths);
+            if (!baseline) {
+                return 1;
+            }
+        }
+
+        std::optional<std::vector<benchmarks::benchmark_run>> current;
+
+        if (auto current_paths = pa.get_argument("current")) {
+            if (!baseline) {
+                std::cerr << "There is no baseline to compare the current results against\n";
+                return 1;
+            }
+
+            current = read_runs(*current_paths);
+            if (!current) {
+                return 1;
+            }
+        }
+
+        benchmarks::benchmark_runner runner(settings);
+
+        benchmarks::add_utils_benchmarks(runner);
+        benchmarks::add_data_benchmarks(runner);
+        benchmarks::add_diagnostics_benchmarks(runner);
+        benchmarks::add_memory_benchmarks(runner);
+        benchmarks::add_resource_benchmarks(runner);
+        benchmarks::add_logging_benchmarks(runner);
+
+        if (pa.has_argument("list")) {
+            for (const auto& name : runner.get_names()) {
+                std::cout << name << '\n';
+            }
+
+            return 0;
+        }
+
+        if (!current) {
+            auto results = runner.run(pa.get_argument("filter").value_or(""));
+
+            std::cout << benchmarks::benchmark_runner::to_table(results);
+
+            if (auto json_path = pa.get_argument("json")) {
+                std::ofstream file(*json_path, std::ios::out | std::ios::trunc);
+                file << benchmarks::benchmark_runner::to_json(results);
+
+                if (!file.good()) {
+                    std::cerr << "Failed to write results to " << *json_path << '\n';
+                    return 1;
+                }
+            }
+
+            current = std::vector<benchmarks::benchmark_run> {
+                { std::string(benchmarks::benchmark_runner::get_build_type()), std::move(results) }
+            };
+        }
+
+        if (baseline) {
+            auto comparisons = benchmarks::compare_benchmarks(*baseline, *current, comparison_settings);
+
+            std::cout << '\n' << benchmarks::to_table(comparisons);
+
+            if (!benchmarks::can_time_change_be_significant(baseline->size(), current->size(), comparison_settings)) {
+                std::cout << "\nNo change in time can be significant with " << baseline->size() << " baseline and "
+                          << current->size() << " current runs, so only the allocations were compared\n";
+            }
+
+            if (benchmarks::has_regression(comparisons)) {
+                std::cerr << "Benchmarks regressed against the baseline\n";
+                return 1;
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << '\n';
+        return 1;
+    }
+
+    return 0;
+}
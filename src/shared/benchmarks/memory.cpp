@@ -0,0 +1,40 @@
+#include "benchmarks.h"
+#include "shared/memory/basic_allocators.h"
+
+#include <new>
+
+namespace pbr::shared::benchmarks {
+    /// Adds a benchmark allocating and freeing a block with the global `operator new`
+    /// \param runner The runner to add the benchmark to
+    /// \param size The size of the block
+    static void add_operator_new_benchmark(benchmark_runner& runner, size_t size) {
+        runner.add("memory/operator_new_" + std::to_string(size), [size](uint64_t iterations) {
+            for (uint64_t i {0u}; i < iterations; ++i) {
+                auto block = ::operator new(size);
+                do_not_optimize(block);
+                ::operator delete(block);
+            }
+        });
+    }
+
+    void add_memory_benchmarks(benchmark_runner& runner) {
+        add_operator_new_benchmark(runner, 16u);
+        add_operator_new_benchmark(runner, 256u);
+        add_operator_new_benchmark(runner, 4096u);
+
+        runner.add("memory/operator_new_aligned_64", [](uint64_t iterations) {
+            for (uint64_t i {0u}; i < iterations; ++i) {
+                auto block = ::operator new(64u, std::align_val_t(64u));
+                do_not_optimize(block);
+                ::operator delete(block, std::align_val_t(64u));
+            }
+        });
+
+        runner.add("memory/get_number_of_allocated_bytes", [](uint64_t iterations) {
+            for (uint64_t i {0u}; i < iterations; ++i) {
+                auto result = memory::get_number_of_allocated_bytes();
+                do_not_optimize(result);
+            }
+        });
+    }
+}
@@ -0,0 +1,56 @@
+#include "benchmarks.h"
+#include "shared/resource/resource_manager.h"
+#include "shared/apis/datetime/datetime_manager.h"
+#include "shared/apis/logging/log_manager.h"
+#include "shared/apis/file/file_manager.h"
+
+#include <memory>
+
+namespace pbr::shared::benchmarks {
+    /// A resource manager loading integers, so only the manager itself is measured
+    class benchmark_resource_manager : public resource::resource_manager<int> {
+    public:
+        /// Constructs this resource manager
+        /// \param data_manager The data manager
+        /// \param log_manager The log manager
+        benchmark_resource_manager(const std::shared_ptr<data::data_manager>& data_manager,
+                                   const std::shared_ptr<apis::logging::ilog_manager>& log_manager)
+            : resource_manager(data_manager, log_manager, "resource_list") {
+        }
+
+    protected:
+        /// Loads a resource
+        /// \returns The loaded resource
+        std::shared_ptr<int> load(const std::filesystem::path&) noexcept override {
+            return std::make_shared<int>(1);
+        }
+    };
+
+    void add_resource_benchmarks(benchmark_runner& runner) {
+        write_benchmark_data_file("resources/resource_list.json", R"({
+    "resources": [
+        { "name": "first", "path": "first" },
+        { "name": "second", "path": "second" },
+        { "name": "third", "path": "third" }
+    ]
+})");
+
+        auto datetime_manager = std::make_shared<apis::datetime::datetime_manager>();
+        auto log_manager = std::make_shared<apis::logging::log_manager>(datetime_manager);
+
+        auto data_manager = std::make_shared<data::data_manager>(get_benchmark_data_path() / "resources",
+                                                                 std::make_shared<apis::file::file_manager>(),
+                                                                 log_manager);
+
+        auto manager = std::make_shared<benchmark_resource_manager>(data_manager, log_manager);
+
+        runner.add("resource/resource_manager_get_cached", [manager](uint64_t iterations) {
+            const std::string name {"second"};
+
+            for (uint64_t i {0u}; i < iterations; ++i) {
+                auto result = manager->get(name);
+                do_not_optimize(result);
+            }
+        });
+    }
+}
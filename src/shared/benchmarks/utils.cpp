@@ -0,0 +1,42 @@
+#include "benchmarks.h"
+#include "shared/utils/strings.h"
+
+namespace pbr::shared::benchmarks {
+    void add_utils_benchmarks(benchmark_runner& runner) {
+        runner.add("utils/split", [](uint64_t iterations) {
+            const std::string value {"graphics,windowing,logging,data,resource,scene"};
+
+            for (uint64_t i {0u}; i < iterations; ++i) {
+                auto result = utils::split(",", value);
+                do_not_optimize(result);
+            }
+        });
+
+        runner.add("utils/trim", [](uint64_t iterations) {
+            const std::string value {"  \t some setting value \r\n"};
+
+            for (uint64_t i {0u}; i < iterations; ++i) {
+                auto result = utils::trim(value);
+                do_not_optimize(result);
+            }
+        });
+
+        runner.add("utils/to_int", [](uint64_t iterations) {
+            const std::string value {"-123456"};
+
+            for (uint64_t i {0u}; i < iterations; ++i) {
+                auto result = utils::to_int(value);
+                do_not_optimize(result);
+            }
+        });
+
+        runner.add("utils/to_float", [](uint64_t iterations) {
+            const std::string value {"-1234.5678"};
+
+            for (uint64_t i {0u}; i < iterations; ++i) {
+                auto result = utils::to_float(value);
+                do_not_optimize(result);
+            }
+        });
+    }
+}
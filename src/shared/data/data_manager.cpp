@@ -41,6 +41,10 @@ namespace pbr::shared::data {
         return settings;
     }
 
+    bool data_manager::has_settings(const std::filesystem::path& relative_path) const noexcept {
+        return this->resolve_path(relative_path, { ".json" }).has_value();
+    }
+
     std::optional<settings> data_manager::read_settings(const std::filesystem::path& relative_path) const noexcept {
         auto path = this->resolve_path(relative_path, { ".json" });
         if (!path) {
@@ -33,6 +33,11 @@ namespace pbr::shared::data {
         /// \returns The read settings, else empty if an error occurred
         std::optional<settings> read_settings(const std::filesystem::path& relative_path) const noexcept;
 
+        /// Returns if a settings file exists, so optional settings can be told apart from invalid ones
+        /// \param relative_path The relative path to the settings file from the `data` directory
+        /// \returns `true` if the settings file exists, else `false`
+        bool has_settings(const std::filesystem::path& relative_path) const noexcept;
+
         /// Reads shader code from the passed file. The file extension (not needed in the relative path),
         /// will be used to determine the type of shader this is. If the file extension is not known, the
         /// shader type will default to the passed type hint.
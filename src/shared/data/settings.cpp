@@ -17,7 +17,7 @@ namespace pbr::shared::data {
             return {};
         }
 
-        if (auto i = utils::to_int(this->_map[key]); i) {
+        if (auto i = utils::to_int(it->second); i) {
             return i;
         }
 
@@ -38,7 +38,7 @@ namespace pbr::shared::data {
             return {};
         }
 
-        if (auto i = utils::to_float(this->_map[key]); i) {
+        if (auto i = utils::to_float(it->second); i) {
             return i;
         }
 
@@ -51,7 +51,7 @@ namespace pbr::shared::data {
             return {};
         }
 
-        auto value = this->_map[key];
+        const auto& value = it->second;
 
         // we're being strict with these values
         if (value == "true") {
@@ -0,0 +1,112 @@
+#include "counter_registry.h"
+
+#include <bit>
+
+namespace pbr::shared::diagnostics {
+    /// Returns the hash of a counter name
+    /// \param name The name of the counter
+    /// \returns The hash of the name
+    static size_t hash_name(std::string_view name) noexcept {
+        // FNV-1a
+        uint64_t hash {14695981039346656037ull};
+
+        for (auto c : name) {
+            hash ^= static_cast<uint8_t>(c);
+            hash *= 1099511628211ull;
+        }
+
+        return static_cast<size_t>(hash);
+    }
+
+    counter_registry::counter_registry(size_t max_counters)
+        : _max_counters(max_counters),
+          _slots(std::make_unique<counter_slot[]>(max_counters)),
+          _names(std::make_unique<std::string[]>(max_counters)),
+          // keep the lookup table at most half full, so probe sequences stay short
+          _lookup_size(std::bit_ceil(max_counters * 2u)) {
+        this->_lookup = std::make_unique<std::atomic_uint32_t[]>(this->_lookup_size);
+    }
+
+    counter_handle counter_registry::register_counter(std::string_view name) noexcept {
+        if (auto handle = this->find_counter(name); handle.is_valid()) {
+            return handle;
+        }
+
+        std::scoped_lock<std::mutex> lock(this->_register_mutex);
+
+        auto mask = this->_lookup_size - 1u;
+
+        for (auto i = hash_name(name) & mask; ; i = (i + 1u) & mask) {
+            auto entry = this->_lookup[i].load(std::memory_order_acquire);
+
+            if (entry == 0u) {
+                auto index = this->_number_of_counters.load(std::memory_order_relaxed);
+                if (index >= this->_max_counters) {
+                    return {};
+                }
+
+                try {
+                    this->_names[index] = name;
+                } catch (...) {
+                    return {};
+                }
+
+                // publish the name before the counter can be found
+                this->_lookup[i].store(static_cast<uint32_t>(index + 1u), std::memory_order_release);
+                this->_number_of_counters.store(index + 1u, std::memory_order_release);
+
+                return counter_handle { .index = static_cast<uint32_t>(index) };
+            }
+
+            // another thread may have registered the same name since it was looked up
+            if (this->_names[entry - 1u] == name) {
+                return counter_handle { .index = entry - 1u };
+            }
+        }
+    }
+
+    counter_handle counter_registry::find_counter(std::string_view name) const noexcept {
+        auto mask = this->_lookup_size - 1u;
+
+        for (auto i = hash_name(name) & mask; ; i = (i + 1u) & mask) {
+            auto entry = this->_lookup[i].load(std::memory_order_acquire);
+
+            if (entry == 0u) {
+                return {};
+            }
+
+            if (this->_names[entry - 1u] == name) {
+                return counter_handle { .index = entry - 1u };
+            }
+        }
+    }
+
+    std::string_view counter_registry::get_name(counter_handle handle) const noexcept {
+        if (!handle.is_valid() || handle.index >= this->get_number_of_counters()) {
+            return {};
+        }
+
+        return this->_names[handle.index];
+    }
+
+    std::vector<counter_snapshot_entry> counter_registry::snapshot() const {
+        auto number_of_counters = this->get_number_of_counters();
+
+        std::vector<counter_snapshot_entry> entries;
+        entries.reserve(number_of_counters);
+
+        for (size_t i {0u}; i < number_of_counters; ++i) {
+            entries.push_back(counter_snapshot_entry {
+                .name = this->_names[i],
+                .value = this->_slots[i].value.load(std::memory_order_relaxed),
+            });
+        }
+
+        return entries;
+    }
+
+    counter_registry& get_counter_registry() noexcept {
+        static counter_registry registry(1024u);
+        return registry;
+    }
+}
@@ -0,0 +1,189 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace pbr::shared::diagnostics {
+    /// Refers to a counter registered with a counter registry
+    struct counter_handle {
+        /// The value of `index` for a handle that does not refer to a counter
+        static constexpr uint32_t invalid_index {UINT32_MAX};
+
+        /// The index of the counter in its registry
+        uint32_t index {invalid_index};
+
+        /// Returns if this handle refers to a counter
+        /// \returns `true` if this handle refers to a counter, else `false`
+        [[nodiscard]]
+        constexpr bool is_valid() const noexcept {
+            return this->index != invalid_index;
+        }
+
+        /// Standard compare operators
+        auto operator <=> (const counter_handle& other) const = default;
+    };
+
+    /// The value of a counter at the time a snapshot was taken
+    struct counter_snapshot_entry {
+        /// The name of the counter
+        std::string name;
+
+        /// The value of the counter
+        int64_t value {0};
+    };
+
+    /// A registry of named counters. A counter is registered once by name, which returns a handle
+    /// used for all later updates. Updating a counter through its handle is a single relaxed atomic
+    /// operation on a slot in its own cache line, so counters can be updated from any thread without
+    /// locks or contention. Looking up a counter by name is lock-free. Registering a new counter takes
+    /// a lock, and the number of counters is fixed when the registry is constructed.
+    class counter_registry {
+    public:
+        /// Constructs this registry
+        /// \param max_counters The most counters that can be registered
+        explicit counter_registry(size_t max_counters = 256u);
+
+        ~counter_registry() = default;
+
+        counter_registry(const counter_registry&) = delete;
+        counter_registry(counter_registry&&) = delete;
+
+        counter_registry& operator = (const counter_registry&) = delete;
+        counter_registry& operator = (counter_registry&&) = delete;
+
+        /// Registers a counter, starting at `0`. If a counter with the passed name is already
+        /// registered, the existing counter's handle is returned. This is thread safe
+        /// \param name The name of the counter
+        /// \returns The handle of the counter, else an invalid handle if the registry is full
+        [[nodiscard]]
+        counter_handle register_counter(std::string_view name) noexcept;
+
+        /// Returns the handle of a registered counter. This is lock-free
+        /// \param name The name of the counter
+        /// \returns The handle of the counter, else an invalid handle if no counter with the passed
+        /// name is registered
+        [[nodiscard]]
+        counter_handle find_counter(std::string_view name) const noexcept;
+
+        /// Adds to a counter. This is lock-free. If the handle is invalid, nothing happens
+        /// \param handle The handle of the counter
+        /// \param amount The amount to add. This can be negative
+        void add(counter_handle handle, int64_t amount) noexcept {
+            if (handle.is_valid()) [[likely]] {
+                this->_slots[handle.index].value.fetch_add(amount, std::memory_order_relaxed);
+            }
+        }
+
+        /// Sets a counter. This is lock-free. If the handle is invalid, nothing happens
+        /// \param handle The handle of the counter
+        /// \param value The value to set
+        void set(counter_handle handle, int64_t value) noexcept {
+            if (handle.is_valid()) [[likely]] {
+                this->_slots[handle.index].value.store(value, std::memory_order_relaxed);
+            }
+        }
+
+        /// Sets a counter to a value if the value is greater than the counter. This is lock-free. If
+        /// the handle is invalid, nothing happens
+        /// \param handle The handle of the counter
+        /// \param value The value to set if it is greater than the counter
+        void update_max(counter_handle handle, int64_t value) noexcept {
+            if (!handle.is_valid()) [[unlikely]] {
+                return;
+            }
+
+            auto& slot_value = this->_slots[handle.index].value;
+            auto current = slot_value.load(std::memory_order_relaxed);
+
+            while (value > current &&
+                   !slot_value.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+            }
+        }
+
+        /// Sets a counter and returns its previous value. This is lock-free
+        /// \param handle The handle of the counter
+        /// \param value The value to set
+        /// \returns The previous value of the counter, else `0` if the handle is invalid
+        int64_t exchange(counter_handle handle, int64_t value) noexcept {
+            if (!handle.is_valid()) {
+                return 0;
+            }
+
+            return this->_slots[handle.index].value.exchange(value, std::memory_order_relaxed);
+        }
+
+        /// Returns the value of a counter. This is lock-free
+        /// \param handle The handle of the counter
+        /// \returns The value of the counter, else `0` if the handle is invalid
+        [[nodiscard]]
+        int64_t get(counter_handle handle) const noexcept {
+            if (!handle.is_valid()) {
+                return 0;
+            }
+
+            return this->_slots[handle.index].value.load(std::memory_order_relaxed);
+        }
+
+        /// Returns the name of a counter
+        /// \param handle The handle of the counter
+        /// \returns The name of the counter, else an empty string if the handle is invalid
+        [[nodiscard]]
+        std::string_view get_name(counter_handle handle) const noexcept;
+
+        /// Returns the number of registered counters
+        /// \returns The number of registered counters
+        [[nodiscard]]
+        size_t get_number_of_counters() const noexcept {
+            return this->_number_of_counters.load(std::memory_order_acquire);
+        }
+
+        /// Returns the values of all registered counters. Writers are not blocked while the snapshot
+        /// is taken, so each value is read atomically, but the values are not all from the same instant
+        /// \returns The values of all registered counters, in the order they were registered
+        [[nodiscard]]
+        std::vector<counter_snapshot_entry> snapshot() const;
+
+    private:
+        /// The value of a single counter. Each value sits in its own cache line, so threads updating
+        /// different counters never contend with each other
+        struct alignas(64) counter_slot {
+            /// The value of the counter
+            std::atomic_int64_t value {0};
+        };
+
+        /// The most counters that can be registered
+        size_t _max_counters {0u};
+
+        /// The value of each counter
+        std::unique_ptr<counter_slot[]> _slots;
+
+        /// The name of each counter. A name is written before its counter is published, and never
+        /// changes afterwards
+        std::unique_ptr<std::string[]> _names;
+
+        /// Maps the hash of a name to the index of its counter plus one, so `0` marks an empty
+        /// entry. This uses open addressing, and entries are never removed
+        std::unique_ptr<std::atomic_uint32_t[]> _lookup;
+
+        /// The number of entries in `_lookup`. This is a power of two
+        size_t _lookup_size {0u};
+
+        /// The number of registered counters
+        std::atomic_size_t _number_of_counters {0u};
+
+        /// Serializes registering counters
+        std::mutex _register_mutex;
+    };
+
+    /// Returns the process wide counter registry. Subsystems register their counters here, so the
+    /// counters can be exported in one place
+    /// \returns The process wide counter registry
+    [[nodiscard]]
+    counter_registry& get_counter_registry() noexcept;
+}
@@ -1,14 +1,19 @@
 #include "counter_set.h"
 
 #include <numeric>
+#include <string>
 
 namespace pbr::shared::diagnostics {
-    void counter_set::increment_counter(const std::string& key, int amount) noexcept {
-        this->_counters[key] += amount;
+    void counter_set::increment_counter(std::string_view key, int amount) noexcept {
+        this->increment_counter(this->register_counter_for_update(key), amount);
     }
 
-    void counter_set::decrement_counter(const std::string& key, int amount) noexcept {
-        this->_counters[key] -= amount;
+    void counter_set::decrement_counter(std::string_view key, int amount) noexcept {
+        this->decrement_counter(this->register_counter_for_update(key), amount);
+    }
+
+    void counter_set::set_counter(std::string_view key, int value) noexcept {
+        this->set_counter(this->register_counter_for_update(key), value);
     }
 
     void counter_set::add_value_to_list(const std::string& key, int value) noexcept {
@@ -21,16 +26,15 @@ namespace pbr::shared::diagnostics {
         auto now = std::chrono::system_clock::now();
         auto last_update = this->_counter_update_times[key];
 
-        auto counter = this->_counters[key];
+        auto handle = this->register_counter_for_update(key);
 
         if (now - last_update >= duration) {
             this->_counter_update_times[key] = now;
-            this->_counters[key] = 0;
-            out_result_at_duration = counter;
+            out_result_at_duration = static_cast<int>(this->_counters.exchange(handle, 0));
             return 0;
         }
 
-        return counter;
+        return this->get_counter(handle);
     }
 
     float counter_set::get_average_for_duration(const std::string& key,
@@ -52,4 +56,24 @@ namespace pbr::shared::diagnostics {
 
         return result;
     }
+
+    counter_handle counter_set::register_counter_for_update(std::string_view key) noexcept {
+        auto handle = this->register_counter(key);
+        if (handle.is_valid()) {
+            return handle;
+        }
+
+        // only log the first, as a full set drops an update on every call
+        if (this->_number_of_dropped_updates.fetch_add(1u, std::memory_order_relaxed) == 0u && this->_log_manager) {
+            try {
+                this->_log_manager->log_message("The counter set is full, so updates to unregistered counters, such as " +
+                                                std::string(key) + ", are dropped.",
+                                                apis::logging::log_levels::warning,
+                                                "Diagnostics");
+            } catch (...) {
+            }
+        }
+
+        return handle;
+    }
 }
@@ -1,38 +1,117 @@
 #pragma once
 
+#include "counter_registry.h"
+#include "shared/apis/logging/ilog_manager.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <unordered_map>
 #include <string>
+#include <string_view>
 #include <chrono>
 #include <vector>
 
 namespace pbr::shared::diagnostics {
     /// A set of counters. A counter can be incremented, decremented and have various
     /// average based operations performed against it. It can also be reset. This may
-    /// be useful for frame counters or number of render calls per frame etc... Counters
-    /// are referenced by a string based key. If a requested key does not exist, a key is
-    /// created with the default type of the counter
+    /// be useful for frame counters or number of render calls per frame etc...
+    /// Counters are kept in a `counter_registry`. Hot paths should register a counter once
+    /// and update it through its handle, which is lock-free, thread safe and does not allocate.
+    /// Counters can also be referenced by a string based key, in which case the key is looked
+    /// up, and registered if it does not exist, on every call. Counter lists and the duration based
+    /// functions are not thread safe.
+    /// The number of counters is fixed when the set is constructed. Once it is full, updates to
+    /// counters that are not registered are dropped. They are counted, and the first is logged
     class counter_set {
     public:
+        /// Constructs this set
+        /// \param log_manager The log manager to log the first dropped update to, else `nullptr`
+        /// \param max_counters The most counters that can be registered
+        explicit counter_set(std::shared_ptr<apis::logging::ilog_manager> log_manager = {},
+                             size_t max_counters = 256u)
+            : _counters(max_counters),
+              _log_manager(std::move(log_manager)) {
+        }
+
+        /// Registers a counter, or returns the handle of an existing counter with the same key
+        /// \param key The key of the counter
+        /// \returns The handle of the counter, else an invalid handle if no more counters can be registered
+        [[nodiscard]]
+        counter_handle register_counter(std::string_view key) noexcept {
+            return this->_counters.register_counter(key);
+        }
+
+        /// Increments a counter. This is thread safe
+        /// \param handle The handle of the counter
+        /// \param amount The amount to increment by
+        void increment_counter(counter_handle handle, int amount) noexcept {
+            this->_counters.add(handle, amount);
+        }
+
         /// Increments a counter
         /// \param key The key of the counter
         /// \param amount The amount to increment by
-        void increment_counter(const std::string& key, int amount) noexcept;
+        void increment_counter(std::string_view key, int amount) noexcept;
+
+        /// Decrements a counter. This is thread safe
+        /// \param handle The handle of the counter
+        /// \param amount The amount to decrement by
+        void decrement_counter(counter_handle handle, int amount) noexcept {
+            this->_counters.add(handle, -static_cast<int64_t>(amount));
+        }
 
         /// Decrements a counter
         /// \param key The key of the counter
         /// \param amount The amount to decrement by
-        void decrement_counter(const std::string& key, int amount) noexcept;
+        void decrement_counter(std::string_view key, int amount) noexcept;
+
+        /// Sets a counter to a value. This is thread safe
+        /// \param handle The handle of the counter
+        /// \param value The value to set
+        void set_counter(counter_handle handle, int value) noexcept {
+            this->_counters.set(handle, value);
+        }
+
+        /// Sets a counter to a value
+        /// \param key The key of the counter
+        /// \param value The value to set
+        void set_counter(std::string_view key, int value) noexcept;
 
         /// Adds a value to a counter list
         /// \param key The key of the counter
         /// \param value The value to add
         void add_value_to_list(const std::string& key, int value) noexcept;
 
-        /// Returns the counter for the passed key
+        /// Returns the counter for the passed handle. This is thread safe
+        /// \param handle The handle of the counter
+        /// \returns The counter for the passed handle
+        [[nodiscard]]
+        int get_counter(counter_handle handle) const noexcept {
+            return static_cast<int>(this->_counters.get(handle));
+        }
+
+        /// Returns the counter for the passed key. The counter is not registered if it does not exist
         /// \param key The key of the counter
-        /// \returns The counter for the passed key
-        int get_counter(const std::string& key) noexcept {
-            return this->_counters[key];
+        /// \returns The counter for the passed key, else `0` if the counter does not exist
+        [[nodiscard]]
+        int get_counter(std::string_view key) const noexcept {
+            return this->get_counter(this->_counters.find_counter(key));
+        }
+
+        /// Returns the number of updates dropped because the set was full. This is thread safe
+        /// \returns The number of updates dropped because the set was full
+        [[nodiscard]]
+        uint64_t get_number_of_dropped_updates() const noexcept {
+            return this->_number_of_dropped_updates.load(std::memory_order_relaxed);
+        }
+
+        /// Returns the registry holding the counters, for instance to snapshot all counters
+        /// \returns The registry holding the counters
+        [[nodiscard]]
+        counter_registry& get_registry() noexcept {
+            return this->_counters;
         }
 
         /// Returns the values for the counter list for the passed key
@@ -71,12 +150,24 @@ namespace pbr::shared::diagnostics {
 
     private:
         /// Stores the counters
-        std::unordered_map<std::string, int> _counters;
+        counter_registry _counters;
+
+        /// The log manager to log the first dropped update to, else `nullptr`
+        std::shared_ptr<apis::logging::ilog_manager> _log_manager;
+
+        /// The number of updates dropped because the set was full
+        std::atomic_uint64_t _number_of_dropped_updates {0u};
 
         /// When a counter was last updated
         std::unordered_map<std::string, std::chrono::system_clock::time_point> _counter_update_times;
 
         /// Stores the counter lists
         std::unordered_map<std::string, std::vector<int>> _counter_lists;
+
+        /// Registers a counter to be updated by key, counting the update as dropped if the set is full
+        /// \param key The key of the counter
+        /// \returns The handle of the counter, else an invalid handle if the set is full
+        [[nodiscard]]
+        counter_handle register_counter_for_update(std::string_view key) noexcept;
     };
 }
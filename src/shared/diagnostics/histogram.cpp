@@ -0,0 +1,166 @@
+#include "histogram.h"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <iomanip>
+
+namespace pbr::shared::diagnostics {
+    static_assert(histogram::get_bucket_index(histogram::max_value) == histogram::number_of_buckets - 1u);
+    static_assert(histogram::get_bucket_highest_value(histogram::number_of_buckets - 1u) == histogram::max_value);
+
+    void histogram::record(std::chrono::nanoseconds value) noexcept {
+        auto count = value.count();
+        auto clamped = count < 0 ? uint64_t {0u} : std::min(static_cast<uint64_t>(count), max_value);
+
+        ++this->_buckets[get_bucket_index(clamped)];
+        ++this->_count;
+        this->_sum += clamped;
+        this->_min = std::min(this->_min, clamped);
+        this->_max = std::max(this->_max, clamped);
+    }
+
+    void histogram::merge(const histogram& other) noexcept {
+        if (other._count == 0u) {
+            return;
+        }
+
+        for (size_t i {0u}; i < number_of_buckets; ++i) {
+            this->_buckets[i] += other._buckets[i];
+        }
+
+        this->_count += other._count;
+        this->_sum += other._sum;
+        this->_min = std::min(this->_min, other._min);
+        this->_max = std::max(this->_max, other._max);
+    }
+
+    void histogram::reset() noexcept {
+        this->_buckets.fill(0u);
+        this->_count = 0u;
+        this->_sum = 0u;
+        this->_min = UINT64_MAX;
+        this->_max = 0u;
+    }
+
+    std::chrono::nanoseconds histogram::get_percentile(double percentile) const noexcept {
+        if (this->_count == 0u) {
+            return std::chrono::nanoseconds(0);
+        }
+
+        percentile = std::clamp(percentile, 0.0, 100.0);
+
+        // the rank of the value at the percentile, counting from 1
+        auto rank = static_cast<uint64_t>(std::ceil(percentile / 100.0 * static_cast<double>(this->_count)));
+        rank = std::clamp(rank, uint64_t {1u}, this->_count);
+
+        // the smallest and largest values are known exactly
+        if (rank == 1u) {
+            return std::chrono::nanoseconds(static_cast<int64_t>(this->_min));
+        }
+
+        if (rank == this->_count) {
+            return std::chrono::nanoseconds(static_cast<int64_t>(this->_max));
+        }
+
+        uint64_t seen {0u};
+
+        for (size_t i {0u}; i < number_of_buckets; ++i) {
+            seen += this->_buckets[i];
+
+            if (seen >= rank) {
+                auto value = std::clamp(get_bucket_highest_value(i), this->_min, this->_max);
+                return std::chrono::nanoseconds(static_cast<int64_t>(value));
+            }
+        }
+
+        return std::chrono::nanoseconds(static_cast<int64_t>(this->_max));
+    }
+
+    histogram_statistics histogram::get_statistics() const noexcept {
+        if (this->_count == 0u) {
+            return {};
+        }
+
+        return histogram_statistics {
+            .count = this->_count,
+            .min = std::chrono::nanoseconds(static_cast<int64_t>(this->_min)),
+            .max = std::chrono::nanoseconds(static_cast<int64_t>(this->_max)),
+            .mean = std::chrono::nanoseconds(static_cast<int64_t>(this->_sum / this->_count)),
+            .p50 = this->get_percentile(50.0),
+            .p95 = this->get_percentile(95.0),
+            .p99 = this->get_percentile(99.0),
+            .p999 = this->get_percentile(99.9),
+        };
+    }
+
+    rolling_histogram::rolling_histogram(std::chrono::nanoseconds window, size_t number_of_slices)
+        : _slice_length(std::chrono::duration_cast<clock::duration>(window) /
+                        static_cast<clock::duration::rep>(std::max(number_of_slices, size_t {1u}))),
+          _slices(std::max(number_of_slices, size_t {1u})),
+          _current_slice_start(clock::now()) {
+    }
+
+    void rolling_histogram::record(std::chrono::nanoseconds value, clock::time_point now) noexcept {
+        this->advance_to(now);
+        this->_slices[this->_current_slice].record(value);
+    }
+
+    histogram_statistics rolling_histogram::get_statistics(clock::time_point now) noexcept {
+        this->advance_to(now);
+
+        this->_merged.reset();
+
+        for (const auto& slice : this->_slices) {
+            this->_merged.merge(slice);
+        }
+
+        return this->_merged.get_statistics();
+    }
+
+    void rolling_histogram::reset() noexcept {
+        for (auto& slice : this->_slices) {
+            slice.reset();
+        }
+
+        this->_current_slice = 0u;
+        this->_current_slice_start = clock::now();
+    }
+
+    void rolling_histogram::advance_to(clock::time_point now) noexcept {
+        if (now - this->_current_slice_start < this->_slice_length) [[likely]] {
+            return;
+        }
+
+        auto number_of_elapsed_slices = static_cast<size_t>((now - this->_current_slice_start) / this->_slice_length);
+
+        // clear the slices that have expired, which is all of them after a long pause
+        auto number_to_clear = std::min(number_of_elapsed_slices, this->_slices.size());
+
+        for (size_t i {0u}; i < number_to_clear; ++i) {
+            this->_current_slice = (this->_current_slice + 1u) % this->_slices.size();
+            this->_slices[this->_current_slice].reset();
+        }
+
+        this->_current_slice_start += this->_slice_length * static_cast<clock::duration::rep>(number_of_elapsed_slices);
+    }
+
+    std::string to_string(const histogram_statistics& statistics) {
+        auto to_milliseconds = [](std::chrono::nanoseconds value) {
+            return std::chrono::duration<double, std::milli>(value).count();
+        };
+
+        std::stringstream ss;
+        ss << std::fixed << std::setprecision(3)
+           << "count: " << statistics.count
+           << ", min: " << to_milliseconds(statistics.min) << "ms"
+           << ", mean: " << to_milliseconds(statistics.mean) << "ms"
+           << ", p50: " << to_milliseconds(statistics.p50) << "ms"
+           << ", p95: " << to_milliseconds(statistics.p95) << "ms"
+           << ", p99: " << to_milliseconds(statistics.p99) << "ms"
+           << ", p99.9: " << to_milliseconds(statistics.p999) << "ms"
+           << ", max: " << to_milliseconds(statistics.max) << "ms";
+
+        return ss.str();
+    }
+}
@@ -0,0 +1,214 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace pbr::shared::diagnostics {
+    /// The statistics of the values recorded in a histogram
+    struct histogram_statistics {
+        /// The number of values recorded
+        uint64_t count {0u};
+
+        /// The smallest value recorded
+        std::chrono::nanoseconds min {0};
+
+        /// The largest value recorded
+        std::chrono::nanoseconds max {0};
+
+        /// The mean of the values recorded
+        std::chrono::nanoseconds mean {0};
+
+        /// The 50th percentile
+        std::chrono::nanoseconds p50 {0};
+
+        /// The 95th percentile
+        std::chrono::nanoseconds p95 {0};
+
+        /// The 99th percentile
+        std::chrono::nanoseconds p99 {0};
+
+        /// The 99.9th percentile
+        std::chrono::nanoseconds p999 {0};
+    };
+
+    /// A histogram of durations using fixed memory. Values are counted in logarithmic buckets, with
+    /// each power of two split into linear sub-buckets, so every value is kept to within about 6% of
+    /// its real value, from nanoseconds up to `max_value`. Recording a value is O(1), and the
+    /// statistics are calculated in O(buckets). This is not thread safe
+    class histogram {
+    public:
+        /// The number of bits used to index the sub-buckets of each power of two
+        static constexpr uint32_t sub_bucket_bits {4u};
+
+        /// The number of sub-buckets in each power of two
+        static constexpr uint32_t sub_bucket_count {1u << sub_bucket_bits};
+
+        /// The largest power of two tracked. Larger values are counted as `max_value`
+        static constexpr uint32_t max_power {40u};
+
+        /// The largest value, in nanoseconds, that is tracked. This is about 18 minutes
+        static constexpr uint64_t max_value {(uint64_t {1u} << max_power) - 1u};
+
+        /// The number of buckets
+        static constexpr size_t number_of_buckets {sub_bucket_count * (max_power - sub_bucket_bits + 1u)};
+
+        /// Records a value
+        /// \param value The value to record
+        void record(std::chrono::nanoseconds value) noexcept;
+
+        /// Adds the values recorded in another histogram to this histogram
+        /// \param other The histogram to add
+        void merge(const histogram& other) noexcept;
+
+        /// Removes all recorded values
+        void reset() noexcept;
+
+        /// Returns the number of values recorded
+        /// \returns The number of values recorded
+        [[nodiscard]]
+        uint64_t get_count() const noexcept {
+            return this->_count;
+        }
+
+        /// Returns the value at a percentile. The value is the highest value that would be counted
+        /// in the same bucket, so it is never lower than the real value. The smallest and largest
+        /// values are exact
+        /// \param percentile The percentile, from `0.0` to `100.0`
+        /// \returns The value at the percentile, else `0` if no values have been recorded
+        [[nodiscard]]
+        std::chrono::nanoseconds get_percentile(double percentile) const noexcept;
+
+        /// Returns the statistics of the recorded values
+        /// \returns The statistics of the recorded values
+        [[nodiscard]]
+        histogram_statistics get_statistics() const noexcept;
+
+        /// Returns the bucket a value is counted in
+        /// \param value The value, in nanoseconds
+        /// \returns The index of the bucket
+        [[nodiscard]]
+        static constexpr size_t get_bucket_index(uint64_t value) noexcept {
+            if (value > max_value) {
+                value = max_value;
+            }
+
+            if (value < sub_bucket_count) {
+                return static_cast<size_t>(value);
+            }
+
+            // the top `sub_bucket_bits` bits below the leading bit pick the sub-bucket
+            auto power = static_cast<uint32_t>(std::bit_width(value)) - 1u;
+            auto shift = power - sub_bucket_bits;
+
+            return static_cast<size_t>((shift + 1u) * sub_bucket_count +
+                                       ((value >> shift) & (sub_bucket_count - 1u)));
+        }
+
+        /// Returns the highest value counted in a bucket
+        /// \param index The index of the bucket
+        /// \returns The highest value counted in the bucket, in nanoseconds
+        [[nodiscard]]
+        static constexpr uint64_t get_bucket_highest_value(size_t index) noexcept {
+            if (index < sub_bucket_count) {
+                return index;
+            }
+
+            auto shift = static_cast<uint32_t>(index / sub_bucket_count) - 1u;
+            auto sub_bucket = index % sub_bucket_count;
+
+            auto lowest = (uint64_t {sub_bucket_count} + sub_bucket) << shift;
+            return lowest + (uint64_t {1u} << shift) - 1u;
+        }
+
+    private:
+        /// The number of values counted in each bucket
+        std::array<uint64_t, number_of_buckets> _buckets {};
+
+        /// The number of values recorded
+        uint64_t _count {0u};
+
+        /// The sum of the values recorded, in nanoseconds
+        uint64_t _sum {0u};
+
+        /// The smallest value recorded, in nanoseconds
+        uint64_t _min {UINT64_MAX};
+
+        /// The largest value recorded, in nanoseconds
+        uint64_t _max {0u};
+    };
+
+    /// A histogram of the durations recorded over a rolling window of time. The window is split
+    /// into slices, each with its own histogram. As time passes, the oldest slice is cleared and
+    /// reused, so the statistics cover between `window - window / number_of_slices` and `window`
+    /// of time. The memory used is fixed. This is not thread safe
+    class rolling_histogram {
+    public:
+        /// The clock used to divide the window into slices
+        using clock = std::chrono::steady_clock;
+
+        /// Constructs this histogram
+        /// \param window The length of time the statistics cover
+        /// \param number_of_slices The number of slices the window is split into. More slices make
+        /// the window move more smoothly, at the cost of memory and of calculating the statistics
+        explicit rolling_histogram(std::chrono::nanoseconds window = std::chrono::seconds(1),
+                                   size_t number_of_slices = 4u);
+
+        /// Records a value at the current time
+        /// \param value The value to record
+        void record(std::chrono::nanoseconds value) noexcept {
+            this->record(value, clock::now());
+        }
+
+        /// Records a value at a point in time
+        /// \param value The value to record
+        /// \param now The time to record the value at. This should not go backwards
+        void record(std::chrono::nanoseconds value, clock::time_point now) noexcept;
+
+        /// Returns the statistics of the values recorded in the window ending now
+        /// \returns The statistics of the values recorded in the window
+        [[nodiscard]]
+        histogram_statistics get_statistics() noexcept {
+            return this->get_statistics(clock::now());
+        }
+
+        /// Returns the statistics of the values recorded in the window ending at a point in time
+        /// \param now The end of the window. This should not go backwards
+        /// \returns The statistics of the values recorded in the window
+        [[nodiscard]]
+        histogram_statistics get_statistics(clock::time_point now) noexcept;
+
+        /// Removes all recorded values
+        void reset() noexcept;
+
+    private:
+        /// The length of each slice
+        clock::duration _slice_length;
+
+        /// The histogram of each slice
+        std::vector<histogram> _slices;
+
+        /// The index of the slice values are currently recorded in
+        size_t _current_slice {0u};
+
+        /// The time the current slice started
+        clock::time_point _current_slice_start;
+
+        /// Histogram the slices are merged into when calculating statistics, kept to avoid reallocating
+        histogram _merged;
+
+        /// Moves to the slice covering the passed time, clearing any slices that have expired
+        /// \param now The current time
+        void advance_to(clock::time_point now) noexcept;
+    };
+
+    /// Formats histogram statistics as a single line, with the durations in milliseconds
+    /// \param statistics The statistics to format
+    /// \returns The formatted statistics
+    [[nodiscard]]
+    std::string to_string(const histogram_statistics& statistics);
+}
@@ -0,0 +1,435 @@
+#include "metrics_exporter.h"
+#include "shared/memory/basic_allocators.h"
+#include "shared/memory/allocation_tags.h"
+#include "shared/platform/platform.h"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <system_error>
+
+#if defined(PLATFORM_LINUX) || defined(PLATFORM_MAC)
+#define METRICS_EXPORTER_SOCKETS
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace pbr::shared::diagnostics {
+    /// How often the exporting thread checks if it should stop while serving the socket
+    constexpr std::chrono::milliseconds socket_poll_interval {100};
+
+    /// Returns a metric name with any characters Prometheus does not allow replaced with `_`
+    /// \param name The name
+    /// \returns The sanitized name
+    static std::string sanitize_metric_name(std::string_view name) {
+        std::string sanitized(name);
+
+        for (auto& c : sanitized) {
+            auto is_valid = (c >= 'a' && c <= 'z') ||
+                            (c >= 'A' && c <= 'Z') ||
+                            (c >= '0' && c <= '9') ||
+                            c == '_' || c == ':';
+
+            if (!is_valid) {
+                c = '_';
+            }
+        }
+
+        return sanitized;
+    }
+
+    /// Writes a file by writing a temporary file and renaming it, so readers never see a
+    /// partially written file
+    /// \param path The path of the file
+    /// \param contents The contents to write
+    /// \returns `true` upon success, else `false`
+    static bool write_file_atomically(const std::filesystem::path& path, std::string_view contents) noexcept {
+        try {
+            auto temporary_path = path;
+            temporary_path += ".tmp";
+
+            {
+                std::ofstream file(temporary_path, std::ios::out | std::ios::trunc | std::ios::binary);
+                if (!file.is_open()) {
+                    return false;
+                }
+
+                file.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+                if (!file.good()) {
+                    return false;
+                }
+            }
+
+            std::error_code error;
+            std::filesystem::rename(temporary_path, path, error);
+
+            return !error;
+        } catch (...) {
+            return false;
+        }
+    }
+
+    metrics_exporter::metrics_exporter(metrics_exporter_settings settings, const counter_registry& registry)
+        : _settings(std::move(settings)),
+          _registry(registry) {
+    }
+
+    metrics_exporter::~metrics_exporter() {
+        this->stop();
+    }
+
+    bool metrics_exporter::start() noexcept {
+        if (this->is_running()) {
+            return false;
+        }
+
+        if (!this->_settings.socket_path.empty() && !this->open_socket()) {
+            return false;
+        }
+
+        {
+            std::scoped_lock<std::mutex> lock(this->_stop_mutex);
+            this->_should_stop = false;
+        }
+
+        try {
+            this->_thread = std::thread(&metrics_exporter::run, this);
+        } catch (...) {
+            this->close_socket();
+            return false;
+        }
+
+        return true;
+    }
+
+    void metrics_exporter::stop() noexcept {
+        if (!this->is_running()) {
+            return;
+        }
+
+        {
+            std::scoped_lock<std::mutex> lock(this->_stop_mutex);
+            this->_should_stop = true;
+        }
+
+        this->_stop_condition.notify_all();
+        this->_thread.join();
+
+        this->close_socket();
+    }
+
+    bool metrics_exporter::export_metrics() noexcept {
+        try {
+            auto entries = this->snapshot();
+            auto succeeded {true};
+
+            this->_latest_prometheus_text = metrics_exporter::to_prometheus_text(entries);
+
+            if (!this->_settings.prometheus_path.empty()) {
+                succeeded &= write_file_atomically(this->_settings.prometheus_path, this->_latest_prometheus_text);
+            }
+
+            if (!this->_settings.json_lines_path.empty()) {
+                auto line = metrics_exporter::to_json_line(entries, std::chrono::system_clock::now());
+                succeeded &= this->append_json_line(line);
+            }
+
+            return succeeded;
+        } catch (...) {
+            return false;
+        }
+    }
+
+    std::vector<counter_snapshot_entry> metrics_exporter::snapshot() const {
+        auto entries = this->_registry.snapshot();
+
+        entries.push_back(counter_snapshot_entry {
+            .name = "memory_allocated_bytes",
+            .value = static_cast<int64_t>(memory::get_number_of_allocated_bytes().get_value()),
+        });
+
+        for (size_t i {0u}; i < memory::number_of_allocation_tags; ++i) {
+            auto tag = static_cast<memory::allocation_tag>(i);
+            if (tag == memory::allocation_tag::untagged) {
+                continue;
+            }
+
+            auto statistics = memory::get_allocation_tag_statistics(tag);
+            auto prefix = "memory_" + std::string(memory::to_string(tag));
+
+            entries.push_back(counter_snapshot_entry {
+                .name = prefix + "_live_bytes",
+                .value = static_cast<int64_t>(statistics.live_bytes.get_value()),
+            });
+
+            entries.push_back(counter_snapshot_entry {
+                .name = prefix + "_peak_bytes",
+                .value = static_cast<int64_t>(statistics.peak_bytes.get_value()),
+            });
+
+            entries.push_back(counter_snapshot_entry {
+                .name = prefix + "_allocations",
+                .value = static_cast<int64_t>(statistics.number_of_allocations),
+            });
+        }
+
+        return entries;
+    }
+
+    std::string metrics_exporter::to_prometheus_text(const std::vector<counter_snapshot_entry>& snapshot) {
+        std::stringstream ss;
+
+        for (const auto& entry : snapshot) {
+            auto name = "pbr_" + sanitize_metric_name(entry.name);
+
+            ss << "# TYPE " << name << " gauge\n"
+               << name << ' ' << entry.value << '\n';
+        }
+
+        return ss.str();
+    }
+
+    std::string metrics_exporter::to_json_line(const std::vector<counter_snapshot_entry>& snapshot,
+                                               std::chrono::system_clock::time_point timestamp) {
+        auto milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(timestamp.time_since_epoch());
+
+        std::stringstream ss;
+        ss << "{\"timestamp_ms\":" << milliseconds.count() << ",\"metrics\":{";
+
+        auto is_first {true};
+        for (const auto& entry : snapshot) {
+            if (!is_first) {
+                ss << ',';
+            }
+
+            is_first = false;
+
+            // sanitizing keeps the names free of characters that would need escaping
+            ss << '"' << sanitize_metric_name(entry.name) << "\":" << entry.value;
+        }
+
+        ss << "}}";
+
+        return ss.str();
+    }
+
+    void metrics_exporter::run() noexcept {
+        while (true) {
+            // failures are retried on the next export, as the outputs may become writable later
+            [[maybe_unused]] auto result = this->export_metrics();
+
+            if (this->wait_until(std::chrono::steady_clock::now() + this->_settings.interval)) {
+                break;
+            }
+        }
+
+        // export one last time, so the outputs hold the final values
+        [[maybe_unused]] auto result = this->export_metrics();
+    }
+
+    bool metrics_exporter::wait_until(std::chrono::steady_clock::time_point deadline) noexcept {
+        std::unique_lock<std::mutex> lock(this->_stop_mutex);
+
+        if (this->_socket < 0) {
+            return this->_stop_condition.wait_until(lock, deadline, [this]() { return this->_should_stop; });
+        }
+
+        while (!this->_should_stop) {
+            auto now = std::chrono::steady_clock::now();
+            if (now >= deadline) {
+                return false;
+            }
+
+            lock.unlock();
+
+            this->serve_socket_connections();
+
+            lock.lock();
+
+            this->_stop_condition.wait_until(lock,
+                                             std::min(deadline, now + socket_poll_interval),
+                                             [this]() { return this->_should_stop; });
+        }
+
+        return true;
+    }
+
+    bool metrics_exporter::append_json_line(std::string_view line) noexcept {
+        try {
+            const auto& path = this->_settings.json_lines_path;
+
+            std::error_code error;
+            auto size = std::filesystem::file_size(path, error);
+
+            if (!error && size + line.size() + 1u > this->_settings.max_json_lines_file_size.get_value()) {
+                auto rotated_path = [&path](uint32_t index) {
+                    auto rotated = path;
+                    rotated += "." + std::to_string(index);
+                    return rotated;
+                };
+
+                // shift each rotated file up by one, dropping the oldest
+                auto number_of_files = this->_settings.number_of_rotated_json_lines_files;
+                if (number_of_files == 0u) {
+                    std::filesystem::remove(path, error);
+                } else {
+                    std::filesystem::remove(rotated_path(number_of_files), error);
+
+                    for (auto i = number_of_files - 1u; i > 0u; --i) {
+                        std::filesystem::rename(rotated_path(i), rotated_path(i + 1u), error);
+                    }
+
+                    std::filesystem::rename(path, rotated_path(1u), error);
+                }
+            }
+
+            std::ofstream file(path, std::ios::out | std::ios::app | std::ios::binary);
+            if (!file.is_open()) {
+                return false;
+            }
+
+            file << line << '\n';
+
+            return file.good();
+        } catch (...) {
+            return false;
+        }
+    }
+
+#ifdef METRICS_EXPORTER_SOCKETS
+    /// Removes a socket left at a path, such as by a previous run. Anything else at the path is
+    /// left alone, as the path may have been passed by mistake
+    /// \param path The path of the socket
+    /// \returns `true` if there is nothing at the path, else `false`
+    static bool remove_socket(const std::string& path) noexcept {
+        struct stat status {};
+
+        if (lstat(path.c_str(), &status) != 0) {
+            return errno == ENOENT;
+        }
+
+        if (!S_ISSOCK(status.st_mode)) {
+            return false;
+        }
+
+        return unlink(path.c_str()) == 0;
+    }
+
+    bool metrics_exporter::open_socket() noexcept {
+        auto path = this->_settings.socket_path.string();
+
+        sockaddr_un address {};
+        if (path.size() >= sizeof(address.sun_path)) {
+            return false;
+        }
+
+        address.sun_family = AF_UNIX;
+        std::memcpy(address.sun_path, path.c_str(), path.size() + 1u);
+
+        auto listening_socket = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (listening_socket < 0) {
+            return false;
+        }
+
+        // a previous run may have left its socket behind
+        if (!remove_socket(path)) {
+            close(listening_socket);
+            return false;
+        }
+
+        if (bind(listening_socket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+            listen(listening_socket, 8) != 0 ||
+            fcntl(listening_socket, F_SETFL, O_NONBLOCK) != 0) {
+            close(listening_socket);
+            return false;
+        }
+
+        this->_socket = listening_socket;
+
+        return true;
+    }
+
+    void metrics_exporter::close_socket() noexcept {
+        if (this->_socket < 0) {
+            return;
+        }
+
+        close(this->_socket);
+        this->_socket = -1;
+
+        remove_socket(this->_settings.socket_path.string());
+    }
+
+    void metrics_exporter::serve_socket_connections() noexcept {
+        pollfd poll_fd {
+            .fd = this->_socket,
+            .events = POLLIN,
+            .revents = 0,
+        };
+
+        if (poll(&poll_fd, 1, 0) <= 0) {
+            return;
+        }
+
+        while (true) {
+            auto connection = accept(this->_socket, nullptr, nullptr);
+            if (connection < 0) {
+                return;
+            }
+
+            const auto& text = this->_latest_prometheus_text;
+            size_t sent {0u};
+
+            while (sent < text.size()) {
+#ifdef MSG_NOSIGNAL
+                auto result = send(connection, text.data() + sent, text.size() - sent, MSG_NOSIGNAL);
+#else
+                auto result = send(connection, text.data() + sent, text.size() - sent, 0);
+#endif
+                if (result <= 0) {
+                    break;
+                }
+
+                sent += static_cast<size_t>(result);
+            }
+
+            close(connection);
+        }
+    }
+#else
+    bool metrics_exporter::open_socket() noexcept {
+        return false;
+    }
+
+    void metrics_exporter::close_socket() noexcept {
+    }
+
+    void metrics_exporter::serve_socket_connections() noexcept {
+    }
+#endif
+
+    void publish_thread_allocation_statistics(std::string_view thread_name, counter_registry& registry) noexcept {
+        try {
+            auto statistics = memory::get_thread_allocation_statistics();
+            auto prefix = "thread_" + std::string(thread_name);
+
+            registry.set(registry.register_counter(prefix + "_allocated_bytes"),
+                         static_cast<int64_t>(statistics.allocated_bytes.get_value()));
+            registry.set(registry.register_counter(prefix + "_freed_bytes"),
+                         static_cast<int64_t>(statistics.freed_bytes.get_value()));
+            registry.set(registry.register_counter(prefix + "_peak_bytes"),
+                         static_cast<int64_t>(statistics.peak_bytes.get_value()));
+            registry.set(registry.register_counter(prefix + "_allocations"),
+                         static_cast<int64_t>(statistics.number_of_allocations));
+            registry.set(registry.register_counter(prefix + "_frees"),
+                         static_cast<int64_t>(statistics.number_of_frees));
+        } catch (...) {
+        }
+    }
+}
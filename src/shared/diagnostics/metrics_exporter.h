@@ -0,0 +1,166 @@
+#pragma once
+
+#include "counter_registry.h"
+#include "shared/memory/bytes.h"
+#include "shared/memory/megabytes.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace pbr::shared::diagnostics {
+    /// The settings of a metrics exporter. Each output is disabled if its path is empty
+    struct metrics_exporter_settings {
+        /// The Prometheus text file to write. It is replaced atomically on each export, so it can
+        /// be read by the node exporter's textfile collector
+        std::filesystem::path prometheus_path;
+
+        /// The JSON-lines file to append a line to on each export
+        std::filesystem::path json_lines_path;
+
+        /// The size the JSON-lines file can grow to before it is rotated
+        memory::bytes max_json_lines_file_size {memory::bytes(memory::megabytes(8.0))};
+
+        /// The number of rotated JSON-lines files to keep, named `<path>.1`, `<path>.2` and so on
+        uint32_t number_of_rotated_json_lines_files {3u};
+
+        /// The Unix domain socket to serve the latest Prometheus text on. Each connection is sent
+        /// the text and closed. A socket left at the path is replaced, but starting fails if anything
+        /// else is there. This is ignored on platforms without Unix domain sockets
+        std::filesystem::path socket_path;
+
+        /// How often the metrics are exported
+        std::chrono::milliseconds interval {std::chrono::seconds(1)};
+    };
+
+    /// Periodically exports a snapshot of the metrics on a background thread. The metrics are the
+    /// counters in a counter registry, along with the allocation statistics of the memory module.
+    /// Both are read with relaxed atomic loads, so taking a snapshot never blocks the threads
+    /// updating them. Values that are expensive to calculate, such as percentiles, should be
+    /// published to the registry by their owner, see `phase_timings::publish`
+    class metrics_exporter {
+    public:
+        /// Constructs this exporter
+        /// \param settings The settings to use
+        /// \param registry The registry to export the counters of. This must outlive this exporter
+        explicit metrics_exporter(metrics_exporter_settings settings,
+                                  const counter_registry& registry = get_counter_registry());
+
+        /// Destroys this exporter, stopping it if it is running
+        ~metrics_exporter();
+
+        metrics_exporter(const metrics_exporter&) = delete;
+        metrics_exporter(metrics_exporter&&) = delete;
+
+        metrics_exporter& operator = (const metrics_exporter&) = delete;
+        metrics_exporter& operator = (metrics_exporter&&) = delete;
+
+        /// Starts exporting on a background thread. The metrics are exported immediately and then
+        /// once every interval
+        /// \returns `true` upon success, else `false`
+        [[nodiscard]]
+        bool start() noexcept;
+
+        /// Stops exporting. The metrics are exported one last time before the thread exits
+        void stop() noexcept;
+
+        /// Returns if this exporter is running
+        /// \returns `true` if this exporter is running, else `false`
+        [[nodiscard]]
+        bool is_running() const noexcept {
+            return this->_thread.joinable();
+        }
+
+        /// Exports the metrics once, on the calling thread. This should not be called while this
+        /// exporter is running
+        /// \returns `true` if every enabled output was written, else `false`
+        [[nodiscard]]
+        bool export_metrics() noexcept;
+
+        /// Takes a snapshot of the metrics
+        /// \returns The snapshot
+        [[nodiscard]]
+        std::vector<counter_snapshot_entry> snapshot() const;
+
+        /// Formats a snapshot in the Prometheus text exposition format. Every metric is exported as
+        /// a gauge prefixed with `pbr_`, with any characters Prometheus does not allow replaced
+        /// \param snapshot The snapshot to format
+        /// \returns The formatted snapshot
+        [[nodiscard]]
+        static std::string to_prometheus_text(const std::vector<counter_snapshot_entry>& snapshot);
+
+        /// Formats a snapshot as a single line of JSON
+        /// \param snapshot The snapshot to format
+        /// \param timestamp The time the snapshot was taken
+        /// \returns The formatted snapshot, without a trailing new line
+        [[nodiscard]]
+        static std::string to_json_line(const std::vector<counter_snapshot_entry>& snapshot,
+                                        std::chrono::system_clock::time_point timestamp);
+
+    private:
+        /// The settings
+        metrics_exporter_settings _settings;
+
+        /// The registry to export the counters of
+        const counter_registry& _registry;
+
+        /// The exporting thread
+        std::thread _thread;
+
+        /// Wakes the exporting thread when it should stop
+        std::condition_variable _stop_condition;
+
+        /// Protects `_should_stop`
+        std::mutex _stop_mutex;
+
+        /// Should the exporting thread stop?
+        bool _should_stop {false};
+
+        /// The listening socket, else `-1` if the socket is disabled
+        int _socket {-1};
+
+        /// The latest Prometheus text, served on the socket. This is only used by the exporting thread
+        std::string _latest_prometheus_text;
+
+        /// Runs the exporting thread
+        void run() noexcept;
+
+        /// Waits for an interval to pass, serving any socket connections in the meantime
+        /// \param deadline The time to wait until
+        /// \returns `true` if the exporter should stop, else `false`
+        [[nodiscard]]
+        bool wait_until(std::chrono::steady_clock::time_point deadline) noexcept;
+
+        /// Appends a line to the JSON-lines file, rotating it first if it is too large
+        /// \param line The line to append
+        /// \returns `true` upon success, else `false`
+        [[nodiscard]]
+        bool append_json_line(std::string_view line) noexcept;
+
+        /// Opens the listening socket
+        /// \returns `true` upon success, else `false`
+        [[nodiscard]]
+        bool open_socket() noexcept;
+
+        /// Closes the listening socket and removes its file
+        void close_socket() noexcept;
+
+        /// Accepts any pending connections and sends them the latest Prometheus text
+        void serve_socket_connections() noexcept;
+    };
+
+    /// Publishes the allocation statistics of the calling thread to a registry, as the gauges
+    /// `thread_<name>_allocated_bytes`, `thread_<name>_freed_bytes`, `thread_<name>_peak_bytes`,
+    /// `thread_<name>_allocations` and `thread_<name>_frees`. This is thread safe
+    /// \param thread_name The name of the calling thread
+    /// \param registry The registry to publish to
+    void publish_thread_allocation_statistics(std::string_view thread_name,
+                                              counter_registry& registry = get_counter_registry()) noexcept;
+}
@@ -0,0 +1,75 @@
+#include "phase_timings.h"
+
+#include <iomanip>
+#include <sstream>
+
+namespace pbr::shared::diagnostics {
+    phase_timings::phase_timings(std::vector<std::string> phase_names, std::chrono::nanoseconds window)
+        : _phase_names(std::move(phase_names)),
+          _histograms(this->_phase_names.size(), rolling_histogram(window)) {
+    }
+
+    void phase_timings::record(size_t phase, clock::duration value, clock::time_point now) noexcept {
+        if (phase >= this->_histograms.size()) {
+            return;
+        }
+
+        std::scoped_lock<std::mutex> lock(this->_mutex);
+        this->_histograms[phase].record(value, now);
+    }
+
+    histogram_statistics phase_timings::get_statistics(size_t phase) noexcept {
+        if (phase >= this->_histograms.size()) {
+            return {};
+        }
+
+        std::scoped_lock<std::mutex> lock(this->_mutex);
+        return this->_histograms[phase].get_statistics();
+    }
+
+    std::string_view phase_timings::get_phase_name(size_t phase) const noexcept {
+        if (phase >= this->_phase_names.size()) {
+            return {};
+        }
+
+        return this->_phase_names[phase];
+    }
+
+    std::string phase_timings::get_summary() {
+        auto to_milliseconds = [](std::chrono::nanoseconds value) {
+            return std::chrono::duration<double, std::milli>(value).count();
+        };
+
+        std::stringstream ss;
+        ss << std::fixed << std::setprecision(3);
+
+        for (size_t i {0u}; i < this->_phase_names.size(); ++i) {
+            auto statistics = this->get_statistics(i);
+
+            if (i > 0u) {
+                ss << " | ";
+            }
+
+            ss << this->_phase_names[i]
+               << " p50: " << to_milliseconds(statistics.p50) << "ms"
+               << " p99: " << to_milliseconds(statistics.p99) << "ms"
+               << " max: " << to_milliseconds(statistics.max) << "ms";
+        }
+
+        return ss.str();
+    }
+
+    void phase_timings::publish(std::string_view prefix, counter_registry& registry) noexcept {
+        try {
+            for (size_t i {0u}; i < this->_phase_names.size(); ++i) {
+                auto statistics = this->get_statistics(i);
+                auto name = std::string(prefix) + "_" + this->_phase_names[i];
+
+                registry.set(registry.register_counter(name + "_p50_ns"), statistics.p50.count());
+                registry.set(registry.register_counter(name + "_p99_ns"), statistics.p99.count());
+                registry.set(registry.register_counter(name + "_max_ns"), statistics.max.count());
+            }
+        } catch (...) {
+        }
+    }
+}
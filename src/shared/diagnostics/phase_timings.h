@@ -0,0 +1,111 @@
+#pragma once
+
+#include "histogram.h"
+#include "counter_registry.h"
+
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace pbr::shared::diagnostics {
+    /// The rolling timing statistics of the named phases of a repeated process, such as the phases
+    /// of a frame. Phases are usually recorded by one thread while the statistics are read by
+    /// another, so each access takes a lock. This is thread safe
+    class phase_timings {
+    public:
+        /// The clock the phases are timed with
+        using clock = rolling_histogram::clock;
+
+        /// Constructs these timings
+        /// \param phase_names The name of each phase. The index of a name is the index of its phase
+        /// \param window The length of time the statistics cover
+        explicit phase_timings(std::vector<std::string> phase_names,
+                               std::chrono::nanoseconds window = std::chrono::seconds(1));
+
+        /// Records the time taken by a phase
+        /// \param phase The index of the phase. If this is out of range, nothing is recorded
+        /// \param value The time taken by the phase
+        /// \param now The time the phase ended
+        void record(size_t phase, clock::duration value, clock::time_point now) noexcept;
+
+        /// Returns the statistics of a phase
+        /// \param phase The index of the phase
+        /// \returns The statistics of the phase, else empty statistics if `phase` is out of range
+        [[nodiscard]]
+        histogram_statistics get_statistics(size_t phase) noexcept;
+
+        /// Returns the number of phases
+        /// \returns The number of phases
+        [[nodiscard]]
+        size_t get_number_of_phases() const noexcept {
+            return this->_phase_names.size();
+        }
+
+        /// Returns the name of a phase
+        /// \param phase The index of the phase
+        /// \returns The name of the phase, else empty if `phase` is out of range
+        [[nodiscard]]
+        std::string_view get_phase_name(size_t phase) const noexcept;
+
+        /// Formats the statistics of every phase as a single line, with the durations in
+        /// milliseconds
+        /// \returns The formatted statistics
+        [[nodiscard]]
+        std::string get_summary();
+
+        /// Publishes the statistics of every phase to a registry, as the gauges
+        /// `<prefix>_<phase>_p50_ns`, `<prefix>_<phase>_p99_ns` and `<prefix>_<phase>_max_ns`, so
+        /// they can be read without calculating the percentiles
+        /// \param prefix The prefix of the gauge names
+        /// \param registry The registry to publish to
+        void publish(std::string_view prefix, counter_registry& registry = get_counter_registry()) noexcept;
+
+    private:
+        /// The name of each phase
+        std::vector<std::string> _phase_names;
+
+        /// The times taken by each phase
+        std::vector<rolling_histogram> _histograms;
+
+        /// Protects `_histograms`
+        std::mutex _mutex;
+    };
+
+    /// Records the time taken by a scope as a phase
+    class scoped_phase_timer {
+    public:
+        /// Starts timing the phase
+        /// \param timings The timings to record the phase in
+        /// \param phase The index of the phase
+        scoped_phase_timer(phase_timings& timings, size_t phase) noexcept
+            : _timings(timings),
+              _phase(phase),
+              _start(phase_timings::clock::now()) {
+        }
+
+        /// Stops timing the phase and records it
+        ~scoped_phase_timer() {
+            auto now = phase_timings::clock::now();
+            this->_timings.record(this->_phase, now - this->_start, now);
+        }
+
+        scoped_phase_timer(const scoped_phase_timer&) = delete;
+        scoped_phase_timer(scoped_phase_timer&&) = delete;
+
+        scoped_phase_timer& operator = (const scoped_phase_timer&) = delete;
+        scoped_phase_timer& operator = (scoped_phase_timer&&) = delete;
+
+    private:
+        /// The timings to record the phase in
+        phase_timings& _timings;
+
+        /// The index of the phase
+        size_t _phase {0u};
+
+        /// The time the phase started
+        phase_timings::clock::time_point _start;
+    };
+}
@@ -0,0 +1,525 @@
+#include "sampling_profiler.h"
+#include "shared/platform/platform.h"
+
+#include <fstream>
+
+#ifdef PLATFORM_LINUX
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <csignal>
+#include <cstdlib>
+#include <ctime>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <sstream>
+#include <unordered_map>
+#include <vector>
+
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <pthread.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+// older C libraries do not name the thread ID field of `sigevent`
+#ifndef sigev_notify_thread_id
+#define sigev_notify_thread_id _sigev_un._tid
+#endif
+#endif
+
+namespace pbr::shared::diagnostics {
+#ifdef PLATFORM_LINUX
+    /// The most frames captured for each sample
+    constexpr size_t max_stack_depth {64u};
+
+    /// The number of innermost frames to skip, as they are the signal handler and the signal
+    /// trampoline
+    constexpr size_t frames_to_skip {2u};
+
+    /// The number of samples each thread's ring buffer holds
+    constexpr size_t samples_per_thread {4096u};
+
+    /// A captured stack. Samples are written by the signal handler while they may be read by
+    /// another thread, so they are guarded by a sequence number, which is odd while the sample is
+    /// being written. The fields are relaxed atomics, so a torn read is detected rather than racy
+    struct stack_sample {
+        /// Incremented before and after the sample is written
+        std::atomic_uint32_t sequence {0u};
+
+        /// The number of captured frames
+        std::atomic_uint32_t depth {0u};
+
+        /// The return addresses of the captured frames, innermost first
+        std::array<std::atomic_uintptr_t, max_stack_depth> frames {};
+    };
+
+    /// A thread registered with the profiler. Threads are never destroyed, so the samples of
+    /// threads that have exited can still be written
+    struct profiled_thread {
+        /// The name of the thread. This is protected by `g_threads_mutex`
+        std::string name;
+
+        /// The thread's handle
+        pthread_t handle {};
+
+        /// The thread's kernel ID, which its timer signals
+        pid_t id {0};
+
+        /// The thread's timer. This is protected by `g_threads_mutex`
+        timer_t timer {};
+
+        /// Does the thread have a timer? This is protected by `g_threads_mutex`
+        bool has_timer {false};
+
+        /// Is the thread alive? This is protected by `g_threads_mutex`
+        bool is_alive {true};
+
+        /// The ring buffer of samples. This is allocated when the thread's timer is first started,
+        /// so threads that are never sampled do not hold a buffer
+        std::atomic<stack_sample*> samples {nullptr};
+
+        /// The total number of samples written. The latest sample is at
+        /// `(number_of_samples - 1) % samples_per_thread`
+        std::atomic_uint64_t number_of_samples {0u};
+
+        /// The value of `number_of_samples` when the samples were last cleared
+        std::atomic_uint64_t first_sample {0u};
+    };
+
+    /// Protects the list of threads and the timers
+    static std::mutex g_threads_mutex;
+
+    /// Every thread that has been registered
+    static std::vector<std::unique_ptr<profiled_thread>> g_threads;
+
+    /// Is the profiler running?
+    static std::atomic_bool g_is_running {false};
+
+    /// The CPU time between samples. This is protected by `g_threads_mutex`
+    static std::chrono::microseconds g_interval {0};
+
+    /// The signal action that was installed before the profiler's. This is protected by
+    /// `g_threads_mutex`
+    static struct sigaction g_previous_action {};
+
+    /// The calling thread, else `nullptr` if it is not registered. This is only set while the
+    /// thread is registered, so the signal handler never touches a thread that has exited
+    static constinit thread_local std::atomic<profiled_thread*> t_thread {nullptr};
+
+    /// Unregisters the calling thread when it exits
+    struct thread_exit_guard {
+        ~thread_exit_guard();
+    };
+
+    /// Unregisters the calling thread when it exits. This is created when the thread registers
+    static thread_local thread_exit_guard t_thread_exit_guard;
+
+    /// Captures the stack of the interrupted thread
+    /// \param info Unused
+    /// \param context Unused
+    static void handle_profiling_signal(int, siginfo_t*, void*) {
+        auto saved_errno = errno;
+
+        auto thread = t_thread.load(std::memory_order_relaxed);
+        auto samples = thread ? thread->samples.load(std::memory_order_acquire) : nullptr;
+
+        if (samples && g_is_running.load(std::memory_order_relaxed)) {
+            void* frames[max_stack_depth + frames_to_skip];
+            auto captured = backtrace(frames, static_cast<int>(max_stack_depth + frames_to_skip));
+            auto depth = captured > static_cast<int>(frames_to_skip) ?
+                         static_cast<size_t>(captured) - frames_to_skip : 0u;
+
+            auto index = thread->number_of_samples.load(std::memory_order_relaxed);
+            auto& sample = samples[index % samples_per_thread];
+
+            auto sequence = sample.sequence.load(std::memory_order_relaxed);
+            sample.sequence.store(sequence + 1u, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+
+            for (size_t i {0u}; i < depth; ++i) {
+                sample.frames[i].store(reinterpret_cast<uintptr_t>(frames[i + frames_to_skip]),
+                                       std::memory_order_relaxed);
+            }
+
+            sample.depth.store(static_cast<uint32_t>(depth), std::memory_order_relaxed);
+            sample.sequence.store(sequence + 2u, std::memory_order_release);
+
+            thread->number_of_samples.store(index + 1u, std::memory_order_release);
+        }
+
+        errno = saved_errno;
+    }
+
+    /// Creates and starts a thread's timer. `g_threads_mutex` must be held
+    /// \param thread The thread
+    /// \returns `true` upon success, else `false`
+    static bool start_thread_timer(profiled_thread& thread) noexcept {
+        if (thread.has_timer || !thread.is_alive) {
+            return true;
+        }
+
+        clockid_t clock;
+        if (pthread_getcpuclockid(thread.handle, &clock) != 0) {
+            return false;
+        }
+
+        if (!thread.samples.load(std::memory_order_relaxed)) {
+            auto samples = new (std::nothrow) stack_sample[samples_per_thread];
+            if (!samples) {
+                return false;
+            }
+
+            thread.samples.store(samples, std::memory_order_release);
+        }
+
+        sigevent event {};
+        event.sigev_notify = SIGEV_THREAD_ID;
+        event.sigev_signo = SIGPROF;
+        event.sigev_notify_thread_id = thread.id;
+
+        if (timer_create(clock, &event, &thread.timer) != 0) {
+            return false;
+        }
+
+        auto seconds = std::chrono::duration_cast<std::chrono::seconds>(g_interval);
+        auto nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(g_interval - seconds);
+
+        itimerspec spec {};
+        spec.it_interval.tv_sec = static_cast<time_t>(seconds.count());
+        spec.it_interval.tv_nsec = static_cast<long>(nanoseconds.count());
+        spec.it_value = spec.it_interval;
+
+        if (timer_settime(thread.timer, 0, &spec, nullptr) != 0) {
+            timer_delete(thread.timer);
+            return false;
+        }
+
+        thread.has_timer = true;
+
+        return true;
+    }
+
+    /// Stops and deletes a thread's timer. `g_threads_mutex` must be held
+    /// \param thread The thread
+    static void stop_thread_timer(profiled_thread& thread) noexcept {
+        if (!thread.has_timer) {
+            return;
+        }
+
+        timer_delete(thread.timer);
+        thread.has_timer = false;
+    }
+
+    thread_exit_guard::~thread_exit_guard() {
+        auto thread = t_thread.load(std::memory_order_relaxed);
+        if (!thread) {
+            return;
+        }
+
+        std::scoped_lock<std::mutex> lock(g_threads_mutex);
+
+        stop_thread_timer(*thread);
+        thread->is_alive = false;
+
+        t_thread.store(nullptr, std::memory_order_relaxed);
+    }
+
+    bool is_sampling_profiler_supported() noexcept {
+        return true;
+    }
+
+    bool register_sampling_profiler_thread(std::string_view name) noexcept {
+        try {
+            std::scoped_lock<std::mutex> lock(g_threads_mutex);
+
+            if (auto thread = t_thread.load(std::memory_order_relaxed)) {
+                thread->name = name;
+                return true;
+            }
+
+            auto thread = std::make_unique<profiled_thread>();
+            thread->name = name;
+            thread->handle = pthread_self();
+            thread->id = static_cast<pid_t>(syscall(SYS_gettid));
+
+            if (g_is_running && !start_thread_timer(*thread)) {
+                return false;
+            }
+
+            // touch the guard, so it is constructed and unregisters this thread when it exits
+            static_cast<void>(&t_thread_exit_guard);
+
+            t_thread.store(thread.get(), std::memory_order_relaxed);
+            g_threads.push_back(std::move(thread));
+        } catch (...) {
+            return false;
+        }
+
+        return true;
+    }
+
+    bool start_sampling_profiler(std::chrono::microseconds interval) noexcept {
+        if (interval.count() <= 0) {
+            return false;
+        }
+
+        if (!t_thread.load(std::memory_order_relaxed) && !register_sampling_profiler_thread("Main")) {
+            return false;
+        }
+
+        // `backtrace` loads the unwinder the first time it is called, which is not safe in a
+        // signal handler, so make sure it is loaded first
+        void* frame {nullptr};
+        backtrace(&frame, 1);
+
+        std::scoped_lock<std::mutex> lock(g_threads_mutex);
+
+        if (g_is_running) {
+            return false;
+        }
+
+        struct sigaction action {};
+        action.sa_sigaction = handle_profiling_signal;
+        action.sa_flags = SA_SIGINFO | SA_RESTART;
+        sigemptyset(&action.sa_mask);
+
+        if (sigaction(SIGPROF, &action, &g_previous_action) != 0) {
+            return false;
+        }
+
+        g_interval = interval;
+        g_is_running = true;
+
+        for (auto& thread : g_threads) {
+            if (!start_thread_timer(*thread)) {
+                for (auto& started_thread : g_threads) {
+                    stop_thread_timer(*started_thread);
+                }
+
+                g_is_running = false;
+                sigaction(SIGPROF, &g_previous_action, nullptr);
+
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    void stop_sampling_profiler() noexcept {
+        std::scoped_lock<std::mutex> lock(g_threads_mutex);
+
+        if (!g_is_running) {
+            return;
+        }
+
+        g_is_running = false;
+
+        for (auto& thread : g_threads) {
+            stop_thread_timer(*thread);
+        }
+
+        // a signal may still be pending, so keep the handler installed. It ignores signals while
+        // the profiler is stopped
+    }
+
+    bool is_sampling_profiler_running() noexcept {
+        return g_is_running.load(std::memory_order_relaxed);
+    }
+
+    void clear_sampling_profiler() noexcept {
+        std::scoped_lock<std::mutex> lock(g_threads_mutex);
+
+        for (auto& thread : g_threads) {
+            thread->first_sample.store(thread->number_of_samples.load(std::memory_order_acquire),
+                                       std::memory_order_relaxed);
+        }
+    }
+
+    /// Returns the range of a thread's samples that are held in its ring buffer
+    /// \param thread The thread
+    /// \returns The index of the first and one past the last sample
+    static std::pair<uint64_t, uint64_t> get_sample_range(const profiled_thread& thread) noexcept {
+        auto end = thread.number_of_samples.load(std::memory_order_acquire);
+        auto begin = std::max(thread.first_sample.load(std::memory_order_relaxed),
+                              end > samples_per_thread ? end - samples_per_thread : 0u);
+
+        return { begin, end };
+    }
+
+    sampling_profiler_statistics get_sampling_profiler_statistics() noexcept {
+        std::scoped_lock<std::mutex> lock(g_threads_mutex);
+
+        sampling_profiler_statistics statistics {
+            .number_of_threads = g_threads.size(),
+        };
+
+        for (const auto& thread : g_threads) {
+            auto [begin, end] = get_sample_range(*thread);
+            auto first_sample = thread->first_sample.load(std::memory_order_relaxed);
+
+            statistics.number_of_samples += end - begin;
+            statistics.number_of_overwritten_samples += begin - std::min(begin, first_sample);
+        }
+
+        return statistics;
+    }
+
+    /// Returns the name of the function containing an address
+    /// \param address The address
+    /// \returns The demangled name of the function, else the module and offset of the address
+    static std::string symbolize(uintptr_t address) {
+        Dl_info info {};
+
+        // return addresses point after the call, so look up the byte before
+        if (dladdr(reinterpret_cast<void*>(address - 1u), &info) == 0) {
+            std::stringstream ss;
+            ss << "0x" << std::hex << address;
+            return ss.str();
+        }
+
+        std::string name;
+
+        if (info.dli_sname) {
+            auto status {0};
+            auto demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+
+            name = status == 0 && demangled ? demangled : info.dli_sname;
+            std::free(demangled);
+        } else {
+            std::string_view module = info.dli_fname ? info.dli_fname : "?";
+            if (auto separator = module.rfind('/'); separator != std::string_view::npos) {
+                module.remove_prefix(separator + 1u);
+            }
+
+            std::stringstream ss;
+            ss << module << "+0x" << std::hex << (address - reinterpret_cast<uintptr_t>(info.dli_fbase));
+            name = ss.str();
+        }
+
+        // `;` separates frames and new lines separate stacks in the collapsed format
+        std::replace(name.begin(), name.end(), ';', ':');
+        std::replace(name.begin(), name.end(), '\n', ' ');
+
+        return name;
+    }
+
+    std::string get_collapsed_stacks() {
+        // the stacks of each thread and how many times they were sampled, with the frames
+        // outermost first
+        std::map<std::pair<std::string, std::vector<uintptr_t>>, uint64_t> stacks;
+
+        {
+            std::scoped_lock<std::mutex> lock(g_threads_mutex);
+
+            std::vector<uintptr_t> frames;
+            frames.reserve(max_stack_depth);
+
+            for (const auto& thread : g_threads) {
+                auto samples = thread->samples.load(std::memory_order_acquire);
+                if (!samples) {
+                    continue;
+                }
+
+                auto [begin, end] = get_sample_range(*thread);
+
+                for (auto i = begin; i < end; ++i) {
+                    const auto& sample = samples[i % samples_per_thread];
+
+                    auto sequence = sample.sequence.load(std::memory_order_acquire);
+                    if (sequence % 2u != 0u) {
+                        continue;
+                    }
+
+                    auto depth = std::min<size_t>(sample.depth.load(std::memory_order_relaxed), max_stack_depth);
+
+                    frames.clear();
+                    for (size_t j {0u}; j < depth; ++j) {
+                        frames.push_back(sample.frames[depth - j - 1u].load(std::memory_order_relaxed));
+                    }
+
+                    // the sample was overwritten while it was copied
+                    std::atomic_thread_fence(std::memory_order_acquire);
+                    if (sample.sequence.load(std::memory_order_relaxed) != sequence) {
+                        continue;
+                    }
+
+                    ++stacks[{ thread->name, frames }];
+                }
+            }
+        }
+
+        std::unordered_map<uintptr_t, std::string> symbols;
+        std::stringstream ss;
+
+        for (const auto& [stack, count] : stacks) {
+            ss << (stack.first.empty() ? "Thread" : stack.first);
+
+            for (auto address : stack.second) {
+                auto symbol = symbols.find(address);
+                if (symbol == symbols.end()) {
+                    symbol = symbols.emplace(address, symbolize(address)).first;
+                }
+
+                ss << ';' << symbol->second;
+            }
+
+            ss << ' ' << count << '\n';
+        }
+
+        return ss.str();
+    }
+#else
+    bool is_sampling_profiler_supported() noexcept {
+        return false;
+    }
+
+    bool start_sampling_profiler(std::chrono::microseconds) noexcept {
+        return false;
+    }
+
+    void stop_sampling_profiler() noexcept {
+    }
+
+    bool is_sampling_profiler_running() noexcept {
+        return false;
+    }
+
+    bool register_sampling_profiler_thread(std::string_view) noexcept {
+        return false;
+    }
+
+    void clear_sampling_profiler() noexcept {
+    }
+
+    sampling_profiler_statistics get_sampling_profiler_statistics() noexcept {
+        return {};
+    }
+
+    std::string get_collapsed_stacks() {
+        return {};
+    }
+#endif
+
+    bool write_collapsed_stacks(const std::filesystem::path& path) noexcept {
+        try {
+            auto stacks = get_collapsed_stacks();
+
+            std::ofstream file(path, std::ios::out | std::ios::trunc);
+            if (!file.is_open()) {
+                return false;
+            }
+
+            file << stacks;
+
+            return file.good();
+        } catch (...) {
+            return false;
+        }
+    }
+}
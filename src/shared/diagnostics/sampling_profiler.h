@@ -0,0 +1,81 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+// An in-process sampling profiler. Each registered thread gets a POSIX timer on its own CPU time
+// clock, which sends it `SIGPROF` each time it has used an interval of CPU time. The signal handler
+// captures the thread's stack into a ring buffer, allocated when its timer is first started, without
+// locking or allocating.
+// Stacks are symbolized when they are written, in the collapsed stack format used by flame graph
+// tools, such as https://github.com/brendangregg/FlameGraph and https://www.speedscope.app.
+// Executables should export their symbols (`-rdynamic`) so their functions can be named, otherwise
+// frames are written as `<module>+<offset>`.
+// This is only supported on Linux. On other platforms, starting the profiler fails.
+
+namespace pbr::shared::diagnostics {
+    /// The statistics of the sampling profiler
+    struct sampling_profiler_statistics {
+        /// The number of threads registered with the profiler
+        size_t number_of_threads {0u};
+
+        /// The number of samples held in the ring buffers
+        uint64_t number_of_samples {0u};
+
+        /// The number of samples overwritten because a ring buffer was full
+        uint64_t number_of_overwritten_samples {0u};
+    };
+
+    /// Returns if the sampling profiler is supported on this platform
+    /// \returns `true` if the sampling profiler is supported, else `false`
+    [[nodiscard]]
+    bool is_sampling_profiler_supported() noexcept;
+
+    /// Starts sampling every registered thread, including the calling thread, which is registered if
+    /// it has not been. This is thread safe
+    /// \param interval The CPU time each thread uses between samples
+    /// \returns `true` upon success, else `false`
+    [[nodiscard]]
+    bool start_sampling_profiler(std::chrono::microseconds interval = std::chrono::milliseconds(1)) noexcept;
+
+    /// Stops sampling. The samples are kept until `clear_sampling_profiler` is called. This is
+    /// thread safe
+    void stop_sampling_profiler() noexcept;
+
+    /// Returns if the sampling profiler is running. This is thread safe
+    /// \returns `true` if the sampling profiler is running, else `false`
+    [[nodiscard]]
+    bool is_sampling_profiler_running() noexcept;
+
+    /// Registers the calling thread with the profiler, so it is sampled while the profiler is
+    /// running. The thread is unregistered when it exits, but its samples are kept. Registering a
+    /// thread again only changes its name. This is thread safe
+    /// \param name The name of the thread, which is the root frame of its stacks
+    /// \returns `true` upon success, else `false`
+    bool register_sampling_profiler_thread(std::string_view name) noexcept;
+
+    /// Removes all samples. This is thread safe
+    void clear_sampling_profiler() noexcept;
+
+    /// Returns the statistics of the profiler. This is thread safe
+    /// \returns The statistics of the profiler
+    [[nodiscard]]
+    sampling_profiler_statistics get_sampling_profiler_statistics() noexcept;
+
+    /// Returns the samples as collapsed stacks, with one line for each unique stack, in the form
+    /// `<thread>;<outermost frame>;...;<innermost frame> <count>`. Samples taken while this is
+    /// called may or may not be included. This is thread safe
+    /// \returns The collapsed stacks
+    [[nodiscard]]
+    std::string get_collapsed_stacks();
+
+    /// Writes the samples as collapsed stacks to a file. This is thread safe
+    /// \param path The path of the file to write
+    /// \returns `true` upon success, else `false`
+    [[nodiscard]]
+    bool write_collapsed_stacks(const std::filesystem::path& path) noexcept;
+}
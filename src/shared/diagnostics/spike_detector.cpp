@@ -0,0 +1,176 @@
+#include "spike_detector.h"
+#include "metrics_exporter.h"
+#include "tracer.h"
+
+#include <fstream>
+
+namespace pbr::shared::diagnostics {
+    spike_detector::spike_detector(std::string name,
+                                   spike_detector_settings settings,
+                                   counter_registry& registry)
+        : _name(std::move(name)),
+          _settings(std::move(settings)),
+          _registry(registry),
+          _spikes_counter(registry.register_counter(this->_name + "_spikes")),
+          _captures_counter(registry.register_counter(this->_name + "_spike_captures")),
+          _frame_times(this->_settings.window) {
+    }
+
+    spike_detector::~spike_detector() {
+        if (!this->_thread.joinable()) {
+            return;
+        }
+
+        {
+            std::scoped_lock<std::mutex> lock(this->_mutex);
+            this->_should_stop = true;
+        }
+
+        this->_condition.notify_all();
+        this->_thread.join();
+    }
+
+    bool spike_detector::record_frame(clock::duration frame_time, clock::time_point now) noexcept {
+        if (now - this->_last_median_update_time >= spike_detector::median_update_interval) {
+            this->_last_median_update_time = now;
+
+            auto statistics = this->_frame_times.get_statistics(now);
+            if (statistics.count >= this->_settings.minimum_frames_for_median) {
+                this->_median = statistics.p50;
+            } else {
+                this->_median.reset();
+            }
+        }
+
+        // the threshold is from the frames before this one, so a long spike does not raise it
+        auto threshold = this->get_spike_threshold();
+        this->_frame_times.record(frame_time, now);
+
+        if (!threshold || frame_time <= *threshold) {
+            return false;
+        }
+
+        this->_registry.add(this->_spikes_counter, 1);
+
+        if (this->_settings.max_captures > 0u && this->_number_of_captures >= this->_settings.max_captures) {
+            return false;
+        }
+
+        if (this->_last_capture_time && now - *this->_last_capture_time < this->_settings.minimum_capture_interval) {
+            return false;
+        }
+
+        if (!this->capture(frame_time, *threshold)) {
+            return false;
+        }
+
+        this->_last_capture_time = now;
+        ++this->_number_of_captures;
+        this->_registry.add(this->_captures_counter, 1);
+
+        return true;
+    }
+
+    std::optional<std::chrono::nanoseconds> spike_detector::get_spike_threshold() const noexcept {
+        std::optional<std::chrono::nanoseconds> threshold;
+
+        if (this->_settings.threshold.count() > 0) {
+            threshold = this->_settings.threshold;
+        }
+
+        if (this->_median && this->_settings.median_multiplier > 0.0) {
+            auto median_threshold = std::chrono::nanoseconds(static_cast<int64_t>(
+                static_cast<double>(this->_median->count()) * this->_settings.median_multiplier));
+
+            // a frame only has to exceed the lower of the two thresholds to be a spike
+            if (!threshold || median_threshold < *threshold) {
+                threshold = median_threshold;
+            }
+        }
+
+        return threshold;
+    }
+
+    void spike_detector::wait_for_captures() noexcept {
+        std::unique_lock<std::mutex> lock(this->_mutex);
+
+        this->_condition.wait(lock, [this]() {
+            return this->_pending_captures.empty() && !this->_is_writing;
+        });
+    }
+
+    bool spike_detector::capture(std::chrono::nanoseconds frame_time, std::chrono::nanoseconds threshold) noexcept {
+        try {
+            pending_capture capture;
+
+            auto file_name = this->_name + "_spike_" + std::to_string(this->_number_of_captures);
+            capture.trace_path = this->_settings.output_directory / (file_name + "_trace.json");
+            capture.metrics_path = this->_settings.output_directory / (file_name + "_metrics.json");
+
+            // fix the window now, so events after the spike are not written
+            capture.until = get_trace_timestamp();
+
+            auto window = static_cast<uint64_t>(this->_settings.window.count());
+            capture.since = capture.until > window ? capture.until - window : 0u;
+
+            metrics_exporter exporter({}, this->_registry);
+
+            auto snapshot = exporter.snapshot();
+            snapshot.push_back({ .name = "spike_frame_time_ns", .value = frame_time.count() });
+            snapshot.push_back({ .name = "spike_threshold_ns", .value = threshold.count() });
+
+            capture.metrics = metrics_exporter::to_json_line(snapshot, std::chrono::system_clock::now());
+
+            {
+                std::scoped_lock<std::mutex> lock(this->_mutex);
+                this->_pending_captures.push_back(std::move(capture));
+            }
+
+            if (!this->_thread.joinable()) {
+                this->_thread = std::thread(&spike_detector::run, this);
+            }
+
+            this->_condition.notify_all();
+
+            return true;
+        } catch (...) {
+            return false;
+        }
+    }
+
+    void spike_detector::run() noexcept {
+        set_trace_thread_name("Spike Detector");
+
+        std::unique_lock<std::mutex> lock(this->_mutex);
+
+        while (true) {
+            this->_condition.wait(lock, [this]() {
+                return this->_should_stop || !this->_pending_captures.empty();
+            });
+
+            if (this->_pending_captures.empty()) {
+                return;
+            }
+
+            auto capture = std::move(this->_pending_captures.front());
+            this->_pending_captures.erase(this->_pending_captures.begin());
+            this->_is_writing = true;
+
+            lock.unlock();
+
+            // a failed capture is not retried, as the trace window would have moved on
+            [[maybe_unused]] auto is_trace_written = write_trace(capture.trace_path, capture.since, capture.until);
+
+            try {
+                std::ofstream file(capture.metrics_path, std::ios::out | std::ios::trunc);
+                file << capture.metrics << '\n';
+            } catch (...) {
+            }
+
+            lock.lock();
+
+            this->_is_writing = false;
+            this->_condition.notify_all();
+        }
+    }
+}
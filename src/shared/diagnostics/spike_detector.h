@@ -0,0 +1,180 @@
+#pragma once
+
+#include "counter_registry.h"
+#include "histogram.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace pbr::shared::diagnostics {
+    /// The settings of a spike detector
+    struct spike_detector_settings {
+        /// The directory captures are written to. It must exist
+        std::filesystem::path output_directory;
+
+        /// Frames taking longer than this are spikes. If this is zero, it is not used
+        std::chrono::nanoseconds threshold {std::chrono::milliseconds(50)};
+
+        /// Frames taking longer than this multiple of the rolling median frame time are spikes. If
+        /// this is zero, it is not used
+        double median_multiplier {4.0};
+
+        /// The number of frames that must be in the rolling window before the median is used
+        size_t minimum_frames_for_median {30u};
+
+        /// The length of time the rolling median covers, and the length of the trace written with
+        /// each capture
+        std::chrono::nanoseconds window {std::chrono::seconds(5)};
+
+        /// The least time between two captures. Spikes within this time of the last capture are
+        /// counted but not captured
+        std::chrono::nanoseconds minimum_capture_interval {std::chrono::seconds(30)};
+
+        /// The most captures written. If this is zero, there is no limit
+        size_t max_captures {10u};
+    };
+
+    /// Watches the frame times of a loop for spikes, which averages hide. When a frame is a spike,
+    /// the trace events of the last window are written to `<name>_spike_<n>_trace.json`, along with a
+    /// snapshot of the counters and allocation statistics in `<name>_spike_<n>_metrics.json`. The
+    /// window is fixed when the spike is detected, and the files are written on a background thread,
+    /// so a capture does not cause another spike.
+    /// Tracing must be enabled for the trace to hold events. It should be in ring mode, see
+    /// `set_trace_ring_mode`, so the most recent events are kept. This is not thread safe, and should
+    /// only be used by the thread running the loop
+    class spike_detector {
+    public:
+        /// The clock frames are timed with
+        using clock = rolling_histogram::clock;
+
+        /// Constructs this detector
+        /// \param name The name of the loop, which prefixes the names of the captured files
+        /// \param settings The settings to use
+        /// \param registry The registry to snapshot the counters of, and to count spikes and
+        /// captures in. This must outlive this detector
+        spike_detector(std::string name,
+                       spike_detector_settings settings,
+                       counter_registry& registry = get_counter_registry());
+
+        /// Destroys this detector, after writing any pending captures
+        ~spike_detector();
+
+        spike_detector(const spike_detector&) = delete;
+        spike_detector(spike_detector&&) = delete;
+
+        spike_detector& operator = (const spike_detector&) = delete;
+        spike_detector& operator = (spike_detector&&) = delete;
+
+        /// Records the time a frame took, capturing it if it is a spike
+        /// \param frame_time The time the frame took
+        /// \param now The time the frame ended
+        /// \returns `true` if the frame was a spike and a capture was started, else `false`
+        bool record_frame(clock::duration frame_time, clock::time_point now) noexcept;
+
+        /// Returns the frame time above which a frame is a spike
+        /// \returns The frame time above which a frame is a spike, else no value if neither the
+        /// threshold nor the median can be used yet
+        [[nodiscard]]
+        std::optional<std::chrono::nanoseconds> get_spike_threshold() const noexcept;
+
+        /// Returns the number of captures started
+        /// \returns The number of captures started
+        [[nodiscard]]
+        size_t get_number_of_captures() const noexcept {
+            return this->_number_of_captures;
+        }
+
+        /// Waits for every started capture to be written
+        void wait_for_captures() noexcept;
+
+    private:
+        /// How often the rolling median is recalculated, as calculating it every frame is too slow
+        static constexpr std::chrono::milliseconds median_update_interval {250};
+
+        /// A capture waiting to be written
+        struct pending_capture {
+            /// The path of the trace file
+            std::filesystem::path trace_path;
+
+            /// The path of the metrics file
+            std::filesystem::path metrics_path;
+
+            /// The start of the trace window, from `get_trace_timestamp`
+            uint64_t since {0u};
+
+            /// The end of the trace window, from `get_trace_timestamp`
+            uint64_t until {0u};
+
+            /// The metrics when the spike was detected
+            std::string metrics;
+        };
+
+        /// The name of the loop
+        std::string _name;
+
+        /// The settings
+        spike_detector_settings _settings;
+
+        /// The registry to snapshot the counters of
+        counter_registry& _registry;
+
+        /// Counts the spikes
+        counter_handle _spikes_counter;
+
+        /// Counts the captures
+        counter_handle _captures_counter;
+
+        /// The frame times in the window
+        rolling_histogram _frame_times;
+
+        /// The median frame time when it was last calculated, else no value if too few frames
+        /// were in the window
+        std::optional<std::chrono::nanoseconds> _median;
+
+        /// The time the median was last calculated
+        clock::time_point _last_median_update_time;
+
+        /// The time of the last capture
+        std::optional<clock::time_point> _last_capture_time;
+
+        /// The number of captures started
+        size_t _number_of_captures {0u};
+
+        /// The thread writing captures. It is started with the first capture
+        std::thread _thread;
+
+        /// Protects `_pending_captures`, `_is_writing` and `_should_stop`
+        std::mutex _mutex;
+
+        /// Wakes the writing thread, and threads waiting for captures to be written
+        std::condition_variable _condition;
+
+        /// The captures waiting to be written
+        std::vector<pending_capture> _pending_captures;
+
+        /// Is the writing thread writing a capture?
+        bool _is_writing {false};
+
+        /// Should the writing thread stop?
+        bool _should_stop {false};
+
+        /// Starts a capture of a spike
+        /// \param frame_time The time the spiking frame took
+        /// \param threshold The threshold the frame exceeded
+        /// \returns `true` upon success, else `false`
+        [[nodiscard]]
+        bool capture(std::chrono::nanoseconds frame_time, std::chrono::nanoseconds threshold) noexcept;
+
+        /// Runs the writing thread
+        void run() noexcept;
+    };
+}
@@ -0,0 +1,416 @@
+#include "tracer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <sstream>
+#include <vector>
+
+namespace pbr::shared::diagnostics {
+    /// The most events each thread can hold. Further events are dropped, or overwrite the oldest
+    /// events in ring mode
+    constexpr size_t max_events_per_thread {64u * 1024u};
+
+    /// A recorded trace event
+    struct trace_event {
+        /// The name of the event
+        const char* name {nullptr};
+
+        /// The category of the event
+        const char* category {nullptr};
+
+        /// The time of the event, in nanoseconds
+        uint64_t timestamp {0u};
+
+        /// The duration of a zone in nanoseconds, the value of a counter or the ID of a flow
+        uint64_t value {0u};
+
+        /// The Chrome trace event phase
+        char phase {'X'};
+    };
+
+    /// The events recorded by a single thread. Only the owning thread writes events, and it
+    /// publishes each event by incrementing `count`, so readers can copy the published events
+    /// without stopping the writer. In ring mode, event `n` is held at `n % max_events_per_thread`,
+    /// and readers discard any events that were overwritten while they were copied. Buffers are
+    /// never destroyed, so the events of threads that have exited can still be written
+    struct thread_trace_buffer {
+        /// The ID of the thread in the trace
+        uint32_t thread_id {0u};
+
+        /// The name of the thread. This is protected by `g_buffers_mutex`
+        std::string name;
+
+        /// The recorded events. This is allocated when the first event is recorded
+        std::atomic<trace_event*> events {nullptr};
+
+        /// The number of recorded events, including any overwritten in ring mode
+        std::atomic_size_t count {0u};
+
+        /// The value of `g_generation` when the events were recorded
+        std::atomic_uint32_t generation {0u};
+
+        /// The number of events dropped because the buffer was full
+        std::atomic_uint64_t number_of_dropped_events {0u};
+    };
+
+    /// Protects the list of buffers and the thread names
+    static std::mutex g_buffers_mutex;
+
+    /// The buffers of every thread that has recorded an event or been named
+    static std::vector<std::unique_ptr<thread_trace_buffer>> g_buffers;
+
+    /// Incremented by `clear_trace`. Buffers recorded in an older generation are cleared by their
+    /// thread before it records its next event, and are ignored by readers
+    static std::atomic_uint32_t g_generation {0u};
+
+    /// Are the oldest events overwritten once a buffer is full?
+    static std::atomic_bool g_is_ring_mode {false};
+
+    /// The ID of the next flow
+    static std::atomic_uint64_t g_next_flow_id {1u};
+
+    /// The calling thread's buffer
+    static thread_local thread_trace_buffer* t_buffer {nullptr};
+
+    /// Returns the calling thread's buffer, creating it if needed
+    /// \returns The calling thread's buffer, else `nullptr` if it could not be created
+    static thread_trace_buffer* get_thread_buffer() noexcept {
+        if (t_buffer) [[likely]] {
+            return t_buffer;
+        }
+
+        try {
+            std::scoped_lock<std::mutex> lock(g_buffers_mutex);
+
+            auto buffer = std::make_unique<thread_trace_buffer>();
+            buffer->thread_id = static_cast<uint32_t>(g_buffers.size() + 1u);
+            buffer->generation = g_generation.load(std::memory_order_acquire);
+
+            t_buffer = buffer.get();
+            g_buffers.push_back(std::move(buffer));
+        } catch (...) {
+            return nullptr;
+        }
+
+        return t_buffer;
+    }
+
+    /// Records an event in the calling thread's buffer
+    /// \param event The event to record
+    static void record_event(const trace_event& event) noexcept {
+        auto buffer = get_thread_buffer();
+        if (!buffer) {
+            return;
+        }
+
+        auto generation = g_generation.load(std::memory_order_acquire);
+        if (buffer->generation.load(std::memory_order_relaxed) != generation) {
+            // unpublish the old events before readers can see the new generation
+            buffer->count.store(0u, std::memory_order_release);
+            buffer->generation.store(generation, std::memory_order_release);
+        }
+
+        auto events = buffer->events.load(std::memory_order_relaxed);
+        if (!events) {
+            events = new (std::nothrow) trace_event[max_events_per_thread];
+            if (!events) {
+                return;
+            }
+
+            buffer->events.store(events, std::memory_order_release);
+        }
+
+        auto index = buffer->count.load(std::memory_order_relaxed);
+        if (index >= max_events_per_thread && !g_is_ring_mode.load(std::memory_order_relaxed)) {
+            buffer->number_of_dropped_events.fetch_add(1u, std::memory_order_relaxed);
+            return;
+        }
+
+        events[index % max_events_per_thread] = event;
+        buffer->count.store(index + 1u, std::memory_order_release);
+    }
+
+    void enable_tracing() noexcept {
+        tracer_state::is_enabled.store(true, std::memory_order_relaxed);
+    }
+
+    void disable_tracing() noexcept {
+        tracer_state::is_enabled.store(false, std::memory_order_relaxed);
+    }
+
+    void clear_trace() noexcept {
+        std::scoped_lock<std::mutex> lock(g_buffers_mutex);
+
+        g_generation.fetch_add(1u, std::memory_order_acq_rel);
+
+        for (auto& buffer : g_buffers) {
+            buffer->number_of_dropped_events.store(0u, std::memory_order_relaxed);
+        }
+    }
+
+    void set_trace_ring_mode(bool is_ring_mode) noexcept {
+        g_is_ring_mode.store(is_ring_mode, std::memory_order_relaxed);
+        clear_trace();
+    }
+
+    bool is_trace_ring_mode() noexcept {
+        return g_is_ring_mode.load(std::memory_order_relaxed);
+    }
+
+    void set_trace_thread_name(std::string_view name) noexcept {
+        auto buffer = get_thread_buffer();
+        if (!buffer) {
+            return;
+        }
+
+        try {
+            std::scoped_lock<std::mutex> lock(g_buffers_mutex);
+            buffer->name = name;
+        } catch (...) {
+        }
+    }
+
+    uint64_t get_trace_timestamp() noexcept {
+        static const auto epoch = std::chrono::steady_clock::now();
+
+        // offset by one, so a timestamp is never `0`
+        auto elapsed = std::chrono::steady_clock::now() - epoch;
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) + 1u;
+    }
+
+    void record_trace_zone(const char* name, const char* category, uint64_t start, uint64_t end) noexcept {
+        record_event(trace_event {
+            .name = name,
+            .category = category,
+            .timestamp = start,
+            .value = end - start,
+            .phase = 'X',
+        });
+    }
+
+    void trace_counter(const char* name, int64_t value) noexcept {
+        if (!is_tracing_enabled()) [[likely]] {
+            return;
+        }
+
+        record_event(trace_event {
+            .name = name,
+            .category = "counter",
+            .timestamp = get_trace_timestamp(),
+            .value = static_cast<uint64_t>(value),
+            .phase = 'C',
+        });
+    }
+
+    uint64_t begin_trace_flow(const char* name) noexcept {
+        if (!is_tracing_enabled()) [[likely]] {
+            return 0u;
+        }
+
+        auto id = g_next_flow_id.fetch_add(1u, std::memory_order_relaxed);
+
+        record_event(trace_event {
+            .name = name,
+            .category = "flow",
+            .timestamp = get_trace_timestamp(),
+            .value = id,
+            .phase = 's',
+        });
+
+        return id;
+    }
+
+    void step_trace_flow(const char* name, uint64_t id) noexcept {
+        if (id == 0u || !is_tracing_enabled()) {
+            return;
+        }
+
+        record_event(trace_event {
+            .name = name,
+            .category = "flow",
+            .timestamp = get_trace_timestamp(),
+            .value = id,
+            .phase = 't',
+        });
+    }
+
+    void end_trace_flow(const char* name, uint64_t id) noexcept {
+        if (id == 0u || !is_tracing_enabled()) {
+            return;
+        }
+
+        record_event(trace_event {
+            .name = name,
+            .category = "flow",
+            .timestamp = get_trace_timestamp(),
+            .value = id,
+            .phase = 'f',
+        });
+    }
+
+    /// Writes a string as a JSON string
+    /// \param ss The stream to write to
+    /// \param value The string to write
+    static void write_json_string(std::stringstream& ss, std::string_view value) {
+        ss << '"';
+
+        for (auto c : value) {
+            switch (c) {
+                case '"':
+                    ss << "\\\"";
+                    break;
+                case '\\':
+                    ss << "\\\\";
+                    break;
+                case '\n':
+                    ss << "\\n";
+                    break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20u) {
+                        ss << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+                           << static_cast<int>(c) << std::dec << std::setfill(' ');
+                    } else {
+                        ss << c;
+                    }
+                    break;
+            }
+        }
+
+        ss << '"';
+    }
+
+    /// Writes a trace event as JSON
+    /// \param ss The stream to write to
+    /// \param event The event to write
+    /// \param thread_id The ID of the thread that recorded the event
+    static void write_event(std::stringstream& ss, const trace_event& event, uint32_t thread_id) {
+        ss << "{\"name\":";
+        write_json_string(ss, event.name ? event.name : "");
+        ss << ",\"cat\":";
+        write_json_string(ss, event.category ? event.category : "");
+        ss << ",\"ph\":\"" << event.phase << "\""
+           << ",\"ts\":" << static_cast<double>(event.timestamp) / 1000.0
+           << ",\"pid\":1,\"tid\":" << thread_id;
+
+        switch (event.phase) {
+            case 'X':
+                ss << ",\"dur\":" << static_cast<double>(event.value) / 1000.0;
+                break;
+            case 'C':
+                ss << ",\"args\":{\"value\":" << static_cast<int64_t>(event.value) << "}";
+                break;
+            case 'f':
+                // bind the end of the flow to the zone enclosing it, rather than the next zone
+                ss << ",\"id\":" << event.value << ",\"bp\":\"e\"";
+                break;
+            default:
+                ss << ",\"id\":" << event.value;
+                break;
+        }
+
+        ss << "}";
+    }
+
+    std::string get_trace_json(uint64_t since, uint64_t until) {
+        std::stringstream ss;
+        ss << std::fixed << std::setprecision(3);
+
+        ss << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+        auto is_first_event {true};
+        auto write_separator = [&ss, &is_first_event]() {
+            if (!is_first_event) {
+                ss << ",\n";
+            }
+
+            is_first_event = false;
+        };
+
+        uint64_t number_of_dropped_events {0u};
+        std::vector<trace_event> events;
+
+        std::scoped_lock<std::mutex> lock(g_buffers_mutex);
+
+        auto generation = g_generation.load(std::memory_order_acquire);
+
+        for (const auto& buffer : g_buffers) {
+            if (!buffer->name.empty()) {
+                write_separator();
+                ss << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->thread_id
+                   << ",\"args\":{\"name\":";
+                write_json_string(ss, buffer->name);
+                ss << "}}";
+            }
+
+            if (buffer->generation.load(std::memory_order_acquire) != generation) {
+                continue;
+            }
+
+            auto count = buffer->count.load(std::memory_order_acquire);
+            auto buffer_events = buffer->events.load(std::memory_order_acquire);
+            if (!buffer_events) {
+                continue;
+            }
+
+            // copy the events first, so the buffer can be checked for a clear during the copy. In
+            // ring mode, the oldest events are copied first
+            auto first = count > max_events_per_thread ? count - max_events_per_thread : size_t {0u};
+
+            events.clear();
+            for (auto i = first; i < count; ++i) {
+                events.push_back(buffer_events[i % max_events_per_thread]);
+            }
+
+            if (buffer->generation.load(std::memory_order_acquire) != generation) {
+                continue;
+            }
+
+            // skip any events that were overwritten while they were copied, including the event
+            // that may be being written but is not yet published
+            auto count_after_copy = buffer->count.load(std::memory_order_acquire) + 1u;
+            auto first_after_copy = count_after_copy > max_events_per_thread ?
+                                    count_after_copy - max_events_per_thread :
+                                    size_t {0u};
+            auto number_of_overwritten_events = std::min(first_after_copy > first ? first_after_copy - first : size_t {0u},
+                                                         events.size());
+
+            for (auto i = number_of_overwritten_events; i < events.size(); ++i) {
+                const auto& event = events[i];
+                if (event.timestamp < since || event.timestamp > until) {
+                    continue;
+                }
+
+                write_separator();
+                write_event(ss, event, buffer->thread_id);
+            }
+
+            number_of_dropped_events += buffer->number_of_dropped_events.load(std::memory_order_relaxed);
+        }
+
+        ss << "],\"otherData\":{\"dropped_events\":\"" << number_of_dropped_events << "\"}}";
+
+        return ss.str();
+    }
+
+    bool write_trace(const std::filesystem::path& path, uint64_t since, uint64_t until) noexcept {
+        try {
+            auto json = get_trace_json(since, until);
+
+            std::ofstream file(path, std::ios::out | std::ios::trunc);
+            if (!file.is_open()) {
+                return false;
+            }
+
+            file << json;
+
+            return file.good();
+        } catch (...) {
+            return false;
+        }
+    }
+}
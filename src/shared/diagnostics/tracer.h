@@ -0,0 +1,149 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+// Records trace events, such as timed zones, counters and flows between threads, which can be
+// written as Chrome trace event JSON and opened in Perfetto (https://ui.perfetto.dev) or
+// chrome://tracing. Each thread records into its own fixed size buffer without locks, and when
+// tracing is disabled, recording an event costs a single relaxed load.
+// Event names and categories are stored as pointers, so they must live until the trace has been
+// written. String literals are the intended use.
+// By default, a thread's events are dropped once its buffer is full. In ring mode, the oldest events
+// are overwritten instead, so the most recent events can always be written, such as when capturing
+// the moments before a frame spike.
+
+namespace pbr::shared::diagnostics {
+    /// The state of the tracer. This is only exposed so the checks can be inlined
+    struct tracer_state {
+        /// Is tracing enabled?
+        static inline std::atomic_bool is_enabled {false};
+    };
+
+    /// Enables recording trace events. This is thread safe
+    void enable_tracing() noexcept;
+
+    /// Disables recording trace events. Events already recorded are kept until `clear_trace` is
+    /// called. This is thread safe
+    void disable_tracing() noexcept;
+
+    /// Returns if trace events are being recorded. This is thread safe
+    /// \returns `true` if trace events are being recorded, else `false`
+    [[nodiscard]]
+    inline bool is_tracing_enabled() noexcept {
+        return tracer_state::is_enabled.load(std::memory_order_relaxed);
+    }
+
+    /// Removes all recorded trace events. This is thread safe
+    void clear_trace() noexcept;
+
+    /// Sets whether each thread's oldest events are overwritten once its buffer is full, rather than
+    /// its newest events being dropped. All recorded trace events are removed. This is thread safe
+    /// \param is_ring_mode `true` to overwrite the oldest events, `false` to drop the newest events
+    void set_trace_ring_mode(bool is_ring_mode) noexcept;
+
+    /// Returns if each thread's oldest events are overwritten once its buffer is full. This is
+    /// thread safe
+    /// \returns `true` if the oldest events are overwritten, else `false`
+    [[nodiscard]]
+    bool is_trace_ring_mode() noexcept;
+
+    /// Names the calling thread in the trace. This is recorded even if tracing is disabled, so
+    /// threads can be named when they start. This is thread safe
+    /// \param name The name of the thread
+    void set_trace_thread_name(std::string_view name) noexcept;
+
+    /// Returns the current time on the trace clock
+    /// \returns The current time on the trace clock, in nanoseconds
+    [[nodiscard]]
+    uint64_t get_trace_timestamp() noexcept;
+
+    /// Records a zone that has completed. Prefer `trace_zone`
+    /// \param name The name of the zone
+    /// \param category The category of the zone
+    /// \param start The time the zone started, from `get_trace_timestamp`
+    /// \param end The time the zone ended, from `get_trace_timestamp`
+    void record_trace_zone(const char* name, const char* category, uint64_t start, uint64_t end) noexcept;
+
+    /// Records the value of a counter, which is shown as a graph in the trace. This does nothing if
+    /// tracing is disabled. This is thread safe
+    /// \param name The name of the counter
+    /// \param value The value of the counter
+    void trace_counter(const char* name, int64_t value) noexcept;
+
+    /// Starts a flow, which links the zone enclosing this call to the zones enclosing the matching
+    /// `step_trace_flow` and `end_trace_flow` calls, which are usually on other threads. This does
+    /// nothing if tracing is disabled. This is thread safe
+    /// \param name The name of the flow
+    /// \returns The ID of the flow, else `0` if tracing is disabled
+    [[nodiscard]]
+    uint64_t begin_trace_flow(const char* name) noexcept;
+
+    /// Adds a step to a flow, linking it to the zone enclosing this call. This is thread safe
+    /// \param name The name of the flow
+    /// \param id The ID returned by `begin_trace_flow`. If this is `0`, nothing happens
+    void step_trace_flow(const char* name, uint64_t id) noexcept;
+
+    /// Ends a flow, linking it to the zone enclosing this call. This is thread safe
+    /// \param name The name of the flow
+    /// \param id The ID returned by `begin_trace_flow`. If this is `0`, nothing happens
+    void end_trace_flow(const char* name, uint64_t id) noexcept;
+
+    /// Returns the recorded trace events as Chrome trace event JSON. Events recorded while this is
+    /// called may or may not be included. This is thread safe
+    /// \param since Only events at or after this time, from `get_trace_timestamp`, are included
+    /// \param until Only events at or before this time, from `get_trace_timestamp`, are included
+    /// \returns The recorded trace events as Chrome trace event JSON
+    [[nodiscard]]
+    std::string get_trace_json(uint64_t since = 0u, uint64_t until = UINT64_MAX);
+
+    /// Writes the recorded trace events to a file as Chrome trace event JSON. This is thread safe
+    /// \param path The path of the file to write
+    /// \param since Only events at or after this time, from `get_trace_timestamp`, are written
+    /// \param until Only events at or before this time, from `get_trace_timestamp`, are written
+    /// \returns `true` upon success, else `false`
+    [[nodiscard]]
+    bool write_trace(const std::filesystem::path& path, uint64_t since = 0u, uint64_t until = UINT64_MAX) noexcept;
+
+    /// Records the time taken by a scope as a zone in the trace. If tracing is disabled when this is
+    /// constructed, nothing is recorded
+    class trace_zone {
+    public:
+        /// Starts the zone
+        /// \param name The name of the zone
+        /// \param category The category of the zone
+        explicit trace_zone(const char* name, const char* category = "game") noexcept
+            : _name(name),
+              _category(category) {
+            if (is_tracing_enabled()) [[unlikely]] {
+                this->_start = get_trace_timestamp();
+            }
+        }
+
+        /// Ends the zone and records it
+        ~trace_zone() {
+            if (this->_start != 0u) [[unlikely]] {
+                record_trace_zone(this->_name, this->_category, this->_start, get_trace_timestamp());
+            }
+        }
+
+        trace_zone(const trace_zone&) = delete;
+        trace_zone(trace_zone&&) = delete;
+
+        trace_zone& operator = (const trace_zone&) = delete;
+        trace_zone& operator = (trace_zone&&) = delete;
+
+    private:
+        /// The name of the zone
+        const char* _name {nullptr};
+
+        /// The category of the zone
+        const char* _category {nullptr};
+
+        /// The time the zone started, `0` if tracing was disabled
+        uint64_t _start {0u};
+    };
+}
@@ -0,0 +1,149 @@
+#include "tracked_mutex.h"
+
+#include <algorithm>
+#include <string>
+
+namespace pbr::shared::diagnostics {
+    /// Registers a counter of a lock
+    /// \param registry The registry to register the counter in
+    /// \param name The name of the lock
+    /// \param suffix The suffix of the counter's name
+    /// \returns The handle of the counter, else an invalid handle if it could not be registered
+    static counter_handle register_lock_counter(counter_registry& registry,
+                                                std::string_view name,
+                                                std::string_view suffix) noexcept {
+        try {
+            std::string counter_name("lock_");
+            counter_name.append(name);
+            counter_name.append(suffix);
+
+            return registry.register_counter(counter_name);
+        } catch (...) {
+            return {};
+        }
+    }
+
+    lock_counters::lock_counters(std::string_view name, counter_registry& registry) noexcept
+        : _registry(registry),
+          _acquisitions(register_lock_counter(registry, name, "_acquisitions")),
+          _contended_acquisitions(register_lock_counter(registry, name, "_contended_acquisitions")),
+          _wait_time(register_lock_counter(registry, name, "_wait_ns")),
+          _max_wait_time(register_lock_counter(registry, name, "_max_wait_ns")),
+          _hold_time(register_lock_counter(registry, name, "_hold_ns")),
+          _max_hold_time(register_lock_counter(registry, name, "_max_hold_ns")) {
+    }
+
+    void lock_counters::record_acquisition(std::chrono::nanoseconds wait_time) noexcept {
+        this->_registry.add(this->_acquisitions, 1);
+
+        if (wait_time.count() > 0) {
+            this->_registry.add(this->_contended_acquisitions, 1);
+            this->_registry.add(this->_wait_time, wait_time.count());
+            this->_registry.update_max(this->_max_wait_time, wait_time.count());
+        }
+    }
+
+    void lock_counters::record_release(std::chrono::nanoseconds hold_time) noexcept {
+        this->_registry.add(this->_hold_time, hold_time.count());
+        this->_registry.update_max(this->_max_hold_time, hold_time.count());
+    }
+
+    lock_statistics lock_counters::get_statistics() const noexcept {
+        return {
+            .acquisitions = this->_registry.get(this->_acquisitions),
+            .contended_acquisitions = this->_registry.get(this->_contended_acquisitions),
+            .total_wait_time = std::chrono::nanoseconds(this->_registry.get(this->_wait_time)),
+            .max_wait_time = std::chrono::nanoseconds(this->_registry.get(this->_max_wait_time)),
+            .total_hold_time = std::chrono::nanoseconds(this->_registry.get(this->_hold_time)),
+            .max_hold_time = std::chrono::nanoseconds(this->_registry.get(this->_max_hold_time)),
+        };
+    }
+
+    /// Locks a mutex, timing the wait only if the mutex is already held
+    /// \param lock Locks the mutex
+    /// \param try_lock Tries to lock the mutex
+    /// \param counters The counters to record the acquisition in
+    /// \returns The time the mutex was locked
+    template <typename L, typename T>
+    std::chrono::steady_clock::time_point lock_and_record(L&& lock, T&& try_lock, lock_counters& counters) {
+        using clock = std::chrono::steady_clock;
+
+        if (try_lock()) [[likely]] {
+            counters.record_acquisition(std::chrono::nanoseconds(0));
+            return clock::now();
+        }
+
+        auto start = clock::now();
+        lock();
+        auto end = clock::now();
+
+        // a wait rounded down to zero is still contended
+        counters.record_acquisition(std::max(end - start, clock::duration(1)));
+
+        return end;
+    }
+
+    void tracked_mutex::lock() {
+        this->_lock_time = lock_and_record([this]() { this->_mutex.lock(); },
+                                           [this]() { return this->_mutex.try_lock(); },
+                                           this->_counters);
+    }
+
+    bool tracked_mutex::try_lock() noexcept {
+        if (!this->_mutex.try_lock()) {
+            return false;
+        }
+
+        this->_counters.record_acquisition(std::chrono::nanoseconds(0));
+        this->_lock_time = clock::now();
+
+        return true;
+    }
+
+    void tracked_mutex::unlock() noexcept {
+        this->_counters.record_release(clock::now() - this->_lock_time);
+        this->_mutex.unlock();
+    }
+
+    void tracked_shared_mutex::lock() {
+        this->_lock_time = lock_and_record([this]() { this->_mutex.lock(); },
+                                           [this]() { return this->_mutex.try_lock(); },
+                                           this->_counters);
+    }
+
+    bool tracked_shared_mutex::try_lock() noexcept {
+        if (!this->_mutex.try_lock()) {
+            return false;
+        }
+
+        this->_counters.record_acquisition(std::chrono::nanoseconds(0));
+        this->_lock_time = clock::now();
+
+        return true;
+    }
+
+    void tracked_shared_mutex::unlock() noexcept {
+        this->_counters.record_release(clock::now() - this->_lock_time);
+        this->_mutex.unlock();
+    }
+
+    void tracked_shared_mutex::lock_shared() {
+        lock_and_record([this]() { this->_mutex.lock_shared(); },
+                        [this]() { return this->_mutex.try_lock_shared(); },
+                        this->_counters);
+    }
+
+    bool tracked_shared_mutex::try_lock_shared() noexcept {
+        if (!this->_mutex.try_lock_shared()) {
+            return false;
+        }
+
+        this->_counters.record_acquisition(std::chrono::nanoseconds(0));
+
+        return true;
+    }
+
+    void tracked_shared_mutex::unlock_shared() noexcept {
+        this->_mutex.unlock_shared();
+    }
+}
@@ -0,0 +1,202 @@
+#pragma once
+
+#include "counter_registry.h"
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <shared_mutex>
+#include <string_view>
+
+// Mutexes that record how they are used, so locks that hurt tail latency can be found. Each lock
+// registers its counters in a counter registry under `lock_<name>_`, so they are exported with every
+// other metric. Locks with the same name share their counters, so a family of locks, such as one for
+// each file, can be measured as one.
+// An uncontended lock costs a `try_lock` and a clock read more than the wrapped mutex. The wait time
+// is only measured when the `try_lock` fails.
+
+namespace pbr::shared::diagnostics {
+    /// The statistics of a tracked lock
+    struct lock_statistics {
+        /// The number of times the lock was acquired
+        int64_t acquisitions {0};
+
+        /// The number of times the lock was acquired after waiting for another thread to release it
+        int64_t contended_acquisitions {0};
+
+        /// The total time spent waiting to acquire the lock
+        std::chrono::nanoseconds total_wait_time {0};
+
+        /// The longest time spent waiting to acquire the lock
+        std::chrono::nanoseconds max_wait_time {0};
+
+        /// The total time the lock was held exclusively
+        std::chrono::nanoseconds total_hold_time {0};
+
+        /// The longest time the lock was held exclusively
+        std::chrono::nanoseconds max_hold_time {0};
+    };
+
+    /// The counters of a tracked lock, held in a counter registry. This is thread safe
+    class lock_counters {
+    public:
+        /// Constructs these counters, registering them if they are not already registered
+        /// \param name The name of the lock
+        /// \param registry The registry to register the counters in
+        lock_counters(std::string_view name, counter_registry& registry) noexcept;
+
+        /// Records that the lock was acquired
+        /// \param wait_time The time spent waiting to acquire the lock. If this is above zero, the
+        /// acquisition was contended
+        void record_acquisition(std::chrono::nanoseconds wait_time) noexcept;
+
+        /// Records that the lock was released after being held exclusively
+        /// \param hold_time The time the lock was held
+        void record_release(std::chrono::nanoseconds hold_time) noexcept;
+
+        /// Returns the statistics of the lock
+        /// \returns The statistics of the lock
+        [[nodiscard]]
+        lock_statistics get_statistics() const noexcept;
+
+    private:
+        /// The registry the counters are held in
+        counter_registry& _registry;
+
+        /// The number of acquisitions
+        counter_handle _acquisitions;
+
+        /// The number of contended acquisitions
+        counter_handle _contended_acquisitions;
+
+        /// The total wait time, in nanoseconds
+        counter_handle _wait_time;
+
+        /// The longest wait time, in nanoseconds
+        counter_handle _max_wait_time;
+
+        /// The total hold time, in nanoseconds
+        counter_handle _hold_time;
+
+        /// The longest hold time, in nanoseconds
+        counter_handle _max_hold_time;
+    };
+
+    /// A drop in replacement for `std::mutex` that records its acquisitions, wait times and hold
+    /// times. This is thread safe
+    class tracked_mutex {
+    public:
+        /// The clock waits and holds are timed with
+        using clock = std::chrono::steady_clock;
+
+        /// Constructs this mutex
+        /// \param name The name of this mutex, which its counters are registered under
+        /// \param registry The registry to register the counters in
+        explicit tracked_mutex(std::string_view name,
+                               counter_registry& registry = get_counter_registry()) noexcept
+            : _counters(name, registry) {
+        }
+
+        ~tracked_mutex() = default;
+
+        tracked_mutex(const tracked_mutex&) = delete;
+        tracked_mutex(tracked_mutex&&) = delete;
+
+        tracked_mutex& operator = (const tracked_mutex&) = delete;
+        tracked_mutex& operator = (tracked_mutex&&) = delete;
+
+        /// Locks this mutex, waiting if another thread holds it
+        void lock();
+
+        /// Locks this mutex if no other thread holds it. A failed attempt is not recorded
+        /// \returns `true` if this mutex was locked, else `false`
+        [[nodiscard]]
+        bool try_lock() noexcept;
+
+        /// Unlocks this mutex
+        void unlock() noexcept;
+
+        /// Returns the statistics of this mutex
+        /// \returns The statistics of this mutex
+        [[nodiscard]]
+        lock_statistics get_statistics() const noexcept {
+            return this->_counters.get_statistics();
+        }
+
+    private:
+        /// The wrapped mutex
+        std::mutex _mutex;
+
+        /// The counters of this mutex
+        lock_counters _counters;
+
+        /// The time this mutex was last locked. This is only accessed by the thread holding the lock
+        clock::time_point _lock_time;
+    };
+
+    /// A drop in replacement for `std::shared_mutex` that records its acquisitions, wait times and
+    /// exclusive hold times. Shared holds overlap, so only their acquisitions and wait times are
+    /// recorded. This is thread safe
+    class tracked_shared_mutex {
+    public:
+        /// The clock waits and holds are timed with
+        using clock = std::chrono::steady_clock;
+
+        /// Constructs this mutex
+        /// \param name The name of this mutex, which its counters are registered under
+        /// \param registry The registry to register the counters in
+        explicit tracked_shared_mutex(std::string_view name,
+                                      counter_registry& registry = get_counter_registry()) noexcept
+            : _counters(name, registry) {
+        }
+
+        ~tracked_shared_mutex() = default;
+
+        tracked_shared_mutex(const tracked_shared_mutex&) = delete;
+        tracked_shared_mutex(tracked_shared_mutex&&) = delete;
+
+        tracked_shared_mutex& operator = (const tracked_shared_mutex&) = delete;
+        tracked_shared_mutex& operator = (tracked_shared_mutex&&) = delete;
+
+        /// Locks this mutex exclusively, waiting if another thread holds it
+        void lock();
+
+        /// Locks this mutex exclusively if no other thread holds it. A failed attempt is not recorded
+        /// \returns `true` if this mutex was locked, else `false`
+        [[nodiscard]]
+        bool try_lock() noexcept;
+
+        /// Unlocks this mutex from being held exclusively
+        void unlock() noexcept;
+
+        /// Locks this mutex shared, waiting if another thread holds it exclusively
+        void lock_shared();
+
+        /// Locks this mutex shared if no other thread holds it exclusively. A failed attempt is not
+        /// recorded
+        /// \returns `true` if this mutex was locked, else `false`
+        [[nodiscard]]
+        bool try_lock_shared() noexcept;
+
+        /// Unlocks this mutex from being held shared
+        void unlock_shared() noexcept;
+
+        /// Returns the statistics of this mutex
+        /// \returns The statistics of this mutex
+        [[nodiscard]]
+        lock_statistics get_statistics() const noexcept {
+            return this->_counters.get_statistics();
+        }
+
+    private:
+        /// The wrapped mutex
+        std::shared_mutex _mutex;
+
+        /// The counters of this mutex
+        lock_counters _counters;
+
+        /// The time this mutex was last locked exclusively. This is only accessed by the thread
+        /// holding the lock exclusively
+        clock::time_point _lock_time;
+    };
+}
@@ -0,0 +1,43 @@
+#include "fixed_timestep.h"
+
+#include <algorithm>
+
+namespace pbr::shared::game {
+    fixed_timestep::fixed_timestep(fixed_timestep_settings settings) noexcept
+        : _settings(settings),
+          _tick_duration(std::chrono::nanoseconds(std::chrono::seconds(1)) /
+                         std::max(settings.ticks_per_second, 1u)) {
+    }
+
+    void fixed_timestep::reset(clock::time_point now) noexcept {
+        this->_last_time = now;
+        this->_accumulator = this->_tick_duration;
+    }
+
+    uint32_t fixed_timestep::advance(clock::time_point now) noexcept {
+        // a clock going backwards adds no time, rather than removing time already simulated
+        this->_accumulator += std::max(std::chrono::nanoseconds(now - this->_last_time), std::chrono::nanoseconds(0));
+        this->_last_time = now;
+
+        auto due_ticks = static_cast<uint64_t>(this->_accumulator / this->_tick_duration);
+        auto max_ticks = static_cast<uint64_t>(std::max(this->_settings.max_ticks_per_frame, 1u));
+
+        if (due_ticks > max_ticks) {
+            // drop the time the ticks are behind by, keeping the leftover time so the
+            // interpolation does not jump
+            this->_number_of_dropped_ticks += due_ticks - max_ticks;
+            this->_accumulator -= this->_tick_duration * static_cast<int64_t>(due_ticks - max_ticks);
+            due_ticks = max_ticks;
+        }
+
+        this->_accumulator -= this->_tick_duration * static_cast<int64_t>(due_ticks);
+        this->_number_of_ticks += due_ticks;
+
+        return static_cast<uint32_t>(due_ticks);
+    }
+
+    float fixed_timestep::get_interpolation_alpha() const noexcept {
+        return static_cast<float>(static_cast<double>(this->_accumulator.count()) /
+                                  static_cast<double>(this->_tick_duration.count()));
+    }
+}
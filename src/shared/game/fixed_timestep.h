@@ -0,0 +1,106 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+namespace pbr::shared::game {
+    /// The settings of a fixed timestep
+    struct fixed_timestep_settings {
+        /// The number of ticks run each second
+        uint32_t ticks_per_second {60u};
+
+        /// The most ticks run to catch up in a single frame. If the ticks fall further behind than
+        /// this, such as after a stall, the time they are behind by is dropped. The simulation then
+        /// runs slower than real time for a moment, rather than each frame running more ticks to
+        /// catch up, taking longer, and falling further behind
+        uint32_t max_ticks_per_frame {5u};
+    };
+
+    /// Decouples the rate the simulation runs at from the frame rate. Each frame, the time since
+    /// the last frame is added to an accumulator, and a tick is run for each whole tick duration it
+    /// holds. The leftover time is how far the frame is between the last tick and the next one,
+    /// which the renderer uses to interpolate between the last two ticks' states. The simulation
+    /// therefore costs the same whatever the frame rate, and each tick advances it by the same time
+    class fixed_timestep {
+    public:
+        /// The clock ticks are timed with
+        using clock = std::chrono::steady_clock;
+
+        /// Constructs this timestep
+        /// \param settings The settings to use. `ticks_per_second` and `max_ticks_per_frame` must
+        /// not be `0`
+        explicit fixed_timestep(fixed_timestep_settings settings = {}) noexcept;
+
+        /// Starts timing from a point in time. One tick is due straight away, so the simulation has
+        /// a state before the first frame is rendered
+        /// \param now The current time
+        void reset(clock::time_point now) noexcept;
+
+        /// Advances the time to the passed time, returning the number of ticks to run
+        /// \param now The current time
+        /// \returns The number of ticks to run, at most `max_ticks_per_frame`
+        [[nodiscard]]
+        uint32_t advance(clock::time_point now) noexcept;
+
+        /// Returns how far the current time is between the last tick and the next one
+        /// \returns How far the current time is between the last tick and the next one, from `0.0`
+        /// to `1.0`
+        [[nodiscard]]
+        float get_interpolation_alpha() const noexcept;
+
+        /// Returns the simulated time each tick advances by
+        /// \returns The simulated time each tick advances by
+        [[nodiscard]]
+        std::chrono::nanoseconds get_tick_duration() const noexcept {
+            return this->_tick_duration;
+        }
+
+        /// Returns the time the last tick was due. The interpolation alpha is `0.0` at this time,
+        /// and rises to `1.0` one tick duration later
+        /// \returns The time the last tick was due
+        [[nodiscard]]
+        clock::time_point get_last_tick_time() const noexcept {
+            return this->_last_time - this->_accumulator;
+        }
+
+        /// Returns the time the next tick is due
+        /// \returns The time the next tick is due
+        [[nodiscard]]
+        clock::time_point get_next_tick_time() const noexcept {
+            return this->_last_time + (this->_tick_duration - this->_accumulator);
+        }
+
+        /// Returns the number of ticks returned by `advance`
+        /// \returns The number of ticks returned by `advance`
+        [[nodiscard]]
+        uint64_t get_number_of_ticks() const noexcept {
+            return this->_number_of_ticks;
+        }
+
+        /// Returns the number of ticks dropped because too many were due in one frame
+        /// \returns The number of ticks dropped because too many were due in one frame
+        [[nodiscard]]
+        uint64_t get_number_of_dropped_ticks() const noexcept {
+            return this->_number_of_dropped_ticks;
+        }
+
+    private:
+        /// The settings
+        fixed_timestep_settings _settings;
+
+        /// The simulated time each tick advances by
+        std::chrono::nanoseconds _tick_duration;
+
+        /// The time not yet simulated
+        std::chrono::nanoseconds _accumulator {0};
+
+        /// The time `advance` or `reset` was last called with
+        clock::time_point _last_time;
+
+        /// The number of ticks returned by `advance`
+        uint64_t _number_of_ticks {0u};
+
+        /// The number of ticks dropped because too many were due in one frame
+        uint64_t _number_of_dropped_ticks {0u};
+    };
+}
@@ -0,0 +1,77 @@
+#include "frame_limiter.h"
+#include "shared/diagnostics/tracer.h"
+
+#include <algorithm>
+#include <string>
+#include <thread>
+
+namespace pbr::shared::game {
+    frame_limiter::frame_limiter(frame_limiter_settings settings) noexcept
+        : _settings(settings),
+          _frame_duration(std::chrono::nanoseconds(std::chrono::seconds(1)) /
+                          std::max(settings.frames_per_second, 1u)) {
+        this->reset(clock::now());
+    }
+
+    void frame_limiter::reset(clock::time_point now) noexcept {
+        this->_next_frame_time = now + this->_frame_duration;
+    }
+
+    frame_limiter::clock::time_point frame_limiter::wait_for_next_frame() noexcept {
+        if (!this->is_limited()) {
+            return clock::now();
+        }
+
+        auto now = this->wait_until(this->_next_frame_time);
+
+        this->_next_frame_time += this->_frame_duration;
+
+        if (this->_next_frame_time < now) {
+            this->reset(now);
+        }
+
+        return now;
+    }
+
+    frame_limiter::clock::time_point frame_limiter::wait_until(clock::time_point time) noexcept {
+        diagnostics::trace_zone trace_zone("frame_limiter::wait_until");
+
+        auto now = clock::now();
+
+        if (now >= time) {
+            this->_overruns.record(now - time, now);
+            return now;
+        }
+
+        if (time - now > this->_settings.spin_time) {
+            std::this_thread::sleep_until(time - this->_settings.spin_time);
+            now = clock::now();
+        }
+
+        while (now < time) {
+            std::this_thread::yield();
+            now = clock::now();
+        }
+
+        this->_jitter.record(now - time, now);
+
+        return now;
+    }
+
+    void frame_limiter::publish(std::string_view prefix,
+                                clock::time_point now,
+                                diagnostics::counter_registry& registry) noexcept {
+        try {
+            auto publish_statistics = [&registry](const std::string& name,
+                                                  const diagnostics::histogram_statistics& statistics) {
+                registry.set(registry.register_counter(name + "_p50_ns"), statistics.p50.count());
+                registry.set(registry.register_counter(name + "_p99_ns"), statistics.p99.count());
+                registry.set(registry.register_counter(name + "_max_ns"), statistics.max.count());
+            };
+
+            publish_statistics(std::string(prefix) + "_frame_jitter", this->get_jitter_statistics(now));
+            publish_statistics(std::string(prefix) + "_frame_overrun", this->get_overrun_statistics(now));
+        } catch (...) {
+        }
+    }
+}
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "shared/diagnostics/counter_registry.h"
+#include "shared/diagnostics/histogram.h"
+
+#include <chrono>
+#include <cstdint>
+#include <string_view>
+
+namespace pbr::shared::game {
+    /// The settings of a frame limiter
+    struct frame_limiter_settings {
+        /// The most frames run each second. If this is `0`, the frame rate is not limited
+        uint32_t frames_per_second {0u};
+
+        /// How long before a frame is due to stop sleeping and spin until it is due. Sleeping can
+        /// wake late by up to the scheduler's granularity, so this should be a little longer than
+        /// that. If this is `0`, waiting only sleeps
+        std::chrono::nanoseconds spin_time {std::chrono::microseconds(1500)};
+
+        /// Should frames only run when there is something new for them to do? This is only used by
+        /// the graphics loop when it runs on its own thread, which then waits for the logic loop to
+        /// synchronize a new frame rather than rendering the same frame again
+        bool is_adaptive {false};
+    };
+
+    /// Paces a loop, so it does not run faster than it needs to and keep a core busy. Waiting sleeps
+    /// until shortly before the frame is due, which gives the core back but can wake late, then
+    /// spins, yielding, until it is due, which wakes on time. Frames are due on a fixed schedule, so
+    /// a frame that starts a little late is followed by a shorter wait, and the frame rate does not
+    /// drift. How late each wait that slept or spun finishes is recorded as the loop's jitter. A wait
+    /// that starts after its time has passed is an overrun instead, as the loop itself was too slow,
+    /// and how late it started is recorded separately. This is not thread safe
+    class frame_limiter {
+    public:
+        /// The clock frames are timed with
+        using clock = std::chrono::steady_clock;
+
+        /// Constructs this limiter. The first frame is due a frame from now
+        /// \param settings The settings to use
+        explicit frame_limiter(frame_limiter_settings settings = {}) noexcept;
+
+        /// Restarts the schedule. The next frame is due a frame from the passed time
+        /// \param now The current time
+        void reset(clock::time_point now) noexcept;
+
+        /// Returns the settings
+        /// \returns The settings
+        [[nodiscard]]
+        const frame_limiter_settings& get_settings() const noexcept {
+            return this->_settings;
+        }
+
+        /// Returns if the frame rate is limited
+        /// \returns `true` if the frame rate is limited, else `false`
+        [[nodiscard]]
+        bool is_limited() const noexcept {
+            return this->_settings.frames_per_second > 0u;
+        }
+
+        /// Waits until the next frame is due. If the loop has fallen more than a frame behind, such
+        /// as after a stall, the schedule restarts from now, rather than frames running back to back
+        /// to catch up. If the frame rate is not limited, this returns straight away
+        /// \returns The time waiting finished
+        clock::time_point wait_for_next_frame() noexcept;
+
+        /// Waits until a point in time, outside of the schedule, such as when the next tick is due
+        /// \param time The time to wait until
+        /// \returns The time waiting finished
+        clock::time_point wait_until(clock::time_point time) noexcept;
+
+        /// Returns the statistics of how late waits that slept or spun finished over the last few
+        /// seconds
+        /// \param now The current time
+        /// \returns The statistics of how late waits finished
+        [[nodiscard]]
+        diagnostics::histogram_statistics get_jitter_statistics(clock::time_point now) noexcept {
+            return this->_jitter.get_statistics(now);
+        }
+
+        /// Returns the statistics of how late waits started, for waits that started after their time
+        /// had passed, over the last few seconds
+        /// \param now The current time
+        /// \returns The statistics of how late waits started
+        [[nodiscard]]
+        diagnostics::histogram_statistics get_overrun_statistics(clock::time_point now) noexcept {
+            return this->_overruns.get_statistics(now);
+        }
+
+        /// Publishes the jitter and overrun statistics as `<prefix>_frame_jitter_<statistic>_ns` and
+        /// `<prefix>_frame_overrun_<statistic>_ns` gauges
+        /// \param prefix The prefix of the gauges' names, such as the name of the loop
+        /// \param now The current time
+        /// \param registry The registry to publish to
+        void publish(std::string_view prefix,
+                     clock::time_point now,
+                     diagnostics::counter_registry& registry = diagnostics::get_counter_registry()) noexcept;
+
+    private:
+        /// The settings
+        frame_limiter_settings _settings;
+
+        /// The time each frame takes, if the frame rate is limited
+        std::chrono::nanoseconds _frame_duration;
+
+        /// The time the next frame is due
+        clock::time_point _next_frame_time;
+
+        /// How late waits that slept or spun finished
+        diagnostics::rolling_histogram _jitter {std::chrono::seconds(5)};
+
+        /// How late waits that started after their time had passed started
+        diagnostics::rolling_histogram _overruns {std::chrono::seconds(5)};
+    };
+}
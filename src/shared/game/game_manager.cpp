@@ -1,5 +1,9 @@
 #include "game_manager.h"
 #include "shared/utils/defer.h"
+#include "shared/diagnostics/tracer.h"
+#include "shared/diagnostics/metrics_exporter.h"
+#include "shared/diagnostics/sampling_profiler.h"
+#include "shared/jobs/job_system.h"
 
 namespace pbr::shared::game {
     bool game_manager::initialize() noexcept {
@@ -29,15 +33,22 @@ namespace pbr::shared::game {
             return false;
         }
 
-        if (!this->_graphics_manager->initialize()) {
-            this->_log_manager->log_message("Failed to initialize graphics manager.",
-                                            apis::logging::log_levels::error,
-                                            "Game");
-            return false;
+        {
+            memory::scoped_allocation_tag allocation_tag(memory::allocation_tag::graphics);
+
+            if (!this->_graphics_manager->initialize()) {
+                this->_log_manager->log_message("Failed to initialize graphics manager.",
+                                                apis::logging::log_levels::error,
+                                                "Game");
+                return false;
+            }
         }
 
         this->_counter_set.get_counter_for_duration("fps", std::chrono::seconds(1), this->_fps);
-        this->_counter_set.get_average_for_duration("average_frame_time", std::chrono::seconds(1), this->_average_frame_time);
+
+        this->_last_frame_time = std::chrono::steady_clock::now();
+        this->_last_frame_timings_log_time = this->_last_frame_time;
+        this->_last_metrics_publish_time = this->_last_frame_time;
 
         this->_log_manager->log_message("Initialized the game manager.",
                                         apis::logging::log_levels::info,
@@ -51,24 +62,51 @@ namespace pbr::shared::game {
                                         apis::logging::log_levels::info,
                                         "Game");
 
-        if (this->_graphics_manager->run_on_separate_thread()) {
-            std::thread graphics_thread(&game_manager::run_graphics_manager,
-                                        this->_graphics_manager,
-                                        std::reference_wrapper(this->_has_exit_been_requested));
+        std::thread graphics_thread;
 
-            // make sure the graphics thread is joined no matter where we exit this function
-            utils::defer defer_graphics_thread {
-                [&graphics_thread, this]() {
-                    if (graphics_thread.joinable()) {
-                        this->request_exit();
+        // make sure the graphics thread is joined no matter where we exit this function
+        utils::defer defer_graphics_thread {
+            [&graphics_thread, this]() {
+                if (graphics_thread.joinable()) {
+                    this->request_exit();
 
-                        graphics_thread.join();
-                    }
+                    // wake the graphics thread if it is waiting for a new frame
+                    ++this->_number_of_synchronized_frames;
+                    this->_number_of_synchronized_frames.notify_all();
+
+                    graphics_thread.join();
                 }
-            };
+            }
+        };
+
+        if (this->_graphics_manager->run_on_separate_thread()) {
+            graphics_thread = std::thread(&game_manager::run_graphics_manager,
+                                          this->_graphics_manager,
+                                          std::reference_wrapper(this->_has_exit_been_requested),
+                                          this->_graphics_spike_detector.get(),
+                                          this->_graphics_frame_limiter_settings,
+                                          std::reference_wrapper(this->_number_of_synchronized_frames),
+                                          std::reference_wrapper(this->_synchronized_next_tick_time),
+                                          this->_thread_config.get_settings(thread_roles::graphics),
+                                          this->_log_manager);
         }
 
+        diagnostics::set_trace_thread_name("Logic");
+        diagnostics::register_sampling_profiler_thread("Logic");
+
+        // window events are pumped by this thread, so jobs that must run on the main thread run here
+        jobs::get_job_system().set_main_thread();
+        jobs::get_job_system().set_log_manager(this->_log_manager);
+
+        this->apply_thread_config();
+
+        auto now = std::chrono::steady_clock::now();
+        this->_fixed_timestep.reset(now);
+        this->_logic_frame_limiter.reset(now);
+
         while (!this->_has_exit_been_requested) {
+            diagnostics::trace_zone frame_trace_zone("frame");
+
             this->begin_frame();
 
             if (!this->update_frame()) {
@@ -78,12 +116,27 @@ namespace pbr::shared::game {
                 return false;
             }
 
+            auto number_of_ticks = this->_fixed_timestep.advance(std::chrono::steady_clock::now());
+
+            for (uint32_t i {0u}; i < number_of_ticks && !this->_has_exit_been_requested; ++i) {
+                if (!this->run_tick()) {
+                    this->_log_manager->log_message("Failed to run tick.",
+                                                    apis::logging::log_levels::error,
+                                                    "Game");
+                    return false;
+                }
+            }
+
             this->synchronize_frame();
 
             if (!this->_graphics_manager->run_on_separate_thread()) {
+                diagnostics::scoped_phase_timer phase_timer(this->_frame_phase_timings, frame_phases::submit);
+
                 this->_graphics_manager->submit_frame_for_render();
             }
 
+            this->wait_for_next_frame();
+
             this->exit_frame();
         }
 
@@ -94,11 +147,114 @@ namespace pbr::shared::game {
         return true;
     }
 
+    bool game_manager::enable_spike_detection(const diagnostics::spike_detector_settings& settings) noexcept {
+        try {
+            this->_logic_spike_detector = std::make_unique<diagnostics::spike_detector>("logic", settings);
+
+            if (this->_graphics_manager->run_on_separate_thread()) {
+                this->_graphics_spike_detector = std::make_unique<diagnostics::spike_detector>("graphics", settings);
+            }
+        } catch (...) {
+            this->_log_manager->log_message("Failed to create the spike detectors.",
+                                            apis::logging::log_levels::error,
+                                            "Game");
+            return false;
+        }
+
+        this->_log_manager->log_message("Capturing frame spikes to " + settings.output_directory.string(),
+                                        apis::logging::log_levels::info,
+                                        "Game");
+
+        return true;
+    }
+
+    bool game_manager::set_fixed_timestep_settings(const fixed_timestep_settings& settings) noexcept {
+        if (settings.ticks_per_second == 0u || settings.max_ticks_per_frame == 0u) {
+            this->_log_manager->log_message("Invalid fixed timestep settings.",
+                                            apis::logging::log_levels::error,
+                                            "Game");
+            return false;
+        }
+
+        this->_fixed_timestep = fixed_timestep(settings);
+
+        this->_log_manager->log_message("Running " + std::to_string(settings.ticks_per_second) + " ticks per second.",
+                                        apis::logging::log_levels::info,
+                                        "Game");
+
+        return true;
+    }
+
+    bool game_manager::set_frame_limiter_settings(const frame_limiter_settings& logic_settings,
+                                                  const frame_limiter_settings& graphics_settings) noexcept {
+        if (logic_settings.spin_time.count() < 0 || graphics_settings.spin_time.count() < 0) {
+            this->_log_manager->log_message("Invalid frame limiter settings.",
+                                            apis::logging::log_levels::error,
+                                            "Game");
+            return false;
+        }
+
+        this->_logic_frame_limiter = frame_limiter(logic_settings);
+        this->_graphics_frame_limiter_settings = graphics_settings;
+
+        auto to_string = [](const frame_limiter_settings& settings) {
+            return (settings.frames_per_second > 0u ? std::to_string(settings.frames_per_second) : std::string("unlimited")) +
+                   (settings.is_adaptive ? " (adaptive)" : "");
+        };
+
+        this->_log_manager->log_message("Limiting frames per second to logic: " + to_string(logic_settings) +
+                                        ", graphics: " + to_string(graphics_settings) + ".",
+                                        apis::logging::log_levels::info,
+                                        "Game");
+
+        return true;
+    }
+
+    void game_manager::apply_thread_config() noexcept {
+        auto& job_system = jobs::get_job_system();
+
+        auto log_layout = [this](thread_roles role, const std::string& suffix) {
+            this->_log_manager->log_message("Thread layout - " + std::string(to_string(role)) + suffix + ": " +
+                                            platform::to_string(this->_thread_config.get_settings(role)) + ".",
+                                            apis::logging::log_levels::info,
+                                            "Game");
+        };
+
+        auto log_failure = [this](thread_roles role) {
+            this->_log_manager->log_message("Failed to apply some of the " + std::string(to_string(role)) +
+                                            " thread settings. Raising a priority may need more privileges.",
+                                            apis::logging::log_levels::warning,
+                                            "Game");
+        };
+
+        log_layout(thread_roles::logic, "");
+
+        if (this->_graphics_manager->run_on_separate_thread()) {
+            log_layout(thread_roles::graphics, "");
+        }
+
+        log_layout(thread_roles::job_worker, " (x" + std::to_string(job_system.get_number_of_workers()) + ")");
+
+        if (!job_system.set_worker_thread_settings(this->_thread_config.get_settings(thread_roles::job_worker))) {
+            log_failure(thread_roles::job_worker);
+        }
+
+        if (!platform::apply_thread_settings(this->_thread_config.get_settings(thread_roles::logic))) {
+            log_failure(thread_roles::logic);
+        }
+    }
+
     bool game_manager::shutdown() noexcept {
         this->_log_manager->log_message("Shutting down the game manager...",
                                         apis::logging::log_levels::info,
                                         "Game");
 
+        if (memory::is_allocation_sampling_enabled()) {
+            this->_log_manager->log_message(memory::get_allocation_sampling_report(game_manager::allocation_report_number_of_sites),
+                                            apis::logging::log_levels::info,
+                                            "Memory");
+        }
+
         this->_log_manager->log_message("Shut down the game manager.",
                                         apis::logging::log_levels::info,
                                         "Game");
@@ -118,35 +274,111 @@ namespace pbr::shared::game {
     }
 
     void game_manager::exit_frame() noexcept {
-        auto now = std::chrono::system_clock::now();
+        auto now = std::chrono::steady_clock::now();
+        auto frame_time = now - this->_last_frame_time;
 
-        auto last_frame_duration = now - this->_last_frame_time;
-        this->_counter_set.add_value_to_list("average_frame_time",
-                                             std::chrono::duration_cast<std::chrono::milliseconds>(last_frame_duration).count());
+        this->_frame_phase_timings.record(frame_phases::frame, frame_time, now);
 
-        this->_counter_set.increment_counter("fps", 1);
+        if (this->_logic_spike_detector && this->_logic_spike_detector->record_frame(frame_time, now)) {
+            this->_log_manager->log_message("Captured a logic frame spike of " +
+                                            std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(frame_time).count()) +
+                                            "ms.",
+                                            apis::logging::log_levels::warning,
+                                            "Game");
+        }
+
+        this->_counter_set.increment_counter(this->_fps_counter, 1);
 
         this->_last_frame_time = now;
 
+        if (diagnostics::is_tracing_enabled()) {
+            diagnostics::trace_counter("allocated_bytes",
+                                       static_cast<int64_t>(memory::get_number_of_allocated_bytes().get_value()));
+        }
+
         this->_counter_set.get_counter_for_duration("fps",
                                                     std::chrono::seconds(1),
                                                     this->_fps);
 
-        this->_counter_set.get_average_for_duration("average_frame_time",
-                                                    std::chrono::seconds(1),
-                                                    this->_average_frame_time);
+        memory::check_allocation_budgets([this](memory::allocation_tag tag,
+                                                memory::bytes live_bytes,
+                                                memory::megabytes budget) {
+            this->_log_manager->log_message("Allocation budget exceeded for `" + std::string(memory::to_string(tag)) +
+                                            "`: " + std::to_string(memory::megabytes(live_bytes).get_value()) +
+                                            "MB used of " + std::to_string(budget.get_value()) + "MB.",
+                                            apis::logging::log_levels::warning,
+                                            "Memory");
+        });
+
+        this->log_frame_timings(now);
+        this->publish_metrics(now);
 
         //this->_log_manager->log_message("FPS: " + std::to_string(this->_fps), apis::logging::log_levels::info);
-        //this->_log_manager->log_message("Average Frame Time: " + std::to_string(this->_average_frame_time), apis::logging::log_levels::info);
         //this->_log_manager->log_message("Frame...", apis::logging::log_levels::info);
     }
 
+    void game_manager::log_frame_timings(std::chrono::steady_clock::time_point now) noexcept {
+        if (now - this->_last_frame_timings_log_time < game_manager::frame_timings_log_interval) {
+            return;
+        }
+
+        this->_last_frame_timings_log_time = now;
+
+        auto jitter = this->_logic_frame_limiter.get_jitter_statistics(now);
+        auto overruns = this->_logic_frame_limiter.get_overrun_statistics(now);
+
+        auto message = "Frame timings: logic [" + this->_frame_phase_timings.get_summary() +
+                       " jitter p99 " + std::to_string(std::chrono::duration_cast<std::chrono::microseconds>(jitter.p99).count()) +
+                       "us overruns " + std::to_string(overruns.count) + "]";
+
+        if (auto graphics_timings = this->_graphics_manager->get_frame_phase_timings()) {
+            message += " graphics [" + graphics_timings->get_summary() + "]";
+        }
+
+        this->_log_manager->log_message(message,
+                                        apis::logging::log_levels::info,
+                                        "Game");
+    }
+
+    void game_manager::publish_metrics(std::chrono::steady_clock::time_point now) noexcept {
+        if (now - this->_last_metrics_publish_time < game_manager::metrics_publish_interval) {
+            return;
+        }
+
+        this->_last_metrics_publish_time = now;
+
+        auto& registry = diagnostics::get_counter_registry();
+
+        static const auto fps_gauge = registry.register_counter("fps");
+        registry.set(fps_gauge, this->_fps);
+
+        static const auto ticks_counter = registry.register_counter("logic_ticks");
+        static const auto dropped_ticks_counter = registry.register_counter("logic_dropped_ticks");
+        registry.set(ticks_counter, static_cast<int64_t>(this->_fixed_timestep.get_number_of_ticks()));
+        registry.set(dropped_ticks_counter, static_cast<int64_t>(this->_fixed_timestep.get_number_of_dropped_ticks()));
+
+        this->_frame_phase_timings.publish("logic");
+        this->_logic_frame_limiter.publish("logic", now);
+
+        if (auto graphics_timings = this->_graphics_manager->get_frame_phase_timings()) {
+            graphics_timings->publish("graphics");
+        }
+
+        diagnostics::publish_thread_allocation_statistics("logic");
+    }
+
     bool game_manager::update_frame() noexcept {
-        if (!this->_window_manager->update()) {
-            this->_log_manager->log_message("Failed to update window manager.",
-                                            apis::logging::log_levels::error,
-                                            "Game");
-            return false;
+        diagnostics::trace_zone trace_zone("update_frame");
+
+        {
+            diagnostics::scoped_phase_timer phase_timer(this->_frame_phase_timings, frame_phases::window_events);
+
+            if (!this->_window_manager->update()) {
+                this->_log_manager->log_message("Failed to update window manager.",
+                                                apis::logging::log_levels::error,
+                                                "Game");
+                return false;
+            }
         }
 
         if (this->_window_manager->should_quit()) {
@@ -154,6 +386,15 @@ namespace pbr::shared::game {
             return true;
         }
 
+        jobs::get_job_system().run_main_thread_jobs();
+
+        return true;
+    }
+
+    bool game_manager::run_tick() noexcept {
+        diagnostics::trace_zone trace_zone("tick");
+        diagnostics::scoped_phase_timer phase_timer(this->_frame_phase_timings, frame_phases::scene);
+
         if (!this->_scene_manager->run()) {
             this->_log_manager->log_message("Failed to run scene manager.",
                                             apis::logging::log_levels::error,
@@ -161,18 +402,140 @@ namespace pbr::shared::game {
             return false;
         }
 
+        // keep the entities of the last two ticks, reusing the older tick's memory for the new one
+        std::swap(this->_previous_tick_entities, this->_current_tick_entities);
+        this->_current_tick_entities.clear();
+
+        this->_scene_manager->submit_renderable_entities(this->_current_tick_entities);
+
+        this->_has_tick_run_since_synchronize = true;
+
         return true;
     }
 
     void game_manager::synchronize_frame() noexcept {
-        apis::graphics::renderable_entities renderable_entities;
-        this->_graphics_manager->submit_renderable_entities(renderable_entities);
+        diagnostics::trace_zone trace_zone("synchronize_frame");
+        diagnostics::scoped_phase_timer phase_timer(this->_frame_phase_timings, frame_phases::synchronize);
+
+        // the graphics manager keeps the last entities submitted, so they are only copied when
+        // there are new ones
+        if (!this->_has_tick_run_since_synchronize) {
+            return;
+        }
+
+        this->_has_tick_run_since_synchronize = false;
+
+        // the entities are filled in place, and the buffer keeps its memory between frames
+        auto& renderable_entities = this->_graphics_manager->get_next_renderable_entities();
+        renderable_entities.clear();
+
+        for (const auto& entity : this->_previous_tick_entities.get_2d_renderable_entities()) {
+            renderable_entities.submit_previous(entity);
+        }
+
+        for (const auto& entity : this->_current_tick_entities.get_2d_renderable_entities()) {
+            renderable_entities.submit(entity);
+        }
+
+        // the renderer works out how far each frame is between the ticks when it renders it, as it
+        // may render many frames before the next tick is synchronized
+        renderable_entities.set_tick_timing(this->_fixed_timestep.get_last_tick_time(),
+                                            this->_fixed_timestep.get_tick_duration());
+
+        this->_graphics_manager->submit_renderable_entities();
+
+        this->_synchronized_next_tick_time = this->_fixed_timestep.get_next_tick_time().time_since_epoch().count();
+
+        ++this->_number_of_synchronized_frames;
+        this->_number_of_synchronized_frames.notify_one();
+    }
+
+    void game_manager::wait_for_next_frame() noexcept {
+        diagnostics::trace_zone trace_zone("wait_for_next_frame");
+        diagnostics::scoped_phase_timer phase_timer(this->_frame_phase_timings, frame_phases::wait);
+
+        if (this->_graphics_manager->run_on_separate_thread() || !this->_graphics_manager->renders_frames()) {
+            // nothing is rendered on this thread, so there is nothing to do until the next tick is
+            // due, or a window event arrives, so input is handled as it arrives rather than once a
+            // tick. The events are waited for until shortly before the tick, as they are waited
+            // for less precisely than the frame limiter waits
+            auto next_tick_time = this->_fixed_timestep.get_next_tick_time();
+
+            if (this->_window_manager->wait_for_events(next_tick_time - this->_logic_frame_limiter.get_settings().spin_time)) {
+                return;
+            }
+
+            this->_logic_frame_limiter.wait_until(next_tick_time);
+        } else {
+            this->_logic_frame_limiter.wait_for_next_frame();
+        }
     }
 
     void game_manager::run_graphics_manager(std::shared_ptr<apis::graphics::igraphics_manager> graphics_manager,
-                                            std::atomic_bool& has_exit_been_requested) noexcept {
+                                            std::atomic_bool& has_exit_been_requested,
+                                            diagnostics::spike_detector* spike_detector,
+                                            frame_limiter_settings limiter_settings,
+                                            std::atomic_uint64_t& number_of_synchronized_frames,
+                                            std::atomic_int64_t& synchronized_next_tick_time,
+                                            platform::thread_settings thread_settings,
+                                            std::shared_ptr<apis::logging::ilog_manager> log_manager) noexcept {
+        memory::scoped_allocation_tag allocation_tag(memory::allocation_tag::graphics);
+
+        diagnostics::set_trace_thread_name("Graphics");
+        diagnostics::register_sampling_profiler_thread("Graphics");
+
+        if (!platform::apply_thread_settings(thread_settings)) {
+            log_manager->log_message("Failed to apply some of the graphics thread settings. Raising a priority may need more privileges.",
+                                     apis::logging::log_levels::warning,
+                                     "Game");
+        }
+
+        frame_limiter limiter(limiter_settings);
+        uint64_t last_rendered_frame {0u};
+
+        auto last_frame_time = std::chrono::steady_clock::now();
+        auto last_metrics_publish_time = last_frame_time;
+
         while (!has_exit_been_requested) {
-            graphics_manager->submit_frame_for_render();
+            if (limiter_settings.is_adaptive) {
+                // the frames rendered between the ticks interpolate between them, but once the
+                // next tick is due, rendering the same frame again would look the same, so give
+                // up the core until there is a new one
+                auto next_tick_time = std::chrono::steady_clock::time_point(
+                    std::chrono::steady_clock::duration(synchronized_next_tick_time.load()));
+
+                if (number_of_synchronized_frames.load() == last_rendered_frame &&
+                    std::chrono::steady_clock::now() >= next_tick_time) {
+                    diagnostics::trace_zone trace_zone("wait_for_synchronized_frame", "graphics");
+
+                    number_of_synchronized_frames.wait(last_rendered_frame);
+
+                    if (has_exit_been_requested) {
+                        break;
+                    }
+                }
+
+                last_rendered_frame = number_of_synchronized_frames.load();
+            }
+
+            {
+                diagnostics::trace_zone frame_trace_zone("frame", "graphics");
+
+                graphics_manager->submit_frame_for_render();
+            }
+
+            auto now = limiter.wait_for_next_frame();
+
+            if (spike_detector) {
+                spike_detector->record_frame(now - last_frame_time, now);
+            }
+
+            last_frame_time = now;
+            if (now - last_metrics_publish_time >= game_manager::metrics_publish_interval) {
+                diagnostics::publish_thread_allocation_statistics("graphics");
+                limiter.publish("graphics", now);
+                last_metrics_publish_time = now;
+            }
         }
     }
 }
@@ -1,12 +1,19 @@
 #pragma once
 
 #include "shared/memory/basic_allocators.h"
+#include "shared/memory/allocation_tags.h"
+#include "shared/memory/allocation_sampler.h"
 #include "shared/apis/logging/ilog_manager.h"
 #include "shared/apis/windowing/iwindow_manager.h"
 #include "shared/apis/graphics/igraphics_manager.h"
 #include "shared/apis/windowing/iapplication_window.h"
 #include "shared/scene/iscene_manager.h"
 #include "shared/diagnostics/counter_set.h"
+#include "shared/diagnostics/phase_timings.h"
+#include "shared/diagnostics/spike_detector.h"
+#include "fixed_timestep.h"
+#include "frame_limiter.h"
+#include "thread_config.h"
 
 #include <cassert>
 #include <memory>
@@ -19,6 +26,9 @@ namespace pbr::shared::game {
     /// Provides the skeleton of the game. The managers to be used are first configured and then added
     /// to this manager. Both the client and server will use this manager. The game loop and threads are
     /// all handled here.
+    /// The scenes are run in ticks at a fixed rate, separate from the frame rate. Each frame runs as
+    /// many ticks as are due, which may be none, and the graphics manager is handed the entities of
+    /// the last two ticks, along with their timing, for its renderer to interpolate between
     class game_manager {
     public:
         /// Constructs this manager
@@ -52,15 +62,11 @@ namespace pbr::shared::game {
             }
         }
 
-        /// Move constructor
-        /// \param The other game manager
-        game_manager(game_manager&& other) {
-            this->_log_manager = std::move(other._log_manager);
-            this->_window_manager = std::move(other._window_manager);
-            this->_graphics_manager = std::move(other._graphics_manager);
-            this->_has_exit_been_requested = other._has_exit_been_requested.load();
-        }
         game_manager(const game_manager&) = delete;
+        game_manager(game_manager&&) = delete;
+
+        game_manager& operator = (const game_manager&) = delete;
+        game_manager& operator = (game_manager&&) = delete;
 
         /// Initializes the game
         /// \returns `true` upon success, else `false`
@@ -73,7 +79,65 @@ namespace pbr::shared::game {
         [[nodiscard]]
         bool run() noexcept;
 
+        /// Captures frame spikes on the logic loop, and on the graphics loop if it runs on a separate
+        /// thread. Tracing should be enabled in ring mode, so each capture holds the events leading
+        /// up to its spike. This must be called before `run`
+        /// \param settings The settings of the spike detectors
+        /// \returns `true` upon success, else `false`
+        [[nodiscard]]
+        bool enable_spike_detection(const diagnostics::spike_detector_settings& settings) noexcept;
+
+        /// Sets the rate the scenes are run at. This must be called before `run`
+        /// \param settings The settings of the fixed timestep
+        /// \returns `true` upon success, else `false` if the settings are invalid
+        [[nodiscard]]
+        bool set_fixed_timestep_settings(const fixed_timestep_settings& settings) noexcept;
+
+        /// Sets how fast the loops run. When the graphics manager renders on the logic thread, the
+        /// logic loop runs at the logic frame rate. Otherwise, the logic loop only runs when a tick
+        /// is due, and the graphics loop, if any, runs at the graphics frame rate. This must be
+        /// called before `run`
+        /// \param logic_settings The settings of the logic loop's frame limiter
+        /// \param graphics_settings The settings of the graphics loop's frame limiter
+        /// \returns `true` upon success, else `false` if the settings are invalid
+        [[nodiscard]]
+        bool set_frame_limiter_settings(const frame_limiter_settings& logic_settings,
+                                        const frame_limiter_settings& graphics_settings) noexcept;
+
+        /// Sets the names, CPU affinities and scheduling of the logic and graphics threads, and of
+        /// the job system's workers. They are applied, and the thread layout logged, when `run` is
+        /// called. This must be called before `run`
+        /// \param config The threading config
+        void set_thread_config(thread_config config) noexcept {
+            this->_thread_config = std::move(config);
+        }
+
     private:
+        /// The number of allocation sites listed in each section of the allocation sampling report
+        static constexpr size_t allocation_report_number_of_sites {20u};
+
+        /// How often the frame timings are logged
+        static constexpr std::chrono::seconds frame_timings_log_interval {5};
+
+        /// How often the frame metrics are published to the global counter registry
+        static constexpr std::chrono::seconds metrics_publish_interval {1};
+
+        /// The phases of a frame
+        enum frame_phases : size_t {
+            /// The whole frame, from the end of one frame to the end of the next
+            frame,
+            /// Pumping the window events
+            window_events,
+            /// Running the scenes for a tick
+            scene,
+            /// Synchronizing data with other threads
+            synchronize,
+            /// Submitting the frame for render, when the graphics manager runs on this thread
+            submit,
+            /// Waiting for the next frame
+            wait,
+        };
+
         /// The path of the main executable
         std::filesystem::path _executable_path;
 
@@ -96,16 +160,68 @@ namespace pbr::shared::game {
         std::atomic_bool _has_exit_been_requested { false };
 
         /// Counts FPS and other diagnostic things
-        diagnostics::counter_set _counter_set;
+        diagnostics::counter_set _counter_set {_log_manager};
+
+        /// The handle of the counter counting frames for the FPS
+        diagnostics::counter_handle _fps_counter {_counter_set.register_counter("fps")};
 
         /// The FPS
         int _fps {0};
 
-        /// The average frame time in ms
-        float _average_frame_time {0.0f};
+        /// The times taken by each phase of a frame, indexed by `frame_phases`
+        diagnostics::phase_timings _frame_phase_timings {{
+            "frame",
+            "window_events",
+            "scene",
+            "synchronize",
+            "submit",
+            "wait",
+        }};
 
         /// The time the last frame ended
-        std::chrono::system_clock::time_point _last_frame_time;
+        std::chrono::steady_clock::time_point _last_frame_time;
+
+        /// The time the frame timings were last logged
+        std::chrono::steady_clock::time_point _last_frame_timings_log_time;
+
+        /// The time the frame metrics were last published
+        std::chrono::steady_clock::time_point _last_metrics_publish_time;
+
+        /// Decides when the scenes are run
+        fixed_timestep _fixed_timestep;
+
+        /// Paces the logic loop
+        frame_limiter _logic_frame_limiter;
+
+        /// The settings of the graphics loop's frame limiter, which is created on the graphics thread
+        frame_limiter_settings _graphics_frame_limiter_settings;
+
+        /// The number of frames synchronized with the graphics thread. The graphics thread waits on
+        /// this when its frame limiter is adaptive
+        std::atomic_uint64_t _number_of_synchronized_frames {0u};
+
+        /// The time the tick after the last synchronized frame's tick is due, as the count of the
+        /// clock's time since its epoch. The synchronized frame has been interpolated up to its
+        /// tick by this time
+        std::atomic_int64_t _synchronized_next_tick_time {0};
+
+        /// The settings of the engine's threads
+        thread_config _thread_config;
+
+        /// The entities of the tick before the last tick
+        apis::graphics::renderable_entities _previous_tick_entities;
+
+        /// The entities of the last tick
+        apis::graphics::renderable_entities _current_tick_entities;
+
+        /// Has a tick run since the entities were last submitted to the graphics manager?
+        bool _has_tick_run_since_synchronize {false};
+
+        /// Captures spikes in the logic loop's frame times, else `nullptr` if spike detection is disabled
+        std::unique_ptr<diagnostics::spike_detector> _logic_spike_detector;
+
+        /// Captures spikes in the graphics loop's frame times, else `nullptr` if spike detection is disabled
+        std::unique_ptr<diagnostics::spike_detector> _graphics_spike_detector;
 
         /// Shuts down the game
         /// \returns `true` upon success, else `false`
@@ -121,22 +237,61 @@ namespace pbr::shared::game {
         /// Exists a frame
         void exit_frame() noexcept;
 
-        /// Updates any frame logic
+        /// Logs the frame timings of this thread and of the graphics manager, if
+        /// `frame_timings_log_interval` has passed since they were last logged
+        /// \param now The current time
+        void log_frame_timings(std::chrono::steady_clock::time_point now) noexcept;
+
+        /// Publishes the FPS, the frame timings and the allocation statistics of this thread to the
+        /// global counter registry, if `metrics_publish_interval` has passed since they were last
+        /// published. This keeps the metrics exporter from having to read them from the hot path
+        /// \param now The current time
+        void publish_metrics(std::chrono::steady_clock::time_point now) noexcept;
+
+        /// Updates any frame logic, such as pumping the window events
         /// \returns `true` upon success, else `false`
         [[nodiscard]]
         bool update_frame() noexcept;
 
-        /// Synchronizes data with other threads, such as submitting renderable entities to
-        /// the graphics manager
+        /// Runs the scenes for a tick, then keeps the entities of the scenes' new state
+        /// \returns `true` upon success, else `false`
+        [[nodiscard]]
+        bool run_tick() noexcept;
+
+        /// Synchronizes data with other threads, such as submitting the entities of the last two
+        /// ticks to the graphics manager. The entities are only submitted when a tick has run since
+        /// they were last submitted, as the graphics manager keeps rendering the latest ones
         void synchronize_frame() noexcept;
 
+        /// Waits until the logic loop's next frame is due. When nothing is rendered on this thread, a
+        /// window event arriving also ends the wait
+        void wait_for_next_frame() noexcept;
+
+        /// Applies the threading config to the job system's workers and the calling thread, the
+        /// logic thread, and logs the thread layout. Threads inherit the affinity and scheduling of
+        /// the thread that creates them, so this should be called after any other threads are started
+        void apply_thread_config() noexcept;
+
         /// Runs the graphics manager on a separate thread.
         /// This function will only exit if `_has_exit_been_requested` is `true`.
         /// All access to the graphics manager should only occur after `enter_synchronize_frame()`
         /// is called and before `exit_synchronize_frame()` is called.
         /// \param graphics_manager The graphics manager to run
         /// \param has_exit_been_requested Will be set to `true` if this thread should exit
+        /// \param spike_detector Captures spikes in the frame times, else `nullptr` if spike detection is disabled
+        /// \param limiter_settings The settings of the frame limiter pacing the frames
+        /// \param number_of_synchronized_frames The number of frames the logic loop has synchronized
+        /// \param synchronized_next_tick_time The time the tick after the last synchronized frame's
+        /// tick is due
+        /// \param thread_settings The settings of this thread
+        /// \param log_manager The log manager to use
         static void run_graphics_manager(std::shared_ptr<apis::graphics::igraphics_manager> graphics_manager,
-                                         std::atomic_bool& has_exit_been_requested) noexcept;
+                                         std::atomic_bool& has_exit_been_requested,
+                                         diagnostics::spike_detector* spike_detector,
+                                         frame_limiter_settings limiter_settings,
+                                         std::atomic_uint64_t& number_of_synchronized_frames,
+                                         std::atomic_int64_t& synchronized_next_tick_time,
+                                         platform::thread_settings thread_settings,
+                                         std::shared_ptr<apis::logging::ilog_manager> log_manager) noexcept;
     };
 }
@@ -0,0 +1,94 @@
+#include "thread_config.h"
+
+namespace pbr::shared::game {
+    const std::filesystem::path thread_config::threading_config_path = "threading/config";
+
+    std::string_view to_string(thread_roles role) noexcept {
+        switch (role) {
+            case thread_roles::logic: return "logic";
+            case thread_roles::graphics: return "graphics";
+            case thread_roles::job_worker: return "job_worker";
+        }
+
+        return "unknown";
+    }
+
+    /// Reads the settings of a thread role, overwriting the settings that are present
+    /// \param role_settings The settings of the role to read from
+    /// \param thread_settings The thread settings to read into
+    /// \returns `true` upon success, else `false` if a setting is invalid
+    static bool read_thread_settings(data::settings& role_settings, platform::thread_settings& thread_settings) noexcept {
+        if (auto name = role_settings.get("name"); name && !name->empty()) {
+            thread_settings.name = *name;
+        }
+
+        if (auto cpus = role_settings.get("cpus"); cpus && !cpus->empty()) {
+            auto parsed_cpus = platform::parse_cpu_list(*cpus);
+            if (!parsed_cpus) {
+                return false;
+            }
+
+            thread_settings.cpus = std::move(*parsed_cpus);
+        }
+
+        if (auto policy = role_settings.get("policy"); policy && !policy->empty()) {
+            thread_settings.policy = platform::parse_thread_scheduling_policy(*policy);
+            if (!thread_settings.policy) {
+                return false;
+            }
+        }
+
+        if (auto priority = role_settings.get("priority"); priority && !priority->empty()) {
+            auto parsed_priority = role_settings.get_as_int("priority");
+            if (!parsed_priority) {
+                return false;
+            }
+
+            thread_settings.priority = *parsed_priority;
+        }
+
+        return platform::are_thread_settings_valid(thread_settings);
+    }
+
+    thread_config::thread_config() {
+        // the logic thread is usually the main thread, whose name is the name of the process, so it
+        // is only renamed if the config names it
+        this->_settings[static_cast<size_t>(thread_roles::graphics)].name = "Graphics";
+        this->_settings[static_cast<size_t>(thread_roles::job_worker)].name = "Job Worker";
+    }
+
+    bool thread_config::load(const std::shared_ptr<data::data_manager>& data_manager,
+                             const std::shared_ptr<apis::logging::ilog_manager>& log_manager,
+                             const std::filesystem::path& config_path) noexcept {
+
+        assert((data_manager));
+        assert((log_manager));
+
+        auto settings = data_manager->read_settings(config_path);
+        if (!settings) {
+            log_manager->log_message("Failed to read threading config settings at path: " +
+                                     config_path.generic_string(),
+                                     apis::logging::log_levels::error,
+                                     "Threading");
+            return false;
+        }
+
+        for (size_t i {0u}; i < number_of_thread_roles; ++i) {
+            auto role = static_cast<thread_roles>(i);
+
+            auto role_settings = settings->get_as_settings(std::string(to_string(role)));
+            if (!role_settings) {
+                continue;
+            }
+
+            if (!read_thread_settings(*role_settings, this->_settings[i])) {
+                log_manager->log_message("Invalid " + std::string(to_string(role)) + " thread settings in the threading config.",
+                                         apis::logging::log_levels::error,
+                                         "Threading");
+                return false;
+            }
+        }
+
+        return true;
+    }
+}
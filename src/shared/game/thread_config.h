@@ -0,0 +1,99 @@
+#pragma once
+
+#include "shared/data/data_manager.h"
+#include "shared/apis/logging/ilog_manager.h"
+#include "shared/platform/thread.h"
+
+#include <array>
+#include <cassert>
+#include <memory>
+#include <exception>
+#include <string_view>
+
+namespace pbr::shared::game {
+    /// The roles of the engine's threads
+    enum class thread_roles : size_t {
+        /// The thread running the logic loop
+        logic,
+
+        /// The thread running the graphics loop, when the graphics manager runs on a separate thread
+        graphics,
+
+        /// Each of the job system's workers, which also load the scenes
+        job_worker,
+    };
+
+    /// The number of thread roles
+    constexpr size_t number_of_thread_roles {3u};
+
+    /// Returns the name of a thread role, as used in the config
+    /// \param role The role
+    /// \returns The name of the role
+    [[nodiscard]]
+    std::string_view to_string(thread_roles role) noexcept;
+
+    /// The threading configuration settings, which set the name, CPU affinity and scheduling of
+    /// each of the engine's threads. Roles the config does not set keep their default settings,
+    /// which only name the graphics thread and the job workers
+    class thread_config final {
+    public:
+        /// Creates the config with the default settings
+        thread_config();
+
+        /// Creates the config
+        /// \param data_manager The data manager
+        /// \param log_manager The log manager
+        /// \param config_path The path to the config file from the data path configured in the data manager
+        thread_config(std::shared_ptr<data::data_manager> data_manager,
+                      std::shared_ptr<apis::logging::ilog_manager> log_manager,
+                      std::filesystem::path config_path = thread_config::threading_config_path)
+            : thread_config() {
+            assert((data_manager));
+
+            if (!this->load(data_manager, log_manager, config_path)) {
+                log_manager->log_message("Failed to load threading config.",
+                                         apis::logging::log_levels::error,
+                                         "Threading");
+
+                throw std::runtime_error("Invalid threading config.");
+            }
+        }
+
+        /// Returns if there is a threading config, as the config is optional
+        /// \param data_manager The data manager
+        /// \param config_path The path to the config file from the data path configured in the data manager
+        /// \returns `true` if there is a config, else `false`
+        [[nodiscard]]
+        static bool has_config(const std::shared_ptr<data::data_manager>& data_manager,
+                               const std::filesystem::path& config_path = thread_config::threading_config_path) noexcept {
+            assert((data_manager));
+
+            return data_manager->has_settings(config_path);
+        }
+
+        /// Returns the settings of a thread role
+        /// \param role The role
+        /// \returns The settings of the role
+        [[nodiscard]]
+        const platform::thread_settings& get_settings(thread_roles role) const noexcept {
+            return this->_settings[static_cast<size_t>(role)];
+        }
+
+    private:
+        /// The path to the threading config
+        static const std::filesystem::path threading_config_path;
+
+        /// Loads the settings from the passed data manager
+        /// \param data_manager The data manager
+        /// \param log_manager The log manager
+        /// \param config_path The path to the config file from the data path configured in the data manager
+        /// \returns `true` upon success, else `false`
+        [[nodiscard]]
+        bool load(const std::shared_ptr<data::data_manager>& data_manager,
+                  const std::shared_ptr<apis::logging::ilog_manager>& log_manager,
+                  const std::filesystem::path& config_path) noexcept;
+
+        /// The settings of each role, indexed by the role
+        std::array<platform::thread_settings, number_of_thread_roles> _settings;
+    };
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <functional>
+
+namespace pbr::shared::jobs {
+    class job_counter;
+
+    /// The function a job runs
+    using job_function = std::function<void()>;
+
+    /// A unit of work queued on the job system
+    struct job {
+        /// The function to run
+        job_function function;
+
+        /// The counter to decrement once the function has run, else `nullptr`
+        job_counter* counter {nullptr};
+    };
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "job.h"
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace pbr::shared::jobs {
+    /// Counts the jobs that have been run with it and have not finished yet. A counter is passed
+    /// when running jobs, then waited on with `job_system::wait`, or used as the dependency of
+    /// other jobs with `job_system::run_after`. A counter must not be destroyed until it has been
+    /// waited on, or until every job run with it has finished and been waited on through another
+    /// counter
+    class job_counter {
+    public:
+        job_counter() = default;
+        ~job_counter() = default;
+
+        job_counter(const job_counter&) = delete;
+        job_counter(job_counter&&) = delete;
+
+        job_counter& operator = (const job_counter&) = delete;
+        job_counter& operator = (job_counter&&) = delete;
+
+        /// Returns if every job run with this counter has finished
+        /// \returns `true` if every job run with this counter has finished, else `false`
+        [[nodiscard]]
+        bool is_complete() const noexcept {
+            return this->_count.load(std::memory_order_acquire) == 0u;
+        }
+
+        /// Returns the number of jobs run with this counter that have not finished
+        /// \returns The number of jobs run with this counter that have not finished
+        [[nodiscard]]
+        uint32_t get_count() const noexcept {
+            return this->_count.load(std::memory_order_acquire);
+        }
+
+    private:
+        friend class job_system;
+
+        /// The number of jobs that have not finished
+        std::atomic_uint32_t _count {0u};
+
+        /// Protects `_continuations`, and is held while the count reaches `0`, so a waiting
+        /// thread can tell when the finishing thread has stopped using this counter
+        std::mutex _mutex;
+
+        /// The jobs to run once the count reaches `0`
+        std::vector<job*> _continuations;
+    };
+}
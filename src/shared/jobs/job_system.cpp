@@ -0,0 +1,546 @@
+#include "job_system.h"
+#include "shared/diagnostics/sampling_profiler.h"
+#include "shared/diagnostics/tracer.h"
+
+#include <algorithm>
+#include <exception>
+#include <string>
+
+namespace pbr::shared::jobs {
+    /// The job system of the calling thread's worker, else `nullptr` if it is not a worker
+    static thread_local const job_system* t_job_system {nullptr};
+
+    /// The index of the calling thread's worker in `t_job_system`
+    static thread_local size_t t_worker_index {0u};
+
+    job_system::job_system(job_system_settings settings)
+        : _settings(settings),
+          _main_thread_id(std::this_thread::get_id()) {
+    }
+
+    job_system::~job_system() {
+        this->stop();
+
+        // run anything queued without workers, or left for the main thread
+        while (auto* job = this->take_job(job_system::not_a_worker)) {
+            this->execute(job);
+        }
+
+        while (auto* job = this->take_main_thread_job()) {
+            this->execute(job);
+        }
+    }
+
+    bool job_system::start() noexcept {
+        if (!this->_workers.empty()) {
+            return false;
+        }
+
+        auto number_of_workers = this->_settings.number_of_workers;
+        if (number_of_workers == 0u) {
+            number_of_workers = std::max(std::thread::hardware_concurrency(), 2u) - 1u;
+        }
+
+        try {
+            this->_should_stop = false;
+
+            // create every deque before starting the threads, as the threads steal from each other
+            this->_workers.resize(number_of_workers);
+
+            for (auto& worker : this->_workers) {
+                worker.deque = std::make_unique<work_stealing_deque>(this->_settings.deque_capacity);
+            }
+
+            for (size_t i {0u}; i < this->_workers.size(); ++i) {
+                this->_workers[i].thread = std::thread(&job_system::run_worker, this, i);
+            }
+        } catch (...) {
+            this->stop();
+            return false;
+        }
+
+        return true;
+    }
+
+    void job_system::stop() noexcept {
+        {
+            std::scoped_lock<std::mutex> lock(this->_sleep_mutex);
+            this->_should_stop = true;
+        }
+
+        this->_sleep_condition.notify_all();
+
+        // stopped workers do not apply settings, so stop waiting for them
+        {
+            std::scoped_lock<std::mutex> lock(this->_worker_thread_settings_mutex);
+        }
+
+        this->_worker_thread_settings_condition.notify_all();
+
+        for (auto& worker : this->_workers) {
+            if (worker.thread.joinable()) {
+                worker.thread.join();
+            }
+        }
+
+        this->_workers.clear();
+    }
+
+    bool job_system::set_worker_thread_settings(const platform::thread_settings& settings) noexcept {
+        std::unique_lock<std::mutex> lock(this->_worker_thread_settings_mutex);
+
+        try {
+            this->_settings.worker_thread_settings = settings;
+        } catch (...) {
+            return false;
+        }
+
+        this->_number_of_workers_with_settings = 0u;
+        this->_are_worker_thread_settings_applied = true;
+
+        auto version = ++this->_worker_thread_settings_version;
+
+        // taking the lock means a worker cannot be between checking the version and sleeping
+        {
+            std::scoped_lock<std::mutex> sleep_lock(this->_sleep_mutex);
+        }
+
+        this->_sleep_condition.notify_all();
+
+        this->_worker_thread_settings_condition.wait(lock, [this, version]() {
+            return this->_should_stop ||
+                   this->_worker_thread_settings_version.load() != version ||
+                   this->_number_of_workers_with_settings >= this->_workers.size();
+        });
+
+        return this->_are_worker_thread_settings_applied;
+    }
+
+    void job_system::set_log_manager(std::shared_ptr<apis::logging::ilog_manager> log_manager) noexcept {
+        std::scoped_lock<std::mutex> lock(this->_log_manager_mutex);
+        this->_log_manager = std::move(log_manager);
+    }
+
+    void job_system::set_main_thread() noexcept {
+        this->_main_thread_id = std::this_thread::get_id();
+    }
+
+    bool job_system::is_main_thread() const noexcept {
+        return this->_main_thread_id.load() == std::this_thread::get_id();
+    }
+
+    bool job_system::run(job_function function, job_counter* counter) noexcept {
+        auto* job = job_system::create_job(std::move(function), counter);
+        if (!job) {
+            return false;
+        }
+
+        this->queue(job);
+
+        return true;
+    }
+
+    bool job_system::run_after(job_counter& dependency, job_function function, job_counter* counter) noexcept {
+        auto* job = job_system::create_job(std::move(function), counter);
+        if (!job) {
+            return false;
+        }
+
+        auto is_waiting {false};
+
+        {
+            std::scoped_lock<std::mutex> lock(dependency._mutex);
+
+            // the count only reaches `0` while the lock is held, so the job cannot be missed
+            if (!dependency.is_complete()) {
+                try {
+                    dependency._continuations.push_back(job);
+                    return true;
+                } catch (...) {
+                    is_waiting = true;
+                }
+            }
+        }
+
+        if (is_waiting) {
+            this->wait(dependency);
+        }
+
+        this->queue(job);
+
+        return true;
+    }
+
+    bool job_system::run_on_main_thread(job_function function, job_counter* counter) noexcept {
+        auto* job = job_system::create_job(std::move(function), counter);
+        if (!job) {
+            return false;
+        }
+
+        try {
+            std::scoped_lock<std::mutex> lock(this->_main_thread_queue_mutex);
+            this->_main_thread_queue.push_back(job);
+        } catch (...) {
+            // uncount the job without running it
+            job->function = {};
+            this->execute(job);
+            return false;
+        }
+
+        // the main thread may be sleeping in `wait`
+        this->wake_waiters();
+
+        return true;
+    }
+
+    size_t job_system::run_main_thread_jobs() noexcept {
+        diagnostics::trace_zone trace_zone("job_system::run_main_thread_jobs", "jobs");
+
+        size_t number_of_jobs {0u};
+
+        {
+            std::scoped_lock<std::mutex> lock(this->_main_thread_queue_mutex);
+            number_of_jobs = this->_main_thread_queue.size();
+        }
+
+        // only run the jobs queued so far, so jobs queuing more jobs cannot keep the main thread here
+        for (size_t i {0u}; i < number_of_jobs; ++i) {
+            auto* job = this->take_main_thread_job();
+            if (!job) {
+                return i;
+            }
+
+            this->execute(job);
+        }
+
+        return number_of_jobs;
+    }
+
+    void job_system::wait(job_counter& counter) noexcept {
+        diagnostics::trace_zone trace_zone("job_system::wait", "jobs");
+
+        auto worker_index = this->get_worker_index();
+        auto is_main_thread = this->is_main_thread();
+
+        while (!counter.is_complete()) {
+            auto* job = is_main_thread ? this->take_main_thread_job() : nullptr;
+
+            if (!job) {
+                job = this->take_job(worker_index);
+            }
+
+            if (job) {
+                this->execute(job);
+                continue;
+            }
+
+            // there is nothing to help with, so sleep until the counter completes or a job is queued
+            std::unique_lock<std::mutex> lock(this->_sleep_mutex);
+
+            ++this->_number_of_sleeping_waiters;
+
+            this->_wait_condition.wait(lock, [this, &counter, is_main_thread]() {
+                if (counter.is_complete() || this->_number_of_queued_jobs.load() > 0u) {
+                    return true;
+                }
+
+                if (!is_main_thread) {
+                    return false;
+                }
+
+                std::scoped_lock<std::mutex> main_thread_queue_lock(this->_main_thread_queue_mutex);
+                return !this->_main_thread_queue.empty();
+            });
+
+            --this->_number_of_sleeping_waiters;
+        }
+
+        // the thread finishing the last job may still hold the lock, and the counter must not be
+        // destroyed until it has released it
+        std::scoped_lock<std::mutex> lock(counter._mutex);
+    }
+
+    void job_system::parallel_for(size_t begin,
+                                  size_t end,
+                                  size_t grain_size,
+                                  const std::function<void(size_t, size_t)>& function) noexcept {
+        grain_size = std::max<size_t>(grain_size, 1u);
+
+        job_counter counter;
+
+        for (auto chunk_begin = begin; chunk_begin < end; chunk_begin += std::min(grain_size, end - chunk_begin)) {
+            auto chunk_end = chunk_begin + std::min(grain_size, end - chunk_begin);
+
+            if (!this->run([&function, chunk_begin, chunk_end]() { function(chunk_begin, chunk_end); }, &counter)) {
+                function(chunk_begin, chunk_end);
+            }
+        }
+
+        this->wait(counter);
+    }
+
+    size_t job_system::get_worker_index() const noexcept {
+        return t_job_system == this ? t_worker_index : job_system::not_a_worker;
+    }
+
+    job* job_system::create_job(job_function function, job_counter* counter) noexcept {
+        try {
+            auto* job = new jobs::job { std::move(function), counter };
+
+            if (counter) {
+                counter->_count.fetch_add(1u, std::memory_order_relaxed);
+            }
+
+            return job;
+        } catch (...) {
+            return nullptr;
+        }
+    }
+
+    void job_system::queue(job* job) noexcept {
+        this->_number_of_queued_jobs.fetch_add(1u);
+
+        auto worker_index = this->get_worker_index();
+        auto is_queued {false};
+
+        if (worker_index != job_system::not_a_worker) {
+            is_queued = this->_workers[worker_index].deque->push(job);
+        }
+
+        if (!is_queued) {
+            try {
+                std::scoped_lock<std::mutex> lock(this->_queue_mutex);
+                this->_queue.push_back(job);
+            } catch (...) {
+                this->_number_of_queued_jobs.fetch_sub(1u);
+
+                // nowhere to queue it, so run it now rather than lose it
+                this->execute(job);
+                return;
+            }
+        }
+
+        auto is_worker_sleeping = this->_number_of_sleeping_workers.load() > 0u;
+        auto is_waiter_sleeping = this->_number_of_sleeping_waiters.load() > 0u;
+
+        if (is_worker_sleeping || is_waiter_sleeping) {
+            // taking the lock means a thread cannot be between checking for jobs and sleeping
+            {
+                std::scoped_lock<std::mutex> lock(this->_sleep_mutex);
+            }
+
+            if (is_worker_sleeping) {
+                this->_sleep_condition.notify_one();
+            }
+
+            if (is_waiter_sleeping) {
+                this->_wait_condition.notify_all();
+            }
+        }
+    }
+
+    job* job_system::take_job(size_t worker_index) noexcept {
+        if (worker_index != job_system::not_a_worker) {
+            if (auto* job = this->_workers[worker_index].deque->pop()) {
+                this->_number_of_queued_jobs.fetch_sub(1u);
+                return job;
+            }
+        }
+
+        if (this->_number_of_queued_jobs.load() == 0u) {
+            return nullptr;
+        }
+
+        {
+            std::scoped_lock<std::mutex> lock(this->_queue_mutex);
+
+            if (!this->_queue.empty()) {
+                auto* job = this->_queue.front();
+                this->_queue.pop_front();
+                this->_number_of_queued_jobs.fetch_sub(1u);
+                return job;
+            }
+        }
+
+        // start with the next worker, so thieves spread out over the workers
+        auto number_of_workers = this->_workers.size();
+        auto first_victim = worker_index == job_system::not_a_worker ? 0u : worker_index + 1u;
+
+        for (size_t i {0u}; i < number_of_workers; ++i) {
+            auto victim = (first_victim + i) % number_of_workers;
+            if (victim == worker_index) {
+                continue;
+            }
+
+            if (auto* job = this->_workers[victim].deque->steal()) {
+                this->_number_of_queued_jobs.fetch_sub(1u);
+                return job;
+            }
+        }
+
+        return nullptr;
+    }
+
+    job* job_system::take_main_thread_job() noexcept {
+        std::scoped_lock<std::mutex> lock(this->_main_thread_queue_mutex);
+
+        if (this->_main_thread_queue.empty()) {
+            return nullptr;
+        }
+
+        auto* job = this->_main_thread_queue.front();
+        this->_main_thread_queue.pop_front();
+
+        return job;
+    }
+
+    void job_system::execute(job* job) noexcept {
+        if (job->function) {
+            diagnostics::trace_zone trace_zone("job", "jobs");
+
+            try {
+                job->function();
+            } catch (const std::exception& e) {
+                this->log_failed_job(e.what());
+            } catch (...) {
+                this->log_failed_job("unknown exception");
+            }
+        }
+
+        auto* counter = job->counter;
+        delete job;
+
+        if (!counter) {
+            return;
+        }
+
+        std::vector<jobs::job*> continuations;
+        auto is_complete {false};
+
+        {
+            std::scoped_lock<std::mutex> lock(counter->_mutex);
+
+            if (counter->_count.fetch_sub(1u, std::memory_order_acq_rel) == 1u) {
+                continuations.swap(counter->_continuations);
+                is_complete = true;
+            }
+        }
+
+        if (!is_complete) {
+            return;
+        }
+
+        for (auto* continuation : continuations) {
+            this->queue(continuation);
+        }
+
+        this->wake_waiters();
+    }
+
+    void job_system::wake_waiters() noexcept {
+        // taking the lock means a waiter cannot be between checking its counter and sleeping. This is
+        // not skipped when the number of sleeping waiters is `0`, as that is not ordered with the
+        // count of the counter, so a waiter about to sleep could be missed
+        {
+            std::scoped_lock<std::mutex> lock(this->_sleep_mutex);
+        }
+
+        this->_wait_condition.notify_all();
+    }
+
+    void job_system::log_failed_job(std::string_view reason) noexcept {
+        this->_number_of_failed_jobs.fetch_add(1u, std::memory_order_relaxed);
+
+        std::shared_ptr<apis::logging::ilog_manager> log_manager;
+
+        {
+            std::scoped_lock<std::mutex> lock(this->_log_manager_mutex);
+            log_manager = this->_log_manager;
+        }
+
+        if (!log_manager) {
+            return;
+        }
+
+        try {
+            log_manager->log_message("A job threw an exception: " + std::string(reason) + ".",
+                                     apis::logging::log_levels::error,
+                                     "Jobs");
+        } catch (...) {
+        }
+    }
+
+    void job_system::apply_worker_thread_settings(size_t worker_index, uint64_t& applied_version) noexcept {
+        if (this->_worker_thread_settings_version.load() == applied_version) {
+            return;
+        }
+
+        std::scoped_lock<std::mutex> lock(this->_worker_thread_settings_mutex);
+
+        applied_version = this->_worker_thread_settings_version.load();
+
+        auto is_applied {false};
+
+        try {
+            auto settings = this->_settings.worker_thread_settings;
+            if (!settings.name.empty()) {
+                settings.name += " " + std::to_string(worker_index);
+            }
+
+            is_applied = platform::apply_thread_settings(settings);
+        } catch (...) {
+        }
+
+        if (!is_applied) {
+            this->_are_worker_thread_settings_applied = false;
+        }
+
+        ++this->_number_of_workers_with_settings;
+        this->_worker_thread_settings_condition.notify_all();
+    }
+
+    void job_system::run_worker(size_t worker_index) noexcept {
+        t_job_system = this;
+        t_worker_index = worker_index;
+
+        auto name = "Job Worker " + std::to_string(worker_index);
+        diagnostics::set_trace_thread_name(name);
+        diagnostics::register_sampling_profiler_thread(name);
+
+        uint64_t applied_thread_settings_version {0u};
+
+        while (true) {
+            this->apply_worker_thread_settings(worker_index, applied_thread_settings_version);
+
+            if (auto* job = this->take_job(worker_index)) {
+                this->execute(job);
+                continue;
+            }
+
+            if (this->_should_stop && this->_number_of_queued_jobs.load() == 0u) {
+                break;
+            }
+
+            std::unique_lock<std::mutex> lock(this->_sleep_mutex);
+
+            ++this->_number_of_sleeping_workers;
+
+            this->_sleep_condition.wait(lock, [this, applied_thread_settings_version]() {
+                return this->_should_stop ||
+                       this->_number_of_queued_jobs.load() > 0u ||
+                       this->_worker_thread_settings_version.load() != applied_thread_settings_version;
+            });
+
+            --this->_number_of_sleeping_workers;
+        }
+
+        t_job_system = nullptr;
+    }
+
+    job_system& get_job_system() noexcept {
+        static job_system system;
+        [[maybe_unused]] static auto is_started = system.start();
+
+        return system;
+    }
+}
@@ -0,0 +1,278 @@
+#pragma once
+
+#include "job.h"
+#include "job_counter.h"
+#include "work_stealing_deque.h"
+#include "shared/apis/logging/ilog_manager.h"
+#include "shared/platform/thread.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace pbr::shared::jobs {
+    /// The settings of a job system
+    struct job_system_settings {
+        /// The number of worker threads. If this is `0`, one fewer than the number of hardware
+        /// threads is used, as the thread waiting on jobs also runs them
+        size_t number_of_workers {0u};
+
+        /// The most jobs each worker's deque holds. Jobs run when a worker's deque is full are
+        /// queued on the shared queue instead
+        size_t deque_capacity {4096u};
+
+        /// The settings of the worker threads. Each worker's index is appended to the name
+        platform::thread_settings worker_thread_settings { "Job Worker", {}, {}, {} };
+    };
+
+    /// Runs jobs on a pool of worker threads. Each worker has its own work-stealing deque, which it
+    /// pushes the jobs it runs to and pops from, so most jobs never touch a shared lock. Jobs run
+    /// from other threads are queued on a shared queue. Idle workers take jobs from the shared
+    /// queue, then steal from the other workers' deques.
+    /// A thread waiting on a counter runs jobs until the counter is complete, and only sleeps when
+    /// there are no jobs it can run, so jobs can wait on the jobs they run without deadlocking the
+    /// pool.
+    /// Some work, such as creating windows, must run on the main thread. This is queued with
+    /// `run_on_main_thread`, and is only run by the main thread, either when it waits on a counter,
+    /// or calls `run_main_thread_jobs`. This is thread safe
+    class job_system {
+    public:
+        /// Constructs this job system. The calling thread is the main thread
+        /// \param settings The settings to use
+        explicit job_system(job_system_settings settings = {});
+
+        /// Destroys this job system, after running every queued job
+        ~job_system();
+
+        job_system(const job_system&) = delete;
+        job_system(job_system&&) = delete;
+
+        job_system& operator = (const job_system&) = delete;
+        job_system& operator = (job_system&&) = delete;
+
+        /// Starts the worker threads. Until this is called, jobs are only run by waiting threads
+        /// \returns `true` upon success, else `false`
+        [[nodiscard]]
+        bool start() noexcept;
+
+        /// Stops the worker threads, after they have run every queued job
+        void stop() noexcept;
+
+        /// Returns the number of worker threads
+        /// \returns The number of worker threads
+        [[nodiscard]]
+        size_t get_number_of_workers() const noexcept {
+            return this->_workers.size();
+        }
+
+        /// Sets the settings of the worker threads, such as their CPU affinity, and waits for every
+        /// running worker to apply them. Workers started later apply them as they start. Each
+        /// worker's index is appended to the name. A worker only applies them between jobs, so this
+        /// must not be called from a job
+        /// \param settings The settings to apply
+        /// \returns `true` if every running worker applied every setting, else `false`
+        [[nodiscard]]
+        bool set_worker_thread_settings(const platform::thread_settings& settings) noexcept;
+
+        /// Sets the log manager that jobs throwing exceptions are logged to
+        /// \param log_manager The log manager to use, else `nullptr` to only count the failed jobs
+        void set_log_manager(std::shared_ptr<apis::logging::ilog_manager> log_manager) noexcept;
+
+        /// Returns the number of jobs that threw an exception. The exception is caught and logged, and
+        /// the job's counter is decremented as if it had finished
+        /// \returns The number of jobs that threw an exception
+        [[nodiscard]]
+        uint64_t get_number_of_failed_jobs() const noexcept {
+            return this->_number_of_failed_jobs.load(std::memory_order_relaxed);
+        }
+
+        /// Makes the calling thread the main thread
+        void set_main_thread() noexcept;
+
+        /// Returns if the calling thread is the main thread
+        /// \returns `true` if the calling thread is the main thread, else `false`
+        [[nodiscard]]
+        bool is_main_thread() const noexcept;
+
+        /// Runs a job on any thread
+        /// \param function The function to run
+        /// \param counter The counter to count the job with, else `nullptr`
+        /// \returns `true` upon success, else `false` if the job could not be created
+        bool run(job_function function, job_counter* counter = nullptr) noexcept;
+
+        /// Runs a job on any thread once every job counted by a counter has finished
+        /// \param dependency The counter to wait on. It must not be destroyed before the job runs
+        /// \param function The function to run
+        /// \param counter The counter to count the job with, else `nullptr`
+        /// \returns `true` upon success, else `false` if the job could not be created
+        bool run_after(job_counter& dependency, job_function function, job_counter* counter = nullptr) noexcept;
+
+        /// Runs a job on the main thread
+        /// \param function The function to run
+        /// \param counter The counter to count the job with, else `nullptr`
+        /// \returns `true` upon success, else `false` if the job could not be created
+        bool run_on_main_thread(job_function function, job_counter* counter = nullptr) noexcept;
+
+        /// Runs the jobs queued to run on the main thread. This must only be called by the main thread
+        /// \returns The number of jobs run
+        size_t run_main_thread_jobs() noexcept;
+
+        /// Runs jobs until every job counted by a counter has finished, sleeping while there are no
+        /// jobs to run. Once this returns, the counter can be destroyed
+        /// \param counter The counter to wait on
+        void wait(job_counter& counter) noexcept;
+
+        /// Splits a range into chunks, running a job for each, and waits for them to finish
+        /// \param begin The first index of the range
+        /// \param end The index after the last index of the range
+        /// \param grain_size The most indices in a chunk. This should be large enough that a chunk
+        /// takes much longer to run than it takes to queue
+        /// \param function Runs a chunk, from its first index to the index after its last
+        void parallel_for(size_t begin,
+                          size_t end,
+                          size_t grain_size,
+                          const std::function<void(size_t, size_t)>& function) noexcept;
+
+    private:
+        /// Used when the calling thread is not one of this system's workers
+        static constexpr size_t not_a_worker {static_cast<size_t>(-1)};
+
+        /// A worker thread
+        struct worker_thread {
+            /// The jobs run by this worker
+            std::unique_ptr<work_stealing_deque> deque;
+
+            /// The thread
+            std::thread thread;
+        };
+
+        /// The settings
+        job_system_settings _settings;
+
+        /// The workers
+        std::vector<worker_thread> _workers;
+
+        /// The ID of the main thread
+        std::atomic<std::thread::id> _main_thread_id;
+
+        /// Protects `_queue`
+        std::mutex _queue_mutex;
+
+        /// The jobs run by threads that are not workers, or that did not fit in a worker's deque
+        std::deque<job*> _queue;
+
+        /// Protects `_main_thread_queue`
+        std::mutex _main_thread_queue_mutex;
+
+        /// The jobs to run on the main thread
+        std::deque<job*> _main_thread_queue;
+
+        /// The number of jobs in the workers' deques and `_queue`
+        std::atomic_size_t _number_of_queued_jobs {0u};
+
+        /// Protects sleeping workers from missing `_should_stop`
+        std::mutex _sleep_mutex;
+
+        /// Wakes sleeping workers
+        std::condition_variable _sleep_condition;
+
+        /// The number of sleeping workers
+        std::atomic_size_t _number_of_sleeping_workers {0u};
+
+        /// Wakes threads sleeping in `wait`, which share `_sleep_mutex` with the workers
+        std::condition_variable _wait_condition;
+
+        /// The number of threads sleeping in `wait`
+        std::atomic_size_t _number_of_sleeping_waiters {0u};
+
+        /// Should the workers stop?
+        std::atomic_bool _should_stop {false};
+
+        /// Protects `_settings.worker_thread_settings` and the state of applying them
+        std::mutex _worker_thread_settings_mutex;
+
+        /// Wakes threads waiting for the workers to apply their settings
+        std::condition_variable _worker_thread_settings_condition;
+
+        /// Incremented each time the worker thread settings are set, so workers know to apply them
+        std::atomic_uint64_t _worker_thread_settings_version {1u};
+
+        /// The number of workers that have applied the current worker thread settings
+        size_t _number_of_workers_with_settings {0u};
+
+        /// Have the current worker thread settings been applied by every worker that applied them?
+        bool _are_worker_thread_settings_applied {true};
+
+        /// Protects `_log_manager`
+        std::mutex _log_manager_mutex;
+
+        /// The log manager that failed jobs are logged to, else `nullptr`
+        std::shared_ptr<apis::logging::ilog_manager> _log_manager;
+
+        /// The number of jobs that threw an exception
+        std::atomic_uint64_t _number_of_failed_jobs {0u};
+
+        /// Returns the index of the calling thread's worker
+        /// \returns The index of the calling thread's worker, else `not_a_worker`
+        [[nodiscard]]
+        size_t get_worker_index() const noexcept;
+
+        /// Creates a job, counting it with its counter
+        /// \param function The function to run
+        /// \param counter The counter to count the job with, else `nullptr`
+        /// \returns The job, else `nullptr` if it could not be allocated
+        [[nodiscard]]
+        static job* create_job(job_function function, job_counter* counter) noexcept;
+
+        /// Queues a job, on the calling worker's deque if it has room, else on the shared queue
+        /// \param job The job to queue
+        void queue(job* job) noexcept;
+
+        /// Takes a job to run
+        /// \param worker_index The index of the calling thread's worker, else `not_a_worker`
+        /// \returns The job, else `nullptr` if there are no jobs
+        [[nodiscard]]
+        job* take_job(size_t worker_index) noexcept;
+
+        /// Takes a job from the main thread's queue
+        /// \returns The job, else `nullptr` if there are no jobs
+        [[nodiscard]]
+        job* take_main_thread_job() noexcept;
+
+        /// Runs a job, then destroys it and queues the jobs waiting on its counter
+        /// \param job The job to run
+        void execute(job* job) noexcept;
+
+        /// Wakes the threads sleeping in `wait`
+        void wake_waiters() noexcept;
+
+        /// Counts and logs a job that threw an exception
+        /// \param reason The message of the exception
+        void log_failed_job(std::string_view reason) noexcept;
+
+        /// Applies the worker thread settings to the calling worker, if they changed since it last
+        /// applied them
+        /// \param worker_index The index of the calling thread's worker
+        /// \param applied_version The version of the settings the worker last applied. This is
+        /// updated to the version applied
+        void apply_worker_thread_settings(size_t worker_index, uint64_t& applied_version) noexcept;
+
+        /// Runs a worker thread
+        /// \param worker_index The index of the worker
+        void run_worker(size_t worker_index) noexcept;
+    };
+
+    /// Returns the job system shared by the engine. Its workers are started when it is first used,
+    /// and the thread that first uses it is the main thread until `job_system::set_main_thread` is
+    /// called
+    /// \returns The job system
+    job_system& get_job_system() noexcept;
+}
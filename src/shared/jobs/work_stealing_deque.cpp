@@ -0,0 +1,86 @@
+#include "work_stealing_deque.h"
+
+#include <algorithm>
+#include <bit>
+
+namespace pbr::shared::jobs {
+    work_stealing_deque::work_stealing_deque(size_t capacity)
+        : _mask(std::bit_ceil(std::max<size_t>(capacity, 2u)) - 1u),
+          _jobs(std::make_unique<std::atomic<job*>[]>(this->_mask + 1u)) {
+    }
+
+    // sequentially consistent operations are used on `_top` and `_bottom`, rather than the
+    // fences of the original algorithm, so thread sanitizer can check this
+
+    bool work_stealing_deque::push(job* job) noexcept {
+        auto bottom = this->_bottom.load(std::memory_order_relaxed);
+        auto top = this->_top.load(std::memory_order_acquire);
+
+        if (bottom - top > static_cast<int64_t>(this->_mask)) {
+            return false;
+        }
+
+        this->_jobs[static_cast<size_t>(bottom) & this->_mask].store(job, std::memory_order_relaxed);
+
+        // publish the job to stealing threads
+        this->_bottom.store(bottom + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    job* work_stealing_deque::pop() noexcept {
+        auto bottom = this->_bottom.load(std::memory_order_relaxed) - 1;
+
+        // reserve the bottom job before checking if a stealing thread has taken it
+        this->_bottom.store(bottom, std::memory_order_seq_cst);
+        auto top = this->_top.load(std::memory_order_seq_cst);
+
+        if (top > bottom) {
+            // empty
+            this->_bottom.store(bottom + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        auto* job = this->_jobs[static_cast<size_t>(bottom) & this->_mask].load(std::memory_order_relaxed);
+
+        if (top == bottom) {
+            // this is the last job, so race the stealing threads for it
+            if (!this->_top.compare_exchange_strong(top, top + 1,
+                                                    std::memory_order_seq_cst,
+                                                    std::memory_order_relaxed)) {
+                job = nullptr;
+            }
+
+            this->_bottom.store(bottom + 1, std::memory_order_relaxed);
+        }
+
+        return job;
+    }
+
+    job* work_stealing_deque::steal() noexcept {
+        auto top = this->_top.load(std::memory_order_seq_cst);
+        auto bottom = this->_bottom.load(std::memory_order_seq_cst);
+
+        if (top >= bottom) {
+            return nullptr;
+        }
+
+        auto* job = this->_jobs[static_cast<size_t>(top) & this->_mask].load(std::memory_order_relaxed);
+
+        if (!this->_top.compare_exchange_strong(top, top + 1,
+                                                std::memory_order_seq_cst,
+                                                std::memory_order_relaxed)) {
+            // another thread took the job
+            return nullptr;
+        }
+
+        return job;
+    }
+
+    size_t work_stealing_deque::get_size() const noexcept {
+        auto bottom = this->_bottom.load(std::memory_order_relaxed);
+        auto top = this->_top.load(std::memory_order_relaxed);
+
+        return bottom > top ? static_cast<size_t>(bottom - top) : 0u;
+    }
+}
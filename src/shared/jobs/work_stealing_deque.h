@@ -0,0 +1,64 @@
+#pragma once
+
+#include "job.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace pbr::shared::jobs {
+    /// A fixed capacity, lock-free work-stealing deque, after Chase and Lev. The owning thread
+    /// pushes and pops jobs at the bottom, in last in, first out order, which keeps recently
+    /// created work in its caches. Other threads steal from the top, taking the oldest jobs,
+    /// which are usually the largest pieces of work
+    class work_stealing_deque {
+    public:
+        /// Constructs this deque
+        /// \param capacity The most jobs this deque holds. This is rounded up to a power of two
+        explicit work_stealing_deque(size_t capacity);
+
+        ~work_stealing_deque() = default;
+
+        work_stealing_deque(const work_stealing_deque&) = delete;
+        work_stealing_deque(work_stealing_deque&&) = delete;
+
+        work_stealing_deque& operator = (const work_stealing_deque&) = delete;
+        work_stealing_deque& operator = (work_stealing_deque&&) = delete;
+
+        /// Pushes a job onto the bottom of this deque. This must only be called by the owning thread
+        /// \param job The job to push
+        /// \returns `true` upon success, else `false` if this deque is full
+        [[nodiscard]]
+        bool push(job* job) noexcept;
+
+        /// Pops the most recently pushed job from the bottom of this deque. This must only be
+        /// called by the owning thread
+        /// \returns The job, else `nullptr` if this deque is empty
+        [[nodiscard]]
+        job* pop() noexcept;
+
+        /// Steals the least recently pushed job from the top of this deque. This is thread safe
+        /// \returns The job, else `nullptr` if this deque is empty or another thread took the job
+        [[nodiscard]]
+        job* steal() noexcept;
+
+        /// Returns the number of jobs in this deque. This may be out of date as soon as it returns
+        /// \returns The number of jobs in this deque
+        [[nodiscard]]
+        size_t get_size() const noexcept;
+
+    private:
+        /// Masks an index into `_jobs`
+        size_t _mask {0u};
+
+        /// The jobs, indexed by position masked with `_mask`
+        std::unique_ptr<std::atomic<job*>[]> _jobs;
+
+        /// The position of the next job to steal
+        alignas(64) std::atomic_int64_t _top {0};
+
+        /// The position after the last pushed job
+        alignas(64) std::atomic_int64_t _bottom {0};
+    };
+}
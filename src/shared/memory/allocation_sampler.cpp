@@ -0,0 +1,462 @@
+#include "allocation_sampler.h"
+#include "kilobytes.h"
+#include "shared/platform/platform.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <sstream>
+#include <iomanip>
+
+#if defined(PLATFORM_LINUX) || defined(PLATFORM_MAC)
+#include <execinfo.h>
+#define HAS_BACKTRACE
+#endif
+
+namespace pbr::shared::memory {
+    /// The maximum number of frames captured for each sampled allocation
+    constexpr size_t max_frames {16u};
+
+    /// The number of innermost frames to skip, as they are inside the sampler and the
+    /// tracked `new` operators
+    constexpr size_t frames_to_skip {3u};
+
+    /// The number of entries in the table of live sampled allocations. This must be a power of two
+    constexpr size_t live_table_capacity {1u << 16u};
+
+    /// The number of entries in the table of allocation sites. This must be a power of two
+    constexpr size_t site_table_capacity {1u << 12u};
+
+    /// A site in the table of allocation sites
+    struct site_entry {
+        /// Is this entry in use?
+        bool is_used {false};
+
+        /// The hash of `frames`
+        uint64_t hash {0u};
+
+        /// The number of frames in `frames`
+        size_t number_of_frames {0u};
+
+        /// The call stack of the site
+        void* frames[max_frames] {};
+
+        /// The number of sampled allocations made from this site
+        uint64_t sampled_allocations {0u};
+
+        /// The number of bytes requested by the sampled allocations made from this site
+        uint64_t sampled_bytes {0u};
+
+        /// The number of sampled allocations from this site that have not been freed
+        uint64_t live_allocations {0u};
+
+        /// The number of bytes requested by the sampled allocations from this site that have not been freed
+        uint64_t live_bytes {0u};
+    };
+
+    /// An allocation in the table of live sampled allocations
+    struct live_entry {
+        /// The sampled memory, `nullptr` if this entry is empty
+        const void* ptr {nullptr};
+
+        /// The number of bytes requested
+        uint64_t size {0u};
+
+        /// The index of the allocation's site in the site table
+        size_t site_index {0u};
+    };
+
+    /// Protects the tables
+    static std::mutex g_sampling_mutex;
+
+    /// The table of live sampled allocations. This is allocated with `malloc` so the
+    /// sampler does not sample itself
+    static live_entry* g_live_table {nullptr};
+
+    /// The number of entries in use in `g_live_table`
+    static size_t g_number_of_live_entries {0u};
+
+    /// The table of allocation sites. This is allocated with `malloc` so the sampler
+    /// does not sample itself
+    static site_entry* g_site_table {nullptr};
+
+    /// The number of samples dropped because a table was full
+    static uint64_t g_number_of_dropped_samples {0u};
+
+    /// The sample rate used for the samples in the tables. This stays set once sampling is
+    /// disabled, so the report can still estimate the total allocations
+    static uint32_t g_report_sample_rate {0u};
+
+    /// Set while the calling thread is inside the sampler, so anything the sampler allocates
+    /// is never sampled
+    static thread_local bool t_is_inside_sampler {false};
+
+    /// The state of the calling thread's random number generator
+    static thread_local uint64_t t_random_state {0u};
+
+    /// Sets a flag for the lifetime of this object
+    struct scoped_flag {
+        explicit scoped_flag(bool& flag) noexcept : _flag(flag) {
+            this->_flag = true;
+        }
+
+        ~scoped_flag() {
+            this->_flag = false;
+        }
+
+        bool& _flag;
+    };
+
+    /// Returns a random number for the calling thread using xorshift
+    /// \returns A random number
+    static uint64_t get_random_number() noexcept {
+        if (t_random_state == 0u) {
+            // seed with the address of the thread local, which differs per thread
+            t_random_state = reinterpret_cast<uintptr_t>(&t_random_state) | 1u;
+        }
+
+        t_random_state ^= t_random_state << 13u;
+        t_random_state ^= t_random_state >> 7u;
+        t_random_state ^= t_random_state << 17u;
+
+        return t_random_state;
+    }
+
+    /// Returns the hash of a pointer
+    /// \param ptr The pointer
+    /// \returns The hash of the pointer
+    static uint64_t hash_pointer(const void* ptr) noexcept {
+        return (reinterpret_cast<uintptr_t>(ptr) >> 4u) * 0x9E3779B97F4A7C15ull;
+    }
+
+    /// Returns the hash of a call stack
+    /// \param frames The frames of the call stack
+    /// \param number_of_frames The number of frames
+    /// \returns The hash of the call stack
+    static uint64_t hash_frames(void* const* frames, size_t number_of_frames) noexcept {
+        uint64_t hash {0xCBF29CE484222325ull};
+
+        for (size_t i {0u}; i < number_of_frames; ++i) {
+            hash = (hash ^ reinterpret_cast<uintptr_t>(frames[i])) * 0x100000001B3ull;
+        }
+
+        return hash;
+    }
+
+    /// Captures the calling thread's call stack
+    /// \param frames Set to the captured frames
+    /// \returns The number of captured frames
+    static size_t capture_frames(void** frames) noexcept {
+#ifdef HAS_BACKTRACE
+        void* buffer[max_frames + frames_to_skip];
+        auto captured = backtrace(buffer, static_cast<int>(max_frames + frames_to_skip));
+
+        if (captured <= static_cast<int>(frames_to_skip)) {
+            return 0u;
+        }
+
+        auto number_of_frames = static_cast<size_t>(captured) - frames_to_skip;
+        std::memcpy(frames, buffer + frames_to_skip, number_of_frames * sizeof(void*));
+
+        return number_of_frames;
+#else
+        (void)frames;
+        return 0u;
+#endif
+    }
+
+    /// Finds or adds a site in the site table. `g_sampling_mutex` must be held by the caller
+    /// \param frames The call stack of the site
+    /// \param number_of_frames The number of frames
+    /// \returns The index of the site, else `site_table_capacity` if the table is full
+    static size_t find_or_add_site(void* const* frames, size_t number_of_frames) noexcept {
+        auto hash = hash_frames(frames, number_of_frames);
+        auto mask = site_table_capacity - 1u;
+
+        for (size_t i {0u}; i < site_table_capacity; ++i) {
+            auto index = (hash + i) & mask;
+            auto& site = g_site_table[index];
+
+            if (!site.is_used) {
+                site.is_used = true;
+                site.hash = hash;
+                site.number_of_frames = number_of_frames;
+                std::memcpy(site.frames, frames, number_of_frames * sizeof(void*));
+                return index;
+            }
+
+            if (site.hash == hash &&
+                site.number_of_frames == number_of_frames &&
+                std::memcmp(site.frames, frames, number_of_frames * sizeof(void*)) == 0) {
+                return index;
+            }
+        }
+
+        return site_table_capacity;
+    }
+
+    /// Removes an entry from the live table, shifting back any entries after it so no tombstones
+    /// are needed. `g_sampling_mutex` must be held by the caller
+    /// \param index The index of the entry to remove
+    static void remove_live_entry(size_t index) noexcept {
+        auto mask = live_table_capacity - 1u;
+        auto next = index;
+
+        while (true) {
+            g_live_table[index] = {};
+
+            while (true) {
+                next = (next + 1u) & mask;
+
+                if (!g_live_table[next].ptr) {
+                    return;
+                }
+
+                // only move the entry back if its home slot is not between the gap and its current slot
+                auto home = hash_pointer(g_live_table[next].ptr) & mask;
+                auto is_home_between = index <= next ? (index < home && home <= next)
+                                                     : (index < home || home <= next);
+
+                if (!is_home_between) {
+                    break;
+                }
+            }
+
+            g_live_table[index] = g_live_table[next];
+            index = next;
+        }
+    }
+
+    bool enable_allocation_sampling(uint32_t sample_rate) noexcept {
+        if (sample_rate == 0u) {
+            return false;
+        }
+
+        {
+            scoped_flag is_inside_sampler(t_is_inside_sampler);
+            std::scoped_lock<std::mutex> lock(g_sampling_mutex);
+
+            if (!g_live_table) {
+                g_live_table = static_cast<live_entry*>(std::calloc(live_table_capacity, sizeof(live_entry)));
+                g_site_table = static_cast<site_entry*>(std::calloc(site_table_capacity, sizeof(site_entry)));
+
+                if (!g_live_table || !g_site_table) {
+                    std::free(g_live_table);
+                    std::free(g_site_table);
+                    g_live_table = nullptr;
+                    g_site_table = nullptr;
+                    return false;
+                }
+            }
+
+            // the first call may load libraries and allocate, so get that out of the way now
+            void* frames[max_frames];
+            (void)capture_frames(frames);
+
+            g_report_sample_rate = sample_rate;
+        }
+
+        allocation_sampling_state::sample_rate.store(sample_rate, std::memory_order_relaxed);
+
+        return true;
+    }
+
+    void disable_allocation_sampling() noexcept {
+        allocation_sampling_state::sample_rate.store(0u, std::memory_order_relaxed);
+    }
+
+    bool is_allocation_sampling_enabled() noexcept {
+        return allocation_sampling_state::sample_rate.load(std::memory_order_relaxed) != 0u;
+    }
+
+    void reset_allocation_sample_countdown() noexcept {
+        auto sample_rate = allocation_sampling_state::sample_rate.load(std::memory_order_relaxed);
+        if (sample_rate == 0u) {
+            allocation_sampling_state::allocations_until_sample = 1u;
+            return;
+        }
+
+        // uniformly pick from [1, 2 * sample_rate - 1], which averages to `sample_rate`
+        auto range = 2u * static_cast<uint64_t>(sample_rate) - 1u;
+        allocation_sampling_state::allocations_until_sample = static_cast<uint32_t>(1u + get_random_number() % range);
+    }
+
+    bool record_sampled_allocation(const void* ptr, size_t size) noexcept {
+        if (t_is_inside_sampler) {
+            return false;
+        }
+
+        scoped_flag is_inside_sampler(t_is_inside_sampler);
+
+        void* frames[max_frames];
+        auto number_of_frames = capture_frames(frames);
+
+        std::scoped_lock<std::mutex> lock(g_sampling_mutex);
+
+        if (!g_live_table || g_number_of_live_entries >= live_table_capacity * 3u / 4u) {
+            ++g_number_of_dropped_samples;
+            return false;
+        }
+
+        auto site_index = find_or_add_site(frames, number_of_frames);
+        if (site_index == site_table_capacity) {
+            ++g_number_of_dropped_samples;
+            return false;
+        }
+
+        auto& site = g_site_table[site_index];
+        ++site.sampled_allocations;
+        site.sampled_bytes += size;
+        ++site.live_allocations;
+        site.live_bytes += size;
+
+        auto mask = live_table_capacity - 1u;
+        auto index = hash_pointer(ptr) & mask;
+
+        while (g_live_table[index].ptr) {
+            index = (index + 1u) & mask;
+        }
+
+        g_live_table[index] = live_entry {
+            .ptr = ptr,
+            .size = size,
+            .site_index = site_index,
+        };
+
+        ++g_number_of_live_entries;
+
+        return true;
+    }
+
+    void remove_sampled_allocation(const void* ptr) noexcept {
+        std::scoped_lock<std::mutex> lock(g_sampling_mutex);
+
+        if (!g_live_table) {
+            return;
+        }
+
+        auto mask = live_table_capacity - 1u;
+        auto index = hash_pointer(ptr) & mask;
+
+        while (g_live_table[index].ptr) {
+            if (g_live_table[index].ptr == ptr) {
+                auto& site = g_site_table[g_live_table[index].site_index];
+                --site.live_allocations;
+                site.live_bytes -= g_live_table[index].size;
+
+                remove_live_entry(index);
+                --g_number_of_live_entries;
+
+                return;
+            }
+
+            index = (index + 1u) & mask;
+        }
+    }
+
+    std::vector<allocation_site> get_allocation_sites() noexcept {
+        std::vector<allocation_site> sites;
+
+        // anything allocated here must not be sampled, as the lock is held
+        scoped_flag is_inside_sampler(t_is_inside_sampler);
+        std::scoped_lock<std::mutex> lock(g_sampling_mutex);
+
+        if (!g_site_table) {
+            return sites;
+        }
+
+        for (size_t i {0u}; i < site_table_capacity; ++i) {
+            const auto& entry = g_site_table[i];
+            if (!entry.is_used) {
+                continue;
+            }
+
+            sites.push_back(allocation_site {
+                .frames = std::vector<void*>(entry.frames, entry.frames + entry.number_of_frames),
+                .sampled_allocations = entry.sampled_allocations,
+                .sampled_bytes = bytes(entry.sampled_bytes),
+                .live_allocations = entry.live_allocations,
+                .live_bytes = bytes(entry.live_bytes),
+            });
+        }
+
+        return sites;
+    }
+
+    /// Writes a section of the report
+    /// \param ss The stream to write to
+    /// \param title The title of the section
+    /// \param sites The sites to write, already sorted
+    /// \param number_of_sites The maximum number of sites to write
+    /// \param sample_rate The sample rate used to estimate the totals
+    /// \param use_live_values Should the live values be written, rather than the sampled totals?
+    static void write_report_section(std::stringstream& ss,
+                                     std::string_view title,
+                                     const std::vector<allocation_site>& sites,
+                                     size_t number_of_sites,
+                                     uint32_t sample_rate,
+                                     bool use_live_values) {
+        ss << title << '\n';
+
+        auto count = std::min(number_of_sites, sites.size());
+        for (size_t i {0u}; i < count; ++i) {
+            const auto& site = sites[i];
+
+            auto allocations = use_live_values ? site.live_allocations : site.sampled_allocations;
+            auto size = use_live_values ? site.live_bytes : site.sampled_bytes;
+
+            if (allocations == 0u) {
+                break;
+            }
+
+            ss << "  #" << (i + 1u)
+               << " ~" << std::fixed << std::setprecision(1)
+               << kilobytes(bytes(size.get_value() * sample_rate)).get_value() << "KB in ~"
+               << allocations * sample_rate << " allocations (sampled: "
+               << size.get_value() << " bytes in " << allocations << " allocations)\n";
+
+#ifdef HAS_BACKTRACE
+            auto symbols = backtrace_symbols(site.frames.data(), static_cast<int>(site.frames.size()));
+            for (size_t j {0u}; j < site.frames.size(); ++j) {
+                ss << "      " << (symbols ? symbols[j] : "?") << '\n';
+            }
+            std::free(symbols);
+#endif
+        }
+    }
+
+    std::string get_allocation_sampling_report(size_t number_of_sites) noexcept {
+        auto sites = get_allocation_sites();
+
+        uint32_t sample_rate {0u};
+        uint64_t number_of_dropped_samples {0u};
+        {
+            std::scoped_lock<std::mutex> lock(g_sampling_mutex);
+            sample_rate = g_report_sample_rate;
+            number_of_dropped_samples = g_number_of_dropped_samples;
+        }
+
+        std::stringstream ss;
+        ss << "Allocation sampling report: 1 in " << sample_rate << " allocations sampled from "
+           << sites.size() << " sites, " << number_of_dropped_samples << " samples dropped.\n";
+
+        std::sort(sites.begin(), sites.end(), [](const auto& a, const auto& b) {
+            return a.sampled_bytes > b.sampled_bytes;
+        });
+        write_report_section(ss, "Top sites by bytes:", sites, number_of_sites, sample_rate, false);
+
+        std::sort(sites.begin(), sites.end(), [](const auto& a, const auto& b) {
+            return a.sampled_allocations > b.sampled_allocations;
+        });
+        write_report_section(ss, "Top sites by allocations:", sites, number_of_sites, sample_rate, false);
+
+        std::sort(sites.begin(), sites.end(), [](const auto& a, const auto& b) {
+            return a.live_bytes > b.live_bytes;
+        });
+        write_report_section(ss, "Top sites by live bytes (probable leaks at shutdown):",
+                             sites, number_of_sites, sample_rate, true);
+
+        return ss.str();
+    }
+}
@@ -0,0 +1,108 @@
+#pragma once
+
+#include "bytes.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace pbr::shared::memory {
+    /// The sampled allocations made from a single call stack
+    struct allocation_site {
+        /// The call stack of the allocations, with the innermost frame first
+        std::vector<void*> frames;
+
+        /// The number of sampled allocations made from this site
+        uint64_t sampled_allocations {0u};
+
+        /// The number of bytes requested by the sampled allocations made from this site
+        bytes sampled_bytes {0u};
+
+        /// The number of sampled allocations from this site that have not been freed
+        uint64_t live_allocations {0u};
+
+        /// The number of bytes requested by the sampled allocations from this site that have not been freed
+        bytes live_bytes {0u};
+    };
+
+    /// Starts sampling allocations. Roughly one in every `sample_rate` allocations made through the
+    /// tracked `new` operators has its call stack captured and is kept in a table of live allocations
+    /// until it is freed. The tables are allocated once, the first time sampling is enabled. This is
+    /// thread safe
+    /// \param sample_rate On average, one in this number of allocations is sampled. `1` samples every
+    /// allocation
+    /// \returns `true` upon success, else `false` if the tables could not be allocated
+    [[nodiscard]]
+    bool enable_allocation_sampling(uint32_t sample_rate) noexcept;
+
+    /// Stops sampling allocations. Allocations that have already been sampled are still removed from
+    /// the table of live allocations when they are freed. This is thread safe
+    void disable_allocation_sampling() noexcept;
+
+    /// Returns if allocations are being sampled. This is thread safe
+    /// \returns `true` if allocations are being sampled, else `false`
+    [[nodiscard]]
+    bool is_allocation_sampling_enabled() noexcept;
+
+    /// Returns every site that has had an allocation sampled. This is thread safe
+    /// \returns Every site that has had an allocation sampled
+    [[nodiscard]]
+    std::vector<allocation_site> get_allocation_sites() noexcept;
+
+    /// Returns a human readable report of the sites with the most sampled bytes, the most sampled
+    /// allocations and the most sampled bytes still live. When called at shutdown, anything still
+    /// live is a probable leak. This is thread safe
+    /// \param number_of_sites The number of sites to list in each section
+    /// \returns The report
+    [[nodiscard]]
+    std::string get_allocation_sampling_report(size_t number_of_sites) noexcept;
+
+    /// The state used to decide which allocations are sampled. This is only exposed so the decision
+    /// can be inlined into the tracked `new` operators
+    struct allocation_sampling_state {
+        /// The current sample rate, `0` if sampling is disabled
+        static inline std::atomic_uint32_t sample_rate {0u};
+
+        /// The number of allocations the calling thread makes before the next one is sampled
+        static constinit inline thread_local uint32_t allocations_until_sample {1u};
+    };
+
+    /// Sets the number of allocations the calling thread makes before the next one is sampled. The
+    /// number is randomized around the sample rate, so allocation patterns that repeat with the same
+    /// period as the sample rate are not always or never sampled
+    void reset_allocation_sample_countdown() noexcept;
+
+    /// Returns if the calling thread's next allocation should be sampled. This is called by the
+    /// tracked `new` operators, and costs a single relaxed load when sampling is disabled
+    /// \returns `true` if the allocation should be sampled, else `false`
+    [[nodiscard]]
+    inline bool should_sample_allocation() noexcept {
+        if (allocation_sampling_state::sample_rate.load(std::memory_order_relaxed) == 0u) [[likely]] {
+            return false;
+        }
+
+        if (--allocation_sampling_state::allocations_until_sample != 0u) [[likely]] {
+            return false;
+        }
+
+        reset_allocation_sample_countdown();
+
+        return true;
+    }
+
+    /// Records a sampled allocation. This is called by the tracked `new` operators when
+    /// `should_sample_allocation` returns `true`
+    /// \param ptr The memory returned to the caller
+    /// \param size The number of bytes requested by the caller
+    /// \returns `true` if the allocation was recorded, else `false`, in which case
+    /// `remove_sampled_allocation` must not be called for it
+    [[nodiscard]]
+    bool record_sampled_allocation(const void* ptr, size_t size) noexcept;
+
+    /// Removes a sampled allocation from the table of live allocations. This is called by the
+    /// tracked `delete` operators for blocks recorded by `record_sampled_allocation`
+    /// \param ptr The memory returned to the caller when it was allocated
+    void remove_sampled_allocation(const void* ptr) noexcept;
+}
@@ -0,0 +1,153 @@
+#include "allocation_tags.h"
+
+#include <array>
+#include <atomic>
+
+namespace pbr::shared::memory {
+    /// The allocation counters of a single tag. Each tag sits in its own cache line, so threads
+    /// allocating for different subsystems never contend with each other
+    struct alignas(64) allocation_tag_counters {
+        /// The number of bytes currently allocated
+        std::atomic_int64_t live_bytes {0};
+
+        /// The highest value of `live_bytes`
+        std::atomic_int64_t peak_bytes {0};
+
+        /// The total number of allocations made
+        std::atomic_uint64_t number_of_allocations {0u};
+
+        /// The budget in bytes, `0` if there is no budget
+        std::atomic_int64_t budget_bytes {0};
+
+        /// Set when `live_bytes` goes over `budget_bytes`. Cleared when reported
+        std::atomic_bool has_exceeded_budget {false};
+    };
+
+    /// The counters for each tag
+    static std::array<allocation_tag_counters, number_of_allocation_tags> g_allocation_tag_counters;
+
+    /// Returns the counters for a tag
+    /// \param tag The tag
+    /// \returns The counters for the tag
+    static allocation_tag_counters& get_counters(allocation_tag tag) noexcept {
+        return g_allocation_tag_counters[static_cast<size_t>(tag) % number_of_allocation_tags];
+    }
+
+    std::string_view to_string(allocation_tag tag) noexcept {
+        switch (tag) {
+            case allocation_tag::untagged:
+                return "untagged";
+            case allocation_tag::graphics:
+                return "graphics";
+            case allocation_tag::scene:
+                return "scene";
+            case allocation_tag::resource:
+                return "resource";
+            case allocation_tag::logging:
+                return "logging";
+            case allocation_tag::world:
+                return "world";
+            case allocation_tag::network:
+                return "network";
+        }
+
+        return "unknown";
+    }
+
+    std::optional<allocation_tag> parse_allocation_tag(std::string_view name) noexcept {
+        for (size_t i {0u}; i < number_of_allocation_tags; ++i) {
+            auto tag = static_cast<allocation_tag>(i);
+
+            if (to_string(tag) == name) {
+                return tag;
+            }
+        }
+
+        return {};
+    }
+
+    allocation_tag_statistics get_allocation_tag_statistics(allocation_tag tag) noexcept {
+        auto& counters = get_counters(tag);
+
+        auto live_bytes = counters.live_bytes.load(std::memory_order_relaxed);
+        auto peak_bytes = counters.peak_bytes.load(std::memory_order_relaxed);
+
+        return allocation_tag_statistics {
+            .live_bytes = bytes(static_cast<bytes::type>(live_bytes > 0 ? live_bytes : 0)),
+            .peak_bytes = bytes(static_cast<bytes::type>(peak_bytes)),
+            .number_of_allocations = counters.number_of_allocations.load(std::memory_order_relaxed),
+        };
+    }
+
+    void set_allocation_budget(allocation_tag tag, megabytes budget) noexcept {
+        auto& counters = get_counters(tag);
+
+        counters.budget_bytes.store(static_cast<int64_t>(bytes(budget).get_value()), std::memory_order_relaxed);
+        counters.has_exceeded_budget.store(false, std::memory_order_relaxed);
+    }
+
+    void clear_allocation_budget(allocation_tag tag) noexcept {
+        auto& counters = get_counters(tag);
+
+        counters.budget_bytes.store(0, std::memory_order_relaxed);
+        counters.has_exceeded_budget.store(false, std::memory_order_relaxed);
+    }
+
+    std::optional<megabytes> get_allocation_budget(allocation_tag tag) noexcept {
+        auto budget_bytes = get_counters(tag).budget_bytes.load(std::memory_order_relaxed);
+        if (budget_bytes <= 0) {
+            return {};
+        }
+
+        return megabytes(bytes(static_cast<bytes::type>(budget_bytes)));
+    }
+
+    void check_allocation_budgets(const allocation_budget_exceeded_callback& callback) noexcept {
+        for (size_t i {0u}; i < number_of_allocation_tags; ++i) {
+            auto& counters = g_allocation_tag_counters[i];
+
+            if (!counters.has_exceeded_budget.load(std::memory_order_relaxed) ||
+                !counters.has_exceeded_budget.exchange(false, std::memory_order_relaxed)) {
+                continue;
+            }
+
+            auto budget_bytes = counters.budget_bytes.load(std::memory_order_relaxed);
+            if (budget_bytes <= 0) {
+                continue;
+            }
+
+            auto live_bytes = counters.live_bytes.load(std::memory_order_relaxed);
+
+            if (callback) {
+                callback(static_cast<allocation_tag>(i),
+                         bytes(static_cast<bytes::type>(live_bytes > 0 ? live_bytes : 0)),
+                         megabytes(bytes(static_cast<bytes::type>(budget_bytes))));
+            }
+        }
+    }
+
+    void record_tagged_allocation(allocation_tag tag, size_t size) noexcept {
+        auto& counters = get_counters(tag);
+
+        auto signed_size = static_cast<int64_t>(size);
+        auto live_bytes = counters.live_bytes.fetch_add(signed_size, std::memory_order_relaxed) + signed_size;
+
+        counters.number_of_allocations.fetch_add(1u, std::memory_order_relaxed);
+
+        auto peak_bytes = counters.peak_bytes.load(std::memory_order_relaxed);
+        while (live_bytes > peak_bytes &&
+               !counters.peak_bytes.compare_exchange_weak(peak_bytes, live_bytes, std::memory_order_relaxed)) {
+        }
+
+        // only flag the budget when it is crossed, so a tag that stays over budget is
+        // reported once rather than every time it is checked
+        auto budget_bytes = counters.budget_bytes.load(std::memory_order_relaxed);
+        if (budget_bytes > 0 && live_bytes > budget_bytes && live_bytes - signed_size <= budget_bytes) {
+            counters.has_exceeded_budget.store(true, std::memory_order_relaxed);
+        }
+    }
+
+    void record_tagged_free(allocation_tag tag, size_t size) noexcept {
+        get_counters(tag).live_bytes.fetch_sub(static_cast<int64_t>(size), std::memory_order_relaxed);
+    }
+}
@@ -0,0 +1,147 @@
+#pragma once
+
+#include "bytes.h"
+#include "megabytes.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string_view>
+
+namespace pbr::shared::memory {
+    /// The subsystems allocations can be tagged with. Allocations made while a tag is set on the
+    /// allocating thread are counted against that tag, so the memory used by each subsystem can
+    /// be tracked and budgeted
+    enum class allocation_tag : uint8_t {
+        /// Allocations not made for any particular subsystem. These are not tracked per tag
+        untagged,
+
+        /// Allocations made by the graphics subsystem
+        graphics,
+
+        /// Allocations made by scenes and the scene manager
+        scene,
+
+        /// Allocations made by resource managers
+        resource,
+
+        /// Allocations made by logging
+        logging,
+
+        /// Allocations made by the world
+        world,
+
+        /// Allocations made by networking
+        network,
+    };
+
+    /// The number of allocation tags, including `allocation_tag::untagged`
+    constexpr size_t number_of_allocation_tags {7u};
+
+    /// Returns a string representation of the passed allocation tag
+    /// \param tag The tag
+    /// \returns A string representation of the passed allocation tag
+    std::string_view to_string(allocation_tag tag) noexcept;
+
+    /// Returns the allocation tag with the passed name, as returned by `to_string`
+    /// \param name The name of the tag
+    /// \returns The tag, else empty if no tag has the name
+    [[nodiscard]]
+    std::optional<allocation_tag> parse_allocation_tag(std::string_view name) noexcept;
+
+    /// Sets the allocation tag of the calling thread for the lifetime of this object. The previous
+    /// tag is restored when this object is destroyed, so guards can be nested
+    class scoped_allocation_tag {
+    public:
+        /// Sets the allocation tag of the calling thread
+        /// \param tag The tag to set
+        explicit scoped_allocation_tag(allocation_tag tag) noexcept
+            : _previous_tag(scoped_allocation_tag::_current_tag) {
+            scoped_allocation_tag::_current_tag = tag;
+        }
+
+        /// Restores the previous allocation tag of the calling thread
+        ~scoped_allocation_tag() {
+            scoped_allocation_tag::_current_tag = this->_previous_tag;
+        }
+
+        scoped_allocation_tag(const scoped_allocation_tag&) = delete;
+        scoped_allocation_tag(scoped_allocation_tag&&) = delete;
+
+        scoped_allocation_tag& operator = (const scoped_allocation_tag&) = delete;
+        scoped_allocation_tag& operator = (scoped_allocation_tag&&) = delete;
+
+        /// Returns the allocation tag of the calling thread
+        /// \returns The allocation tag of the calling thread
+        [[nodiscard]]
+        static allocation_tag get_current_tag() noexcept {
+            return scoped_allocation_tag::_current_tag;
+        }
+
+    private:
+        /// The tag to restore when this object is destroyed
+        allocation_tag _previous_tag {allocation_tag::untagged};
+
+        /// The allocation tag of the calling thread
+        static constinit inline thread_local allocation_tag _current_tag {allocation_tag::untagged};
+    };
+
+    /// The allocation statistics of a single tag
+    struct allocation_tag_statistics {
+        /// The number of bytes currently allocated, including the size of any headers
+        bytes live_bytes {0u};
+
+        /// The highest number of bytes that have been allocated at any one time
+        bytes peak_bytes {0u};
+
+        /// The total number of allocations made
+        uint64_t number_of_allocations {0u};
+    };
+
+    /// Returns the allocation statistics of a tag. This is thread safe
+    /// \param tag The tag
+    /// \returns The allocation statistics of the tag
+    [[nodiscard]]
+    allocation_tag_statistics get_allocation_tag_statistics(allocation_tag tag) noexcept;
+
+    /// Sets the budget of a tag. When the number of live bytes for the tag goes over the budget, the
+    /// tag is reported by the next call to `check_allocation_budgets`. This is thread safe
+    /// \param tag The tag
+    /// \param budget The budget
+    void set_allocation_budget(allocation_tag tag, megabytes budget) noexcept;
+
+    /// Removes the budget of a tag. This is thread safe
+    /// \param tag The tag
+    void clear_allocation_budget(allocation_tag tag) noexcept;
+
+    /// Returns the budget of a tag. This is thread safe
+    /// \param tag The tag
+    /// \returns The budget of the tag, else empty if the tag has no budget
+    [[nodiscard]]
+    std::optional<megabytes> get_allocation_budget(allocation_tag tag) noexcept;
+
+    /// Called for each tag that has gone over its budget
+    /// \param tag The tag
+    /// \param live_bytes The number of bytes currently allocated for the tag
+    /// \param budget The budget of the tag
+    using allocation_budget_exceeded_callback = std::function<void(allocation_tag tag,
+                                                                   bytes live_bytes,
+                                                                   megabytes budget)>;
+
+    /// Calls the passed callback for each tag that has gone over its budget since this function
+    /// was last called. Budgets cannot be reported as they are exceeded, as that happens inside
+    /// `operator new`, so this should be polled, for instance once per frame. This is thread safe
+    /// \param callback The callback to call
+    void check_allocation_budgets(const allocation_budget_exceeded_callback& callback) noexcept;
+
+    /// Records an allocation against a tag. This is called by the tracked `new` operators
+    /// \param tag The tag
+    /// \param size The size of the allocation, including the header
+    void record_tagged_allocation(allocation_tag tag, size_t size) noexcept;
+
+    /// Records a free against a tag. This is called by the tracked `delete` operators
+    /// \param tag The tag the freed memory was allocated with
+    /// \param size The size of the freed block, including the header
+    void record_tagged_free(allocation_tag tag, size_t size) noexcept;
+}
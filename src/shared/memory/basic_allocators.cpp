@@ -1,68 +1,500 @@
 #include <atomic>
 #include <cstdint>
-#include <tuple>
+#include <cstdlib>
+#include <cstddef>
+#include <mutex>
+#include <algorithm>
 #include <cassert>
 
 #include "basic_allocators.h"
+#include "allocation_tags.h"
+#include "allocation_sampler.h"
+#include "small_object_allocator.h"
+#include "shared/platform/platform.h"
 
-/// Keeps track of the number of allocated bytes for the application as a whole, for all threads
-static std::atomic_uint64_t g_number_of_allocated_bytes {0};
+/// The number of allocated bytes that are not held by a live thread's shard. When a thread exits,
+/// its shard is folded into this value. Allocations made after a thread's shard has been destroyed,
+/// for instance by other `thread_local` destructors, are also added here
+static std::atomic_int64_t g_number_of_allocated_bytes {0};
+
+/// Protects the list of live thread shards
+static std::mutex g_thread_shards_mutex;
+
+/// Set to `true` once the calling thread's shard has been destroyed
+static thread_local bool t_has_thread_shard_been_destroyed {false};
+
+/// Adds to a counter that is only ever written by a single thread. As there is only one writer,
+/// this avoids the cost of an atomic read-modify-write, while still allowing other threads to read
+/// the counter safely
+/// \param counter The counter to add to
+/// \param value The value to add
+template <typename T, typename V>
+inline void add_to_single_writer_counter(std::atomic<T>& counter, V value) noexcept {
+    counter.store(counter.load(std::memory_order_relaxed) + static_cast<T>(value), std::memory_order_relaxed);
+}
+
+/// The allocation counters for a single thread. Only the owning thread writes to these counters, other
+/// threads only ever read them. Each shard sits in its own cache line, so the threads never contend
+/// with each other when allocating
+struct alignas(64) thread_allocation_shard {
+    /// The number of bytes allocated by this thread
+    std::atomic_uint64_t allocated_bytes {0u};
+
+    /// The number of bytes freed by this thread
+    std::atomic_uint64_t freed_bytes {0u};
+
+    /// The number of allocations made by this thread
+    std::atomic_uint64_t number_of_allocations {0u};
+
+    /// The number of frees made by this thread
+    std::atomic_uint64_t number_of_frees {0u};
+
+    /// The highest value of `allocated_bytes - freed_bytes`
+    std::atomic_int64_t peak_bytes {0};
+
+    /// The previous shard in the list of live shards
+    thread_allocation_shard* previous {nullptr};
+
+    /// The next shard in the list of live shards
+    thread_allocation_shard* next {nullptr};
+
+    /// The first shard in the list of live shards
+    static thread_allocation_shard* head;
+
+    /// Adds this shard to the list of live shards
+    thread_allocation_shard() noexcept {
+        std::scoped_lock<std::mutex> lock(g_thread_shards_mutex);
+
+        this->next = thread_allocation_shard::head;
+        if (this->next) {
+            this->next->previous = this;
+        }
+
+        thread_allocation_shard::head = this;
+    }
+
+    /// Folds this shard into the global total and removes it from the list of live shards
+    ~thread_allocation_shard() {
+        {
+            std::scoped_lock<std::mutex> lock(g_thread_shards_mutex);
+
+            g_number_of_allocated_bytes += this->get_number_of_allocated_bytes();
+
+            if (this->previous) {
+                this->previous->next = this->next;
+            } else {
+                thread_allocation_shard::head = this->next;
+            }
+
+            if (this->next) {
+                this->next->previous = this->previous;
+            }
+        }
+
+        t_has_thread_shard_been_destroyed = true;
+    }
+
+    /// Returns the number of bytes this thread currently has allocated. This can be negative
+    /// if this thread has freed memory allocated by other threads
+    /// \returns The number of bytes this thread currently has allocated
+    int64_t get_number_of_allocated_bytes() const noexcept {
+        return static_cast<int64_t>(this->allocated_bytes.load(std::memory_order_relaxed) -
+                                    this->freed_bytes.load(std::memory_order_relaxed));
+    }
+
+    /// Records an allocation. Only call this from the owning thread
+    /// \param size The size of the allocation, including the header
+    void record_allocation(size_t size) noexcept {
+        add_to_single_writer_counter(this->allocated_bytes, size);
+        add_to_single_writer_counter(this->number_of_allocations, 1u);
+
+        auto allocated = this->get_number_of_allocated_bytes();
+        if (allocated > this->peak_bytes.load(std::memory_order_relaxed)) {
+            this->peak_bytes.store(allocated, std::memory_order_relaxed);
+        }
+    }
+
+    /// Records a free. Only call this from the owning thread
+    /// \param size The size of the freed block, including the header
+    void record_free(size_t size) noexcept {
+        add_to_single_writer_counter(this->freed_bytes, size);
+        add_to_single_writer_counter(this->number_of_frees, 1u);
+    }
+};
+
+thread_allocation_shard* thread_allocation_shard::head {nullptr};
+
+/// Returns the calling thread's shard. The shard is created on first use
+/// \returns The calling thread's shard, else `nullptr` if the shard has already been destroyed
+thread_allocation_shard* get_thread_shard() noexcept {
+    if (t_has_thread_shard_been_destroyed) {
+        return nullptr;
+    }
+
+    static thread_local thread_allocation_shard shard;
+    return &shard;
+}
+
+/// Records an allocation against the calling thread
+/// \param size The size of the allocation, including the header
+void record_allocation(size_t size) noexcept {
+    if (auto shard = get_thread_shard(); shard) {
+        shard->record_allocation(size);
+    } else {
+        g_number_of_allocated_bytes += static_cast<int64_t>(size);
+    }
+}
+
+/// Records a free against the calling thread and the tag the block was allocated with
+/// \param size The size of the freed block, including the header
+/// \param tag The tag stored in the freed block's header
+void record_free(size_t size, uint32_t tag) noexcept {
+    tag &= ~pbr::shared::memory::memory_block_header::SAMPLED_FLAG;
+
+    if (auto shard = get_thread_shard(); shard) {
+        shard->record_free(size);
+    } else {
+        g_number_of_allocated_bytes -= static_cast<int64_t>(size);
+    }
+
+    if (tag != static_cast<uint32_t>(pbr::shared::memory::allocation_tag::untagged)) {
+        pbr::shared::memory::record_tagged_free(static_cast<pbr::shared::memory::allocation_tag>(tag), size);
+    }
+}
+
+using pbr::shared::memory::memory_block_header;
+
+/// Should the block headers be written and validated? This is skipped in `RELEASE` builds to keep
+/// the overhead of the tracked allocators as low as possible
+#ifdef RELEASE
+constexpr bool validate_block_headers {false};
+#else
+constexpr bool validate_block_headers {true};
+#endif
+
+/// The alignment `malloc` and the non-aligned `new` operators guarantee
+constexpr size_t default_alignment {__STDCPP_DEFAULT_NEW_ALIGNMENT__};
+
+/// Should small blocks be served by the small object allocator rather than `malloc`? This is
+/// selected at build time with the `USE_SMALL_OBJECT_ALLOCATOR` option
+#ifdef USE_SMALL_OBJECT_ALLOCATOR
+constexpr bool use_small_object_allocator {true};
+#else
+constexpr bool use_small_object_allocator {false};
+#endif
+
+/// Returns if a block is served by the small object allocator
+/// \param total_size The total size of the block
+/// \param alignment The alignment of the block
+/// \returns `true` if the block is served by the small object allocator, else `false`
+constexpr bool is_small_object_block(size_t total_size, size_t alignment) noexcept {
+    return use_small_object_allocator &&
+           alignment <= default_alignment &&
+           pbr::shared::memory::is_small_object_size(total_size);
+}
+
+static_assert(sizeof(memory_block_header) % default_alignment == 0,
+              "The block header must keep the default alignment of the returned memory.");
+
+/// Returns the offset from the start of an allocated block to the memory returned to the caller
+/// \param alignment The alignment of the allocation
+/// \returns The offset from the start of an allocated block to the memory returned to the caller
+constexpr size_t get_block_offset(size_t alignment) noexcept {
+    return alignment > sizeof(memory_block_header) ? alignment : sizeof(memory_block_header);
+}
+
+/// Allocates a block of raw memory
+/// \param total_size The total size of the block
+/// \param alignment The alignment of the block
+/// \returns The block, else `nullptr` if the allocation failed
+void* allocate_block(size_t total_size, size_t alignment) noexcept {
+    if (is_small_object_block(total_size, alignment)) {
+        return pbr::shared::memory::allocate_small_object(total_size);
+    }
+
+    if (alignment <= default_alignment) {
+        return malloc(total_size);
+    }
+
+#ifdef PLATFORM_WINDOWS
+    return _aligned_malloc(total_size, alignment);
+#else
+    return aligned_alloc(alignment, total_size);
+#endif
+}
+
+/// Frees a block of raw memory allocated with `allocate_block()`
+/// \param ptr The block to free
+/// \param total_size The total size the block was allocated with
+/// \param alignment The alignment the block was allocated with
+void free_block(void* ptr, size_t total_size, size_t alignment) noexcept {
+    if (is_small_object_block(total_size, alignment)) {
+        pbr::shared::memory::free_small_object(ptr, total_size);
+        return;
+    }
+
+#ifdef PLATFORM_WINDOWS
+    if (alignment > default_alignment) {
+        _aligned_free(ptr);
+        return;
+    }
+#else
+    (void)alignment;
+#endif
+
+    free(ptr);
+}
 
 /// Allocates a block of memory with the header
 /// \param size The size of the block to allocate, not including the header size
-/// \returns A pointer to the usable block of memory and the total allocated size, including the size of the header
-std::pair<void*, size_t> allocate_with_header(size_t size) {
-    auto total_size = size + sizeof(pbr::shared::memory::memory_block_header);
+/// \param alignment The alignment of the memory returned to the caller
+/// \returns A pointer to the usable block of memory, else `nullptr` if the allocation failed
+void* allocate_with_header(size_t size, size_t alignment) noexcept {
+    auto total_size = pbr::shared::memory::get_allocated_block_size(size, alignment);
+
+    auto ptr = static_cast<std::byte*>(allocate_block(total_size, alignment));
+    if (!ptr) {
+        return nullptr;
+    }
+
+    auto usable_ptr = ptr + get_block_offset(alignment);
 
-    auto ptr = malloc(total_size);
-    assert((ptr));
+    auto header_ptr = reinterpret_cast<memory_block_header*>(usable_ptr) - 1;
+    header_ptr->size = total_size;
 
-    auto header_ptr = static_cast<pbr::shared::memory::memory_block_header*>(ptr);
-    header_ptr[0].key = pbr::shared::memory::memory_block_header::ID;
-    header_ptr[0].size = total_size;
+    if constexpr (validate_block_headers) {
+        header_ptr->key = memory_block_header::ID;
+    }
+
+    auto tag = pbr::shared::memory::scoped_allocation_tag::get_current_tag();
+    header_ptr->tag = static_cast<uint32_t>(tag);
 
-    return { static_cast<void*>(&header_ptr[1]), total_size };
+    record_allocation(total_size);
+
+    if (tag != pbr::shared::memory::allocation_tag::untagged) {
+        pbr::shared::memory::record_tagged_allocation(tag, total_size);
+    }
+
+    if (pbr::shared::memory::should_sample_allocation()) [[unlikely]] {
+        if (pbr::shared::memory::record_sampled_allocation(usable_ptr, size)) {
+            header_ptr->tag |= memory_block_header::SAMPLED_FLAG;
+        }
+    }
+
+    return usable_ptr;
+}
+
+/// Allocates a block of memory with the header, calling the new handler until the allocation
+/// succeeds. If there is no new handler, `std::bad_alloc` is thrown
+/// \param size The size of the block to allocate, not including the header size
+/// \param alignment The alignment of the memory returned to the caller
+/// \returns A pointer to the usable block of memory
+void* allocate_with_header_or_throw(size_t size, size_t alignment) {
+    while (true) {
+        if (auto ptr = allocate_with_header(size, alignment); ptr) {
+            return ptr;
+        }
+
+        auto handler = std::get_new_handler();
+        if (!handler) {
+            throw std::bad_alloc();
+        }
+
+        handler();
+    }
 }
 
-/// Returns the starting address of the block of memory to free. If the memory was
-/// allocated by us, it returns the address of the header, else it returns the passed
-/// address
-/// \param ptr The pointer to check
-/// \returns The pointer to free and the size of the allocated block of memory. If the memory was
-/// not allocated by us, `0` is returned.
-std::pair<void*, size_t> get_ptr_to_free(void* ptr) {
-    assert((ptr));
+/// Frees a block of memory allocated with `allocate_with_header()`. The size of the block is read
+/// from its header
+/// \param ptr The pointer returned by `allocate_with_header()`
+/// \param alignment The alignment `ptr` was allocated with
+void free_with_header(void* ptr, size_t alignment) noexcept {
+    if (!ptr) {
+        return;
+    }
+
+    auto header_ptr = static_cast<memory_block_header*>(ptr) - 1;
 
-    auto header_ptr = static_cast<pbr::shared::memory::memory_block_header*>(ptr);
-    assert((ptr));
+    if constexpr (validate_block_headers) {
+        // this memory was not allocated by us, so just free it as is
+        if (header_ptr->key != memory_block_header::ID) {
+            free(ptr);
+            return;
+        }
+    }
 
-    auto header = &header_ptr[-1];
+    auto total_size = header_ptr->size;
+    auto tag = header_ptr->tag;
 
-    if (header->key != pbr::shared::memory::memory_block_header::ID) {
-        return { ptr, 0 };
+    if (tag & memory_block_header::SAMPLED_FLAG) [[unlikely]] {
+        pbr::shared::memory::remove_sampled_allocation(ptr);
     }
 
-    return { static_cast<void*>(header), header->size };
+    free_block(static_cast<std::byte*>(ptr) - get_block_offset(alignment), total_size, alignment);
+
+    record_free(total_size, tag);
+}
+
+/// Frees a block of memory allocated with `allocate_with_header()`. The size of the block is
+/// calculated from the passed size, so only the tag is read from the header
+/// \param ptr The pointer returned by `allocate_with_header()`
+/// \param size The size passed to `allocate_with_header()`
+/// \param alignment The alignment `ptr` was allocated with
+void free_with_size(void* ptr, size_t size, size_t alignment) noexcept {
+    if (!ptr) {
+        return;
+    }
+
+    auto total_size = pbr::shared::memory::get_allocated_block_size(size, alignment);
+
+    auto header_ptr = static_cast<memory_block_header*>(ptr) - 1;
+
+    assert((!validate_block_headers || header_ptr->size == total_size));
+
+    auto tag = header_ptr->tag;
+
+    if (tag & memory_block_header::SAMPLED_FLAG) [[unlikely]] {
+        pbr::shared::memory::remove_sampled_allocation(ptr);
+    }
+
+    free_block(static_cast<std::byte*>(ptr) - get_block_offset(alignment), total_size, alignment);
+
+    record_free(total_size, tag);
 }
 
 void* operator new(size_t size) {
-    auto [ptr, total_size] = allocate_with_header(size);
+    return allocate_with_header_or_throw(size, default_alignment);
+}
+
+void* operator new[](size_t size) {
+    return allocate_with_header_or_throw(size, default_alignment);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    try {
+        return allocate_with_header_or_throw(size, default_alignment);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+    try {
+        return allocate_with_header_or_throw(size, default_alignment);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void* operator new(size_t size, std::align_val_t alignment) {
+    return allocate_with_header_or_throw(size, static_cast<size_t>(alignment));
+}
 
-    g_number_of_allocated_bytes += total_size;
+void* operator new[](size_t size, std::align_val_t alignment) {
+    return allocate_with_header_or_throw(size, static_cast<size_t>(alignment));
+}
 
-    return ptr;
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    try {
+        return allocate_with_header_or_throw(size, static_cast<size_t>(alignment));
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    try {
+        return allocate_with_header_or_throw(size, static_cast<size_t>(alignment));
+    } catch (...) {
+        return nullptr;
+    }
 }
 
 void operator delete(void* ptr) noexcept {
-    auto [ptr_to_free, size] = get_ptr_to_free(ptr);
+    free_with_header(ptr, default_alignment);
+}
+
+void operator delete[](void* ptr) noexcept {
+    free_with_header(ptr, default_alignment);
+}
+
+void operator delete(void* ptr, size_t size) noexcept {
+    free_with_size(ptr, size, default_alignment);
+}
 
-    free(ptr_to_free);
+void operator delete[](void* ptr, size_t size) noexcept {
+    free_with_size(ptr, size, default_alignment);
+}
 
-    g_number_of_allocated_bytes -= size;
+void operator delete(void* ptr, const std::nothrow_t&) noexcept {
+    free_with_header(ptr, default_alignment);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept {
+    free_with_header(ptr, default_alignment);
+}
+
+void operator delete(void* ptr, std::align_val_t alignment) noexcept {
+    free_with_header(ptr, static_cast<size_t>(alignment));
+}
+
+void operator delete[](void* ptr, std::align_val_t alignment) noexcept {
+    free_with_header(ptr, static_cast<size_t>(alignment));
+}
+
+void operator delete(void* ptr, size_t size, std::align_val_t alignment) noexcept {
+    free_with_size(ptr, size, static_cast<size_t>(alignment));
+}
+
+void operator delete[](void* ptr, size_t size, std::align_val_t alignment) noexcept {
+    free_with_size(ptr, size, static_cast<size_t>(alignment));
+}
+
+void operator delete(void* ptr, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    free_with_header(ptr, static_cast<size_t>(alignment));
+}
+
+void operator delete[](void* ptr, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    free_with_header(ptr, static_cast<size_t>(alignment));
 }
 
 namespace pbr::shared::memory {
     bytes get_number_of_allocated_bytes() noexcept {
-        return bytes(g_number_of_allocated_bytes.load());
+        std::scoped_lock<std::mutex> lock(g_thread_shards_mutex);
+
+        auto total = g_number_of_allocated_bytes.load();
+
+        for (auto shard = thread_allocation_shard::head; shard; shard = shard->next) {
+            total += shard->get_number_of_allocated_bytes();
+        }
+
+        return bytes(static_cast<bytes::type>(total));
+    }
+
+    size_t get_allocated_block_size(size_t size, size_t alignment) noexcept {
+        if (alignment <= default_alignment) {
+            return size + sizeof(memory_block_header);
+        }
+
+        // `aligned_alloc()` requires the size to be a multiple of the alignment
+        auto total_size = size + get_block_offset(alignment);
+        return (total_size + alignment - 1u) / alignment * alignment;
+    }
+
+    thread_allocation_statistics get_thread_allocation_statistics() noexcept {
+        auto shard = get_thread_shard();
+        if (!shard) {
+            return {};
+        }
+
+        thread_allocation_statistics statistics;
+        statistics.allocated_bytes = bytes(shard->allocated_bytes.load(std::memory_order_relaxed));
+        statistics.freed_bytes = bytes(shard->freed_bytes.load(std::memory_order_relaxed));
+        statistics.number_of_allocations = shard->number_of_allocations.load(std::memory_order_relaxed);
+        statistics.number_of_frees = shard->number_of_frees.load(std::memory_order_relaxed);
+        statistics.peak_bytes = bytes(static_cast<bytes::type>(
+            std::max<int64_t>(shard->peak_bytes.load(std::memory_order_relaxed), 0)));
+
+        return statistics;
     }
 }
@@ -2,37 +2,195 @@
 
 #include "bytes.h"
 
+#include <cstddef>
+#include <cstdint>
 #include <new>
 
-#ifndef RELEASE
+// The full set of replaceable allocation and deallocation functions is overridden, so every allocation
+// made through `new` is tracked. This is also the case for `RELEASE` builds, though `RELEASE` builds skip
+// validating the block headers to keep the overhead as low as possible. Allocations are also counted
+// against the calling thread's allocation tag, see `allocation_tags.h`, and may be sampled, see
+// `allocation_sampler.h`. When the `USE_SMALL_OBJECT_ALLOCATOR` build option is on, small blocks are
+// served by the small object allocator, see `small_object_allocator.h`, rather than `malloc`.
+
 /// Overrides the default `new` operator. This will keep track of the total number of allocated bytes.
 /// This is thread safe.
 /// \param size The number of bytes to allocate.
 /// \return A pointer to the allocated memory.
 void* operator new(size_t size);
 
+/// Overrides the default array `new` operator. This will keep track of the total number of allocated bytes.
+/// This is thread safe.
+/// \param size The number of bytes to allocate.
+/// \return A pointer to the allocated memory.
+void* operator new[](size_t size);
+
+/// Overrides the default non-throwing `new` operator. This will keep track of the total number of allocated bytes.
+/// This is thread safe.
+/// \param size The number of bytes to allocate.
+/// \return A pointer to the allocated memory, else `nullptr` if the allocation failed.
+void* operator new(size_t size, const std::nothrow_t&) noexcept;
+
+/// Overrides the default non-throwing array `new` operator. This will keep track of the total number of
+/// allocated bytes. This is thread safe.
+/// \param size The number of bytes to allocate.
+/// \return A pointer to the allocated memory, else `nullptr` if the allocation failed.
+void* operator new[](size_t size, const std::nothrow_t&) noexcept;
+
+/// Overrides the default aligned `new` operator. This will keep track of the total number of allocated bytes.
+/// This is thread safe.
+/// \param size The number of bytes to allocate.
+/// \param alignment The alignment of the allocated memory.
+/// \return A pointer to the allocated memory.
+void* operator new(size_t size, std::align_val_t alignment);
+
+/// Overrides the default aligned array `new` operator. This will keep track of the total number of
+/// allocated bytes. This is thread safe.
+/// \param size The number of bytes to allocate.
+/// \param alignment The alignment of the allocated memory.
+/// \return A pointer to the allocated memory.
+void* operator new[](size_t size, std::align_val_t alignment);
+
+/// Overrides the default non-throwing aligned `new` operator. This will keep track of the total number of
+/// allocated bytes. This is thread safe.
+/// \param size The number of bytes to allocate.
+/// \param alignment The alignment of the allocated memory.
+/// \return A pointer to the allocated memory, else `nullptr` if the allocation failed.
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept;
+
+/// Overrides the default non-throwing aligned array `new` operator. This will keep track of the total number
+/// of allocated bytes. This is thread safe.
+/// \param size The number of bytes to allocate.
+/// \param alignment The alignment of the allocated memory.
+/// \return A pointer to the allocated memory, else `nullptr` if the allocation failed.
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept;
+
 /// Overrides the default `delete` operator. This will decrease the total number of allocated bytes.
 /// This is thread safe. If `ptr` was not allocated with the overridden `new` above, the result is
 /// undefined behavior.
 /// \param ptr The pointer to delete.
 void operator delete(void* ptr) noexcept;
-#endif
+
+/// Overrides the default array `delete` operator. This will decrease the total number of allocated bytes.
+/// This is thread safe.
+/// \param ptr The pointer to delete.
+void operator delete[](void* ptr) noexcept;
+
+/// Overrides the default sized `delete` operator. This will decrease the total number of allocated bytes.
+/// The size of the block is taken from `size` rather than the block header. This is thread safe.
+/// \param ptr The pointer to delete.
+/// \param size The size passed to `new` when `ptr` was allocated.
+void operator delete(void* ptr, size_t size) noexcept;
+
+/// Overrides the default sized array `delete` operator. This will decrease the total number of allocated
+/// bytes. The size of the block is taken from `size` rather than the block header. This is thread safe.
+/// \param ptr The pointer to delete.
+/// \param size The size passed to `new[]` when `ptr` was allocated.
+void operator delete[](void* ptr, size_t size) noexcept;
+
+/// Overrides the default non-throwing `delete` operator. This will decrease the total number of allocated
+/// bytes. This is thread safe.
+/// \param ptr The pointer to delete.
+void operator delete(void* ptr, const std::nothrow_t&) noexcept;
+
+/// Overrides the default non-throwing array `delete` operator. This will decrease the total number of
+/// allocated bytes. This is thread safe.
+/// \param ptr The pointer to delete.
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept;
+
+/// Overrides the default aligned `delete` operator. This will decrease the total number of allocated bytes.
+/// This is thread safe.
+/// \param ptr The pointer to delete.
+/// \param alignment The alignment passed to `new` when `ptr` was allocated.
+void operator delete(void* ptr, std::align_val_t alignment) noexcept;
+
+/// Overrides the default aligned array `delete` operator. This will decrease the total number of allocated
+/// bytes. This is thread safe.
+/// \param ptr The pointer to delete.
+/// \param alignment The alignment passed to `new[]` when `ptr` was allocated.
+void operator delete[](void* ptr, std::align_val_t alignment) noexcept;
+
+/// Overrides the default sized aligned `delete` operator. This will decrease the total number of allocated
+/// bytes. The size of the block is taken from `size` rather than the block header. This is thread safe.
+/// \param ptr The pointer to delete.
+/// \param size The size passed to `new` when `ptr` was allocated.
+/// \param alignment The alignment passed to `new` when `ptr` was allocated.
+void operator delete(void* ptr, size_t size, std::align_val_t alignment) noexcept;
+
+/// Overrides the default sized aligned array `delete` operator. This will decrease the total number of
+/// allocated bytes. The size of the block is taken from `size` rather than the block header. This is
+/// thread safe.
+/// \param ptr The pointer to delete.
+/// \param size The size passed to `new[]` when `ptr` was allocated.
+/// \param alignment The alignment passed to `new[]` when `ptr` was allocated.
+void operator delete[](void* ptr, size_t size, std::align_val_t alignment) noexcept;
+
+/// Overrides the default non-throwing aligned `delete` operator. This will decrease the total number of
+/// allocated bytes. This is thread safe.
+/// \param ptr The pointer to delete.
+/// \param alignment The alignment passed to `new` when `ptr` was allocated.
+void operator delete(void* ptr, std::align_val_t alignment, const std::nothrow_t&) noexcept;
+
+/// Overrides the default non-throwing aligned array `delete` operator. This will decrease the total number
+/// of allocated bytes. This is thread safe.
+/// \param ptr The pointer to delete.
+/// \param alignment The alignment passed to `new[]` when `ptr` was allocated.
+void operator delete[](void* ptr, std::align_val_t alignment, const std::nothrow_t&) noexcept;
 
 namespace pbr::shared::memory {
-    /// The header of an allocated memory block
+    /// The header of an allocated memory block. The header is placed directly before the memory
+    /// returned to the caller. For over-aligned allocations, the start of the block is padded so
+    /// the returned memory keeps its alignment
     struct memory_block_header {
         /// The value that `key` should have
-        static const size_t ID {0xABCD};
+        static const uint32_t ID {0xABCD};
+
+        /// Set in `tag` when the block has been recorded by the allocation sampler
+        static const uint32_t SAMPLED_FLAG {0x80000000u};
 
         /// The key identifying this block
-        size_t key {0u};
+        uint32_t key {0u};
+
+        /// The allocation tag the block was allocated with, combined with `SAMPLED_FLAG`
+        uint32_t tag {0u};
 
         /// The size of the allocated block, including the size
-        /// of this header
+        /// of this header and any alignment padding
         size_t size {0u};
     };
 
+    /// Returns the total size of a block allocated by the overridden `new` operators
+    /// \param size The size passed to `new`
+    /// \param alignment The alignment passed to `new`
+    /// \returns The total size of the block, including the header and any alignment padding
+    size_t get_allocated_block_size(size_t size,
+                                    size_t alignment = __STDCPP_DEFAULT_NEW_ALIGNMENT__) noexcept;
+
+    /// The allocation statistics of a single thread. Memory freed by a thread is counted
+    /// against that thread, even if the memory was allocated by another thread
+    struct thread_allocation_statistics {
+        /// The total number of bytes allocated by the thread, including the size of any headers
+        bytes allocated_bytes {0u};
+
+        /// The total number of bytes freed by the thread, including the size of any headers
+        bytes freed_bytes {0u};
+
+        /// The total number of allocations made by the thread
+        uint64_t number_of_allocations {0u};
+
+        /// The total number of frees made by the thread
+        uint64_t number_of_frees {0u};
+
+        /// The highest number of bytes the thread has had allocated at any one time. This is
+        /// the difference between the allocated and freed bytes
+        bytes peak_bytes {0u};
+    };
+
     /// Returns the total number of allocated bytes. This is thread safe.
     /// \return The total number of allocated bytes.
     bytes get_number_of_allocated_bytes() noexcept;
+
+    /// Returns the allocation statistics of the calling thread. This is thread safe.
+    /// \return The allocation statistics of the calling thread.
+    thread_allocation_statistics get_thread_allocation_statistics() noexcept;
 }
@@ -34,6 +34,9 @@ namespace pbr::shared::memory {
         bytes(bytes&&) = default;
         ~bytes() = default;
 
+        bytes& operator = (const bytes&) = default;
+        bytes& operator = (bytes&&) = default;
+
         /// Returns the number of bytes
         type get_value() const noexcept {
             return this->_value;
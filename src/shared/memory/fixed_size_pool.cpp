@@ -0,0 +1,177 @@
+#include "fixed_size_pool.h"
+#include "shared/diagnostics/counter_set.h"
+
+#include <algorithm>
+#include <cassert>
+#include <new>
+#include <utility>
+
+namespace pbr::shared::memory {
+    /// Rounds a value up to a multiple of an alignment
+    /// \param value The value to round up
+    /// \param alignment The alignment to round up to. This must be a power of two
+    /// \returns The rounded up value
+    static constexpr size_t round_up(size_t value, size_t alignment) noexcept {
+        return (value + alignment - 1u) & ~(alignment - 1u);
+    }
+
+    fixed_size_pool::fixed_size_pool(size_t slot_size, size_t slot_alignment, size_t slots_per_slab)
+        : _slot_alignment(std::max(slot_alignment, alignof(free_slot))),
+          _slots_per_slab(std::max(slots_per_slab, size_t(1u))),
+          _owner_thread_id(std::this_thread::get_id()) {
+        assert((slot_alignment & (slot_alignment - 1u)) == 0u);
+
+        this->_slot_size = round_up(std::max(slot_size, sizeof(free_slot)), this->_slot_alignment);
+        this->_first_slot_offset = round_up(sizeof(slab), this->_slot_alignment);
+        this->_slab_size = this->_first_slot_offset + this->_slot_size * this->_slots_per_slab;
+    }
+
+    fixed_size_pool::~fixed_size_pool() {
+        auto current = this->_slabs;
+
+        while (current) {
+            auto next = current->next;
+
+            ::operator delete(current, this->_slab_size, std::align_val_t(this->_slot_alignment));
+
+            current = next;
+        }
+    }
+
+    void* fixed_size_pool::allocate() {
+        if (std::this_thread::get_id() != this->_owner_thread_id) {
+            return this->allocate_shared();
+        }
+
+        if (!this->_owner_free_list) {
+            this->_owner_free_list = this->take_remote_free_list();
+
+            if (!this->_owner_free_list) {
+                std::scoped_lock<std::mutex> lock(this->_mutex);
+
+                // take any slots that were reserved or are unused by other threads before growing
+                if (this->_shared_free_list) {
+                    this->_owner_free_list = std::exchange(this->_shared_free_list, nullptr);
+                } else {
+                    this->_owner_free_list = this->allocate_slab();
+                }
+            }
+        }
+
+        auto slot = this->_owner_free_list;
+        this->_owner_free_list = slot->next;
+
+        this->_number_of_owner_allocations.store(this->_number_of_owner_allocations.load(std::memory_order_relaxed) + 1u,
+                                                 std::memory_order_relaxed);
+
+        return slot;
+    }
+
+    void fixed_size_pool::deallocate(void* ptr) noexcept {
+        if (!ptr) {
+            return;
+        }
+
+        auto slot = static_cast<free_slot*>(ptr);
+
+        if (std::this_thread::get_id() == this->_owner_thread_id) {
+            slot->next = this->_owner_free_list;
+            this->_owner_free_list = slot;
+
+            this->_number_of_owner_frees.store(this->_number_of_owner_frees.load(std::memory_order_relaxed) + 1u,
+                                               std::memory_order_relaxed);
+            return;
+        }
+
+        // slots are only ever taken off this list all at once, so there is no ABA problem
+        slot->next = this->_remote_free_list.load(std::memory_order_relaxed);
+        while (!this->_remote_free_list.compare_exchange_weak(slot->next,
+                                                              slot,
+                                                              std::memory_order_release,
+                                                              std::memory_order_relaxed)) {
+        }
+
+        this->_number_of_remote_frees.fetch_add(1u, std::memory_order_relaxed);
+    }
+
+    void fixed_size_pool::reserve(size_t number_of_slots) {
+        std::scoped_lock<std::mutex> lock(this->_mutex);
+
+        while (this->_number_of_slabs.load(std::memory_order_relaxed) * this->_slots_per_slab < number_of_slots) {
+            auto slots = this->allocate_slab();
+
+            // find the end of the new slots so the existing shared free slots can be appended
+            auto last = slots;
+            while (last->next) {
+                last = last->next;
+            }
+
+            last->next = this->_shared_free_list;
+            this->_shared_free_list = slots;
+        }
+    }
+
+    pool_statistics fixed_size_pool::get_statistics() const noexcept {
+        auto allocations = this->_number_of_owner_allocations.load(std::memory_order_relaxed) +
+                           this->_number_of_shared_allocations.load(std::memory_order_relaxed);
+        auto frees = this->_number_of_owner_frees.load(std::memory_order_relaxed) +
+                     this->_number_of_remote_frees.load(std::memory_order_relaxed);
+        auto number_of_slabs = this->_number_of_slabs.load(std::memory_order_relaxed);
+
+        return pool_statistics {
+            .live_slots = allocations >= frees ? allocations - frees : 0u,
+            .capacity = number_of_slabs * this->_slots_per_slab,
+            .number_of_slabs = number_of_slabs,
+        };
+    }
+
+    void fixed_size_pool::export_statistics(diagnostics::counter_set& counter_set,
+                                            const std::string& name) const noexcept {
+        auto statistics = this->get_statistics();
+
+        counter_set.set_counter(name + ".live_slots", static_cast<int>(statistics.live_slots));
+        counter_set.set_counter(name + ".capacity", static_cast<int>(statistics.capacity));
+        counter_set.set_counter(name + ".slabs", static_cast<int>(statistics.number_of_slabs));
+    }
+
+    fixed_size_pool::free_slot* fixed_size_pool::allocate_slab() {
+        auto memory = static_cast<std::byte*>(::operator new(this->_slab_size,
+                                                             std::align_val_t(this->_slot_alignment)));
+
+        auto new_slab = ::new (memory) slab { .next = this->_slabs };
+        this->_slabs = new_slab;
+
+        auto first_slot = memory + this->_first_slot_offset;
+
+        // link the slots in address order, so they are handed out in that order
+        for (size_t i {0u}; i < this->_slots_per_slab; ++i) {
+            auto slot = first_slot + i * this->_slot_size;
+            auto next = i + 1u < this->_slots_per_slab ? first_slot + (i + 1u) * this->_slot_size : nullptr;
+
+            ::new (slot) free_slot { .next = reinterpret_cast<free_slot*>(next) };
+        }
+
+        this->_number_of_slabs.fetch_add(1u, std::memory_order_relaxed);
+
+        return reinterpret_cast<free_slot*>(first_slot);
+    }
+
+    void* fixed_size_pool::allocate_shared() {
+        std::scoped_lock<std::mutex> lock(this->_mutex);
+
+        if (!this->_shared_free_list) {
+            this->_shared_free_list = this->take_remote_free_list();
+
+            if (!this->_shared_free_list) {
+                this->_shared_free_list = this->allocate_slab();
+            }
+        }
+
+        auto slot = this->_shared_free_list;
+        this->_shared_free_list = slot->next;
+
+        this->_number_of_shared_allocations.fetch_add(1u, std::memory_order_relaxed);
+
+        return slot;
+    }
+}
@@ -0,0 +1,176 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <string>
+
+namespace pbr::shared::diagnostics {
+    class counter_set;
+}
+
+namespace pbr::shared::memory {
+    /// The occupancy statistics of a pool
+    struct pool_statistics {
+        /// The number of slots currently allocated
+        uint64_t live_slots {0u};
+
+        /// The total number of slots in all slabs
+        uint64_t capacity {0u};
+
+        /// The number of slabs allocated
+        uint64_t number_of_slabs {0u};
+    };
+
+    /// Allocates fixed size slots from slabs of memory. Free slots are kept in an intrusive free
+    /// list, so both allocating and freeing are O(1), and no memory is returned to the heap until
+    /// the pool is destroyed. Slabs are allocated on demand, so once the pool has grown to its
+    /// working size, no further heap allocations are made.
+    /// The thread that constructs the pool is its owner. The owner allocates and frees without any
+    /// atomic read-modify-write operations or locks. Slots freed by other threads are pushed onto a
+    /// lock-free list, which the owner reclaims when its own free list is empty. Other threads may
+    /// also allocate, though this takes a lock.
+    class fixed_size_pool {
+    public:
+        /// Constructs this pool. No slabs are allocated until the first allocation
+        /// \param slot_size The size of each slot in bytes
+        /// \param slot_alignment The alignment of each slot. This must be a power of two
+        /// \param slots_per_slab The number of slots in each slab
+        fixed_size_pool(size_t slot_size, size_t slot_alignment, size_t slots_per_slab);
+
+        /// Destroys this pool and frees all slabs. All slots must have been freed, as any
+        /// slots still in use will be left dangling
+        ~fixed_size_pool();
+
+        fixed_size_pool(const fixed_size_pool&) = delete;
+        fixed_size_pool(fixed_size_pool&&) = delete;
+
+        fixed_size_pool& operator = (const fixed_size_pool&) = delete;
+        fixed_size_pool& operator = (fixed_size_pool&&) = delete;
+
+        /// Allocates a slot. This is thread safe
+        /// \returns The allocated slot
+        /// \throws std::bad_alloc if a new slab could not be allocated
+        [[nodiscard]]
+        void* allocate();
+
+        /// Frees a slot. This is thread safe
+        /// \param ptr The slot to free. This must have been allocated by this pool. If this is
+        /// `nullptr`, nothing happens
+        void deallocate(void* ptr) noexcept;
+
+        /// Allocates slabs until the pool has at least the passed number of slots. Call this during
+        /// loading to avoid growing the pool later. This is thread safe
+        /// \param number_of_slots The number of slots the pool should have
+        /// \throws std::bad_alloc if a new slab could not be allocated
+        void reserve(size_t number_of_slots);
+
+        /// Returns the size of each slot in bytes
+        /// \returns The size of each slot in bytes
+        [[nodiscard]]
+        size_t get_slot_size() const noexcept {
+            return this->_slot_size;
+        }
+
+        /// Returns the alignment of each slot
+        /// \returns The alignment of each slot
+        [[nodiscard]]
+        size_t get_slot_alignment() const noexcept {
+            return this->_slot_alignment;
+        }
+
+        /// Returns the occupancy statistics of this pool. This is thread safe
+        /// \returns The occupancy statistics of this pool
+        [[nodiscard]]
+        pool_statistics get_statistics() const noexcept;
+
+        /// Sets the occupancy statistics of this pool as counters in a counter set. The counters
+        /// are named `<name>.live_slots`, `<name>.capacity` and `<name>.slabs`
+        /// \param counter_set The counter set to set the counters in
+        /// \param name The name of the pool
+        void export_statistics(diagnostics::counter_set& counter_set, const std::string& name) const noexcept;
+
+    private:
+        /// A free slot. Free slots store the next free slot in their own memory
+        struct free_slot {
+            /// The next free slot
+            free_slot* next {nullptr};
+        };
+
+        /// A slab of slots. The header sits at the start of the slab's memory, and the
+        /// slots follow it
+        struct slab {
+            /// The next slab
+            slab* next {nullptr};
+        };
+
+        /// The size of each slot in bytes
+        size_t _slot_size {0u};
+
+        /// The alignment of each slot
+        size_t _slot_alignment {0u};
+
+        /// The number of slots in each slab
+        size_t _slots_per_slab {0u};
+
+        /// The offset of the first slot from the start of a slab
+        size_t _first_slot_offset {0u};
+
+        /// The size of a slab in bytes
+        size_t _slab_size {0u};
+
+        /// The thread that owns this pool
+        std::thread::id _owner_thread_id;
+
+        /// The free slots only the owner thread can use
+        free_slot* _owner_free_list {nullptr};
+
+        /// The number of slots allocated by the owner thread. Only the owner writes to this
+        std::atomic_uint64_t _number_of_owner_allocations {0u};
+
+        /// The number of slots freed by the owner thread. Only the owner writes to this
+        std::atomic_uint64_t _number_of_owner_frees {0u};
+
+        /// Slots freed by threads other than the owner
+        alignas(64) std::atomic<free_slot*> _remote_free_list {nullptr};
+
+        /// The number of slots freed by threads other than the owner
+        std::atomic_uint64_t _number_of_remote_frees {0u};
+
+        /// Protects the slabs and the shared free list
+        alignas(64) mutable std::mutex _mutex;
+
+        /// The free slots used by threads other than the owner
+        free_slot* _shared_free_list {nullptr};
+
+        /// The number of slots allocated by threads other than the owner
+        std::atomic_uint64_t _number_of_shared_allocations {0u};
+
+        /// All allocated slabs
+        slab* _slabs {nullptr};
+
+        /// The number of allocated slabs
+        std::atomic_uint64_t _number_of_slabs {0u};
+
+        /// Allocates a new slab. `_mutex` must be held by the caller
+        /// \returns A list of the slab's slots
+        /// \throws std::bad_alloc if the slab could not be allocated
+        [[nodiscard]]
+        free_slot* allocate_slab();
+
+        /// Allocates a slot on a thread other than the owner
+        /// \returns The allocated slot
+        /// \throws std::bad_alloc if a new slab could not be allocated
+        [[nodiscard]]
+        void* allocate_shared();
+
+        /// Takes all the slots freed by threads other than the owner
+        /// \returns A list of the freed slots
+        [[nodiscard]]
+        free_slot* take_remote_free_list() noexcept {
+            return this->_remote_free_list.exchange(nullptr, std::memory_order_acquire);
+        }
+    };
+}
@@ -34,6 +34,9 @@ namespace pbr::shared::memory {
         gigabytes(gigabytes&&) = default;
         ~gigabytes() = default;
 
+        gigabytes& operator = (const gigabytes&) = default;
+        gigabytes& operator = (gigabytes&&) = default;
+
         /// Returns the number of gigabytes
         type get_value() const noexcept {
             return this->_value;
@@ -34,6 +34,9 @@ namespace pbr::shared::memory {
         kilobytes(kilobytes&&) = default;
         ~kilobytes() = default;
 
+        kilobytes& operator = (const kilobytes&) = default;
+        kilobytes& operator = (kilobytes&&) = default;
+
         /// Returns the number of kilobytes
         type get_value() const noexcept {
             return this->_value;
@@ -34,6 +34,9 @@ namespace pbr::shared::memory {
         megabytes(megabytes&&) = default;
         ~megabytes() = default;
 
+        megabytes& operator = (const megabytes&) = default;
+        megabytes& operator = (megabytes&&) = default;
+
         /// Returns the number of megabytes
         type get_value() const noexcept {
             return this->_value;
@@ -0,0 +1,217 @@
+#pragma once
+
+#include "fixed_size_pool.h"
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <string>
+#include <utility>
+
+namespace pbr::shared::memory {
+    template <typename T, size_t SlotSize>
+    class object_pool;
+
+    /// A standard allocator that allocates single objects from an object pool. Allocations that
+    /// do not fit in a slot of the pool, such as arrays or larger rebound types, fall back to
+    /// `operator new`. This allows an object pool to be used with `std::allocate_shared`, where the
+    /// allocator is rebound to the shared pointer's control block type
+    template <typename U, typename Pool>
+    class object_pool_allocator {
+    public:
+        /// The type allocated by this allocator
+        using value_type = U;
+
+        /// Constructs this allocator
+        /// \param pool The pool to allocate from. This must outlive this allocator and any copies of it
+        explicit object_pool_allocator(Pool& pool) noexcept
+            : _pool(&pool) {
+        }
+
+        /// Constructs this allocator from an allocator of another type
+        /// \param other The allocator to copy the pool from
+        template <typename V>
+        object_pool_allocator(const object_pool_allocator<V, Pool>& other) noexcept // NOLINT(google-explicit-constructor)
+            : _pool(other.get_pool()) {
+        }
+
+        /// Allocates memory for objects
+        /// \param n The number of objects to allocate memory for
+        /// \returns The allocated memory
+        [[nodiscard]]
+        U* allocate(size_t n) {
+            if (fits_in_slot(n)) {
+                return static_cast<U*>(this->_pool->allocate_slot());
+            }
+
+            return static_cast<U*>(::operator new(n * sizeof(U), std::align_val_t(alignof(U))));
+        }
+
+        /// Deallocates memory allocated by `allocate`
+        /// \param ptr The memory to deallocate
+        /// \param n The number of objects passed to `allocate`
+        void deallocate(U* ptr, size_t n) noexcept {
+            if (fits_in_slot(n)) {
+                this->_pool->deallocate_slot(ptr);
+                return;
+            }
+
+            ::operator delete(ptr, n * sizeof(U), std::align_val_t(alignof(U)));
+        }
+
+        /// Returns the pool this allocator allocates from
+        /// \returns The pool this allocator allocates from
+        [[nodiscard]]
+        Pool* get_pool() const noexcept {
+            return this->_pool;
+        }
+
+        /// Allocators are equal if they allocate from the same pool
+        template <typename V>
+        bool operator == (const object_pool_allocator<V, Pool>& other) const noexcept {
+            return this->_pool == other.get_pool();
+        }
+
+    private:
+        /// The pool to allocate from
+        Pool* _pool {nullptr};
+
+        /// Returns if an allocation fits in a slot of the pool
+        /// \param n The number of objects being allocated
+        /// \returns `true` if the allocation fits in a slot, else `false`
+        [[nodiscard]]
+        static constexpr bool fits_in_slot(size_t n) noexcept {
+            return n == 1u && sizeof(U) <= Pool::slot_size && alignof(U) <= Pool::slot_alignment;
+        }
+    };
+
+    /// A pool of objects of a single type. Objects are allocated from slabs of fixed size slots, so
+    /// creating and destroying objects is O(1) and makes no heap allocations once the pool has grown
+    /// to its working size. See `fixed_size_pool` for the threading behavior.
+    /// \tparam T The type of object in the pool
+    /// \tparam SlotSize The size of each slot. This can be larger than `T` so other types, such as
+    /// a shared pointer's control block, can also be allocated from the pool
+    template <typename T, size_t SlotSize = sizeof(T)>
+    class object_pool {
+    public:
+        static_assert(SlotSize >= sizeof(T), "The slot size must be large enough to hold `T`.");
+
+        /// The size of each slot
+        static constexpr size_t slot_size {SlotSize};
+
+        /// The alignment of each slot
+        static constexpr size_t slot_alignment {alignof(T) > alignof(std::max_align_t) ? alignof(T) : alignof(std::max_align_t)};
+
+        /// The allocator type for `std::allocate_shared` and standard containers
+        using allocator_type = object_pool_allocator<T, object_pool>;
+
+        /// Constructs this pool. No memory is allocated until the first object is created
+        /// \param objects_per_slab The number of objects in each slab
+        explicit object_pool(size_t objects_per_slab = 64u)
+            : _pool(slot_size, slot_alignment, objects_per_slab) {
+        }
+
+        ~object_pool() = default;
+
+        object_pool(const object_pool&) = delete;
+        object_pool(object_pool&&) = delete;
+
+        object_pool& operator = (const object_pool&) = delete;
+        object_pool& operator = (object_pool&&) = delete;
+
+        /// Creates an object. This is thread safe
+        /// \param args The arguments to pass to the constructor of `T`
+        /// \returns The created object
+        /// \throws std::bad_alloc if a new slab could not be allocated, or anything thrown by `T`'s
+        /// constructor
+        template <typename... Args>
+        [[nodiscard]]
+        T* create(Args&&... args) {
+            auto slot = this->_pool.allocate();
+
+            try {
+                return ::new (slot) T(std::forward<Args>(args)...);
+            } catch (...) {
+                this->_pool.deallocate(slot);
+                throw;
+            }
+        }
+
+        /// Destroys an object created by `create`. This is thread safe
+        /// \param object The object to destroy. If this is `nullptr`, nothing happens
+        void destroy(T* object) noexcept {
+            if (!object) {
+                return;
+            }
+
+            object->~T();
+            this->_pool.deallocate(object);
+        }
+
+        /// Creates a shared pointer to an object, with both the object and the shared pointer's
+        /// control block allocated from this pool if they fit in a slot. Use `shared_object_pool`
+        /// to make sure they fit. This pool must outlive the returned pointer
+        /// \param args The arguments to pass to the constructor of `T`
+        /// \returns The created shared pointer
+        template <typename... Args>
+        [[nodiscard]]
+        std::shared_ptr<T> make_shared(Args&&... args) {
+            return std::allocate_shared<T>(allocator_type(*this), std::forward<Args>(args)...);
+        }
+
+        /// Returns an allocator for this pool
+        /// \returns An allocator for this pool
+        [[nodiscard]]
+        allocator_type get_allocator() noexcept {
+            return allocator_type(*this);
+        }
+
+        /// Allocates an uninitialized slot. This is thread safe
+        /// \returns The allocated slot
+        /// \throws std::bad_alloc if a new slab could not be allocated
+        [[nodiscard]]
+        void* allocate_slot() {
+            return this->_pool.allocate();
+        }
+
+        /// Frees a slot allocated by `allocate_slot`. This is thread safe
+        /// \param ptr The slot to free
+        void deallocate_slot(void* ptr) noexcept {
+            this->_pool.deallocate(ptr);
+        }
+
+        /// Makes sure the pool can hold at least the passed number of objects without growing
+        /// \param number_of_objects The number of objects the pool should be able to hold
+        void reserve(size_t number_of_objects) {
+            this->_pool.reserve(number_of_objects);
+        }
+
+        /// Returns the occupancy statistics of this pool. This is thread safe
+        /// \returns The occupancy statistics of this pool
+        [[nodiscard]]
+        pool_statistics get_statistics() const noexcept {
+            return this->_pool.get_statistics();
+        }
+
+        /// Sets the occupancy statistics of this pool as counters in a counter set
+        /// \param counter_set The counter set to set the counters in
+        /// \param name The name of the pool
+        void export_statistics(diagnostics::counter_set& counter_set, const std::string& name) const noexcept {
+            this->_pool.export_statistics(counter_set, name);
+        }
+
+    private:
+        /// The pool of slots
+        fixed_size_pool _pool;
+    };
+
+    /// The number of bytes a shared pointer's control block needs on top of the object it holds,
+    /// when the control block and object are allocated together by `std::allocate_shared`. This
+    /// covers the virtual table pointer, the use and weak counts and the allocator
+    constexpr size_t shared_control_block_overhead {4u * sizeof(void*)};
+
+    /// An object pool whose slots are large enough to hold the control block created by
+    /// `std::allocate_shared`, so shared pointers made by `make_shared` come from the pool
+    template <typename T>
+    using shared_object_pool = object_pool<T, sizeof(T) + shared_control_block_overhead>;
+}
@@ -0,0 +1,187 @@
+#include "region_allocator.h"
+#include "shared/platform/platform.h"
+
+#include <new>
+
+#ifdef PLATFORM_WINDOWS
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace pbr::shared::memory {
+    /// Rounds a size up to a multiple of a power of two
+    /// \param size The size to round up
+    /// \param multiple The multiple to round up to. This must be a power of two
+    /// \returns The rounded up size
+    static constexpr size_t round_up(size_t size, size_t multiple) noexcept {
+        return (size + multiple - 1u) & ~(multiple - 1u);
+    }
+
+    /// Returns the size of a page
+    /// \returns The size of a page
+    static size_t get_page_size() noexcept {
+#ifdef PLATFORM_WINDOWS
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+        return static_cast<size_t>(info.dwPageSize);
+#else
+        return static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#endif
+    }
+
+    region_allocator::region_allocator(bytes reserve_size, bool use_huge_pages) {
+        auto page_size = get_page_size();
+
+#ifdef MADV_HUGEPAGE
+        this->_is_using_huge_pages = use_huge_pages;
+#else
+        (void)use_huge_pages;
+#endif
+
+        this->_commit_granularity = this->_is_using_huge_pages ? huge_page_size : min_commit_granularity;
+        if (this->_commit_granularity < page_size) {
+            this->_commit_granularity = page_size;
+        }
+
+        this->_reserved_size = round_up(static_cast<size_t>(reserve_size.get_value()), this->_commit_granularity);
+
+#ifdef PLATFORM_WINDOWS
+        this->_start = static_cast<std::byte*>(VirtualAlloc(nullptr, this->_reserved_size, MEM_RESERVE, PAGE_NOACCESS));
+        if (!this->_start) {
+            throw std::bad_alloc();
+        }
+#else
+        // reserve an extra huge page, so the start of the region can be aligned to a huge page
+        auto mapped_size = this->_reserved_size + (this->_is_using_huge_pages ? huge_page_size : 0u);
+
+        auto mapped = mmap(nullptr, mapped_size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        if (mapped == MAP_FAILED) {
+            throw std::bad_alloc();
+        }
+
+        auto mapped_start = static_cast<std::byte*>(mapped);
+        this->_start = mapped_start;
+
+        if (this->_is_using_huge_pages) {
+            this->_start = reinterpret_cast<std::byte*>(round_up(reinterpret_cast<uintptr_t>(mapped_start), huge_page_size));
+
+            // unmap the unaligned head and tail
+            auto head_size = static_cast<size_t>(this->_start - mapped_start);
+            if (head_size > 0u) {
+                munmap(mapped_start, head_size);
+            }
+
+            auto tail_size = mapped_size - head_size - this->_reserved_size;
+            if (tail_size > 0u) {
+                munmap(this->_start + this->_reserved_size, tail_size);
+            }
+        }
+#endif
+    }
+
+    region_allocator::~region_allocator() {
+#ifdef PLATFORM_WINDOWS
+        VirtualFree(this->_start, 0, MEM_RELEASE);
+#else
+        munmap(this->_start, this->_reserved_size);
+#endif
+    }
+
+    void* region_allocator::allocate(size_t size, size_t alignment) noexcept {
+        auto address = reinterpret_cast<uintptr_t>(this->_start) + this->_offset;
+        auto aligned_address = (address + (alignment - 1u)) & ~(uintptr_t(alignment) - 1u);
+
+        auto padding = static_cast<size_t>(aligned_address - address);
+        auto remaining = this->_reserved_size - this->_offset;
+
+        if (padding > remaining || size > remaining - padding) {
+            return nullptr;
+        }
+
+        auto end_offset = this->_offset + padding + size;
+
+        if (end_offset > this->_committed_size && !this->commit_up_to(end_offset)) {
+            return nullptr;
+        }
+
+        this->_offset = end_offset;
+
+        return reinterpret_cast<void*>(aligned_address);
+    }
+
+    void region_allocator::reset() noexcept {
+        this->_offset = 0u;
+    }
+
+    bool region_allocator::decommit() noexcept {
+        this->_offset = 0u;
+
+        if (this->_committed_size == 0u) {
+            return true;
+        }
+
+#ifdef PLATFORM_WINDOWS
+        if (!VirtualFree(this->_start, this->_committed_size, MEM_DECOMMIT)) {
+            return false;
+        }
+#else
+        // replacing the committed range with a fresh reservation both returns the pages to the
+        // operating system and makes the range inaccessible again, with a single call
+        auto mapped = mmap(this->_start,
+                           this->_committed_size,
+                           PROT_NONE,
+                           MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE | MAP_FIXED,
+                           -1,
+                           0);
+        if (mapped == MAP_FAILED) {
+            return false;
+        }
+#endif
+
+        this->_committed_size = 0u;
+
+        return true;
+    }
+
+    region_footprint region_allocator::get_footprint() const noexcept {
+        return region_footprint {
+            .reserved = gigabytes(this->get_reserved_size()),
+            .committed = megabytes(this->get_committed_size()),
+            .used = megabytes(this->get_used_bytes()),
+        };
+    }
+
+    bool region_allocator::commit_up_to(size_t offset) noexcept {
+        auto new_committed_size = round_up(offset, this->_commit_granularity);
+        if (new_committed_size > this->_reserved_size) {
+            new_committed_size = this->_reserved_size;
+        }
+
+        auto commit_start = this->_start + this->_committed_size;
+        auto commit_size = new_committed_size - this->_committed_size;
+
+#ifdef PLATFORM_WINDOWS
+        if (!VirtualAlloc(commit_start, commit_size, MEM_COMMIT, PAGE_READWRITE)) {
+            return false;
+        }
+#else
+        if (mprotect(commit_start, commit_size, PROT_READ | PROT_WRITE) != 0) {
+            return false;
+        }
+
+#ifdef MADV_HUGEPAGE
+        // this is only a hint, so a failure, for instance if transparent huge pages are
+        // disabled, still leaves usable memory
+        if (this->_is_using_huge_pages) {
+            madvise(commit_start, commit_size, MADV_HUGEPAGE);
+        }
+#endif
+#endif
+
+        this->_committed_size = new_committed_size;
+
+        return true;
+    }
+}
@@ -0,0 +1,150 @@
+#pragma once
+
+#include "bytes.h"
+#include "megabytes.h"
+#include "gigabytes.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace pbr::shared::memory {
+    /// The memory footprint of a region allocator
+    struct region_footprint {
+        /// The address space reserved by the region
+        gigabytes reserved {0.0};
+
+        /// The memory committed by the region, which is backed by physical memory once touched
+        megabytes committed {0.0};
+
+        /// The memory currently allocated from the region
+        megabytes used {0.0};
+    };
+
+    /// A bump allocator over a large range of reserved address space, for large buffers such as
+    /// world data. Reserving address space uses no memory, so the region can be sized for the
+    /// largest expected data. Pages are committed as allocations reach them, and can be returned
+    /// to the operating system with `decommit`, for instance when a scene is unloaded, while the
+    /// address space stays reserved for the next use. On Linux, the region can be backed by
+    /// transparent huge pages, which reduces TLB misses when passing over the whole region.
+    /// Individual allocations are never freed. This is not thread safe.
+    class region_allocator {
+    public:
+        /// Constructs this allocator, reserving the address space of the region
+        /// \param reserve_size The size of the address space to reserve. This is rounded up to a
+        /// whole number of commit granules
+        /// \param use_huge_pages Should the region be backed by transparent huge pages where supported?
+        /// \throws std::bad_alloc if the address space could not be reserved
+        explicit region_allocator(bytes reserve_size, bool use_huge_pages = true);
+
+        /// Destroys this allocator and releases the reserved address space. Any memory allocated
+        /// by this allocator is released
+        ~region_allocator();
+
+        region_allocator(const region_allocator&) = delete;
+        region_allocator(region_allocator&&) = delete;
+
+        region_allocator& operator = (const region_allocator&) = delete;
+        region_allocator& operator = (region_allocator&&) = delete;
+
+        /// Allocates memory from this region, committing more of the region if needed
+        /// \param size The number of bytes to allocate
+        /// \param alignment The alignment of the allocated memory. This must be a power of two
+        /// \returns The allocated memory, else `nullptr` if the region does not have enough space
+        /// left or the memory could not be committed
+        [[nodiscard]]
+        void* allocate(size_t size, size_t alignment = alignof(std::max_align_t)) noexcept;
+
+        /// Releases all memory allocated from this region. The committed memory is kept, so
+        /// refilling the region does not need to commit it again
+        void reset() noexcept;
+
+        /// Releases all memory allocated from this region and returns the committed memory to the
+        /// operating system. The address space stays reserved
+        /// \returns `true` upon success, else `false`
+        [[nodiscard]]
+        bool decommit() noexcept;
+
+        /// Returns if the passed memory was allocated from this region
+        /// \param ptr The memory to check
+        /// \returns `true` if the memory is owned by this region, else `false`
+        [[nodiscard]]
+        bool owns(const void* ptr) const noexcept {
+            auto address = reinterpret_cast<uintptr_t>(ptr);
+            auto start = reinterpret_cast<uintptr_t>(this->_start);
+
+            return address >= start && address < start + this->_reserved_size;
+        }
+
+        /// Returns the size of the reserved address space
+        /// \returns The size of the reserved address space
+        [[nodiscard]]
+        bytes get_reserved_size() const noexcept {
+            return bytes(this->_reserved_size);
+        }
+
+        /// Returns the number of bytes committed
+        /// \returns The number of bytes committed
+        [[nodiscard]]
+        bytes get_committed_size() const noexcept {
+            return bytes(this->_committed_size);
+        }
+
+        /// Returns the number of bytes currently allocated, including any alignment padding
+        /// \returns The number of bytes currently allocated
+        [[nodiscard]]
+        bytes get_used_bytes() const noexcept {
+            return bytes(this->_offset);
+        }
+
+        /// Returns the size of the chunks the region is committed in
+        /// \returns The size of the chunks the region is committed in
+        [[nodiscard]]
+        bytes get_commit_granularity() const noexcept {
+            return bytes(this->_commit_granularity);
+        }
+
+        /// Returns if the region is backed by transparent huge pages
+        /// \returns `true` if the region is backed by transparent huge pages, else `false`
+        [[nodiscard]]
+        bool is_using_huge_pages() const noexcept {
+            return this->_is_using_huge_pages;
+        }
+
+        /// Returns the memory footprint of this region
+        /// \returns The memory footprint of this region
+        [[nodiscard]]
+        region_footprint get_footprint() const noexcept;
+
+    private:
+        /// The size of a huge page, which is also the commit granularity when huge pages are used
+        static constexpr size_t huge_page_size {2u * 1024u * 1024u};
+
+        /// The smallest commit granularity. Committing in chunks larger than a page reduces the
+        /// number of system calls when the region is filled
+        static constexpr size_t min_commit_granularity {64u * 1024u};
+
+        /// The start of the reserved address space
+        std::byte* _start {nullptr};
+
+        /// The size of the reserved address space
+        size_t _reserved_size {0u};
+
+        /// The number of bytes committed from `_start`
+        size_t _committed_size {0u};
+
+        /// The offset of the next allocation from `_start`
+        size_t _offset {0u};
+
+        /// The size of the chunks the region is committed in
+        size_t _commit_granularity {min_commit_granularity};
+
+        /// Is the region backed by transparent huge pages?
+        bool _is_using_huge_pages {false};
+
+        /// Commits the region up to at least the passed offset
+        /// \param offset The offset to commit up to
+        /// \returns `true` upon success, else `false`
+        [[nodiscard]]
+        bool commit_up_to(size_t offset) noexcept;
+    };
+}
@@ -0,0 +1,349 @@
+#include "small_object_allocator.h"
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdlib>
+#include <mutex>
+
+namespace pbr::shared::memory {
+    /// The granularity of the smallest size classes. Every size class is a multiple of this, so
+    /// every block keeps the default alignment
+    constexpr size_t size_class_granularity {16u};
+
+    static_assert(size_class_granularity % __STDCPP_DEFAULT_NEW_ALIGNMENT__ == 0u,
+                  "Every size class must keep the default alignment.");
+
+    /// The largest size class that is a multiple of `size_class_granularity`. Above this, each power
+    /// of two is split into four size classes, which keeps the rounding waste under 25%
+    constexpr size_t max_linear_size_class {128u};
+
+    /// The number of size classes
+    constexpr size_t number_of_size_classes {max_linear_size_class / size_class_granularity +
+                                             4u * (std::bit_width(max_small_object_size) -
+                                                   std::bit_width(max_linear_size_class))};
+
+    /// The size of each span carved into blocks
+    constexpr size_t span_size {64u * 1024u};
+
+    /// The most bytes moved between a thread cache and a central free list at once
+    constexpr size_t max_batch_bytes {8u * 1024u};
+
+    /// The most blocks moved between a thread cache and a central free list at once
+    constexpr size_t max_batch_size {64u};
+
+    /// The fewest blocks moved between a thread cache and a central free list at once
+    constexpr size_t min_batch_size {4u};
+
+    /// Returns the size class index of a block size
+    /// \param size The size of the block
+    /// \returns The size class index
+    constexpr size_t get_size_class(size_t size) noexcept {
+        if (size <= max_linear_size_class) {
+            return size <= size_class_granularity ? 0u : (size - 1u) / size_class_granularity;
+        }
+
+        auto power = static_cast<size_t>(std::bit_width(size - 1u)) - 1u;
+        auto step_shift = power - 2u;
+
+        return max_linear_size_class / size_class_granularity +
+               4u * (power - (std::bit_width(max_linear_size_class) - 1u)) +
+               ((size - 1u - (size_t {1u} << power)) >> step_shift);
+    }
+
+    /// Returns the block size of a size class
+    /// \param size_class The size class index
+    /// \returns The block size of the size class
+    constexpr size_t get_size_class_size(size_t size_class) noexcept {
+        constexpr auto number_of_linear_size_classes = max_linear_size_class / size_class_granularity;
+
+        if (size_class < number_of_linear_size_classes) {
+            return (size_class + 1u) * size_class_granularity;
+        }
+
+        auto power = (size_class - number_of_linear_size_classes) / 4u +
+                     static_cast<size_t>(std::bit_width(max_linear_size_class)) - 1u;
+        auto step = (size_class - number_of_linear_size_classes) % 4u + 1u;
+
+        return (size_t {1u} << power) + step * (size_t {1u} << (power - 2u));
+    }
+
+    static_assert(get_size_class(1u) == 0u && get_size_class(16u) == 0u && get_size_class(17u) == 1u);
+    static_assert(get_size_class_size(get_size_class(129u)) == 160u);
+    static_assert(get_size_class_size(get_size_class(max_small_object_size)) == max_small_object_size);
+    static_assert(get_size_class(max_small_object_size) == number_of_size_classes - 1u);
+
+    /// Returns the number of blocks moved between a thread cache and a central free list at once
+    /// \param size_class The size class index
+    /// \returns The number of blocks in a batch
+    constexpr size_t get_batch_size(size_t size_class) noexcept {
+        auto batch_size = max_batch_bytes / get_size_class_size(size_class);
+
+        if (batch_size < min_batch_size) {
+            return min_batch_size;
+        }
+
+        return batch_size > max_batch_size ? max_batch_size : batch_size;
+    }
+
+    /// A free block. Free blocks are linked together through their first bytes
+    struct free_block {
+        /// The next free block
+        free_block* next {nullptr};
+    };
+
+    /// The free blocks of a single size class shared by all threads. Each list sits in its own
+    /// cache line, so threads moving batches of different size classes never contend
+    struct alignas(64) central_free_list {
+        /// Protects this list
+        std::mutex mutex;
+
+        /// The first free block
+        free_block* head {nullptr};
+
+        /// The number of free blocks
+        size_t count {0u};
+    };
+
+    /// The central free lists for each size class
+    static constinit std::array<central_free_list, number_of_size_classes> g_central_free_lists;
+
+    /// The number of spans allocated
+    static constinit std::atomic_uint64_t g_number_of_spans {0u};
+
+    /// Set to `true` once the calling thread's cache has been destroyed
+    static constinit thread_local bool t_has_thread_cache_been_destroyed {false};
+
+    /// Allocates a span and carves it into blocks of a size class. Call this with the central free
+    /// list's mutex held
+    /// \param size_class The size class index
+    /// \param list The central free list of the size class
+    /// \returns `true` if the span was allocated, else `false`
+    static bool allocate_span(size_t size_class, central_free_list& list) noexcept {
+        auto span = static_cast<std::byte*>(std::malloc(span_size));
+        if (!span) {
+            return false;
+        }
+
+        g_number_of_spans.fetch_add(1u, std::memory_order_relaxed);
+
+        auto block_size = get_size_class_size(size_class);
+        auto number_of_blocks = span_size / block_size;
+
+        // link the blocks in address order, so consecutive allocations are adjacent in memory
+        for (auto i = number_of_blocks; i > 0u; --i) {
+            auto block = reinterpret_cast<free_block*>(span + (i - 1u) * block_size);
+            block->next = list.head;
+            list.head = block;
+        }
+
+        list.count += number_of_blocks;
+
+        return true;
+    }
+
+    /// Takes up to a batch of blocks from a central free list, allocating a new span if it is empty
+    /// \param size_class The size class index
+    /// \param max_count The most blocks to take
+    /// \param out_count Set to the number of blocks taken
+    /// \returns The first of the taken blocks, linked together, else `nullptr` if no blocks could be taken
+    static free_block* take_from_central(size_t size_class, size_t max_count, size_t& out_count) noexcept {
+        auto& list = g_central_free_lists[size_class];
+
+        std::scoped_lock<std::mutex> lock(list.mutex);
+
+        if (!list.head && !allocate_span(size_class, list)) {
+            out_count = 0u;
+            return nullptr;
+        }
+
+        auto first = list.head;
+        auto last = first;
+        size_t count {1u};
+
+        while (count < max_count && last->next) {
+            last = last->next;
+            ++count;
+        }
+
+        list.head = last->next;
+        list.count -= count;
+        last->next = nullptr;
+
+        out_count = count;
+
+        return first;
+    }
+
+    /// Returns a list of blocks to a central free list
+    /// \param size_class The size class index
+    /// \param first The first block in the list
+    /// \param last The last block in the list
+    /// \param count The number of blocks in the list
+    static void return_to_central(size_t size_class, free_block* first, free_block* last, size_t count) noexcept {
+        auto& list = g_central_free_lists[size_class];
+
+        std::scoped_lock<std::mutex> lock(list.mutex);
+
+        last->next = list.head;
+        list.head = first;
+        list.count += count;
+    }
+
+    /// The free blocks cached by a single thread. Only the owning thread accesses its cache, so
+    /// allocating and freeing from the cache takes no locks and no atomic operations
+    struct thread_cache {
+        /// The free blocks of a single size class
+        struct size_class_cache {
+            /// The first free block
+            free_block* head {nullptr};
+
+            /// The number of free blocks
+            size_t count {0u};
+        };
+
+        /// The free blocks of each size class
+        std::array<size_class_cache, number_of_size_classes> size_classes;
+
+        /// Returns all cached blocks to the central free lists
+        ~thread_cache() {
+            this->flush();
+            t_has_thread_cache_been_destroyed = true;
+        }
+
+        /// Allocates a block, refilling the cache from the central free list if it is empty
+        /// \param size_class The size class index
+        /// \returns The block, else `nullptr` if no block could be allocated
+        void* allocate(size_t size_class) noexcept {
+            auto& cache = this->size_classes[size_class];
+
+            if (!cache.head) [[unlikely]] {
+                cache.head = take_from_central(size_class, get_batch_size(size_class), cache.count);
+                if (!cache.head) {
+                    return nullptr;
+                }
+            }
+
+            auto block = cache.head;
+            cache.head = block->next;
+            --cache.count;
+
+            return block;
+        }
+
+        /// Frees a block, returning a batch to the central free list if the cache has grown too large
+        /// \param ptr The block to free
+        /// \param size_class The size class index
+        void free(void* ptr, size_t size_class) noexcept {
+            auto& cache = this->size_classes[size_class];
+
+            auto block = static_cast<free_block*>(ptr);
+            block->next = cache.head;
+            cache.head = block;
+            ++cache.count;
+
+            auto batch_size = get_batch_size(size_class);
+
+            // keep one batch cached, so a thread alternating between allocating and freeing
+            // around a batch boundary does not move the same batch back and forth
+            if (cache.count >= 2u * batch_size) [[unlikely]] {
+                auto first = cache.head;
+                auto last = first;
+
+                for (size_t i {1u}; i < batch_size; ++i) {
+                    last = last->next;
+                }
+
+                cache.head = last->next;
+                cache.count -= batch_size;
+
+                return_to_central(size_class, first, last, batch_size);
+            }
+        }
+
+        /// Returns all cached blocks to the central free lists
+        void flush() noexcept {
+            for (size_t i {0u}; i < number_of_size_classes; ++i) {
+                auto& cache = this->size_classes[i];
+                if (!cache.head) {
+                    continue;
+                }
+
+                auto last = cache.head;
+                while (last->next) {
+                    last = last->next;
+                }
+
+                return_to_central(i, cache.head, last, cache.count);
+
+                cache.head = nullptr;
+                cache.count = 0u;
+            }
+        }
+    };
+
+    /// Returns the calling thread's cache. The cache is created on first use
+    /// \returns The calling thread's cache, else `nullptr` if the cache has already been destroyed
+    static thread_cache* get_thread_cache() noexcept {
+        if (t_has_thread_cache_been_destroyed) [[unlikely]] {
+            return nullptr;
+        }
+
+        static thread_local thread_cache cache;
+        return &cache;
+    }
+
+    size_t get_small_object_block_size(size_t size) noexcept {
+        return get_size_class_size(get_size_class(size));
+    }
+
+    void* allocate_small_object(size_t size) noexcept {
+        auto size_class = get_size_class(size);
+
+        if (auto cache = get_thread_cache(); cache) [[likely]] {
+            return cache->allocate(size_class);
+        }
+
+        size_t count {0u};
+        return take_from_central(size_class, 1u, count);
+    }
+
+    void free_small_object(void* ptr, size_t size) noexcept {
+        auto size_class = get_size_class(size);
+
+        if (auto cache = get_thread_cache(); cache) [[likely]] {
+            cache->free(ptr, size_class);
+            return;
+        }
+
+        auto block = static_cast<free_block*>(ptr);
+        return_to_central(size_class, block, block, 1u);
+    }
+
+    void flush_small_object_thread_cache() noexcept {
+        if (auto cache = get_thread_cache(); cache) {
+            cache->flush();
+        }
+    }
+
+    small_object_allocator_statistics get_small_object_allocator_statistics() noexcept {
+        small_object_allocator_statistics statistics;
+
+        auto number_of_spans = g_number_of_spans.load(std::memory_order_relaxed);
+        statistics.number_of_spans = number_of_spans;
+        statistics.reserved_bytes = bytes(number_of_spans * span_size);
+
+        bytes::type central_free_bytes {0u};
+
+        for (size_t i {0u}; i < number_of_size_classes; ++i) {
+            auto& list = g_central_free_lists[i];
+
+            std::scoped_lock<std::mutex> lock(list.mutex);
+            central_free_bytes += list.count * get_size_class_size(i);
+        }
+
+        statistics.central_free_bytes = bytes(central_free_bytes);
+
+        return statistics;
+    }
+}
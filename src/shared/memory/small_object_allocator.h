@@ -0,0 +1,66 @@
+#pragma once
+
+#include "bytes.h"
+
+#include <cstddef>
+#include <cstdint>
+
+// The small object allocator serves the blocks behind the tracked `new` operators when the
+// `USE_SMALL_OBJECT_ALLOCATOR` build option is on. Blocks are rounded up to a size class and taken
+// from a per-thread cache, which refills from and returns batches to a central free list per size
+// class. The central free lists carve their blocks from spans allocated with `malloc`. Blocks larger
+// than `max_small_object_size` are not handled by this allocator.
+
+namespace pbr::shared::memory {
+    /// The largest block, in bytes, served by the small object allocator
+    constexpr size_t max_small_object_size {1024u};
+
+    /// The statistics of the small object allocator
+    struct small_object_allocator_statistics {
+        /// The number of bytes allocated for spans. Spans are never returned to the heap
+        bytes reserved_bytes {0u};
+
+        /// The number of spans allocated
+        uint64_t number_of_spans {0u};
+
+        /// The number of bytes in free blocks held by the central free lists. This does not
+        /// include the free blocks held by each thread's cache
+        bytes central_free_bytes {0u};
+    };
+
+    /// Returns if a block of the passed size is served by the small object allocator
+    /// \param size The size of the block
+    /// \returns `true` if the block is served by the small object allocator, else `false`
+    [[nodiscard]]
+    constexpr bool is_small_object_size(size_t size) noexcept {
+        return size <= max_small_object_size;
+    }
+
+    /// Returns the size of the block the small object allocator allocates for the passed size
+    /// \param size The requested size. This must be no larger than `max_small_object_size`
+    /// \returns The size of the size class the requested size is rounded up to
+    [[nodiscard]]
+    size_t get_small_object_block_size(size_t size) noexcept;
+
+    /// Allocates a block. The block is aligned to `__STDCPP_DEFAULT_NEW_ALIGNMENT__`. This is thread safe
+    /// \param size The size of the block. This must be no larger than `max_small_object_size`
+    /// \returns The block, else `nullptr` if a new span could not be allocated
+    [[nodiscard]]
+    void* allocate_small_object(size_t size) noexcept;
+
+    /// Frees a block allocated by `allocate_small_object`. The block is kept in the calling thread's
+    /// cache, so it can be freed by a different thread from the one that allocated it. This is
+    /// thread safe
+    /// \param ptr The block to free
+    /// \param size The size passed to `allocate_small_object`
+    void free_small_object(void* ptr, size_t size) noexcept;
+
+    /// Returns all blocks in the calling thread's cache to the central free lists, so other threads
+    /// can reuse them. This happens automatically when a thread exits
+    void flush_small_object_thread_cache() noexcept;
+
+    /// Returns the statistics of the small object allocator. This is thread safe
+    /// \returns The statistics of the small object allocator
+    [[nodiscard]]
+    small_object_allocator_statistics get_small_object_allocator_statistics() noexcept;
+}
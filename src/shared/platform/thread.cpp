@@ -0,0 +1,276 @@
+#include "thread.h"
+#include "platform.h"
+
+#include <algorithm>
+#include <charconv>
+#include <sstream>
+
+#ifdef PLATFORM_LINUX
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace pbr::shared::platform {
+    /// The longest name Linux allows a thread, excluding the terminator
+    constexpr size_t max_thread_name_length {15u};
+
+    /// The number of CPUs an affinity can name, so CPU indices are less than this
+#ifdef PLATFORM_LINUX
+    constexpr uint32_t max_number_of_cpus {CPU_SETSIZE};
+#else
+    constexpr uint32_t max_number_of_cpus {1024u};
+#endif
+
+    /// Returns if a policy is a real-time policy
+    /// \param policy The policy
+    /// \returns `true` if the policy is a real-time policy, else `false`
+    static bool is_real_time(thread_scheduling_policy policy) noexcept {
+        return policy == thread_scheduling_policy::fifo || policy == thread_scheduling_policy::round_robin;
+    }
+
+#ifdef PLATFORM_LINUX
+    /// Sets the name of the calling thread
+    /// \param name The name
+    /// \returns `true` upon success, else `false`
+    static bool set_thread_name(const std::string& name) noexcept {
+        auto truncated_name = name.substr(0u, max_thread_name_length);
+
+        return pthread_setname_np(pthread_self(), truncated_name.c_str()) == 0;
+    }
+
+    /// Sets the CPUs the calling thread may run on
+    /// \param cpus The indices of the CPUs
+    /// \returns `true` upon success, else `false`
+    static bool set_thread_affinity(const std::vector<uint32_t>& cpus) noexcept {
+        cpu_set_t cpu_set;
+        CPU_ZERO(&cpu_set);
+
+        for (auto cpu : cpus) {
+            if (cpu >= max_number_of_cpus) {
+                return false;
+            }
+
+            CPU_SET(cpu, &cpu_set);
+        }
+
+        return pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set) == 0;
+    }
+
+    /// Sets the scheduling policy and priority of the calling thread
+    /// \param policy The policy, else empty to keep the current policy
+    /// \param priority The priority, else empty to keep the current priority
+    /// \returns `true` upon success, else `false`
+    static bool set_thread_scheduling(std::optional<thread_scheduling_policy> policy,
+                                      std::optional<int32_t> priority) noexcept {
+        sched_param parameters {};
+        auto current_policy {0};
+
+        if (pthread_getschedparam(pthread_self(), &current_policy, &parameters) != 0) {
+            return false;
+        }
+
+        auto native_policy = current_policy;
+
+        if (policy) {
+            switch (*policy) {
+                case thread_scheduling_policy::normal: native_policy = SCHED_OTHER; break;
+                case thread_scheduling_policy::batch: native_policy = SCHED_BATCH; break;
+                case thread_scheduling_policy::idle: native_policy = SCHED_IDLE; break;
+                case thread_scheduling_policy::fifo: native_policy = SCHED_FIFO; break;
+                case thread_scheduling_policy::round_robin: native_policy = SCHED_RR; break;
+            }
+        }
+
+        auto is_native_real_time = native_policy == SCHED_FIFO || native_policy == SCHED_RR;
+
+        if (is_native_real_time) {
+            if (priority) {
+                parameters.sched_priority = *priority;
+            } else if (parameters.sched_priority == 0) {
+                // a real-time thread needs a priority, so use the lowest
+                parameters.sched_priority = sched_get_priority_min(native_policy);
+            }
+        } else {
+            parameters.sched_priority = 0;
+        }
+
+        if ((native_policy != current_policy || is_native_real_time) &&
+            pthread_setschedparam(pthread_self(), native_policy, &parameters) != 0) {
+            return false;
+        }
+
+        // the nice value of a time-sharing thread is set per thread with its thread ID
+        if (priority && !is_native_real_time && native_policy != SCHED_IDLE) {
+            auto thread_id = static_cast<id_t>(syscall(SYS_gettid));
+
+            if (setpriority(PRIO_PROCESS, thread_id, *priority) != 0) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+#endif
+
+    bool are_thread_settings_valid(const thread_settings& settings) noexcept {
+        if (!settings.priority) {
+            return true;
+        }
+
+        if (settings.policy && is_real_time(*settings.policy)) {
+            return *settings.priority >= 1 && *settings.priority <= 99;
+        }
+
+        return *settings.priority >= -20 && *settings.priority <= 19;
+    }
+
+    bool apply_thread_settings(const thread_settings& settings) noexcept {
+#ifdef PLATFORM_LINUX
+        auto is_applied {true};
+
+        if (!settings.name.empty() && !set_thread_name(settings.name)) {
+            is_applied = false;
+        }
+
+        if (!settings.cpus.empty() && !set_thread_affinity(settings.cpus)) {
+            is_applied = false;
+        }
+
+        if ((settings.policy || settings.priority) && !set_thread_scheduling(settings.policy, settings.priority)) {
+            is_applied = false;
+        }
+
+        return is_applied;
+#else
+        // the name is only for debugging, so it is not a failure if it cannot be set
+        return settings.cpus.empty() && !settings.policy && !settings.priority;
+#endif
+    }
+
+    std::optional<thread_scheduling_policy> parse_thread_scheduling_policy(std::string_view text) noexcept {
+        if (text == "normal") {
+            return thread_scheduling_policy::normal;
+        } else if (text == "batch") {
+            return thread_scheduling_policy::batch;
+        } else if (text == "idle") {
+            return thread_scheduling_policy::idle;
+        } else if (text == "fifo") {
+            return thread_scheduling_policy::fifo;
+        } else if (text == "round_robin") {
+            return thread_scheduling_policy::round_robin;
+        }
+
+        return {};
+    }
+
+    /// Parses a CPU index
+    /// \param text The text to parse
+    /// \returns The parsed index, else empty if the text is not an index of a CPU an affinity can name
+    static std::optional<uint32_t> parse_cpu(std::string_view text) noexcept {
+        uint32_t cpu {0u};
+
+        auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), cpu);
+        if (error != std::errc() || end != text.data() + text.size() || text.empty() ||
+            cpu >= max_number_of_cpus) {
+            return {};
+        }
+
+        return cpu;
+    }
+
+    std::optional<std::vector<uint32_t>> parse_cpu_list(std::string_view text) noexcept {
+        try {
+            std::vector<uint32_t> cpus;
+
+            while (!text.empty()) {
+                auto separator = text.find(',');
+                auto item = text.substr(0u, separator);
+                text = separator == std::string_view::npos ? std::string_view() : text.substr(separator + 1u);
+
+                // a trailing separator leaves an empty item
+                if (item.empty() || (separator != std::string_view::npos && text.empty())) {
+                    return {};
+                }
+
+                auto dash = item.find('-');
+                auto first = parse_cpu(item.substr(0u, dash));
+                auto last = dash == std::string_view::npos ? first : parse_cpu(item.substr(dash + 1u));
+
+                if (!first || !last || *first > *last) {
+                    return {};
+                }
+
+                for (auto cpu = *first; cpu <= *last; ++cpu) {
+                    cpus.push_back(cpu);
+                }
+            }
+
+            if (cpus.empty()) {
+                return {};
+            }
+
+            std::sort(cpus.begin(), cpus.end());
+            cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+
+            return cpus;
+        } catch (...) {
+            return {};
+        }
+    }
+
+    /// Formats CPU indices as a list of indices and ranges, such as `0-3,6`
+    /// \param cpus The CPU indices, in ascending order
+    /// \returns The formatted indices
+    static std::string to_cpu_list(const std::vector<uint32_t>& cpus) {
+        std::stringstream ss;
+
+        for (size_t i {0u}; i < cpus.size();) {
+            auto last = i;
+            while (last + 1u < cpus.size() && cpus[last + 1u] == cpus[last] + 1u) {
+                ++last;
+            }
+
+            ss << (i > 0u ? "," : "") << cpus[i];
+            if (last > i) {
+                ss << '-' << cpus[last];
+            }
+
+            i = last + 1u;
+        }
+
+        return ss.str();
+    }
+
+    std::string to_string(const thread_settings& settings) {
+        std::stringstream ss;
+
+        ss << "name: " << (settings.name.empty() ? "inherited" : settings.name);
+        ss << ", cpus: " << (settings.cpus.empty() ? "inherited" : to_cpu_list(settings.cpus));
+        ss << ", policy: ";
+
+        if (!settings.policy) {
+            ss << "inherited";
+        } else {
+            switch (*settings.policy) {
+                case thread_scheduling_policy::normal: ss << "normal"; break;
+                case thread_scheduling_policy::batch: ss << "batch"; break;
+                case thread_scheduling_policy::idle: ss << "idle"; break;
+                case thread_scheduling_policy::fifo: ss << "fifo"; break;
+                case thread_scheduling_policy::round_robin: ss << "round_robin"; break;
+            }
+        }
+
+        ss << ", priority: ";
+
+        if (settings.priority) {
+            ss << *settings.priority;
+        } else {
+            ss << "inherited";
+        }
+
+        return ss.str();
+    }
+}
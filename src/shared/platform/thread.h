@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace pbr::shared::platform {
+    /// The policies a thread can be scheduled with
+    enum class thread_scheduling_policy {
+        /// The default time-sharing policy. The priority is the thread's nice value, from `-20` to `19`
+        normal,
+
+        /// Time-sharing for CPU heavy work that is not interactive. The priority is the thread's
+        /// nice value, from `-20` to `19`
+        batch,
+
+        /// Only runs when nothing else wants the CPU. The priority is not used
+        idle,
+
+        /// Real-time, first in first out. The priority is from `1` to `99`
+        fifo,
+
+        /// Real-time, round robin. The priority is from `1` to `99`
+        round_robin,
+    };
+
+    /// The settings of a thread. Any setting without a value is inherited from the thread that
+    /// created it
+    struct thread_settings {
+        /// The name of the thread, as shown by debuggers and `top`. It is cut to 15 characters, as
+        /// that is the most Linux allows. If this is empty, the name is not changed
+        std::string name;
+
+        /// The indices of the CPUs the thread may run on. If this is empty, the affinity is not changed
+        std::vector<uint32_t> cpus;
+
+        /// The scheduling policy of the thread
+        std::optional<thread_scheduling_policy> policy;
+
+        /// The priority of the thread, whose meaning depends on the policy
+        std::optional<int32_t> priority;
+    };
+
+    /// Returns if thread settings are in range. This does not check if the process is allowed to
+    /// apply them, as raising a priority usually needs privileges
+    /// \param settings The settings to check
+    /// \returns `true` if the settings are valid, else `false`
+    [[nodiscard]]
+    bool are_thread_settings_valid(const thread_settings& settings) noexcept;
+
+    /// Applies settings to the calling thread. Settings that cannot be applied are skipped, and
+    /// the rest are still applied. Only Linux supports the affinity and scheduling settings
+    /// \param settings The settings to apply
+    /// \returns `true` if every setting was applied, else `false`
+    [[nodiscard]]
+    bool apply_thread_settings(const thread_settings& settings) noexcept;
+
+    /// Parses a scheduling policy, one of `normal`, `batch`, `idle`, `fifo` or `round_robin`
+    /// \param text The text to parse
+    /// \returns The parsed policy, else empty if the text is not a policy
+    [[nodiscard]]
+    std::optional<thread_scheduling_policy> parse_thread_scheduling_policy(std::string_view text) noexcept;
+
+    /// Parses a list of CPU indices and ranges, such as `0-3,6`, in the same format as `taskset -c`
+    /// \param text The text to parse
+    /// \returns The parsed CPU indices in ascending order, else empty if the text is not a valid list or
+    /// names a CPU an affinity cannot, such as CPU 1024 or beyond on Linux
+    [[nodiscard]]
+    std::optional<std::vector<uint32_t>> parse_cpu_list(std::string_view text) noexcept;
+
+    /// Formats thread settings for logging
+    /// \param settings The settings to format
+    /// \returns The formatted settings
+    [[nodiscard]]
+    std::string to_string(const thread_settings& settings);
+}
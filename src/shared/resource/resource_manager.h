@@ -1,5 +1,7 @@
 #pragma once
 
+#include "shared/memory/allocation_tags.h"
+#include "shared/diagnostics/counter_registry.h"
 #include "shared/apis/logging/ilog_manager.h"
 #include "shared/data/data_manager.h"
 
@@ -45,7 +47,17 @@ namespace pbr::shared::resource {
         /// \returns The item to get. If not found, returns `nullptr`
         [[nodiscard]]
         std::shared_ptr<T> get(const std::string& name) noexcept {
+            memory::scoped_allocation_tag allocation_tag(memory::allocation_tag::resource);
+
+            auto& registry = diagnostics::get_counter_registry();
+
+            static const auto hits = registry.register_counter("resource_cache_hits");
+            static const auto misses = registry.register_counter("resource_cache_misses");
+            static const auto loaded = registry.register_counter("resource_cache_loaded");
+
             if (!this->_resources.contains(name)) {
+                registry.add(misses, 1);
+
                 if (!this->_paths.contains(name)) {
                     this->_log_manager->log_message("Failed to get resource with name: " + name,
                                                     apis::logging::log_levels::error,
@@ -64,6 +76,9 @@ namespace pbr::shared::resource {
                 }
 
                 this->_resources[name] = loaded_resource;
+                registry.add(loaded, 1);
+            } else {
+                registry.add(hits, 1);
             }
 
             return this->_resources[name];
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "shared/memory/basic_allocators.h"
+#include "shared/apis/graphics/renderable_entities.h"
 #include "scene_types.h"
 
 #include <vector>
@@ -16,5 +17,11 @@ namespace pbr::shared::scene {
         /// \returns `true` upon success else `false`
         [[nodiscard]]
         virtual bool run() noexcept = 0;
+
+        /// Submits the entities of the scenes' current state to be rendered. This is called after
+        /// each tick
+        /// \param renderable_entities The entities to submit to
+        virtual void submit_renderable_entities(apis::graphics::renderable_entities&) noexcept {
+        }
     };
 }
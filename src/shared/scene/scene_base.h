@@ -1,6 +1,7 @@
 #pragma once
 
 #include "scene_types.h"
+#include "shared/apis/graphics/renderable_entities.h"
 #include "shared/apis/logging/ilog_manager.h"
 
 #include <cassert>
@@ -33,6 +34,17 @@ namespace pbr::shared::scene {
         [[nodiscard]]
         virtual bool run() noexcept = 0;
 
+        /// Submits the entities of the scene's current state to be rendered. This is called after
+        /// the scene is run
+        /// \param renderable_entities The entities to submit to
+        virtual void submit_renderable_entities(apis::graphics::renderable_entities&) const noexcept {
+        }
+
+        /// Unloads the scene. This is called before the scene is destroyed, and should return any
+        /// large resources held by the scene, such as world data, to the system
+        virtual void unload() noexcept {
+        }
+
         /// Returns `true` if this scene should quit, else `false`
         /// \returns `true` if this scene should quit, else `false`
         [[nodiscard]]
@@ -1,7 +1,12 @@
 #include "scene_manager.h"
+#include "shared/memory/allocation_tags.h"
+#include "shared/diagnostics/tracer.h"
 
 namespace pbr::shared::scene {
     bool scene_manager::run() noexcept {
+        diagnostics::trace_zone trace_zone("scene_manager::run", "scene");
+        memory::scoped_allocation_tag allocation_tag(memory::allocation_tag::scene);
+
         if (this->_are_loading_new_scenes) {
             if (!this->_loading_scene->run()) {
                 this->_log_manager->log_message("Failed to run loading scene.",
@@ -10,7 +15,7 @@ namespace pbr::shared::scene {
                 return false;
             }
 
-            // scene loading happens in another thread, so check if that was successful
+            // scene loading happens in a job on another thread, so check if that was successful
             // here as we can return here
             if (this->_did_loading_new_scenes_fail) {
                 return false;
@@ -41,12 +46,30 @@ namespace pbr::shared::scene {
         return true;
     }
 
+    void scene_manager::submit_renderable_entities(apis::graphics::renderable_entities& renderable_entities) noexcept {
+        if (this->_are_loading_new_scenes) {
+            if (this->_loading_scene) {
+                this->_loading_scene->submit_renderable_entities(renderable_entities);
+            }
+
+            return;
+        }
+
+        for (const auto& scene : this->_loaded_scenes) {
+            scene->submit_renderable_entities(renderable_entities);
+        }
+    }
+
     bool scene_manager::setup_loading_new_scenes(bool have_scenes_quit) noexcept {
         if (!this->_loaded_scenes.empty() && !have_scenes_quit) {
             return true;
         }
 
         // destroy any previously loaded 'loading' scene
+        if (this->_loading_scene) {
+            this->_loading_scene->unload();
+        }
+
         this->_loading_scene = {};
 
         this->_loading_scene = this->_scene_factory->create_scene(this->_loading_scene_type);
@@ -67,16 +90,16 @@ namespace pbr::shared::scene {
 
         this->_are_loading_new_scenes = true;
 
-        // the scene loading thread should have finished by now - otherwise we shouldn't be here, but just in case...
-        if (this->_new_scene_loading_thread && this->_new_scene_loading_thread->joinable()) {
-            this->_new_scene_loading_thread->join();
-        }
+        auto& job_system = jobs::get_job_system();
 
-        // destroy the old thread
-        this->_new_scene_loading_thread = {};
+        // the scene loading job should have finished by now - otherwise we shouldn't be here, but just in case...
+        job_system.wait(this->_new_scene_loading_counter);
 
         // start the loading and let it run using `this->_are_loading_new_scenes` as an exit clause
-        this->_new_scene_loading_thread = std::make_unique<std::thread>([this]() {
+        auto is_job_run = job_system.run([this]() {
+            diagnostics::trace_zone trace_zone("load_new_scenes", "scene");
+            memory::scoped_allocation_tag allocation_tag(memory::allocation_tag::scene);
+
             auto next_scenes = this->_scene_factory->get_next_scenes(this->_loaded_scenes);
 
             if (!this->queue_new_scenes(next_scenes)) {
@@ -88,7 +111,14 @@ namespace pbr::shared::scene {
             }
 
             this->_are_loading_new_scenes = false;
-        });
+        }, &this->_new_scene_loading_counter);
+
+        if (!is_job_run) {
+            this->_log_manager->log_message("Failed to start loading new scenes.",
+                                            apis::logging::log_levels::error,
+                                            "Scene");
+            return false;
+        }
 
         return true;
     }
@@ -101,6 +131,10 @@ namespace pbr::shared::scene {
             return false;
         }
 
+        for (auto& scene : this->_loaded_scenes) {
+            scene->unload();
+        }
+
         this->_loaded_scenes.clear();
 
         for (const auto& type : types) {
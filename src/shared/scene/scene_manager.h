@@ -2,12 +2,12 @@
 
 #include "shared/memory/basic_allocators.h"
 #include "shared/apis/logging/log_manager.h"
+#include "shared/jobs/job_system.h"
 #include "iscene_manager.h"
 #include "iscene_factory.h"
 
 #include <cassert>
 #include <memory>
-#include <thread>
 #include <atomic>
 
 namespace pbr::shared::scene {
@@ -28,9 +28,7 @@ namespace pbr::shared::scene {
             assert((this->_log_manager));
         }
         ~scene_manager() override {
-            if (this->_new_scene_loading_thread && this->_new_scene_loading_thread->joinable()) {
-                this->_new_scene_loading_thread->join();
-            }
+            jobs::get_job_system().wait(this->_new_scene_loading_counter);
         }
 
         /// Runs the scene manager
@@ -38,6 +36,10 @@ namespace pbr::shared::scene {
         [[nodiscard]]
         bool run() noexcept override;
 
+        /// Submits the entities of the running scenes' current state to be rendered
+        /// \param renderable_entities The entities to submit to
+        void submit_renderable_entities(apis::graphics::renderable_entities& renderable_entities) noexcept override;
+
     private:
         /// The scene factory to use
         std::shared_ptr<iscene_factory> _scene_factory;
@@ -51,8 +53,8 @@ namespace pbr::shared::scene {
         /// Did the loading of new scenes fail?
         std::atomic_bool _did_loading_new_scenes_fail {false};
 
-        /// Handles loading the new scenes
-        std::unique_ptr<std::thread> _new_scene_loading_thread;
+        /// Counts the job loading the new scenes
+        jobs::job_counter _new_scene_loading_counter;
 
         /// The log manager to use
         std::shared_ptr<apis::logging::ilog_manager> _log_manager;
@@ -61,7 +63,7 @@ namespace pbr::shared::scene {
         std::shared_ptr<scene_base> _loading_scene;
 
         /// The loaded scenes
-        /// When loading new scenes, this will be used from the loading thread
+        /// When loading new scenes, this will be used from the loading job
         /// Make sure that `_are_loading_new_scenes` is false before accessing this for general use
         std::vector<std::shared_ptr<scene_base>> _loaded_scenes;
 
@@ -72,7 +74,7 @@ namespace pbr::shared::scene {
         bool setup_loading_new_scenes(bool have_scenes_quit) noexcept;
 
         /// Queues new scene types to load. Any currently loaded scenes will be destroyed
-        /// This runs on the loading thread, so do not call this from any other thread
+        /// This runs in the loading job, so do not call this from anywhere else
         /// \param types The scene types to load
         /// \returns `true` upon success else `false`. All queued scenes must successfully load to count as success.
         /// Passing an empty list of types will result in failure.
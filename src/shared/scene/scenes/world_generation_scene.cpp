@@ -1,7 +1,10 @@
 #include "world_generation_scene.h"
+#include "shared/memory/allocation_tags.h"
 
 namespace pbr::shared::scene::scenes {
     bool world_generation_scene::load() noexcept {
+        memory::scoped_allocation_tag allocation_tag(memory::allocation_tag::world);
+
         this->_log_manager->log_message("Loading the world generation scene...",
                                         apis::logging::log_levels::info,
                                         "Scene");
@@ -9,6 +12,8 @@ namespace pbr::shared::scene::scenes {
     }
 
     bool world_generation_scene::run() noexcept {
+        memory::scoped_allocation_tag allocation_tag(memory::allocation_tag::world);
+
         //this->_log_manager->log_message("Running the world generation scene...",
         // apis::logging::log_levels::info,
         // "Scene");
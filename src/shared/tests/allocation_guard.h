@@ -0,0 +1,119 @@
+#pragma once
+
+#include "catch2/catch.hpp"
+#include "shared/memory/basic_allocators.h"
+
+#include <cstdint>
+#include <string>
+
+/// The heap allocations made by a thread over a period of time
+struct allocation_counts {
+    /// The number of allocations made
+    uint64_t number_of_allocations {0u};
+
+    /// The number of bytes allocated, including the size of any headers
+    uint64_t allocated_bytes {0u};
+};
+
+/// Counts the heap allocations made by the calling thread from when this guard is constructed.
+/// Only the calling thread's allocations are counted, so allocations made by other threads, such
+/// as Catch2's or a logging endpoint's, do not affect the counts. Read the counts before making any
+/// assertions, as the assertions may allocate
+class allocation_guard {
+public:
+    /// Constructs this guard, starting the count
+    allocation_guard() noexcept
+        : _start(pbr::shared::memory::get_thread_allocation_statistics()) {
+    }
+
+    /// Returns the allocations made by the calling thread since this guard was constructed
+    /// \returns The allocations made by the calling thread since this guard was constructed
+    [[nodiscard]]
+    allocation_counts get_counts() const noexcept {
+        auto now = pbr::shared::memory::get_thread_allocation_statistics();
+
+        return {
+            .number_of_allocations = now.number_of_allocations - this->_start.number_of_allocations,
+            .allocated_bytes = now.allocated_bytes.get_value() - this->_start.allocated_bytes.get_value(),
+        };
+    }
+
+private:
+    /// The statistics of the calling thread when this guard was constructed
+    pbr::shared::memory::thread_allocation_statistics _start;
+};
+
+/// Counts the heap allocations made by a function on the calling thread
+/// \param function The function to count the allocations of
+/// \returns The allocations made by the function
+template <typename F>
+allocation_counts count_allocations(F&& function) {
+    allocation_guard guard;
+    function();
+
+    return guard.get_counts();
+}
+
+/// Matches allocation counts with at most a number of allocations and allocated bytes
+class allocation_counts_matcher : public Catch::MatcherBase<allocation_counts> {
+public:
+    /// Constructs this matcher
+    /// \param max_allocations The most allocations that match
+    /// \param max_bytes The most allocated bytes that match
+    allocation_counts_matcher(uint64_t max_allocations, uint64_t max_bytes) noexcept
+        : _max_allocations(max_allocations),
+          _max_bytes(max_bytes) {
+    }
+
+    bool match(const allocation_counts& counts) const override {
+        return counts.number_of_allocations <= this->_max_allocations &&
+               counts.allocated_bytes <= this->_max_bytes;
+    }
+
+    std::string describe() const override {
+        if (this->_max_allocations == 0u) {
+            return "makes no allocations";
+        }
+
+        return "makes at most " + std::to_string(this->_max_allocations) + " allocations of at most " +
+               std::to_string(this->_max_bytes) + " bytes";
+    }
+
+private:
+    /// The most allocations that match
+    uint64_t _max_allocations {0u};
+
+    /// The most allocated bytes that match
+    uint64_t _max_bytes {0u};
+};
+
+/// Matches allocation counts with no allocations
+/// \returns The matcher
+inline allocation_counts_matcher makes_no_allocations() noexcept {
+    return { 0u, 0u };
+}
+
+/// Matches allocation counts with at most a number of allocations
+/// \param max_allocations The most allocations that match
+/// \returns The matcher
+inline allocation_counts_matcher makes_at_most_allocations(uint64_t max_allocations) noexcept {
+    return { max_allocations, UINT64_MAX };
+}
+
+/// Matches allocation counts with at most a number of allocated bytes
+/// \param max_bytes The most allocated bytes that match
+/// \returns The matcher
+inline allocation_counts_matcher allocates_at_most_bytes(uint64_t max_bytes) noexcept {
+    return { UINT64_MAX, max_bytes };
+}
+
+namespace Catch {
+    /// Formats allocation counts in failed assertions
+    template <>
+    struct StringMaker<allocation_counts> {
+        static std::string convert(const allocation_counts& counts) {
+            return std::to_string(counts.number_of_allocations) + " allocations of " +
+                   std::to_string(counts.allocated_bytes) + " bytes";
+        }
+    };
+}
@@ -1,5 +1,6 @@
 #include "catch2/catch.hpp"
 #include "shared/apis/file/file_manager.h"
+#include "shared/jobs/job_system.h"
 #include "shared/tests/test_utils.h"
 
 #include <filesystem>
@@ -109,6 +110,26 @@ TEST_CASE("read_file_bytes_async - file system path - returns file bytes", "[sha
     }
 }
 
+TEST_CASE("read_file_bytes_async - counter - returns file bytes once waited on", "[shared/apis/file]") {
+    file_manager manager;
+
+    auto file_data_path = get_test_data_file_path("test.png");
+
+    auto expected = read_file_bytes(file_data_path);
+
+    auto uri = pbr::shared::utils::build_uri("file:///" + file_data_path.generic_string());
+    REQUIRE(uri);
+
+    std::optional<std::vector<std::byte>> result;
+    pbr::shared::jobs::job_counter counter;
+
+    manager.read_file_bytes_async(*uri, result, counter);
+    pbr::shared::jobs::get_job_system().wait(counter);
+
+    REQUIRE(result);
+    REQUIRE(expected == *result);
+}
+
 //////////
 /// read_file_text
 //////////
@@ -172,3 +193,58 @@ TEST_CASE("read_file_text_async - file system path - returns file text", "[share
 
     REQUIRE(expected == *result);
 }
+
+TEST_CASE("read_file_text_async - manager destroyed before read - returns file text", "[shared/apis/file]") {
+    auto file_data_path = get_test_data_file_path("text.txt");
+
+    auto expected = read_file_text(file_data_path);
+
+    auto uri = pbr::shared::utils::build_uri("file:///" + file_data_path.generic_string());
+    REQUIRE(uri);
+
+    std::future<std::optional<std::string>> result_future;
+
+    {
+        file_manager manager;
+        result_future = manager.read_file_text_async(*uri);
+    }
+
+    REQUIRE(result_future.valid());
+
+    auto result = result_future.get();
+    REQUIRE(result);
+
+    REQUIRE(expected == *result);
+}
+
+TEST_CASE("read_file_text_async - counter waited on from jobs - returns file text", "[shared/apis/file]") {
+    file_manager manager;
+
+    auto file_data_path = get_test_data_file_path("text.txt");
+
+    auto expected = read_file_text(file_data_path);
+
+    auto uri = pbr::shared::utils::build_uri("file:///" + file_data_path.generic_string());
+    REQUIRE(uri);
+
+    auto& job_system = pbr::shared::jobs::get_job_system();
+
+    // more jobs than workers wait on their reads, so the reads only run if waiting runs them
+    std::vector<std::optional<std::string>> results(16u);
+    pbr::shared::jobs::job_counter counter;
+
+    for (auto& result : results) {
+        REQUIRE(job_system.run([&manager, &job_system, &uri, &result]() {
+            pbr::shared::jobs::job_counter read_counter;
+            manager.read_file_text_async(*uri, result, read_counter);
+            job_system.wait(read_counter);
+        }, &counter));
+    }
+
+    job_system.wait(counter);
+
+    for (const auto& result : results) {
+        REQUIRE(result);
+        REQUIRE(expected == *result);
+    }
+}
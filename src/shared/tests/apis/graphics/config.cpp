@@ -48,6 +48,7 @@ TEST_CASE("constructor - valid api name - sets correctly", "[shared/apis/graphic
     std::vector<std::pair<std::filesystem::path, graphics::apis>> paths {
         { "config_opengl", graphics::apis::opengl, },
         { "config_vulkan", graphics::apis::vulkan, },
+        { "config_null", graphics::apis::null, },
     };
 
     for (const auto& [path, expected] : paths) {
@@ -6,6 +6,7 @@
 #include "shared/apis/file/file_manager.h"
 #include "shared/apis/graphics/vulkan/graphics_manager.h"
 #include "shared/apis/graphics/opengl/graphics_manager.h"
+#include "shared/apis/graphics/null/graphics_manager.h"
 #include "shared/tests/test_utils.h"
 
 using namespace pbr::shared;
@@ -40,6 +41,7 @@ class dummy_window : public windowing::iwindow_manager {
     std::shared_ptr<windowing::iapplication_window> create_application_window() noexcept override {return {};}
     std::shared_ptr<windowing::iapplication_window> get_main_application_window() const noexcept override {return {};}
     bool update() noexcept override {return true;}
+    bool wait_for_events(std::chrono::steady_clock::time_point) noexcept override {return false;}
     bool should_quit() const noexcept override {return true;}
 };
 
@@ -105,4 +107,23 @@ TEST_CASE("create - opengl api name - returns opengl manager", "[shared/apis/gra
 
     auto result = std::dynamic_pointer_cast<graphics::opengl::graphics_manager>(result_manager);
     REQUIRE(result);
-}
\ No newline at end of file
+}
+
+TEST_CASE("create - null api name - returns null manager", "[shared/apis/graphics/graphics_manager]") {
+    auto data_manager = create_data_manager();
+    auto window_manager = create_window_manager();
+    auto config = create_config();
+
+    config.set_api(graphics::apis::null);
+
+    auto result_manager = graphics_manager_factory::create(config,
+                                                           data_manager,
+                                                           g_log_manager,
+                                                           g_log_manager,
+                                                           window_manager,
+                                                           {},
+                                                           {});
+
+    auto result = std::dynamic_pointer_cast<graphics::null::graphics_manager>(result_manager);
+    REQUIRE(result);
+}
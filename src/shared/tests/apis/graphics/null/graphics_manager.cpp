@@ -0,0 +1,75 @@
+#include "catch2/catch.hpp"
+#include "shared/apis/graphics/null/graphics_manager.h"
+#include "shared/apis/datetime/datetime_manager.h"
+#include "shared/apis/logging/log_manager.h"
+#include "shared/tests/allocation_guard.h"
+
+using namespace pbr::shared;
+using namespace pbr::shared::apis;
+using namespace pbr::shared::apis::graphics;
+
+static auto g_datetime_manager = std::make_shared<datetime::datetime_manager>();
+static auto g_log_manager = std::make_shared<logging::log_manager>(g_datetime_manager);
+
+//////////
+/// initialize
+//////////
+
+TEST_CASE("initialize - returns true", "[shared/apis/graphics/null/graphics_manager]") {
+    null::graphics_manager manager(g_log_manager);
+
+    REQUIRE(manager.load_api(""));
+    REQUIRE(manager.initialize());
+    REQUIRE(manager.implemented_api() == graphics::apis::null);
+    REQUIRE_FALSE(manager.run_on_separate_thread());
+}
+
+//////////
+/// submit_renderable_entities
+//////////
+
+TEST_CASE("submit_renderable_entities - entities - counts and discards them", "[shared/apis/graphics/null/graphics_manager]") {
+    null::graphics_manager manager(g_log_manager);
+
+    auto& entities = manager.get_next_renderable_entities();
+    entities.submit({});
+    entities.submit({});
+
+    manager.submit_renderable_entities();
+
+    REQUIRE(manager.get_number_of_submitted_entities() == 2u);
+    REQUIRE(manager.get_next_renderable_entities().get_2d_renderable_entities().empty());
+}
+
+TEST_CASE("submit_renderable_entities - warmed up - makes no allocations", "[shared/apis/graphics/null/graphics_manager]") {
+    null::graphics_manager manager(g_log_manager);
+
+    auto submit = [&manager]() {
+        auto& entities = manager.get_next_renderable_entities();
+        entities.clear();
+
+        for (auto i {0}; i < 100; ++i) {
+            entities.submit({});
+        }
+
+        manager.submit_renderable_entities();
+        manager.submit_frame_for_render();
+    };
+
+    submit();
+
+    REQUIRE_THAT(count_allocations(submit), makes_no_allocations());
+}
+
+//////////
+/// submit_frame_for_render
+//////////
+
+TEST_CASE("submit_frame_for_render - counts frames", "[shared/apis/graphics/null/graphics_manager]") {
+    null::graphics_manager manager(g_log_manager);
+
+    manager.submit_frame_for_render();
+    manager.submit_frame_for_render();
+
+    REQUIRE(manager.get_number_of_submitted_frames() == 2u);
+}
@@ -0,0 +1,76 @@
+#include "catch2/catch.hpp"
+#include "shared/tests/allocation_guard.h"
+#include "shared/apis/graphics/renderable_entities.h"
+#include "shared/utils/triple_buffer.h"
+
+using namespace pbr::shared::apis::graphics;
+using namespace pbr::shared::utils;
+
+//////////
+/// submit
+//////////
+
+TEST_CASE("submit - reused triple buffer - makes no allocations", "[shared/apis/graphics]") {
+    triple_buffer<renderable_entities> buffer;
+    auto tick_time = std::chrono::steady_clock::now();
+
+    auto submit_frame = [&buffer, tick_time]() {
+        auto& entities = buffer.get_back_buffer();
+        entities.clear();
+
+        for (auto i {0}; i < 100; ++i) {
+            entities.submit({});
+            entities.submit_previous({});
+        }
+
+        entities.set_tick_timing(tick_time, std::chrono::milliseconds(10));
+
+        buffer.publish();
+    };
+
+    // each buffer allocates its memory the first time it is filled
+    for (auto i {0}; i < 3; ++i) {
+        submit_frame();
+        REQUIRE(buffer.update());
+    }
+
+    auto counts = count_allocations([&buffer, &submit_frame]() {
+        submit_frame();
+        [[maybe_unused]] auto is_updated = buffer.update();
+    });
+
+    REQUIRE(buffer.get_front_buffer().get_2d_renderable_entities().size() == 100u);
+    REQUIRE(buffer.get_front_buffer().get_interpolation_alpha(tick_time + std::chrono::milliseconds(5)) == Approx(0.5f));
+    REQUIRE_THAT(counts, makes_no_allocations());
+}
+
+TEST_CASE("submit - new entities - allocates", "[shared/apis/graphics]") {
+    auto counts = count_allocations([]() {
+        renderable_entities entities;
+        entities.submit({});
+    });
+
+    REQUIRE_THAT(counts, !makes_no_allocations());
+}
+
+//////////
+/// get_interpolation_alpha
+//////////
+
+TEST_CASE("get_interpolation_alpha - no tick timing - returns one", "[shared/apis/graphics]") {
+    renderable_entities entities;
+
+    REQUIRE(entities.get_interpolation_alpha(std::chrono::steady_clock::now()) == 1.0f);
+}
+
+TEST_CASE("get_interpolation_alpha - frames between ticks - rises from zero to one", "[shared/apis/graphics]") {
+    renderable_entities entities;
+
+    auto tick_time = std::chrono::steady_clock::now();
+    entities.set_tick_timing(tick_time, std::chrono::milliseconds(20));
+
+    REQUIRE(entities.get_interpolation_alpha(tick_time - std::chrono::milliseconds(5)) == 0.0f);
+    REQUIRE(entities.get_interpolation_alpha(tick_time) == 0.0f);
+    REQUIRE(entities.get_interpolation_alpha(tick_time + std::chrono::milliseconds(5)) == Approx(0.25f));
+    REQUIRE(entities.get_interpolation_alpha(tick_time + std::chrono::milliseconds(30)) == 1.0f);
+}
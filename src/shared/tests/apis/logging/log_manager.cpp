@@ -1,4 +1,5 @@
 #include "catch2/catch.hpp"
+#include "shared/tests/allocation_guard.h"
 #include "shared/apis/logging/log_manager.h"
 #include "shared/apis/datetime/datetime_manager.h"
 #include "shared/utils/strings.h"
@@ -196,6 +197,21 @@ TEST_CASE("log_message - high log level - ignores messages from lower levels", "
     REQUIRE(result == expected);
 }
 
+TEST_CASE("log_message - below log level - makes no allocations", "[shared/apis/logging]") {
+    auto datetime_manager = std::make_shared<pbr::shared::apis::datetime::datetime_manager>();
+    log_manager l(datetime_manager);
+
+    REQUIRE(l.add_endpoint(std::make_shared<test_endpoint>()));
+
+    l.set_log_level(log_levels::error);
+
+    auto counts = count_allocations([&l]() {
+        l.log_message("a message long enough that copying it would allocate", log_levels::info, "prefix");
+    });
+
+    REQUIRE_THAT(counts, makes_no_allocations());
+}
+
 TEST_CASE("log_message - single thread - passes log message to all endpoints", "[shared/apis/logging]") {
     auto datetime_manager = std::make_shared<pbr::shared::apis::datetime::datetime_manager>();
     log_manager l(datetime_manager);
@@ -0,0 +1,76 @@
+#include "catch2/catch.hpp"
+#include "shared/apis/windowing/null_window_manager.h"
+#include "shared/apis/datetime/datetime_manager.h"
+#include "shared/apis/logging/log_manager.h"
+
+#include <csignal>
+
+using namespace pbr::shared;
+using namespace pbr::shared::apis;
+using namespace pbr::shared::apis::windowing;
+
+static auto g_datetime_manager = std::make_shared<datetime::datetime_manager>();
+static auto g_log_manager = std::make_shared<logging::log_manager>(g_datetime_manager);
+
+//////////
+/// create_application_window
+//////////
+
+TEST_CASE("create_application_window - returns window", "[shared/apis/windowing/null_window_manager]") {
+    null_window_manager manager(g_log_manager);
+
+    REQUIRE(manager.initialize());
+
+    auto window = manager.create_application_window();
+
+    REQUIRE(window);
+    REQUIRE(manager.get_main_application_window() == window);
+    REQUIRE(window->get_size().width == null_window_manager::application_window_size.width);
+    REQUIRE(window->set_size(640u, 480u, true));
+    REQUIRE(window->get_size().height == 480u);
+}
+
+//////////
+/// update
+//////////
+
+TEST_CASE("update - no quit signal - does not quit", "[shared/apis/windowing/null_window_manager]") {
+    null_window_manager manager(g_log_manager);
+
+    REQUIRE(manager.initialize());
+    REQUIRE(manager.update());
+
+    REQUIRE_FALSE(manager.should_quit());
+}
+
+TEST_CASE("update - quit signal - quits", "[shared/apis/windowing/null_window_manager]") {
+    null_window_manager manager(g_log_manager);
+
+    REQUIRE(manager.initialize());
+
+    std::raise(SIGTERM);
+
+    REQUIRE(manager.update());
+    REQUIRE(manager.should_quit());
+
+    // later tests should not quit
+    REQUIRE(manager.initialize());
+}
+
+//////////
+/// wait_for_events
+//////////
+
+TEST_CASE("wait_for_events - quit signal - returns true", "[shared/apis/windowing/null_window_manager]") {
+    null_window_manager manager(g_log_manager);
+
+    REQUIRE(manager.initialize());
+    REQUIRE_FALSE(manager.wait_for_events(std::chrono::steady_clock::now()));
+
+    std::raise(SIGTERM);
+
+    REQUIRE(manager.wait_for_events(std::chrono::steady_clock::now()));
+
+    // later tests should not quit
+    REQUIRE(manager.initialize());
+}
@@ -0,0 +1,232 @@
+#include "catch2/catch.hpp"
+#include "shared/benchmarks/benchmark_comparison.h"
+
+#include <string>
+#include <vector>
+
+using namespace pbr::shared::benchmarks;
+
+/// Creates the results of runs of a benchmark, one run for each median time
+/// \param medians The median time of each run
+/// \param allocations_per_iteration The allocations per iteration of each run
+/// \returns The runs
+static std::vector<benchmark_run> create_runs(const std::vector<double>& medians,
+                                              double allocations_per_iteration = 0.0) {
+    std::vector<benchmark_run> runs;
+
+    for (auto median : medians) {
+        benchmark_result result;
+        result.name = "test/benchmark";
+        result.median = median;
+        result.allocations_per_iteration = allocations_per_iteration;
+
+        runs.push_back({ std::string(benchmark_runner::get_build_type()), { result } });
+    }
+
+    return runs;
+}
+
+//////////
+/// mann_whitney_u_test
+//////////
+
+TEST_CASE("mann_whitney_u_test - identical samples - returns about one", "[shared/benchmarks]") {
+    std::vector<double> samples { 10.0, 12.0, 11.0, 15.0, 9.0, 13.0 };
+
+    auto result = mann_whitney_u_test(samples, samples);
+
+    REQUIRE(result == Approx(1.0).margin(0.01));
+}
+
+TEST_CASE("mann_whitney_u_test - all samples tied - returns one", "[shared/benchmarks]") {
+    auto result = mann_whitney_u_test({ 5.0, 5.0, 5.0 }, { 5.0, 5.0, 5.0, 5.0 });
+
+    REQUIRE(result == 1.0);
+}
+
+TEST_CASE("mann_whitney_u_test - some samples tied - shares ranks between ties", "[shared/benchmarks]") {
+    // the three 2s share the rank 3, so U is 1, and the ties reduce the variance
+    auto result = mann_whitney_u_test({ 1.0, 2.0, 2.0 }, { 2.0, 3.0, 4.0 });
+
+    REQUIRE(result == Approx(0.16416).epsilon(0.001));
+}
+
+TEST_CASE("mann_whitney_u_test - separated samples - returns small p-value", "[shared/benchmarks]") {
+    auto result = mann_whitney_u_test({ 1.0, 2.0, 3.0, 4.0, 5.0 }, { 6.0, 7.0, 8.0, 9.0, 10.0 });
+
+    REQUIRE(result == Approx(0.012186).epsilon(0.001));
+}
+
+TEST_CASE("mann_whitney_u_test - no samples - returns one", "[shared/benchmarks]") {
+    auto result = mann_whitney_u_test({}, { 1.0, 2.0 });
+
+    REQUIRE(result == 1.0);
+}
+
+//////////
+/// compare_benchmarks
+//////////
+
+TEST_CASE("compare_benchmarks - identical runs - unchanged", "[shared/benchmarks]") {
+    auto runs = create_runs({ 100.0, 104.0, 98.0, 101.0, 103.0 });
+
+    auto result = compare_benchmarks(runs, runs);
+
+    REQUIRE(result.size() == 1u);
+    REQUIRE(result[0].verdict == benchmark_verdict::unchanged);
+    REQUIRE(result[0].number_of_baseline_runs == 5u);
+    REQUIRE(result[0].number_of_current_runs == 5u);
+    REQUIRE_FALSE(has_regression(result));
+}
+
+TEST_CASE("compare_benchmarks - every run slower - regressed", "[shared/benchmarks]") {
+    auto baseline = create_runs({ 100.0, 104.0, 98.0, 101.0, 103.0 });
+    auto current = create_runs({ 130.0, 128.0, 135.0, 131.0, 129.0 });
+
+    auto result = compare_benchmarks(baseline, current);
+
+    REQUIRE(result[0].verdict == benchmark_verdict::regressed);
+    REQUIRE(result[0].baseline_median == 101.0);
+    REQUIRE(result[0].current_median == 130.0);
+    REQUIRE(result[0].change == Approx(29.0 / 101.0));
+    REQUIRE(has_regression(result));
+}
+
+TEST_CASE("compare_benchmarks - every run faster - improved", "[shared/benchmarks]") {
+    auto baseline = create_runs({ 130.0, 128.0, 135.0, 131.0, 129.0 });
+    auto current = create_runs({ 100.0, 104.0, 98.0, 101.0, 103.0 });
+
+    auto result = compare_benchmarks(baseline, current);
+
+    REQUIRE(result[0].verdict == benchmark_verdict::improved);
+    REQUIRE_FALSE(has_regression(result));
+}
+
+TEST_CASE("compare_benchmarks - slower runs overlap - unchanged", "[shared/benchmarks]") {
+    // the medians are 30% apart, but the runs vary as much between themselves
+    auto baseline = create_runs({ 100.0, 140.0, 90.0, 135.0, 95.0 });
+    auto current = create_runs({ 130.0, 95.0, 145.0, 100.0, 138.0 });
+
+    auto result = compare_benchmarks(baseline, current);
+
+    REQUIRE(result[0].verdict == benchmark_verdict::unchanged);
+}
+
+TEST_CASE("compare_benchmarks - significant change below threshold - unchanged", "[shared/benchmarks]") {
+    auto baseline = create_runs({ 100.0, 100.5, 100.2, 100.1, 100.3 });
+    auto current = create_runs({ 102.0, 102.5, 102.2, 102.1, 102.3 });
+
+    auto result = compare_benchmarks(baseline, current);
+
+    REQUIRE(result[0].p_value < 0.05);
+    REQUIRE(result[0].verdict == benchmark_verdict::unchanged);
+}
+
+TEST_CASE("compare_benchmarks - single run each - does not compare times", "[shared/benchmarks]") {
+    auto baseline = create_runs({ 100.0 });
+    auto current = create_runs({ 200.0 });
+
+    auto result = compare_benchmarks(baseline, current);
+
+    REQUIRE(result[0].change == Approx(1.0));
+    REQUIRE(result[0].verdict == benchmark_verdict::unchanged);
+}
+
+TEST_CASE("compare_benchmarks - more allocations with equal times - regressed", "[shared/benchmarks]") {
+    auto baseline = create_runs({ 100.0, 100.0, 100.0 }, 1.0);
+    auto current = create_runs({ 100.0, 100.0, 100.0 }, 2.0);
+
+    auto result = compare_benchmarks(baseline, current);
+
+    REQUIRE(result[0].has_allocation_regression);
+    REQUIRE(result[0].verdict == benchmark_verdict::regressed);
+    REQUIRE(has_regression(result));
+}
+
+TEST_CASE("compare_benchmarks - allocations within tolerance - unchanged", "[shared/benchmarks]") {
+    auto baseline = create_runs({ 100.0 }, 1.0);
+    auto current = create_runs({ 100.0 }, 1.2);
+
+    auto result = compare_benchmarks(baseline, current);
+
+    REQUIRE_FALSE(result[0].has_allocation_regression);
+    REQUIRE(result[0].verdict == benchmark_verdict::unchanged);
+}
+
+TEST_CASE("compare_benchmarks - benchmark only in one - added and removed", "[shared/benchmarks]") {
+    auto baseline = create_runs({ 100.0 });
+    auto current = create_runs({ 100.0 });
+    current[0].results[0].name = "test/other";
+
+    auto result = compare_benchmarks(baseline, current);
+
+    REQUIRE(result.size() == 2u);
+    REQUIRE(result[0].name == "test/other");
+    REQUIRE(result[0].verdict == benchmark_verdict::added);
+    REQUIRE(result[1].name == "test/benchmark");
+    REQUIRE(result[1].verdict == benchmark_verdict::removed);
+    REQUIRE_FALSE(has_regression(result));
+}
+
+//////////
+/// can_time_change_be_significant
+//////////
+
+TEST_CASE("can_time_change_be_significant - single run each - returns false", "[shared/benchmarks]") {
+    REQUIRE_FALSE(can_time_change_be_significant(1u, 1u));
+}
+
+TEST_CASE("can_time_change_be_significant - five runs each - returns true", "[shared/benchmarks]") {
+    REQUIRE(can_time_change_be_significant(5u, 5u));
+}
+
+//////////
+/// is_comparable_with_this_build
+//////////
+
+TEST_CASE("is_comparable_with_this_build - same build type - returns true", "[shared/benchmarks]") {
+    benchmark_run run;
+    run.build_type = benchmark_runner::get_build_type();
+
+    REQUIRE(is_comparable_with_this_build(run));
+}
+
+TEST_CASE("is_comparable_with_this_build - other build type - returns false", "[shared/benchmarks]") {
+    benchmark_run run;
+    run.build_type = "OTHER";
+
+    REQUIRE_FALSE(is_comparable_with_this_build(run));
+}
+
+//////////
+/// from_json
+//////////
+
+TEST_CASE("from_json - results written by to_json - returns results", "[shared/benchmarks]") {
+    benchmark_result result;
+    result.name = "test/benchmark";
+    result.iterations_per_sample = 8u;
+    result.samples = { 1.0, 2.0, 3.0 };
+    benchmark_runner::calculate_statistics(result);
+
+    auto run = benchmark_runner::from_json(benchmark_runner::to_json({ result }));
+
+    REQUIRE(run);
+    REQUIRE(run->build_type == benchmark_runner::get_build_type());
+    REQUIRE(run->results.size() == 1u);
+    REQUIRE(run->results[0].name == "test/benchmark");
+    REQUIRE(run->results[0].median == 2.0);
+    REQUIRE(run->results[0].samples == result.samples);
+}
+
+TEST_CASE("from_json - malformed json - returns empty", "[shared/benchmarks]") {
+    REQUIRE_FALSE(benchmark_runner::from_json("{ \"build_type\": "));
+}
+
+TEST_CASE("from_json - missing build type - returns empty", "[shared/benchmarks]") {
+    REQUIRE_FALSE(benchmark_runner::from_json("{ \"benchmarks\": [] }"));
+}
+
+TEST_CASE("from_json - missing result fields - returns empty", "[shared/benchmarks]") {
+    REQUIRE_FALSE(benchmark_runner::from_json("{ \"build_type\": \"RELEASE\", \"benchmarks\": [ { \"name\": \"test\" } ] }"));
+}
@@ -82,6 +82,22 @@ TEST_CASE("read_settings - valid settings file - returns valid settings", "[shar
     REQUIRE((*array1)[1].get("string4") == "value4");
 }
 
+//////////
+/// has_settings
+//////////
+
+TEST_CASE("has_settings - invalid path - returns false", "[shared/data]") {
+    auto dm = create_data_manager();
+
+    REQUIRE_FALSE(dm.has_settings("invalid"));
+}
+
+TEST_CASE("has_settings - invalid settings file - returns true", "[shared/data]") {
+    auto dm = create_data_manager();
+
+    REQUIRE(dm.has_settings("invalid_settings"));
+}
+
 //////////
 /// read_shader_code
 //////////
@@ -1,5 +1,6 @@
 #include "catch2/catch.hpp"
 #include "test_utils.h"
+#include "shared/tests/allocation_guard.h"
 #include "shared/data/settings.h"
 
 using namespace pbr::shared;
@@ -224,6 +225,22 @@ TEST_CASE("get_as_int - known key - returns value", "[shared/data]") {
     REQUIRE(*result == expected);
 }
 
+TEST_CASE("get_as_int - known key - makes no allocations", "[shared/data]") {
+    settings settings;
+
+    std::string key = "a key long enough to not fit in a small string";
+    settings.add(key, 1234);
+
+    std::optional<int> result;
+
+    auto counts = count_allocations([&]() {
+        result = settings.get_as_int(key);
+    });
+
+    REQUIRE(result);
+    REQUIRE_THAT(counts, makes_no_allocations());
+}
+
 TEST_CASE("get_as_int - existing key - overwrites value", "[shared/data]") {
     settings settings;
 
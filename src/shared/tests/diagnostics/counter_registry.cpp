@@ -0,0 +1,230 @@
+#include <thread>
+#include <vector>
+#include <string>
+#include "catch2/catch.hpp"
+#include "shared/diagnostics/counter_registry.h"
+
+using namespace pbr::shared::diagnostics;
+
+//////////
+/// register_counter
+//////////
+
+TEST_CASE("register_counter - new name - returns valid handle", "[shared/diagnostics]") {
+    counter_registry registry;
+
+    auto result = registry.register_counter("counter");
+
+    REQUIRE(result.is_valid());
+    REQUIRE(registry.get_name(result) == "counter");
+    REQUIRE(registry.get(result) == 0);
+    REQUIRE(registry.get_number_of_counters() == 1u);
+}
+
+TEST_CASE("register_counter - existing name - returns existing handle", "[shared/diagnostics]") {
+    counter_registry registry;
+
+    auto first = registry.register_counter("counter");
+    auto result = registry.register_counter("counter");
+
+    REQUIRE(result == first);
+    REQUIRE(registry.get_number_of_counters() == 1u);
+}
+
+TEST_CASE("register_counter - registry full - returns invalid handle", "[shared/diagnostics]") {
+    counter_registry registry(2u);
+
+    REQUIRE(registry.register_counter("first").is_valid());
+    REQUIRE(registry.register_counter("second").is_valid());
+
+    auto result = registry.register_counter("third");
+
+    REQUIRE_FALSE(result.is_valid());
+    REQUIRE(registry.register_counter("first").is_valid());
+}
+
+TEST_CASE("register_counter - multiple threads - registers each name once", "[shared/diagnostics]") {
+    counter_registry registry;
+
+    auto number_of_threads = 4;
+    auto number_of_names = 50;
+
+    std::vector<std::vector<counter_handle>> handles(number_of_threads);
+    std::vector<std::thread> threads;
+
+    for (auto t {0}; t < number_of_threads; ++t) {
+        threads.emplace_back([&registry, &handles, number_of_names, t]() {
+            for (auto i {0}; i < number_of_names; ++i) {
+                handles[t].push_back(registry.register_counter("counter" + std::to_string(i)));
+            }
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    REQUIRE(registry.get_number_of_counters() == static_cast<size_t>(number_of_names));
+
+    for (auto t {1}; t < number_of_threads; ++t) {
+        REQUIRE(handles[t] == handles[0]);
+    }
+}
+
+//////////
+/// find_counter
+//////////
+
+TEST_CASE("find_counter - registered name - returns handle", "[shared/diagnostics]") {
+    counter_registry registry;
+
+    auto handle = registry.register_counter("counter");
+
+    auto result = registry.find_counter("counter");
+
+    REQUIRE(result == handle);
+}
+
+TEST_CASE("find_counter - unknown name - returns invalid handle", "[shared/diagnostics]") {
+    counter_registry registry;
+
+    [[maybe_unused]] auto handle = registry.register_counter("counter");
+
+    auto result = registry.find_counter("unknown");
+
+    REQUIRE_FALSE(result.is_valid());
+    REQUIRE(registry.get_number_of_counters() == 1u);
+}
+
+//////////
+/// add
+//////////
+
+TEST_CASE("add - multiple threads - counts every update", "[shared/diagnostics]") {
+    counter_registry registry;
+
+    auto handle = registry.register_counter("counter");
+
+    auto number_of_threads = 4;
+    auto number_of_updates = 100'000;
+
+    std::vector<std::thread> threads;
+
+    for (auto t {0}; t < number_of_threads; ++t) {
+        threads.emplace_back([&registry, handle, number_of_updates]() {
+            for (auto i {0}; i < number_of_updates; ++i) {
+                registry.add(handle, 1);
+            }
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    REQUIRE(registry.get(handle) == number_of_threads * number_of_updates);
+}
+
+TEST_CASE("add - invalid handle - does nothing", "[shared/diagnostics]") {
+    counter_registry registry;
+
+    registry.add({}, 1);
+
+    REQUIRE(registry.get({}) == 0);
+}
+
+//////////
+/// set and exchange
+//////////
+
+TEST_CASE("set - sets counter", "[shared/diagnostics]") {
+    counter_registry registry;
+
+    auto handle = registry.register_counter("counter");
+
+    registry.add(handle, 5);
+    registry.set(handle, -3);
+
+    REQUIRE(registry.get(handle) == -3);
+}
+
+TEST_CASE("exchange - returns previous value", "[shared/diagnostics]") {
+    counter_registry registry;
+
+    auto handle = registry.register_counter("counter");
+    registry.add(handle, 5);
+
+    auto result = registry.exchange(handle, 0);
+
+    REQUIRE(result == 5);
+    REQUIRE(registry.get(handle) == 0);
+}
+
+//////////
+/// update_max
+//////////
+
+TEST_CASE("update_max - only greater values - set counter", "[shared/diagnostics]") {
+    counter_registry registry;
+
+    auto handle = registry.register_counter("counter");
+
+    registry.update_max(handle, 5);
+    registry.update_max(handle, 3);
+
+    REQUIRE(registry.get(handle) == 5);
+
+    registry.update_max(handle, 8);
+
+    REQUIRE(registry.get(handle) == 8);
+}
+
+//////////
+/// snapshot
+//////////
+
+TEST_CASE("snapshot - returns all counters in registration order", "[shared/diagnostics]") {
+    counter_registry registry;
+
+    auto first = registry.register_counter("first");
+    auto second = registry.register_counter("second");
+
+    registry.add(first, 1);
+    registry.add(second, 2);
+
+    auto result = registry.snapshot();
+
+    REQUIRE(result.size() == 2u);
+    REQUIRE(result[0].name == "first");
+    REQUIRE(result[0].value == 1);
+    REQUIRE(result[1].name == "second");
+    REQUIRE(result[1].value == 2);
+}
+
+TEST_CASE("snapshot - while writers update - does not block", "[shared/diagnostics]") {
+    counter_registry registry;
+
+    auto handle = registry.register_counter("counter");
+
+    std::atomic_bool should_stop {false};
+
+    std::thread writer([&registry, handle, &should_stop]() {
+        while (!should_stop) {
+            registry.add(handle, 1);
+        }
+    });
+
+    int64_t previous {0};
+
+    for (auto i {0}; i < 1000; ++i) {
+        auto result = registry.snapshot();
+
+        REQUIRE(result.size() == 1u);
+        REQUIRE(result[0].value >= previous);
+
+        previous = result[0].value;
+    }
+
+    should_stop = true;
+    writer.join();
+}
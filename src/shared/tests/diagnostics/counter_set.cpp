@@ -1,9 +1,29 @@
 #include <thread>
 #include "catch2/catch.hpp"
+#include "shared/tests/allocation_guard.h"
 #include "shared/diagnostics/counter_set.h"
+#include "shared/apis/datetime/datetime_manager.h"
+#include "shared/apis/logging/log_manager.h"
+
+#include <memory>
+#include <string>
+#include <vector>
 
 using namespace pbr::shared::diagnostics;
 
+/// Records the messages logged by a counter set
+class dropped_update_endpoint : public pbr::shared::apis::logging::endpoint {
+public:
+    /// The logged messages
+    std::vector<std::string> messages;
+
+    /// Records a message
+    /// \param message The message to record
+    void log(std::string_view message, pbr::shared::apis::logging::log_levels) noexcept override {
+        this->messages.emplace_back(message);
+    }
+};
+
 //////////
 /// increment
 //////////
@@ -40,6 +60,24 @@ TEST_CASE("decrement - valid amount - decrements counter", "[shared/diagnostics]
     REQUIRE(result == -value * 2);
 }
 
+//////////
+/// set
+//////////
+
+TEST_CASE("set - valid value - sets counter", "[shared/diagnostics]") {
+    counter_set c;
+
+    auto key = "key";
+    auto value = 10;
+
+    c.increment_counter(key, 5);
+    c.set_counter(key, value);
+
+    auto result = c.get_counter(key);
+
+    REQUIRE(result == value);
+}
+
 //////////
 /// add_value_to_list
 //////////
@@ -127,7 +165,10 @@ TEST_CASE("get_counter_for_duration - returns values", "[shared/diagnostics]") {
     c.get_counter_for_duration(key, duration, result_on_duration);
     result_on_duration = 0;
 
-    while (std::chrono::system_clock::now() - now < duration) {
+    // stop short of the duration, so the last call cannot be preempted past it
+    auto loop_duration = duration - std::chrono::milliseconds(50);
+
+    while (std::chrono::system_clock::now() - now < loop_duration) {
         expected += value;
 
         c.increment_counter(key, value);
@@ -186,3 +227,94 @@ TEST_CASE("get_average_for_duration - returns values", "[shared/diagnostics]") {
     REQUIRE(result == expected);
     REQUIRE(result_on_duration == expected);
 }
+
+//////////
+/// handles
+//////////
+
+TEST_CASE("register_counter - same key - returns same handle", "[shared/diagnostics]") {
+    counter_set c;
+
+    auto first = c.register_counter("key");
+    auto second = c.register_counter("key");
+
+    REQUIRE(first.is_valid());
+    REQUIRE(first == second);
+}
+
+TEST_CASE("increment - handle - increments counter for key", "[shared/diagnostics]") {
+    counter_set c;
+
+    auto handle = c.register_counter("key");
+
+    c.increment_counter(handle, 3);
+    c.increment_counter("key", 4);
+    c.decrement_counter(handle, 2);
+
+    REQUIRE(c.get_counter(handle) == 5);
+    REQUIRE(c.get_counter("key") == 5);
+}
+
+TEST_CASE("get_counter - unknown key - returns zero without registering", "[shared/diagnostics]") {
+    counter_set c;
+
+    auto result = c.get_counter("unknown");
+
+    REQUIRE(result == 0);
+    REQUIRE(c.get_registry().get_number_of_counters() == 0u);
+}
+
+TEST_CASE("increment_counter - set full - drops update and logs once", "[shared/diagnostics]") {
+    auto datetime_manager = std::make_shared<pbr::shared::apis::datetime::datetime_manager>();
+    auto log_manager = std::make_shared<pbr::shared::apis::logging::log_manager>(datetime_manager);
+    auto endpoint = std::make_shared<dropped_update_endpoint>();
+    REQUIRE(log_manager->add_endpoint(endpoint));
+
+    counter_set c(log_manager, 1u);
+
+    c.increment_counter("registered", 1);
+    c.increment_counter("overflowing", 1);
+    c.increment_counter("overflowing", 1);
+    c.increment_counter("registered", 1);
+
+    REQUIRE(c.get_counter("registered") == 2);
+    REQUIRE(c.get_counter("overflowing") == 0);
+    REQUIRE(c.get_number_of_dropped_updates() == 2u);
+    REQUIRE(endpoint->messages.size() == 1u);
+    REQUIRE(endpoint->messages[0].find("overflowing") != std::string::npos);
+}
+
+//////////
+/// allocations
+//////////
+
+TEST_CASE("increment_counter - by handle - makes no allocations", "[shared/diagnostics]") {
+    counter_set c;
+
+    auto handle = c.register_counter("key");
+
+    auto counts = count_allocations([&c, handle]() {
+        c.increment_counter(handle, 1);
+        c.decrement_counter(handle, 2);
+        c.set_counter(handle, 3);
+    });
+
+    REQUIRE(c.get_counter(handle) == 3);
+    REQUIRE_THAT(counts, makes_no_allocations());
+}
+
+TEST_CASE("increment_counter - by registered key - makes no allocations", "[shared/diagnostics]") {
+    counter_set c;
+
+    auto key = "a key long enough to not fit in a small string";
+    c.set_counter(key, 0);
+
+    auto counts = count_allocations([&c, key]() {
+        c.increment_counter(key, 1);
+        c.decrement_counter(key, 2);
+        c.set_counter(key, 3);
+    });
+
+    REQUIRE(c.get_counter(key) == 3);
+    REQUIRE_THAT(counts, makes_no_allocations());
+}
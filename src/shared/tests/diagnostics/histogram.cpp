@@ -0,0 +1,215 @@
+#include <chrono>
+#include "catch2/catch.hpp"
+#include "shared/diagnostics/histogram.h"
+
+using namespace pbr::shared::diagnostics;
+using namespace std::chrono_literals;
+
+//////////
+/// get_bucket_index
+//////////
+
+TEST_CASE("get_bucket_index - highest value of bucket - is in that bucket", "[shared/diagnostics]") {
+    for (size_t i {0u}; i < histogram::number_of_buckets; ++i) {
+        auto value = histogram::get_bucket_highest_value(i);
+
+        REQUIRE(histogram::get_bucket_index(value) == i);
+        REQUIRE(histogram::get_bucket_index(value + 1u) == std::min(i + 1u, histogram::number_of_buckets - 1u));
+    }
+}
+
+TEST_CASE("get_bucket_index - value - bucket is within precision", "[shared/diagnostics]") {
+    for (uint64_t value {1u}; value < histogram::max_value; value = value * 3u + 1u) {
+        auto highest = histogram::get_bucket_highest_value(histogram::get_bucket_index(value));
+
+        REQUIRE(highest >= value);
+        REQUIRE(static_cast<double>(highest - value) <= static_cast<double>(value) / histogram::sub_bucket_count);
+    }
+}
+
+//////////
+/// record
+//////////
+
+TEST_CASE("record - values - returns min, max and mean", "[shared/diagnostics]") {
+    histogram h;
+
+    h.record(1ms);
+    h.record(2ms);
+    h.record(3ms);
+
+    auto result = h.get_statistics();
+
+    REQUIRE(result.count == 3u);
+    REQUIRE(result.min == 1ms);
+    REQUIRE(result.max == 3ms);
+    REQUIRE(result.mean == 2ms);
+}
+
+TEST_CASE("record - negative value - recorded as zero", "[shared/diagnostics]") {
+    histogram h;
+
+    h.record(-5ns);
+
+    auto result = h.get_statistics();
+
+    REQUIRE(result.count == 1u);
+    REQUIRE(result.max == 0ns);
+}
+
+TEST_CASE("record - larger than max value - clamped to max value", "[shared/diagnostics]") {
+    histogram h;
+
+    h.record(std::chrono::hours(1));
+
+    auto result = h.get_statistics();
+
+    REQUIRE(result.max == std::chrono::nanoseconds(histogram::max_value));
+}
+
+//////////
+/// get_percentile
+//////////
+
+TEST_CASE("get_percentile - no values - returns zero", "[shared/diagnostics]") {
+    histogram h;
+
+    auto result = h.get_percentile(50.0);
+
+    REQUIRE(result == 0ns);
+}
+
+TEST_CASE("get_percentile - uniform values - returns values within precision", "[shared/diagnostics]") {
+    histogram h;
+
+    for (auto i {1}; i <= 1000; ++i) {
+        h.record(std::chrono::microseconds(i));
+    }
+
+    auto check = [&h](double percentile, std::chrono::nanoseconds expected) {
+        auto result = h.get_percentile(percentile);
+
+        REQUIRE(result >= expected);
+        REQUIRE(result.count() <= expected.count() + expected.count() / histogram::sub_bucket_count);
+    };
+
+    check(50.0, 500us);
+    check(95.0, 950us);
+    check(99.0, 990us);
+    check(99.9, 999us);
+    check(100.0, 1000us);
+
+    REQUIRE(h.get_percentile(0.0) == 1us);
+}
+
+TEST_CASE("get_statistics - single value - all percentiles are the value", "[shared/diagnostics]") {
+    histogram h;
+
+    h.record(16'666'667ns);
+
+    auto result = h.get_statistics();
+
+    REQUIRE(result.p50 == 16'666'667ns);
+    REQUIRE(result.p999 == 16'666'667ns);
+}
+
+//////////
+/// merge
+//////////
+
+TEST_CASE("merge - combines values", "[shared/diagnostics]") {
+    histogram first;
+    histogram second;
+
+    first.record(1ms);
+    second.record(5ms);
+    second.record(3ms);
+
+    first.merge(second);
+
+    auto result = first.get_statistics();
+
+    REQUIRE(result.count == 3u);
+    REQUIRE(result.min == 1ms);
+    REQUIRE(result.max == 5ms);
+    REQUIRE(result.mean == 3ms);
+}
+
+//////////
+/// reset
+//////////
+
+TEST_CASE("reset - removes values", "[shared/diagnostics]") {
+    histogram h;
+
+    h.record(1ms);
+    h.reset();
+
+    auto result = h.get_statistics();
+
+    REQUIRE(result.count == 0u);
+    REQUIRE(h.get_percentile(99.0) == 0ns);
+}
+
+//////////
+/// rolling_histogram
+//////////
+
+TEST_CASE("rolling_histogram - within window - includes values", "[shared/diagnostics]") {
+    rolling_histogram h(1s, 4u);
+
+    auto now = rolling_histogram::clock::now();
+
+    h.record(1ms, now);
+    h.record(2ms, now + 500ms);
+
+    auto result = h.get_statistics(now + 600ms);
+
+    REQUIRE(result.count == 2u);
+    REQUIRE(result.max == 2ms);
+}
+
+TEST_CASE("rolling_histogram - after window - drops old values", "[shared/diagnostics]") {
+    rolling_histogram h(1s, 4u);
+
+    auto now = rolling_histogram::clock::now();
+
+    h.record(10ms, now);
+    h.record(1ms, now + 900ms);
+
+    auto result = h.get_statistics(now + 1100ms);
+
+    REQUIRE(result.count == 1u);
+    REQUIRE(result.max == 1ms);
+}
+
+TEST_CASE("rolling_histogram - long pause - drops all values", "[shared/diagnostics]") {
+    rolling_histogram h(1s, 4u);
+
+    auto now = rolling_histogram::clock::now();
+
+    h.record(10ms, now);
+
+    auto result = h.get_statistics(now + 1h);
+
+    REQUIRE(result.count == 0u);
+
+    h.record(1ms, now + 1h);
+
+    REQUIRE(h.get_statistics(now + 1h).count == 1u);
+}
+
+//////////
+/// to_string
+//////////
+
+TEST_CASE("to_string - returns statistics in milliseconds", "[shared/diagnostics]") {
+    histogram h;
+
+    h.record(2ms);
+
+    auto result = to_string(h.get_statistics());
+
+    REQUIRE(result.find("count: 1") != std::string::npos);
+    REQUIRE(result.find("p99.9: 2.000ms") != std::string::npos);
+}
@@ -0,0 +1,271 @@
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include "catch2/catch.hpp"
+#include "shared/diagnostics/metrics_exporter.h"
+#include "shared/platform/platform.h"
+
+#if defined(PLATFORM_LINUX) || defined(PLATFORM_MAC)
+#include <cstring>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+using namespace pbr::shared::diagnostics;
+using namespace std::chrono_literals;
+
+/// Creates an empty directory for a test's output, removing it when the test ends
+struct scoped_metrics_directory {
+    std::filesystem::path path {std::filesystem::temp_directory_path() / "pbr_metrics_exporter_test"};
+
+    scoped_metrics_directory() {
+        std::filesystem::remove_all(this->path);
+        std::filesystem::create_directories(this->path);
+    }
+
+    ~scoped_metrics_directory() {
+        std::error_code error;
+        std::filesystem::remove_all(this->path, error);
+    }
+};
+
+/// Reads the contents of a file
+/// \param path The path of the file
+/// \returns The contents of the file
+static std::string read_file(const std::filesystem::path& path) {
+    std::ifstream file(path);
+    std::stringstream contents;
+    contents << file.rdbuf();
+    return contents.str();
+}
+
+//////////
+/// to_prometheus_text
+//////////
+
+TEST_CASE("to_prometheus_text - snapshot - writes prefixed sanitized gauges", "[shared/diagnostics]") {
+    std::vector<counter_snapshot_entry> snapshot {
+        { .name = "fps", .value = 60 },
+        { .name = "frame.time-ms", .value = -2 },
+    };
+
+    auto result = metrics_exporter::to_prometheus_text(snapshot);
+
+    REQUIRE(result == "# TYPE pbr_fps gauge\n"
+                      "pbr_fps 60\n"
+                      "# TYPE pbr_frame_time_ms gauge\n"
+                      "pbr_frame_time_ms -2\n");
+}
+
+//////////
+/// to_json_line
+//////////
+
+TEST_CASE("to_json_line - snapshot - writes single json line", "[shared/diagnostics]") {
+    std::vector<counter_snapshot_entry> snapshot {
+        { .name = "fps", .value = 60 },
+        { .name = "frame time", .value = 16 },
+    };
+
+    auto timestamp = std::chrono::system_clock::time_point(std::chrono::milliseconds(1234));
+
+    auto result = metrics_exporter::to_json_line(snapshot, timestamp);
+
+    REQUIRE(result == R"({"timestamp_ms":1234,"metrics":{"fps":60,"frame_time":16}})");
+}
+
+//////////
+/// snapshot
+//////////
+
+TEST_CASE("snapshot - includes counters and memory statistics", "[shared/diagnostics]") {
+    counter_registry registry;
+    registry.set(registry.register_counter("test_counter"), 42);
+
+    metrics_exporter exporter({}, registry);
+
+    auto result = exporter.snapshot();
+
+    auto find = [&result](std::string_view name) {
+        return std::find_if(result.begin(), result.end(), [name](const auto& entry) {
+            return entry.name == name;
+        });
+    };
+
+    REQUIRE(find("test_counter") != result.end());
+    REQUIRE(find("test_counter")->value == 42);
+    REQUIRE(find("memory_allocated_bytes") != result.end());
+    REQUIRE(find("memory_graphics_live_bytes") != result.end());
+}
+
+//////////
+/// export_metrics
+//////////
+
+TEST_CASE("export_metrics - paths set - writes prometheus and json lines files", "[shared/diagnostics]") {
+    scoped_metrics_directory directory;
+
+    counter_registry registry;
+    registry.set(registry.register_counter("test_counter"), 7);
+
+    metrics_exporter_settings settings;
+    settings.prometheus_path = directory.path / "metrics.prom";
+    settings.json_lines_path = directory.path / "metrics.jsonl";
+
+    metrics_exporter exporter(settings, registry);
+
+    REQUIRE(exporter.export_metrics());
+    REQUIRE(exporter.export_metrics());
+
+    auto prometheus_text = read_file(settings.prometheus_path);
+    REQUIRE(prometheus_text.find("pbr_test_counter 7\n") != std::string::npos);
+    REQUIRE_FALSE(std::filesystem::exists(directory.path / "metrics.prom.tmp"));
+
+    auto json_lines = read_file(settings.json_lines_path);
+    REQUIRE(std::count(json_lines.begin(), json_lines.end(), '\n') == 2);
+    REQUIRE(json_lines.find(R"("test_counter":7)") != std::string::npos);
+}
+
+TEST_CASE("export_metrics - json lines file too large - rotates file", "[shared/diagnostics]") {
+    scoped_metrics_directory directory;
+
+    counter_registry registry;
+
+    metrics_exporter_settings settings;
+    settings.json_lines_path = directory.path / "metrics.jsonl";
+    settings.max_json_lines_file_size = pbr::shared::memory::bytes(1u);
+    settings.number_of_rotated_json_lines_files = 2u;
+
+    metrics_exporter exporter(settings, registry);
+
+    for (auto i {0}; i < 4; ++i) {
+        REQUIRE(exporter.export_metrics());
+    }
+
+    REQUIRE(std::filesystem::exists(directory.path / "metrics.jsonl"));
+    REQUIRE(std::filesystem::exists(directory.path / "metrics.jsonl.1"));
+    REQUIRE(std::filesystem::exists(directory.path / "metrics.jsonl.2"));
+    REQUIRE_FALSE(std::filesystem::exists(directory.path / "metrics.jsonl.3"));
+}
+
+TEST_CASE("export_metrics - invalid path - returns false", "[shared/diagnostics]") {
+    counter_registry registry;
+
+    metrics_exporter_settings settings;
+    settings.prometheus_path = std::filesystem::temp_directory_path() / "pbr_missing_directory" / "metrics.prom";
+
+    metrics_exporter exporter(settings, registry);
+
+    REQUIRE_FALSE(exporter.export_metrics());
+}
+
+//////////
+/// start
+//////////
+
+TEST_CASE("start - stopped - exports metrics", "[shared/diagnostics]") {
+    scoped_metrics_directory directory;
+
+    counter_registry registry;
+    auto handle = registry.register_counter("test_counter");
+
+    metrics_exporter_settings settings;
+    settings.prometheus_path = directory.path / "metrics.prom";
+    settings.interval = 10ms;
+
+    metrics_exporter exporter(settings, registry);
+
+    REQUIRE(exporter.start());
+    REQUIRE(exporter.is_running());
+    REQUIRE_FALSE(exporter.start());
+
+    registry.set(handle, 3);
+
+    exporter.stop();
+    REQUIRE_FALSE(exporter.is_running());
+
+    // the final export happens after the counter was set
+    auto prometheus_text = read_file(settings.prometheus_path);
+    REQUIRE(prometheus_text.find("pbr_test_counter 3\n") != std::string::npos);
+}
+
+#if defined(PLATFORM_LINUX) || defined(PLATFORM_MAC)
+TEST_CASE("start - socket path set - serves prometheus text", "[shared/diagnostics]") {
+    scoped_metrics_directory directory;
+
+    counter_registry registry;
+    registry.set(registry.register_counter("test_counter"), 5);
+
+    metrics_exporter_settings settings;
+    settings.socket_path = directory.path / "metrics.sock";
+    settings.interval = 10ms;
+
+    metrics_exporter exporter(settings, registry);
+    REQUIRE(exporter.start());
+
+    auto client = socket(AF_UNIX, SOCK_STREAM, 0);
+    REQUIRE(client >= 0);
+
+    sockaddr_un address {};
+    address.sun_family = AF_UNIX;
+    std::strcpy(address.sun_path, settings.socket_path.c_str());
+
+    REQUIRE(connect(client, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0);
+
+    std::string received;
+    char buffer[256];
+
+    while (true) {
+        auto result = read(client, buffer, sizeof(buffer));
+        if (result <= 0) {
+            break;
+        }
+
+        received.append(buffer, static_cast<size_t>(result));
+    }
+
+    close(client);
+    exporter.stop();
+
+    REQUIRE(received.find("pbr_test_counter 5\n") != std::string::npos);
+    REQUIRE_FALSE(std::filesystem::exists(settings.socket_path));
+}
+
+TEST_CASE("start - socket path is a file - returns false and keeps file", "[shared/diagnostics]") {
+    scoped_metrics_directory directory;
+
+    counter_registry registry;
+
+    metrics_exporter_settings settings;
+    settings.socket_path = directory.path / "metrics.sock";
+
+    std::ofstream(settings.socket_path) << "not a socket";
+
+    metrics_exporter exporter(settings, registry);
+
+    REQUIRE_FALSE(exporter.start());
+    REQUIRE(read_file(settings.socket_path) == "not a socket");
+}
+#endif
+
+//////////
+/// publish_thread_allocation_statistics
+//////////
+
+TEST_CASE("publish_thread_allocation_statistics - publishes gauges for thread", "[shared/diagnostics]") {
+    counter_registry registry;
+
+    auto allocation = std::make_unique<int>(1);
+
+    publish_thread_allocation_statistics("test", registry);
+
+    auto allocated_bytes = registry.find_counter("thread_test_allocated_bytes");
+
+    REQUIRE(allocated_bytes.is_valid());
+    REQUIRE(registry.find_counter("thread_test_freed_bytes").is_valid());
+    REQUIRE(registry.find_counter("thread_test_peak_bytes").is_valid());
+    REQUIRE(registry.find_counter("thread_test_allocations").is_valid());
+    REQUIRE(registry.find_counter("thread_test_frees").is_valid());
+    REQUIRE(registry.get(allocated_bytes) > 0);
+}
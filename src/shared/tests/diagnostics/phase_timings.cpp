@@ -0,0 +1,125 @@
+#include <thread>
+#include "catch2/catch.hpp"
+#include "shared/diagnostics/phase_timings.h"
+
+using namespace pbr::shared::diagnostics;
+using namespace std::chrono_literals;
+
+//////////
+/// record
+//////////
+
+TEST_CASE("record - valid phase - records in that phase only", "[shared/diagnostics]") {
+    phase_timings timings({"first", "second"});
+
+    auto now = phase_timings::clock::now();
+
+    timings.record(1u, 2ms, now);
+    timings.record(1u, 4ms, now);
+
+    auto first = timings.get_statistics(0u);
+    auto second = timings.get_statistics(1u);
+
+    REQUIRE(first.count == 0u);
+    REQUIRE(second.count == 2u);
+    REQUIRE(second.min == 2ms);
+    REQUIRE(second.max == 4ms);
+}
+
+TEST_CASE("record - invalid phase - records nothing", "[shared/diagnostics]") {
+    phase_timings timings({"first"});
+
+    timings.record(1u, 2ms, phase_timings::clock::now());
+
+    REQUIRE(timings.get_statistics(0u).count == 0u);
+    REQUIRE(timings.get_statistics(1u).count == 0u);
+}
+
+TEST_CASE("record - multiple threads - records every value", "[shared/diagnostics]") {
+    constexpr size_t number_of_threads {4u};
+    constexpr size_t values_per_thread {1000u};
+
+    phase_timings timings({"phase"}, 1h);
+
+    std::vector<std::thread> threads;
+    for (size_t i {0u}; i < number_of_threads; ++i) {
+        threads.emplace_back([&timings]() {
+            for (size_t j {0u}; j < values_per_thread; ++j) {
+                timings.record(0u, 1us, phase_timings::clock::now());
+            }
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    REQUIRE(timings.get_statistics(0u).count == number_of_threads * values_per_thread);
+}
+
+//////////
+/// scoped_phase_timer
+//////////
+
+TEST_CASE("scoped_phase_timer - scope ends - records scope duration", "[shared/diagnostics]") {
+    phase_timings timings({"phase"});
+
+    {
+        scoped_phase_timer timer(timings, 0u);
+        std::this_thread::sleep_for(2ms);
+    }
+
+    auto statistics = timings.get_statistics(0u);
+
+    REQUIRE(statistics.count == 1u);
+    REQUIRE(statistics.min >= 2ms);
+}
+
+//////////
+/// get_phase_name
+//////////
+
+TEST_CASE("get_phase_name - returns names by index", "[shared/diagnostics]") {
+    phase_timings timings({"first", "second"});
+
+    REQUIRE(timings.get_number_of_phases() == 2u);
+    REQUIRE(timings.get_phase_name(0u) == "first");
+    REQUIRE(timings.get_phase_name(1u) == "second");
+    REQUIRE(timings.get_phase_name(2u).empty());
+}
+
+//////////
+/// get_summary
+//////////
+
+TEST_CASE("get_summary - returns every phase on one line", "[shared/diagnostics]") {
+    phase_timings timings({"first", "second"});
+
+    timings.record(0u, 1500us, phase_timings::clock::now());
+
+    auto result = timings.get_summary();
+
+    REQUIRE(result.find('\n') == std::string::npos);
+    REQUIRE(result.starts_with("first p50: "));
+    REQUIRE(result.find("max: 1.500ms") != std::string::npos);
+    REQUIRE(result.find(" | second p50: 0.000ms") != std::string::npos);
+}
+
+//////////
+/// publish
+//////////
+
+TEST_CASE("publish - recorded phases - sets gauges in registry", "[shared/diagnostics]") {
+    phase_timings timings({"first"});
+    counter_registry registry;
+
+    timings.record(0u, 2ms, phase_timings::clock::now());
+    timings.publish("test", registry);
+
+    auto p50 = registry.find_counter("test_first_p50_ns");
+    auto max = registry.find_counter("test_first_max_ns");
+
+    REQUIRE(p50.is_valid());
+    REQUIRE(registry.find_counter("test_first_p99_ns").is_valid());
+    REQUIRE(registry.get(max) == std::chrono::nanoseconds(2ms).count());
+}
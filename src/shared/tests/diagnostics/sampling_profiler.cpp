@@ -0,0 +1,102 @@
+#include <chrono>
+#include <filesystem>
+#include <thread>
+#include "catch2/catch.hpp"
+#include "shared/diagnostics/sampling_profiler.h"
+
+using namespace pbr::shared::diagnostics;
+using namespace std::chrono_literals;
+
+/// Uses CPU time until a duration has passed. This is not static and not inlined, so it can be
+/// found by name in the profile
+/// \param duration The time to use the CPU for
+/// \returns A value, so the work is not optimized away
+[[gnu::noinline]]
+uint64_t sampling_profiler_test_busy_work(std::chrono::milliseconds duration) {
+    volatile uint64_t value {0u};
+
+    auto end = std::chrono::steady_clock::now() + duration;
+    while (std::chrono::steady_clock::now() < end) {
+        for (auto i {0}; i < 1000; ++i) {
+            value = value + static_cast<uint64_t>(i);
+        }
+    }
+
+    return value;
+}
+
+//////////
+/// start_sampling_profiler
+//////////
+
+TEST_CASE("start_sampling_profiler - invalid interval - returns false", "[shared/diagnostics]") {
+    auto result = start_sampling_profiler(0us);
+
+    REQUIRE_FALSE(result);
+}
+
+TEST_CASE("start_sampling_profiler - busy thread - records collapsed stacks", "[shared/diagnostics]") {
+    if (!is_sampling_profiler_supported()) {
+        return;
+    }
+
+    // the test binary is profiling every test, which these samples would be mixed into
+    if (is_sampling_profiler_running()) {
+        return;
+    }
+
+    REQUIRE(start_sampling_profiler(500us));
+    clear_sampling_profiler();
+
+    std::thread thread([]() {
+        REQUIRE(register_sampling_profiler_thread("Profiled Worker"));
+        sampling_profiler_test_busy_work(200ms);
+    });
+    thread.join();
+
+    auto statistics = get_sampling_profiler_statistics();
+    auto stacks = get_collapsed_stacks();
+
+    stop_sampling_profiler();
+    REQUIRE_FALSE(is_sampling_profiler_running());
+
+    REQUIRE(statistics.number_of_samples > 0u);
+    REQUIRE(stacks.find("Profiled Worker;") != std::string::npos);
+    REQUIRE(stacks.find("sampling_profiler_test_busy_work") != std::string::npos);
+}
+
+//////////
+/// clear_sampling_profiler
+//////////
+
+TEST_CASE("clear_sampling_profiler - removes samples", "[shared/diagnostics]") {
+    if (!is_sampling_profiler_supported()) {
+        return;
+    }
+
+    // the test binary is profiling every test, whose samples must be kept
+    if (is_sampling_profiler_running()) {
+        return;
+    }
+
+    REQUIRE(start_sampling_profiler(500us));
+    sampling_profiler_test_busy_work(50ms);
+    stop_sampling_profiler();
+
+    clear_sampling_profiler();
+
+    REQUIRE(get_sampling_profiler_statistics().number_of_samples == 0u);
+    REQUIRE(get_collapsed_stacks().empty());
+}
+
+//////////
+/// write_collapsed_stacks
+//////////
+
+TEST_CASE("write_collapsed_stacks - invalid path - returns false", "[shared/diagnostics]") {
+    auto path = std::filesystem::temp_directory_path() / "pbr_missing_directory" / "profile.txt";
+
+    auto result = write_collapsed_stacks(path);
+
+    REQUIRE_FALSE(result);
+}
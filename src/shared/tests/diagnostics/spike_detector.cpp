@@ -0,0 +1,164 @@
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include "catch2/catch.hpp"
+#include "shared/diagnostics/spike_detector.h"
+#include "shared/diagnostics/tracer.h"
+
+using namespace pbr::shared::diagnostics;
+using namespace std::chrono_literals;
+
+/// Creates an empty directory for a test's captures, removing it when the test ends
+struct scoped_spike_directory {
+    std::filesystem::path path {std::filesystem::temp_directory_path() / "pbr_spike_detector_test"};
+
+    scoped_spike_directory() {
+        std::filesystem::remove_all(this->path);
+        std::filesystem::create_directories(this->path);
+    }
+
+    ~scoped_spike_directory() {
+        std::error_code error;
+        std::filesystem::remove_all(this->path, error);
+    }
+};
+
+/// Returns the settings used by the tests, which only use the absolute threshold
+/// \param directory The directory to write captures to
+/// \returns The settings
+static spike_detector_settings create_settings(const std::filesystem::path& directory) {
+    spike_detector_settings settings;
+    settings.output_directory = directory;
+    settings.threshold = 50ms;
+    settings.median_multiplier = 0.0;
+    settings.minimum_capture_interval = 1s;
+
+    return settings;
+}
+
+//////////
+/// record_frame
+//////////
+
+TEST_CASE("record_frame - below threshold - does not capture", "[shared/diagnostics]") {
+    scoped_spike_directory directory;
+    counter_registry registry;
+
+    spike_detector detector("test", create_settings(directory.path), registry);
+
+    auto result = detector.record_frame(10ms, spike_detector::clock::now());
+
+    REQUIRE_FALSE(result);
+    REQUIRE(detector.get_number_of_captures() == 0u);
+}
+
+TEST_CASE("record_frame - above threshold - writes trace and metrics", "[shared/diagnostics]") {
+    scoped_spike_directory directory;
+    counter_registry registry;
+    registry.set(registry.register_counter("test_counter"), 9);
+
+    clear_trace();
+    set_trace_ring_mode(true);
+    enable_tracing();
+
+    {
+        trace_zone zone("spiking_zone");
+    }
+
+    spike_detector detector("test", create_settings(directory.path), registry);
+
+    auto result = detector.record_frame(80ms, spike_detector::clock::now());
+    detector.wait_for_captures();
+
+    disable_tracing();
+    set_trace_ring_mode(false);
+
+    REQUIRE(result);
+    REQUIRE(detector.get_number_of_captures() == 1u);
+    REQUIRE(registry.get(registry.find_counter("test_spikes")) == 1);
+    REQUIRE(registry.get(registry.find_counter("test_spike_captures")) == 1);
+
+    std::ifstream trace_file(directory.path / "test_spike_0_trace.json");
+    std::stringstream trace;
+    trace << trace_file.rdbuf();
+
+    REQUIRE(trace.str().find("spiking_zone") != std::string::npos);
+
+    std::ifstream metrics_file(directory.path / "test_spike_0_metrics.json");
+    std::stringstream metrics;
+    metrics << metrics_file.rdbuf();
+
+    REQUIRE(metrics.str().find(R"("test_counter":9)") != std::string::npos);
+    REQUIRE(metrics.str().find(R"("spike_frame_time_ns":80000000)") != std::string::npos);
+    REQUIRE(metrics.str().find("memory_allocated_bytes") != std::string::npos);
+}
+
+TEST_CASE("record_frame - spikes within capture interval - captures once", "[shared/diagnostics]") {
+    scoped_spike_directory directory;
+    counter_registry registry;
+
+    spike_detector detector("test", create_settings(directory.path), registry);
+
+    auto now = spike_detector::clock::now();
+
+    REQUIRE(detector.record_frame(80ms, now));
+    REQUIRE_FALSE(detector.record_frame(80ms, now + 100ms));
+    REQUIRE(detector.record_frame(80ms, now + 2s));
+
+    detector.wait_for_captures();
+
+    REQUIRE(detector.get_number_of_captures() == 2u);
+    REQUIRE(registry.get(registry.find_counter("test_spikes")) == 3);
+}
+
+TEST_CASE("record_frame - max captures reached - stops capturing", "[shared/diagnostics]") {
+    scoped_spike_directory directory;
+    counter_registry registry;
+
+    auto settings = create_settings(directory.path);
+    settings.max_captures = 1u;
+
+    spike_detector detector("test", settings, registry);
+
+    auto now = spike_detector::clock::now();
+
+    REQUIRE(detector.record_frame(80ms, now));
+    REQUIRE_FALSE(detector.record_frame(80ms, now + 2s));
+}
+
+//////////
+/// get_spike_threshold
+//////////
+
+TEST_CASE("get_spike_threshold - enough frames - uses multiple of median", "[shared/diagnostics]") {
+    scoped_spike_directory directory;
+    counter_registry registry;
+
+    auto settings = create_settings(directory.path);
+    settings.threshold = 0ns;
+    settings.median_multiplier = 3.0;
+    settings.minimum_frames_for_median = 10u;
+
+    spike_detector detector("test", settings, registry);
+
+    REQUIRE_FALSE(detector.get_spike_threshold().has_value());
+
+    auto now = spike_detector::clock::now();
+
+    for (auto i {0}; i < 20; ++i) {
+        now += 10ms;
+        REQUIRE_FALSE(detector.record_frame(10ms, now));
+    }
+
+    // the median is recalculated periodically
+    now += 1s;
+    REQUIRE_FALSE(detector.record_frame(10ms, now));
+
+    auto threshold = detector.get_spike_threshold();
+
+    REQUIRE(threshold.has_value());
+    REQUIRE(*threshold > 25ms);
+    REQUIRE(*threshold < 35ms);
+
+    REQUIRE(detector.record_frame(40ms, now + 10ms));
+}
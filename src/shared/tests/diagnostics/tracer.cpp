@@ -0,0 +1,263 @@
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include "catch2/catch.hpp"
+#include "shared/diagnostics/tracer.h"
+
+using namespace pbr::shared::diagnostics;
+
+/// Enables tracing for the lifetime of a test, and clears any events recorded by other tests
+struct scoped_tracing {
+    scoped_tracing() {
+        clear_trace();
+        enable_tracing();
+    }
+
+    ~scoped_tracing() {
+        disable_tracing();
+        clear_trace();
+    }
+};
+
+/// Returns the number of times a string appears in another string
+/// \param value The string to search
+/// \param search The string to search for
+/// \returns The number of times `search` appears in `value`
+static size_t count_occurrences(const std::string& value, const std::string& search) {
+    size_t count {0u};
+
+    for (auto position = value.find(search); position != std::string::npos; position = value.find(search, position + 1u)) {
+        ++count;
+    }
+
+    return count;
+}
+
+//////////
+/// trace_zone
+//////////
+
+TEST_CASE("trace_zone - tracing disabled - records nothing", "[shared/diagnostics]") {
+    clear_trace();
+    disable_tracing();
+
+    {
+        trace_zone zone("disabled_zone");
+    }
+
+    auto json = get_trace_json();
+
+    REQUIRE(json.find("disabled_zone") == std::string::npos);
+}
+
+TEST_CASE("trace_zone - tracing enabled - records complete event", "[shared/diagnostics]") {
+    scoped_tracing tracing;
+
+    {
+        trace_zone zone("enabled_zone", "test");
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    auto json = get_trace_json();
+
+    REQUIRE(json.find(R"("name":"enabled_zone","cat":"test","ph":"X")") != std::string::npos);
+    REQUIRE(json.find(R"("dur":)") != std::string::npos);
+}
+
+TEST_CASE("trace_zone - enabled during zone - records nothing", "[shared/diagnostics]") {
+    clear_trace();
+    disable_tracing();
+
+    {
+        trace_zone zone("late_zone");
+        enable_tracing();
+    }
+
+    auto json = get_trace_json();
+
+    disable_tracing();
+
+    REQUIRE(json.find("late_zone") == std::string::npos);
+}
+
+//////////
+/// set_trace_thread_name
+//////////
+
+TEST_CASE("set_trace_thread_name - named threads - writes thread metadata", "[shared/diagnostics]") {
+    scoped_tracing tracing;
+
+    std::thread thread([]() {
+        set_trace_thread_name("Test \"Worker\"");
+        trace_zone zone("worker_zone");
+    });
+    thread.join();
+
+    auto json = get_trace_json();
+
+    REQUIRE(json.find(R"("name":"thread_name","ph":"M")") != std::string::npos);
+    REQUIRE(json.find(R"({"name":"Test \"Worker\""})") != std::string::npos);
+    REQUIRE(json.find("worker_zone") != std::string::npos);
+}
+
+//////////
+/// trace_counter
+//////////
+
+TEST_CASE("trace_counter - tracing enabled - records counter event", "[shared/diagnostics]") {
+    scoped_tracing tracing;
+
+    trace_counter("test_counter", -42);
+
+    auto json = get_trace_json();
+
+    REQUIRE(json.find(R"("name":"test_counter","cat":"counter","ph":"C")") != std::string::npos);
+    REQUIRE(json.find(R"("args":{"value":-42})") != std::string::npos);
+}
+
+//////////
+/// flows
+//////////
+
+TEST_CASE("begin_trace_flow - tracing disabled - returns zero", "[shared/diagnostics]") {
+    disable_tracing();
+
+    auto id = begin_trace_flow("flow");
+
+    REQUIRE(id == 0u);
+}
+
+TEST_CASE("end_trace_flow - across threads - records matching flow events", "[shared/diagnostics]") {
+    scoped_tracing tracing;
+
+    uint64_t id {0u};
+
+    std::thread thread([&id]() {
+        trace_zone zone("producer");
+        id = begin_trace_flow("test_flow");
+    });
+    thread.join();
+
+    REQUIRE(id != 0u);
+
+    {
+        trace_zone zone("consumer");
+        step_trace_flow("test_flow", id);
+        end_trace_flow("test_flow", id);
+    }
+
+    auto json = get_trace_json();
+    auto id_field = "\"id\":" + std::to_string(id);
+
+    REQUIRE(json.find(R"("ph":"s")") != std::string::npos);
+    REQUIRE(json.find(R"("ph":"t")") != std::string::npos);
+    REQUIRE(json.find(R"("ph":"f")") != std::string::npos);
+    REQUIRE(count_occurrences(json, id_field) == 3u);
+}
+
+//////////
+/// clear_trace
+//////////
+
+TEST_CASE("clear_trace - recorded events - removes events", "[shared/diagnostics]") {
+    scoped_tracing tracing;
+
+    {
+        trace_zone zone("cleared_zone");
+    }
+
+    clear_trace();
+
+    auto json = get_trace_json();
+    REQUIRE(json.find("cleared_zone") == std::string::npos);
+
+    {
+        trace_zone zone("new_zone");
+    }
+
+    json = get_trace_json();
+    REQUIRE(json.find("new_zone") != std::string::npos);
+}
+
+//////////
+/// set_trace_ring_mode
+//////////
+
+TEST_CASE("set_trace_ring_mode - buffer full - overwrites oldest events", "[shared/diagnostics]") {
+    scoped_tracing tracing;
+    set_trace_ring_mode(true);
+
+    trace_counter("oldest_counter", 1);
+
+    // more than a thread's buffer can hold
+    for (auto i {0}; i < 70000; ++i) {
+        trace_counter("ring_counter", i);
+    }
+
+    trace_counter("newest_counter", 1);
+
+    auto json = get_trace_json();
+
+    set_trace_ring_mode(false);
+
+    REQUIRE(is_trace_ring_mode() == false);
+    REQUIRE(json.find("oldest_counter") == std::string::npos);
+    REQUIRE(json.find("newest_counter") != std::string::npos);
+    REQUIRE(json.find(R"("dropped_events":"0")") != std::string::npos);
+}
+
+//////////
+/// get_trace_json
+//////////
+
+TEST_CASE("get_trace_json - time range - only includes events in range", "[shared/diagnostics]") {
+    scoped_tracing tracing;
+
+    trace_counter("before_counter", 1);
+    auto since = get_trace_timestamp();
+    trace_counter("inside_counter", 1);
+    auto until = get_trace_timestamp();
+    trace_counter("after_counter", 1);
+
+    auto json = get_trace_json(since, until);
+
+    REQUIRE(json.find("before_counter") == std::string::npos);
+    REQUIRE(json.find("inside_counter") != std::string::npos);
+    REQUIRE(json.find("after_counter") == std::string::npos);
+}
+
+//////////
+/// write_trace
+//////////
+
+TEST_CASE("write_trace - valid path - writes trace json", "[shared/diagnostics]") {
+    scoped_tracing tracing;
+
+    {
+        trace_zone zone("written_zone");
+    }
+
+    auto path = std::filesystem::temp_directory_path() / "pbr_tracer_test.json";
+
+    auto result = write_trace(path);
+    REQUIRE(result);
+
+    std::ifstream file(path);
+    std::stringstream contents;
+    contents << file.rdbuf();
+    file.close();
+
+    std::filesystem::remove(path);
+
+    REQUIRE(contents.str().starts_with(R"({"displayTimeUnit":"ms","traceEvents":[)"));
+    REQUIRE(contents.str().find("written_zone") != std::string::npos);
+}
+
+TEST_CASE("write_trace - invalid path - returns false", "[shared/diagnostics]") {
+    auto path = std::filesystem::temp_directory_path() / "pbr_missing_directory" / "trace.json";
+
+    auto result = write_trace(path);
+
+    REQUIRE_FALSE(result);
+}
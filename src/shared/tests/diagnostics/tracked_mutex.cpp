@@ -0,0 +1,182 @@
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+#include "catch2/catch.hpp"
+#include "shared/diagnostics/tracked_mutex.h"
+
+using namespace pbr::shared::diagnostics;
+using namespace std::chrono_literals;
+
+//////////
+/// tracked_mutex
+//////////
+
+TEST_CASE("tracked_mutex - constructed - registers counters", "[shared/diagnostics]") {
+    counter_registry registry;
+
+    tracked_mutex mutex("test", registry);
+
+    REQUIRE(registry.find_counter("lock_test_acquisitions").is_valid());
+    REQUIRE(registry.find_counter("lock_test_contended_acquisitions").is_valid());
+    REQUIRE(registry.find_counter("lock_test_wait_ns").is_valid());
+    REQUIRE(registry.find_counter("lock_test_max_wait_ns").is_valid());
+    REQUIRE(registry.find_counter("lock_test_hold_ns").is_valid());
+    REQUIRE(registry.find_counter("lock_test_max_hold_ns").is_valid());
+}
+
+TEST_CASE("tracked_mutex - uncontended - records acquisitions and hold time", "[shared/diagnostics]") {
+    counter_registry registry;
+
+    tracked_mutex mutex("test", registry);
+
+    {
+        std::scoped_lock<tracked_mutex> lock(mutex);
+        std::this_thread::sleep_for(2ms);
+    }
+
+    REQUIRE(mutex.try_lock());
+    mutex.unlock();
+
+    auto statistics = mutex.get_statistics();
+
+    REQUIRE(statistics.acquisitions == 2);
+    REQUIRE(statistics.contended_acquisitions == 0);
+    REQUIRE(statistics.total_wait_time == 0ns);
+    REQUIRE(statistics.max_hold_time >= 2ms);
+    REQUIRE(statistics.total_hold_time >= statistics.max_hold_time);
+}
+
+TEST_CASE("tracked_mutex - held by other thread - records contended wait", "[shared/diagnostics]") {
+    counter_registry registry;
+
+    tracked_mutex mutex("test", registry);
+
+    mutex.lock();
+
+    std::thread thread([&mutex]() {
+        std::scoped_lock<tracked_mutex> lock(mutex);
+    });
+
+    std::this_thread::sleep_for(5ms);
+    mutex.unlock();
+    thread.join();
+
+    auto statistics = mutex.get_statistics();
+
+    REQUIRE(statistics.acquisitions == 2);
+    REQUIRE(statistics.contended_acquisitions == 1);
+    REQUIRE(statistics.max_wait_time > 0ns);
+    REQUIRE(statistics.total_wait_time == statistics.max_wait_time);
+}
+
+TEST_CASE("tracked_mutex - held by other thread - try_lock records nothing", "[shared/diagnostics]") {
+    counter_registry registry;
+
+    tracked_mutex mutex("test", registry);
+
+    mutex.lock();
+
+    bool result {true};
+    std::thread thread([&mutex, &result]() {
+        result = mutex.try_lock();
+    });
+    thread.join();
+
+    mutex.unlock();
+
+    REQUIRE_FALSE(result);
+    REQUIRE(mutex.get_statistics().acquisitions == 1);
+}
+
+TEST_CASE("tracked_mutex - multiple threads - counts every acquisition", "[shared/diagnostics]") {
+    constexpr size_t number_of_threads {4u};
+    constexpr size_t locks_per_thread {1000u};
+
+    counter_registry registry;
+
+    tracked_mutex mutex("test", registry);
+    size_t value {0u};
+
+    std::vector<std::thread> threads;
+    for (size_t i {0u}; i < number_of_threads; ++i) {
+        threads.emplace_back([&mutex, &value]() {
+            for (size_t j {0u}; j < locks_per_thread; ++j) {
+                std::scoped_lock<tracked_mutex> lock(mutex);
+                ++value;
+            }
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    auto statistics = mutex.get_statistics();
+
+    REQUIRE(value == number_of_threads * locks_per_thread);
+    REQUIRE(statistics.acquisitions == static_cast<int64_t>(number_of_threads * locks_per_thread));
+    REQUIRE(statistics.contended_acquisitions <= statistics.acquisitions);
+}
+
+TEST_CASE("tracked_mutex - same name - shares counters", "[shared/diagnostics]") {
+    counter_registry registry;
+
+    tracked_mutex first("test", registry);
+    tracked_mutex second("test", registry);
+
+    first.lock();
+    first.unlock();
+    second.lock();
+    second.unlock();
+
+    REQUIRE(first.get_statistics().acquisitions == 2);
+    REQUIRE(second.get_statistics().acquisitions == 2);
+}
+
+//////////
+/// tracked_shared_mutex
+//////////
+
+TEST_CASE("tracked_shared_mutex - shared locks - records acquisitions", "[shared/diagnostics]") {
+    counter_registry registry;
+
+    tracked_shared_mutex mutex("test", registry);
+
+    {
+        std::shared_lock<tracked_shared_mutex> first(mutex);
+        std::shared_lock<tracked_shared_mutex> second(mutex);
+    }
+
+    REQUIRE(mutex.try_lock_shared());
+    mutex.unlock_shared();
+
+    auto statistics = mutex.get_statistics();
+
+    REQUIRE(statistics.acquisitions == 3);
+    REQUIRE(statistics.contended_acquisitions == 0);
+    REQUIRE(statistics.total_hold_time == 0ns);
+}
+
+TEST_CASE("tracked_shared_mutex - exclusive lock held - shared lock records contended wait", "[shared/diagnostics]") {
+    counter_registry registry;
+
+    tracked_shared_mutex mutex("test", registry);
+
+    mutex.lock();
+
+    std::thread thread([&mutex]() {
+        std::shared_lock<tracked_shared_mutex> lock(mutex);
+    });
+
+    std::this_thread::sleep_for(5ms);
+    mutex.unlock();
+    thread.join();
+
+    auto statistics = mutex.get_statistics();
+
+    REQUIRE(statistics.acquisitions == 2);
+    REQUIRE(statistics.contended_acquisitions == 1);
+    REQUIRE(statistics.max_wait_time > 0ns);
+    REQUIRE(statistics.max_hold_time >= 5ms);
+}
@@ -0,0 +1,115 @@
+#include "catch2/catch.hpp"
+#include "shared/game/fixed_timestep.h"
+
+using namespace pbr::shared::game;
+using namespace std::chrono_literals;
+
+/// Returns the settings used by the tests, which have a tick every 10ms
+/// \returns The settings
+static fixed_timestep_settings create_settings() {
+    fixed_timestep_settings settings;
+    settings.ticks_per_second = 100u;
+    settings.max_ticks_per_frame = 5u;
+
+    return settings;
+}
+
+//////////
+/// reset
+//////////
+
+TEST_CASE("reset - advance to same time - returns one tick", "[shared/game]") {
+    fixed_timestep timestep(create_settings());
+
+    auto now = fixed_timestep::clock::now();
+    timestep.reset(now);
+
+    auto result = timestep.advance(now);
+
+    REQUIRE(result == 1u);
+    REQUIRE(timestep.get_interpolation_alpha() == 0.0f);
+}
+
+//////////
+/// advance
+//////////
+
+TEST_CASE("advance - less than a tick - returns no ticks", "[shared/game]") {
+    fixed_timestep timestep(create_settings());
+
+    auto now = fixed_timestep::clock::now();
+    timestep.reset(now);
+    REQUIRE(timestep.advance(now) == 1u);
+
+    auto result = timestep.advance(now + 5ms);
+
+    REQUIRE(result == 0u);
+    REQUIRE(timestep.get_interpolation_alpha() == Approx(0.5f));
+    REQUIRE(timestep.get_next_tick_time() == now + 10ms);
+    REQUIRE(timestep.get_last_tick_time() == now);
+}
+
+TEST_CASE("advance - several ticks - returns ticks and keeps leftover time", "[shared/game]") {
+    fixed_timestep timestep(create_settings());
+
+    auto now = fixed_timestep::clock::now();
+    timestep.reset(now);
+    REQUIRE(timestep.advance(now) == 1u);
+
+    auto result = timestep.advance(now + 32ms);
+
+    REQUIRE(result == 3u);
+    REQUIRE(timestep.get_interpolation_alpha() == Approx(0.2f));
+    REQUIRE(timestep.get_number_of_ticks() == 4u);
+}
+
+TEST_CASE("advance - more than max ticks - drops ticks", "[shared/game]") {
+    fixed_timestep timestep(create_settings());
+
+    auto now = fixed_timestep::clock::now();
+    timestep.reset(now);
+    REQUIRE(timestep.advance(now) == 1u);
+
+    auto result = timestep.advance(now + 1004ms);
+
+    REQUIRE(result == 5u);
+    REQUIRE(timestep.get_number_of_dropped_ticks() == 95u);
+    REQUIRE(timestep.get_interpolation_alpha() == Approx(0.4f));
+
+    // the dropped time is not caught up later
+    REQUIRE(timestep.advance(now + 1008ms) == 0u);
+}
+
+TEST_CASE("advance - clock goes backwards - returns no ticks", "[shared/game]") {
+    fixed_timestep timestep(create_settings());
+
+    auto now = fixed_timestep::clock::now();
+    timestep.reset(now);
+    REQUIRE(timestep.advance(now) == 1u);
+
+    auto result = timestep.advance(now - 1s);
+
+    REQUIRE(result == 0u);
+    REQUIRE(timestep.get_interpolation_alpha() == 0.0f);
+}
+
+TEST_CASE("advance - frame rate higher than tick rate - runs tick rate", "[shared/game]") {
+    fixed_timestep_settings settings;
+    settings.ticks_per_second = 60u;
+
+    fixed_timestep timestep(settings);
+
+    auto now = fixed_timestep::clock::now();
+    timestep.reset(now);
+
+    uint64_t number_of_ticks {0u};
+
+    // a second of frames at 144 fps
+    for (auto i {0}; i <= 144; ++i) {
+        number_of_ticks += timestep.advance(now + std::chrono::nanoseconds(1s) * i / 144);
+    }
+
+    // the first tick is due straight away
+    REQUIRE(number_of_ticks == 61u);
+    REQUIRE(timestep.get_number_of_dropped_ticks() == 0u);
+}
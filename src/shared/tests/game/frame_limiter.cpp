@@ -0,0 +1,111 @@
+#include "catch2/catch.hpp"
+#include "shared/game/frame_limiter.h"
+
+using namespace pbr::shared;
+using namespace pbr::shared::game;
+using namespace std::chrono_literals;
+
+/// Returns the settings used by the tests, which have a frame every 10ms
+/// \returns The settings
+static frame_limiter_settings create_settings() {
+    frame_limiter_settings settings;
+    settings.frames_per_second = 100u;
+    settings.spin_time = 1ms;
+
+    return settings;
+}
+
+//////////
+/// wait_for_next_frame
+//////////
+
+TEST_CASE("wait_for_next_frame - not limited - returns straight away", "[shared/game]") {
+    frame_limiter limiter;
+
+    auto start = frame_limiter::clock::now();
+    auto result = limiter.wait_for_next_frame();
+
+    REQUIRE_FALSE(limiter.is_limited());
+    REQUIRE(result >= start);
+    REQUIRE(limiter.get_jitter_statistics(result).count == 0u);
+    REQUIRE(limiter.get_overrun_statistics(result).count == 0u);
+}
+
+TEST_CASE("wait_for_next_frame - limited - waits for each frame", "[shared/game]") {
+    frame_limiter limiter(create_settings());
+
+    auto start = frame_limiter::clock::now();
+    limiter.reset(start);
+
+    frame_limiter::clock::time_point result;
+
+    for (auto i {0}; i < 5; ++i) {
+        result = limiter.wait_for_next_frame();
+    }
+
+    // only bound how long waiting takes loosely, as a busy machine can wake threads very late
+    REQUIRE(result - start >= 50ms);
+    REQUIRE(result - start < 1s);
+}
+
+TEST_CASE("wait_for_next_frame - fallen behind - restarts schedule", "[shared/game]") {
+    frame_limiter limiter(create_settings());
+
+    auto start = frame_limiter::clock::now();
+    limiter.reset(start - 1s);
+
+    auto late_frame = limiter.wait_for_next_frame();
+    auto next_frame = limiter.wait_for_next_frame();
+
+    REQUIRE(limiter.get_overrun_statistics(next_frame).count == 1u);
+    REQUIRE(limiter.get_overrun_statistics(next_frame).max >= 990ms);
+    REQUIRE(next_frame - late_frame >= 10ms);
+}
+
+//////////
+/// wait_until
+//////////
+
+TEST_CASE("wait_until - future time - waits until time", "[shared/game]") {
+    frame_limiter limiter(create_settings());
+
+    auto time = frame_limiter::clock::now() + 5ms;
+
+    auto result = limiter.wait_until(time);
+
+    REQUIRE(result >= time);
+    REQUIRE(limiter.get_jitter_statistics(result).count == 1u);
+    REQUIRE(limiter.get_overrun_statistics(result).count == 0u);
+}
+
+TEST_CASE("wait_until - past time - records overrun rather than jitter", "[shared/game]") {
+    frame_limiter limiter(create_settings());
+
+    auto now = frame_limiter::clock::now();
+    auto result = limiter.wait_until(now - 20ms);
+
+    auto overruns = limiter.get_overrun_statistics(result);
+
+    REQUIRE(overruns.count == 1u);
+    REQUIRE(overruns.max >= 20ms);
+    REQUIRE(limiter.get_jitter_statistics(result).count == 0u);
+}
+
+//////////
+/// publish
+//////////
+
+TEST_CASE("publish - waits recorded - sets jitter and overrun gauges", "[shared/game]") {
+    diagnostics::counter_registry registry;
+    frame_limiter limiter(create_settings());
+
+    auto now = frame_limiter::clock::now();
+    limiter.wait_until(now + 2ms);
+    auto result = limiter.wait_until(now - 20ms);
+
+    limiter.publish("test", result, registry);
+
+    REQUIRE(registry.get(registry.find_counter("test_frame_overrun_max_ns")) >= 20'000'000);
+    REQUIRE(registry.find_counter("test_frame_overrun_p50_ns").is_valid());
+    REQUIRE(registry.find_counter("test_frame_jitter_p50_ns").is_valid());
+}
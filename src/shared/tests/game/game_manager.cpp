@@ -8,10 +8,21 @@
 #include "shared/apis/graphics/renderable_entities.h"
 #include "shared/apis/windowing/iconsole_window.h"
 #include "shared/apis/windowing/window_size.h"
+#include "shared/apis/windowing/null_window_manager.h"
+#include "shared/apis/graphics/null/graphics_manager.h"
 #include "shared/scene/iscene_manager.h"
-
+#include "shared/utils/triple_buffer.h"
+#include "shared/tests/allocation_guard.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <mutex>
+#include <optional>
 #include <thread>
 #include <memory>
+#include <vector>
 
 using namespace pbr::shared;
 using namespace pbr::shared::game;
@@ -65,9 +76,20 @@ public:
         return this->update_result;
     }
 
+    bool wait_for_events(std::chrono::steady_clock::time_point) noexcept override {
+        return false;
+    }
+
     int frames_to_run_before_quit = 1;
 
+    /// If set, the window does not quit until this is `true`
+    const std::atomic_bool* quit_after {nullptr};
+
     bool should_quit() const noexcept override {
+        if (this->quit_after && !*this->quit_after) {
+            return false;
+        }
+
         return frames_to_run_before_quit < 0;
     }
 };
@@ -98,19 +120,75 @@ public:
         return true;
     }
 
-    bool submit_frame_for_render_called {false};
+    std::atomic_bool submit_frame_for_render_called {false};
+
+    /// The number of frames to render before `has_rendered_frames` is set
+    size_t frames_to_render {1u};
+    std::atomic_bool has_rendered_frames {false};
+
+    /// The interpolation alpha of each rendered frame, as the renderer would compute it
+    std::vector<float> rendered_interpolation_alphas;
 
     void submit_frame_for_render() noexcept override {
+        {
+            std::scoped_lock lock(this->_tick_timing_mutex);
+
+            if (this->submitted_tick_duration.count() > 0) {
+                this->rendered_interpolation_alphas.push_back(
+                    this->_submitted_entities.get_interpolation_alpha(std::chrono::steady_clock::now()));
+            }
+
+            if (this->rendered_interpolation_alphas.size() >= this->frames_to_render) {
+                this->has_rendered_frames = true;
+            }
+        }
+
         this->submit_frame_for_render_called = true;
     }
 
-    void submit_renderable_entities(apis::graphics::renderable_entities) noexcept override {
+    size_t number_of_submit_renderable_entities_calls {0u};
+    size_t number_of_submitted_entities {0u};
+    size_t number_of_submitted_previous_entities {0u};
+    std::chrono::nanoseconds submitted_tick_duration {0};
+
+    apis::graphics::renderable_entities next_renderable_entities;
+
+    apis::graphics::renderable_entities& get_next_renderable_entities() noexcept override {
+        return this->next_renderable_entities;
+    }
+
+    void submit_renderable_entities() noexcept override {
+        ++this->number_of_submit_renderable_entities_calls;
+        this->number_of_submitted_entities = this->next_renderable_entities.get_2d_renderable_entities().size();
+        this->number_of_submitted_previous_entities = this->next_renderable_entities.get_previous_2d_renderable_entities().size();
+
+        std::scoped_lock lock(this->_tick_timing_mutex);
+
+        this->_submitted_entities.set_tick_timing(this->next_renderable_entities.get_tick_time(),
+                                                  this->next_renderable_entities.get_tick_duration());
+        this->submitted_tick_duration = this->next_renderable_entities.get_tick_duration();
     }
 
     bool _run_on_separate_thread {false};
     bool run_on_separate_thread() const noexcept override {
         return _run_on_separate_thread;
     }
+
+    bool _renders_frames {true};
+    bool renders_frames() const noexcept override {
+        return _renders_frames;
+    }
+
+    diagnostics::phase_timings* get_frame_phase_timings() noexcept override {
+        return nullptr;
+    }
+
+private:
+    /// Guards the tick timing, which the logic thread submits while the graphics thread renders
+    std::mutex _tick_timing_mutex;
+
+    /// The submitted entities, which only hold the tick timing
+    apis::graphics::renderable_entities _submitted_entities;
 };
 
 class test_scene_manager : public scene::iscene_manager {
@@ -122,6 +200,75 @@ public:
         this->run_called = true;
         return this->run_result;
     }
+
+    void submit_renderable_entities(apis::graphics::renderable_entities& renderable_entities) noexcept override {
+        renderable_entities.submit({});
+    }
+};
+
+/// Fills the entities into a triple buffer, as the graphics managers do, and counts the
+/// allocations made from the start of each tick until its entities are submitted
+class allocation_counting_graphics_manager : public test_graphics_manager {
+public:
+    allocation_counting_graphics_manager() {
+        this->tick_allocation_counts.reserve(this->ticks_to_count);
+    }
+
+    /// Counts the allocations of the current tick, started when the scene manager runs
+    std::optional<allocation_guard> tick_allocation_guard;
+
+    /// The allocations made by each tick
+    std::vector<allocation_counts> tick_allocation_counts;
+
+    /// The number of ticks to count before `has_counted_ticks` is set
+    size_t ticks_to_count {8u};
+    std::atomic_bool has_counted_ticks {false};
+
+    apis::graphics::renderable_entities& get_next_renderable_entities() noexcept override {
+        return this->_renderable_entities.get_back_buffer();
+    }
+
+    void submit_renderable_entities() noexcept override {
+        this->_renderable_entities.publish();
+
+        if (this->tick_allocation_guard && this->tick_allocation_counts.size() < this->ticks_to_count) {
+            this->tick_allocation_counts.push_back(this->tick_allocation_guard->get_counts());
+            this->has_counted_ticks = this->tick_allocation_counts.size() == this->ticks_to_count;
+        }
+
+        this->tick_allocation_guard.reset();
+    }
+
+    void submit_frame_for_render() noexcept override {
+        [[maybe_unused]] auto is_updated = this->_renderable_entities.update();
+    }
+
+private:
+    /// The entities handed from the logic loop to the renderer
+    utils::triple_buffer<apis::graphics::renderable_entities> _renderable_entities;
+};
+
+/// Starts counting the allocations of each tick when it runs, and submits many entities
+class allocation_counting_scene_manager : public test_scene_manager {
+public:
+    explicit allocation_counting_scene_manager(std::shared_ptr<allocation_counting_graphics_manager> graphics_manager)
+        : _graphics_manager(graphics_manager) {
+    }
+
+    bool run() noexcept override {
+        this->_graphics_manager->tick_allocation_guard.emplace();
+        return true;
+    }
+
+    void submit_renderable_entities(apis::graphics::renderable_entities& renderable_entities) noexcept override {
+        for (auto i {0}; i < 100; ++i) {
+            renderable_entities.submit({});
+        }
+    }
+
+private:
+    /// The graphics manager counting the allocations
+    std::shared_ptr<allocation_counting_graphics_manager> _graphics_manager;
 };
 
 std::shared_ptr<test_window_manager> g_window_manager;
@@ -136,12 +283,11 @@ game_manager create_game_manager() {
     g_graphics_manager = std::make_shared<test_graphics_manager>();
     g_scene_manager = std::make_shared<test_scene_manager>();
 
-    game_manager gm("",
-                    log_manager,
-                    g_window_manager,
-                    g_graphics_manager,
-                    g_scene_manager);
-    return gm;
+    return game_manager("",
+                        log_manager,
+                        g_window_manager,
+                        g_graphics_manager,
+                        g_scene_manager);
 }
 
 //////////
@@ -302,6 +448,9 @@ TEST_CASE("run - separate thread, frame is submitted for render", "[shared/game]
 
     g_graphics_manager->_run_on_separate_thread = true;
 
+    // the graphics thread may not have submitted a frame before the logic thread's frame ends
+    g_window_manager->quit_after = &g_graphics_manager->submit_frame_for_render_called;
+
     REQUIRE(gm.initialize());
 
     REQUIRE(gm.run());
@@ -320,3 +469,236 @@ TEST_CASE("run - same thread, frame is submitted for render", "[shared/game]") {
 
     REQUIRE(g_graphics_manager->submit_frame_for_render_called);
 }
+
+TEST_CASE("run - runs one tick - submits entities of last two ticks", "[shared/game]") {
+    auto gm = create_game_manager();
+
+    REQUIRE(gm.initialize());
+
+    REQUIRE(gm.run());
+
+    REQUIRE(g_graphics_manager->number_of_submitted_entities == 1u);
+    REQUIRE(g_graphics_manager->number_of_submitted_previous_entities == 0u);
+    REQUIRE(g_graphics_manager->submitted_tick_duration > std::chrono::nanoseconds(0));
+    REQUIRE_FALSE(g_graphics_manager->rendered_interpolation_alphas.empty());
+
+    for (auto alpha : g_graphics_manager->rendered_interpolation_alphas) {
+        REQUIRE(alpha >= 0.0f);
+        REQUIRE(alpha <= 1.0f);
+    }
+}
+
+TEST_CASE("run - frames without a tick - submits entities once a tick", "[shared/game]") {
+    auto gm = create_game_manager();
+
+    fixed_timestep_settings timestep_settings;
+    timestep_settings.ticks_per_second = 1u;
+
+    REQUIRE(gm.set_fixed_timestep_settings(timestep_settings));
+
+    g_window_manager->frames_to_run_before_quit = 5;
+
+    REQUIRE(gm.initialize());
+
+    REQUIRE(gm.run());
+
+    REQUIRE(g_graphics_manager->number_of_submit_renderable_entities_calls == 1u);
+}
+
+TEST_CASE("run - separate thread, frames between ticks - interpolates between ticks", "[shared/game]") {
+    auto gm = create_game_manager();
+
+    fixed_timestep_settings timestep_settings;
+    timestep_settings.ticks_per_second = 10u;
+
+    frame_limiter_settings graphics_settings;
+    graphics_settings.frames_per_second = 200u;
+    graphics_settings.is_adaptive = true;
+
+    REQUIRE(gm.set_fixed_timestep_settings(timestep_settings));
+    REQUIRE(gm.set_frame_limiter_settings({}, graphics_settings));
+
+    g_graphics_manager->_run_on_separate_thread = true;
+    g_graphics_manager->frames_to_render = 20u;
+    g_window_manager->quit_after = &g_graphics_manager->has_rendered_frames;
+
+    REQUIRE(gm.initialize());
+
+    REQUIRE(gm.run());
+
+    // the frames rendered between two ticks are further between them the later they are rendered
+    auto alphas = g_graphics_manager->rendered_interpolation_alphas;
+    std::sort(alphas.begin(), alphas.end());
+    alphas.erase(std::unique(alphas.begin(), alphas.end()), alphas.end());
+
+    REQUIRE(alphas.size() >= 5u);
+}
+
+TEST_CASE("run - steady state ticks - submits entities without allocating", "[shared/game]") {
+    auto datetime_manager = std::make_shared<apis::datetime::datetime_manager>();
+    auto log_manager = std::make_shared<apis::logging::log_manager>(datetime_manager);
+
+    auto window_manager = std::make_shared<test_window_manager>();
+    auto graphics_manager = std::make_shared<allocation_counting_graphics_manager>();
+
+    game_manager gm("",
+                    log_manager,
+                    window_manager,
+                    graphics_manager,
+                    std::make_shared<allocation_counting_scene_manager>(graphics_manager));
+
+    // each frame runs at most one tick, so each count covers a single tick and its synchronization
+    fixed_timestep_settings timestep_settings;
+    timestep_settings.ticks_per_second = 1000u;
+    timestep_settings.max_ticks_per_frame = 1u;
+
+    REQUIRE(gm.set_fixed_timestep_settings(timestep_settings));
+
+    window_manager->quit_after = &graphics_manager->has_counted_ticks;
+
+    REQUIRE(gm.initialize());
+
+    REQUIRE(gm.run());
+
+    // the first tick has no previous tick, and the two tick buffers and the three triple buffer
+    // buffers each allocate their memory the first time they are filled with both ticks
+    constexpr size_t number_of_warm_up_ticks {4u};
+
+    auto counts = graphics_manager->tick_allocation_counts;
+    REQUIRE(counts.size() == graphics_manager->ticks_to_count);
+    REQUIRE_THAT(counts[0], !makes_no_allocations());
+
+    for (auto i {number_of_warm_up_ticks}; i < counts.size(); ++i) {
+        REQUIRE_THAT(counts[i], makes_no_allocations());
+    }
+}
+
+TEST_CASE("run - graphics manager renders no frames - waits for each tick", "[shared/game]") {
+    auto gm = create_game_manager();
+    g_graphics_manager->_renders_frames = false;
+
+    fixed_timestep_settings timestep_settings;
+    timestep_settings.ticks_per_second = 100u;
+
+    REQUIRE(gm.set_fixed_timestep_settings(timestep_settings));
+
+    // the logic frame rate is not limited, so without waiting for ticks, the frames would all run
+    // before the first tick is due
+    g_window_manager->frames_to_run_before_quit = 3;
+
+    REQUIRE(gm.initialize());
+
+    REQUIRE(gm.run());
+
+    REQUIRE(g_graphics_manager->number_of_submit_renderable_entities_calls >= 3u);
+}
+
+TEST_CASE("run - null window and graphics managers - runs headless", "[shared/game]") {
+    auto datetime_manager = std::make_shared<apis::datetime::datetime_manager>();
+    auto log_manager = std::make_shared<apis::logging::log_manager>(datetime_manager);
+
+    auto window_manager = std::make_shared<apis::windowing::null_window_manager>(log_manager);
+    auto graphics_manager = std::make_shared<apis::graphics::null::graphics_manager>(log_manager);
+
+    game_manager gm("",
+                    log_manager,
+                    window_manager,
+                    graphics_manager,
+                    std::make_shared<test_scene_manager>());
+
+    REQUIRE(gm.initialize());
+
+    // quit after the first frame
+    std::raise(SIGTERM);
+
+    REQUIRE(gm.run());
+
+    REQUIRE(graphics_manager->get_number_of_submitted_frames() == 1u);
+}
+
+//////////
+/// set_fixed_timestep_settings
+//////////
+
+TEST_CASE("set_fixed_timestep_settings - valid settings - returns true", "[shared/game]") {
+    auto gm = create_game_manager();
+
+    fixed_timestep_settings settings;
+    settings.ticks_per_second = 30u;
+
+    auto result = gm.set_fixed_timestep_settings(settings);
+
+    REQUIRE(result);
+}
+
+TEST_CASE("set_fixed_timestep_settings - no ticks per second - returns false", "[shared/game]") {
+    auto gm = create_game_manager();
+
+    fixed_timestep_settings settings;
+    settings.ticks_per_second = 0u;
+
+    auto result = gm.set_fixed_timestep_settings(settings);
+
+    REQUIRE_FALSE(result);
+}
+
+//////////
+/// set_frame_limiter_settings
+//////////
+
+TEST_CASE("set_frame_limiter_settings - valid settings - returns true", "[shared/game]") {
+    auto gm = create_game_manager();
+
+    frame_limiter_settings settings;
+    settings.frames_per_second = 60u;
+
+    auto result = gm.set_frame_limiter_settings(settings, settings);
+
+    REQUIRE(result);
+}
+
+TEST_CASE("set_frame_limiter_settings - negative spin time - returns false", "[shared/game]") {
+    auto gm = create_game_manager();
+
+    frame_limiter_settings settings;
+    settings.spin_time = std::chrono::milliseconds(-1);
+
+    auto result = gm.set_frame_limiter_settings({}, settings);
+
+    REQUIRE_FALSE(result);
+}
+
+TEST_CASE("set_frame_limiter_settings - adaptive graphics loop - renders synchronized frames", "[shared/game]") {
+    auto gm = create_game_manager();
+
+    frame_limiter_settings graphics_settings;
+    graphics_settings.frames_per_second = 100u;
+    graphics_settings.is_adaptive = true;
+
+    REQUIRE(gm.set_frame_limiter_settings({}, graphics_settings));
+
+    g_graphics_manager->_run_on_separate_thread = true;
+    g_window_manager->quit_after = &g_graphics_manager->submit_frame_for_render_called;
+
+    REQUIRE(gm.initialize());
+
+    REQUIRE(gm.run());
+
+    REQUIRE(g_graphics_manager->submit_frame_for_render_called);
+}
+
+//////////
+/// enable_spike_detection
+//////////
+
+TEST_CASE("enable_spike_detection - runs frames - returns true", "[shared/game]") {
+    auto gm = create_game_manager();
+
+    diagnostics::spike_detector_settings settings;
+    settings.output_directory = std::filesystem::temp_directory_path();
+
+    REQUIRE(gm.enable_spike_detection(settings));
+    REQUIRE(gm.initialize());
+
+    REQUIRE(gm.run());
+}
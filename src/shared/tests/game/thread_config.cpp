@@ -0,0 +1,89 @@
+#include "catch2/catch.hpp"
+#include "shared/game/thread_config.h"
+#include "shared/apis/datetime/datetime_manager.h"
+#include "shared/apis/logging/log_manager.h"
+#include "shared/apis/file/file_manager.h"
+#include "shared/tests/test_utils.h"
+
+using namespace pbr::shared;
+using namespace pbr::shared::apis;
+using namespace pbr::shared::data;
+using namespace pbr::shared::game;
+
+static auto g_datetime_manager = std::make_shared<datetime::datetime_manager>();
+static auto g_log_manager = std::make_shared<logging::log_manager>(g_datetime_manager);
+
+static std::shared_ptr<data_manager> create_data_manager() {
+    auto file_manager = std::make_shared<file::file_manager>();
+
+    auto data_path = get_test_data_file_path("threading");
+
+    return std::make_shared<data_manager>(data_path, file_manager, g_log_manager);
+}
+
+//////////
+/// has_config
+//////////
+
+TEST_CASE("has_config - config exists - returns true", "[shared/game]") {
+    REQUIRE(thread_config::has_config(create_data_manager(), "config_invalid_cpus"));
+}
+
+TEST_CASE("has_config - config missing - returns false", "[shared/game]") {
+    REQUIRE_FALSE(thread_config::has_config(create_data_manager(), "config_missing"));
+}
+
+//////////
+/// constructor
+//////////
+
+TEST_CASE("constructor - default - only names threads", "[shared/game]") {
+    thread_config config;
+
+    REQUIRE(config.get_settings(thread_roles::logic).name.empty());
+    REQUIRE(config.get_settings(thread_roles::graphics).name == "Graphics");
+    REQUIRE(config.get_settings(thread_roles::job_worker).name == "Job Worker");
+
+    for (auto role : { thread_roles::logic, thread_roles::graphics, thread_roles::job_worker }) {
+        REQUIRE(config.get_settings(role).cpus.empty());
+        REQUIRE_FALSE(config.get_settings(role).policy.has_value());
+        REQUIRE_FALSE(config.get_settings(role).priority.has_value());
+    }
+}
+
+TEST_CASE("constructor - valid config - loads settings", "[shared/game]") {
+    thread_config config(create_data_manager(), g_log_manager, "config_valid");
+
+    const auto& logic = config.get_settings(thread_roles::logic);
+    REQUIRE(logic.name == "Server Logic");
+    REQUIRE(logic.cpus == std::vector<uint32_t> { 0u });
+    REQUIRE(logic.policy == platform::thread_scheduling_policy::normal);
+    REQUIRE(logic.priority == 0);
+
+    const auto& job_worker = config.get_settings(thread_roles::job_worker);
+    REQUIRE(job_worker.name == "Job Worker");
+    REQUIRE(job_worker.cpus == std::vector<uint32_t> { 1u, 2u, 3u, 6u });
+    REQUIRE(job_worker.policy == platform::thread_scheduling_policy::batch);
+    REQUIRE_FALSE(job_worker.priority.has_value());
+}
+
+TEST_CASE("constructor - role not in config - keeps default settings", "[shared/game]") {
+    thread_config config(create_data_manager(), g_log_manager, "config_valid");
+
+    const auto& graphics = config.get_settings(thread_roles::graphics);
+    REQUIRE(graphics.name == "Graphics");
+    REQUIRE(graphics.cpus.empty());
+    REQUIRE_FALSE(graphics.policy.has_value());
+}
+
+TEST_CASE("constructor - invalid cpus - throws", "[shared/game]") {
+    REQUIRE_THROWS_AS(thread_config(create_data_manager(), g_log_manager, "config_invalid_cpus"), std::runtime_error);
+}
+
+TEST_CASE("constructor - invalid priority - throws", "[shared/game]") {
+    REQUIRE_THROWS_AS(thread_config(create_data_manager(), g_log_manager, "config_invalid_priority"), std::runtime_error);
+}
+
+TEST_CASE("constructor - missing config - throws", "[shared/game]") {
+    REQUIRE_THROWS_AS(thread_config(create_data_manager(), g_log_manager, "config_missing"), std::runtime_error);
+}
@@ -0,0 +1,381 @@
+#include "catch2/catch.hpp"
+#include "shared/jobs/job_system.h"
+#include "shared/apis/datetime/datetime_manager.h"
+#include "shared/apis/logging/log_manager.h"
+#include "shared/platform/platform.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef PLATFORM_LINUX
+#include <pthread.h>
+#include <time.h>
+#endif
+
+using namespace pbr::shared::jobs;
+
+/// Returns the settings used by the tests
+/// \param number_of_workers The number of worker threads
+/// \returns The settings
+static job_system_settings create_settings(size_t number_of_workers) {
+    job_system_settings settings;
+    settings.number_of_workers = number_of_workers;
+    settings.deque_capacity = 16u;
+
+    return settings;
+}
+
+/// Records the messages logged by the job system
+class failed_job_endpoint : public pbr::shared::apis::logging::endpoint {
+public:
+    /// The logged messages
+    std::vector<std::string> messages;
+
+    /// Records a message
+    /// \param message The message to record
+    void log(std::string_view message, pbr::shared::apis::logging::log_levels) noexcept override {
+        this->messages.emplace_back(message);
+    }
+};
+
+//////////
+/// run
+//////////
+
+TEST_CASE("run - started - runs every job", "[shared/jobs]") {
+    job_system system(create_settings(4u));
+    REQUIRE(system.start());
+    REQUIRE(system.get_number_of_workers() == 4u);
+
+    std::atomic_uint32_t count {0u};
+    job_counter counter;
+
+    for (auto i {0}; i < 1000; ++i) {
+        REQUIRE(system.run([&count]() { ++count; }, &counter));
+    }
+
+    system.wait(counter);
+
+    REQUIRE(counter.is_complete());
+    REQUIRE(count == 1000u);
+}
+
+TEST_CASE("run - not started - runs jobs when waiting", "[shared/jobs]") {
+    job_system system(create_settings(2u));
+
+    std::atomic_uint32_t count {0u};
+    job_counter counter;
+
+    for (auto i {0}; i < 10; ++i) {
+        REQUIRE(system.run([&count]() { ++count; }, &counter));
+    }
+
+    REQUIRE(counter.get_count() == 10u);
+
+    system.wait(counter);
+
+    REQUIRE(count == 10u);
+}
+
+TEST_CASE("run - nested jobs overflow deque - runs every job", "[shared/jobs]") {
+    job_system system(create_settings(3u));
+    REQUIRE(system.start());
+
+    std::atomic_uint32_t count {0u};
+    job_counter counter;
+
+    REQUIRE(system.run([&system, &count]() {
+        job_counter nested_counter;
+
+        // more jobs than fit in a worker's deque
+        for (auto i {0}; i < 100; ++i) {
+            system.run([&count]() { ++count; }, &nested_counter);
+        }
+
+        system.wait(nested_counter);
+    }, &counter));
+
+    system.wait(counter);
+
+    REQUIRE(count == 100u);
+}
+
+TEST_CASE("run - job throws - logs it and completes the counter", "[shared/jobs]") {
+    auto datetime_manager = std::make_shared<pbr::shared::apis::datetime::datetime_manager>();
+    auto log_manager = std::make_shared<pbr::shared::apis::logging::log_manager>(datetime_manager);
+    auto endpoint = std::make_shared<failed_job_endpoint>();
+    REQUIRE(log_manager->add_endpoint(endpoint));
+
+    job_system system(create_settings(2u));
+    system.set_log_manager(log_manager);
+    REQUIRE(system.start());
+
+    job_counter counter;
+
+    REQUIRE(system.run([]() { throw std::runtime_error("test failure"); }, &counter));
+
+    system.wait(counter);
+    system.stop();
+
+    REQUIRE(counter.is_complete());
+    REQUIRE(system.get_number_of_failed_jobs() == 1u);
+    REQUIRE(endpoint->messages.size() == 1u);
+    REQUIRE(endpoint->messages[0].find("test failure") != std::string::npos);
+}
+
+//////////
+/// run_after
+//////////
+
+TEST_CASE("run_after - dependency incomplete - runs after dependency", "[shared/jobs]") {
+    job_system system(create_settings(2u));
+    REQUIRE(system.start());
+
+    std::atomic_bool is_dependency_run {false};
+    std::atomic_bool was_dependency_run_first {false};
+    std::atomic_bool is_released {false};
+
+    job_counter dependency;
+    job_counter counter;
+
+    REQUIRE(system.run([&is_released, &is_dependency_run]() {
+        while (!is_released) {
+            std::this_thread::yield();
+        }
+
+        is_dependency_run = true;
+    }, &dependency));
+
+    REQUIRE(system.run_after(dependency, [&is_dependency_run, &was_dependency_run_first]() {
+        was_dependency_run_first = is_dependency_run.load();
+    }, &counter));
+
+    REQUIRE_FALSE(counter.is_complete());
+
+    is_released = true;
+
+    system.wait(counter);
+    system.wait(dependency);
+
+    REQUIRE(was_dependency_run_first);
+}
+
+TEST_CASE("run_after - dependency complete - runs", "[shared/jobs]") {
+    job_system system(create_settings(1u));
+    REQUIRE(system.start());
+
+    std::atomic_bool is_run {false};
+
+    job_counter dependency;
+    job_counter counter;
+
+    REQUIRE(system.run_after(dependency, [&is_run]() { is_run = true; }, &counter));
+
+    system.wait(counter);
+
+    REQUIRE(is_run);
+}
+
+//////////
+/// run_on_main_thread
+//////////
+
+TEST_CASE("run_on_main_thread - job from worker - runs on main thread", "[shared/jobs]") {
+    job_system system(create_settings(2u));
+    REQUIRE(system.start());
+
+    auto main_thread_id = std::this_thread::get_id();
+    std::atomic_bool was_run_on_main_thread {false};
+
+    job_counter counter;
+
+    REQUIRE(system.run([&system, &counter, &was_run_on_main_thread, main_thread_id]() {
+        system.run_on_main_thread([&was_run_on_main_thread, main_thread_id]() {
+            was_run_on_main_thread = std::this_thread::get_id() == main_thread_id;
+        }, &counter);
+    }, &counter));
+
+    system.wait(counter);
+
+    REQUIRE(was_run_on_main_thread);
+}
+
+//////////
+/// run_main_thread_jobs
+//////////
+
+TEST_CASE("run_main_thread_jobs - queued jobs - runs them", "[shared/jobs]") {
+    job_system system(create_settings(1u));
+    REQUIRE(system.start());
+
+    auto count {0u};
+
+    REQUIRE(system.run_on_main_thread([&count]() { ++count; }));
+    REQUIRE(system.run_on_main_thread([&count]() { ++count; }));
+
+    REQUIRE(system.run_main_thread_jobs() == 2u);
+    REQUIRE(count == 2u);
+    REQUIRE(system.run_main_thread_jobs() == 0u);
+}
+
+//////////
+/// wait
+//////////
+
+#ifdef PLATFORM_LINUX
+TEST_CASE("wait - job still running - sleeps until complete", "[shared/jobs]") {
+    job_system system(create_settings(1u));
+    REQUIRE(system.start());
+
+    job_counter counter;
+
+    REQUIRE(system.run([]() { std::this_thread::sleep_for(std::chrono::milliseconds(200)); }, &counter));
+
+    // give the worker time to take the job, so the waiting thread has nothing to run
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    timespec cpu_time_before {};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &cpu_time_before);
+
+    system.wait(counter);
+
+    timespec cpu_time_after {};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &cpu_time_after);
+
+    auto cpu_time = std::chrono::seconds(cpu_time_after.tv_sec - cpu_time_before.tv_sec) +
+                    std::chrono::nanoseconds(cpu_time_after.tv_nsec - cpu_time_before.tv_nsec);
+
+    REQUIRE(counter.is_complete());
+    REQUIRE(cpu_time < std::chrono::milliseconds(50));
+}
+#endif
+
+TEST_CASE("wait - job queued while sleeping - wakes to run it", "[shared/jobs]") {
+    job_system system(create_settings(1u));
+
+    // the waiting thread cannot run main thread jobs, so it sleeps while this job is queued
+    job_counter counter;
+    REQUIRE(system.run_on_main_thread([]() {}, &counter));
+
+    std::thread waiting_thread([&system, &counter]() {
+        system.wait(counter);
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    // without workers, only the waiting thread can run this job
+    std::atomic_bool is_run {false};
+    REQUIRE(system.run([&is_run]() { is_run = true; }));
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!is_run && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::yield();
+    }
+
+    REQUIRE(system.run_main_thread_jobs() == 1u);
+    waiting_thread.join();
+
+    REQUIRE(is_run);
+    REQUIRE(counter.is_complete());
+}
+
+//////////
+/// parallel_for
+//////////
+
+TEST_CASE("parallel_for - range - runs each index once", "[shared/jobs]") {
+    job_system system(create_settings(4u));
+    REQUIRE(system.start());
+
+    std::vector<uint32_t> values(10007u, 0u);
+
+    system.parallel_for(0u, values.size(), 64u, [&values](size_t begin, size_t end) {
+        for (auto i = begin; i < end; ++i) {
+            ++values[i];
+        }
+    });
+
+    REQUIRE(std::accumulate(values.begin(), values.end(), 0u) == values.size());
+    REQUIRE(std::all_of(values.begin(), values.end(), [](uint32_t value) { return value == 1u; }));
+}
+
+TEST_CASE("parallel_for - empty range - does not run", "[shared/jobs]") {
+    job_system system(create_settings(1u));
+    REQUIRE(system.start());
+
+    auto is_run {false};
+
+    system.parallel_for(5u, 5u, 1u, [&is_run](size_t, size_t) { is_run = true; });
+
+    REQUIRE_FALSE(is_run);
+}
+
+//////////
+/// stop
+//////////
+
+TEST_CASE("stop - queued jobs - runs them first", "[shared/jobs]") {
+    std::atomic_uint32_t count {0u};
+
+    {
+        job_system system(create_settings(2u));
+        REQUIRE(system.start());
+
+        for (auto i {0}; i < 100; ++i) {
+            system.run([&count]() { ++count; });
+        }
+    }
+
+    REQUIRE(count == 100u);
+}
+
+//////////
+/// set_worker_thread_settings
+//////////
+
+TEST_CASE("set_worker_thread_settings - not started - returns true", "[shared/jobs]") {
+    job_system system(create_settings(2u));
+
+    REQUIRE(system.set_worker_thread_settings({ "Test Worker", {}, {}, {} }));
+}
+
+#ifdef PLATFORM_LINUX
+TEST_CASE("set_worker_thread_settings - started - names workers", "[shared/jobs]") {
+    job_system system(create_settings(2u));
+    REQUIRE(system.start());
+
+    REQUIRE(system.set_worker_thread_settings({ "Test Worker", {}, {}, {} }));
+
+    std::mutex mutex;
+    std::vector<std::string> names;
+
+    system.parallel_for(0u, 100u, 1u, [&mutex, &names](size_t, size_t) {
+        std::array<char, 16> buffer {};
+        pthread_getname_np(pthread_self(), buffer.data(), buffer.size());
+
+        // give the workers time to take some of the jobs
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+        std::scoped_lock<std::mutex> lock(mutex);
+        names.emplace_back(buffer.data());
+    });
+
+    for (const auto& name : names) {
+        // the waiting thread also runs jobs
+        if (name.starts_with("Test Worker")) {
+            REQUIRE((name == "Test Worker 0" || name == "Test Worker 1"));
+        }
+    }
+
+    REQUIRE(std::any_of(names.begin(), names.end(), [](const auto& name) { return name.starts_with("Test Worker"); }));
+}
+#endif
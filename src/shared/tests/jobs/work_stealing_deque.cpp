@@ -0,0 +1,114 @@
+#include "catch2/catch.hpp"
+#include "shared/jobs/work_stealing_deque.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace pbr::shared::jobs;
+
+//////////
+/// push
+//////////
+
+TEST_CASE("push - deque full - returns false", "[shared/jobs]") {
+    work_stealing_deque deque(4u);
+    std::vector<job> jobs(5u);
+
+    for (auto i {0u}; i < 4u; ++i) {
+        REQUIRE(deque.push(&jobs[i]));
+    }
+
+    REQUIRE_FALSE(deque.push(&jobs[4]));
+    REQUIRE(deque.get_size() == 4u);
+}
+
+//////////
+/// pop
+//////////
+
+TEST_CASE("pop - pushed jobs - returns last pushed first", "[shared/jobs]") {
+    work_stealing_deque deque(4u);
+    std::vector<job> jobs(3u);
+
+    for (auto& job : jobs) {
+        REQUIRE(deque.push(&job));
+    }
+
+    REQUIRE(deque.pop() == &jobs[2]);
+    REQUIRE(deque.pop() == &jobs[1]);
+    REQUIRE(deque.pop() == &jobs[0]);
+    REQUIRE(deque.pop() == nullptr);
+}
+
+//////////
+/// steal
+//////////
+
+TEST_CASE("steal - pushed jobs - returns first pushed first", "[shared/jobs]") {
+    work_stealing_deque deque(4u);
+    std::vector<job> jobs(3u);
+
+    for (auto& job : jobs) {
+        REQUIRE(deque.push(&job));
+    }
+
+    REQUIRE(deque.steal() == &jobs[0]);
+    REQUIRE(deque.steal() == &jobs[1]);
+    REQUIRE(deque.pop() == &jobs[2]);
+    REQUIRE(deque.steal() == nullptr);
+}
+
+TEST_CASE("steal - thieves race owner - each job taken once", "[shared/jobs]") {
+    constexpr auto number_of_jobs {100000u};
+    constexpr auto number_of_thieves {3u};
+
+    work_stealing_deque deque(64u);
+    std::vector<job> jobs(number_of_jobs);
+    std::vector<std::atomic_uint32_t> times_taken(number_of_jobs);
+    std::atomic_bool is_done {false};
+
+    auto take = [&jobs, &times_taken](job* job) {
+        if (job) {
+            ++times_taken[static_cast<size_t>(job - jobs.data())];
+        }
+    };
+
+    std::vector<std::thread> thieves;
+    for (auto i {0u}; i < number_of_thieves; ++i) {
+        thieves.emplace_back([&deque, &is_done, &take]() {
+            while (!is_done) {
+                take(deque.steal());
+            }
+        });
+    }
+
+    for (auto& job : jobs) {
+        while (!deque.push(&job)) {
+            take(deque.pop());
+        }
+
+        if ((&job - jobs.data()) % 3 == 0) {
+            take(deque.pop());
+        }
+    }
+
+    while (auto* job = deque.pop()) {
+        take(job);
+    }
+
+    is_done = true;
+
+    for (auto& thief : thieves) {
+        thief.join();
+    }
+
+    auto number_taken_once {0u};
+    for (const auto& count : times_taken) {
+        if (count == 1u) {
+            ++number_taken_once;
+        }
+    }
+
+    REQUIRE(number_taken_once == number_of_jobs);
+}
@@ -1,6 +1,9 @@
 #define CATCH_CONFIG_RUNNER
 #include "catch2/catch.hpp"
 #include "test_utils.h"
+#include "shared/diagnostics/sampling_profiler.h"
+
+#include <iostream>
 
 int main(int argv, char* args[])
 {
@@ -8,5 +11,31 @@ int main(int argv, char* args[])
 
     current_working_directory = args[0];
 
-    return session.run(argv, args);
+    // `--profile <path>` samples the selected tests and writes their collapsed stacks to the path
+    std::string profile_path;
+    session.cli(session.cli()
+        | Catch::clara::Opt(profile_path, "path")
+            ["--profile"]
+            ("profile the tests with the sampling profiler, writing collapsed stacks to the path"));
+
+    if (auto result = session.applyCommandLine(argv, args); result != 0) {
+        return result;
+    }
+
+    if (!profile_path.empty() && !pbr::shared::diagnostics::start_sampling_profiler()) {
+        std::cerr << "Failed to start the sampling profiler.\n";
+        return 1;
+    }
+
+    auto result = session.run();
+
+    if (!profile_path.empty()) {
+        pbr::shared::diagnostics::stop_sampling_profiler();
+
+        if (!pbr::shared::diagnostics::write_collapsed_stacks(profile_path)) {
+            std::cerr << "Failed to write profile to " << profile_path << '\n';
+        }
+    }
+
+    return result;
 }
@@ -0,0 +1,189 @@
+#include <algorithm>
+#include <thread>
+#include <vector>
+#include "catch2/catch.hpp"
+#include "shared/memory/allocation_sampler.h"
+#include "shared/memory/basic_allocators.h"
+
+using namespace pbr::shared::memory;
+
+/// Returns the total number of sampled and live allocations across all sites
+/// \param out_live_allocations Set to the number of live sampled allocations
+/// \returns The number of sampled allocations
+uint64_t get_total_sampled_allocations(uint64_t& out_live_allocations) {
+    auto sites = get_allocation_sites();
+
+    uint64_t sampled {0u};
+    out_live_allocations = 0u;
+
+    for (const auto& site : sites) {
+        sampled += site.sampled_allocations;
+        out_live_allocations += site.live_allocations;
+    }
+
+    return sampled;
+}
+
+//////////
+/// enable_allocation_sampling
+//////////
+
+TEST_CASE("enable_allocation_sampling - zero rate - returns false", "[shared/memory]") {
+    auto result = enable_allocation_sampling(0u);
+
+    REQUIRE_FALSE(result);
+    REQUIRE_FALSE(is_allocation_sampling_enabled());
+}
+
+TEST_CASE("enable_allocation_sampling - valid rate - enables sampling", "[shared/memory]") {
+    auto result = enable_allocation_sampling(100u);
+
+    REQUIRE(result);
+    REQUIRE(is_allocation_sampling_enabled());
+
+    disable_allocation_sampling();
+
+    REQUIRE_FALSE(is_allocation_sampling_enabled());
+}
+
+//////////
+/// record_sampled_allocation
+//////////
+
+TEST_CASE("sampling - every allocation - records live allocations", "[shared/memory]") {
+    REQUIRE(enable_allocation_sampling(1u));
+
+    uint64_t live_before {0u};
+    auto sampled_before = get_total_sampled_allocations(live_before);
+
+    std::vector<int*> allocations;
+    allocations.reserve(10u);
+
+    for (auto i {0}; i < 10; ++i) {
+        allocations.push_back(new int(i));
+    }
+
+    disable_allocation_sampling();
+
+    uint64_t live_after {0u};
+    auto sampled_after = get_total_sampled_allocations(live_after);
+
+    REQUIRE(sampled_after - sampled_before >= 10u);
+    REQUIRE(live_after - live_before >= 10u);
+
+    for (auto allocation : allocations) {
+        delete allocation;
+    }
+
+    uint64_t live_freed {0u};
+    (void)get_total_sampled_allocations(live_freed);
+
+    REQUIRE(live_freed <= live_after - 10u);
+}
+
+TEST_CASE("sampling - freed on other thread - removes live allocation", "[shared/memory]") {
+    REQUIRE(enable_allocation_sampling(1u));
+
+    auto volatile ptr = new char[64];
+
+    disable_allocation_sampling();
+
+    uint64_t live_before {0u};
+    (void)get_total_sampled_allocations(live_before);
+
+    std::thread thread([ptr]() {
+        delete[] ptr;
+    });
+    thread.join();
+
+    uint64_t live_after {0u};
+    (void)get_total_sampled_allocations(live_after);
+
+    REQUIRE(live_after == live_before - 1u);
+}
+
+TEST_CASE("sampling - sized delete - removes live allocation", "[shared/memory]") {
+    REQUIRE(enable_allocation_sampling(1u));
+
+    auto ptr = ::operator new(32u);
+
+    disable_allocation_sampling();
+
+    uint64_t live_before {0u};
+    (void)get_total_sampled_allocations(live_before);
+
+    ::operator delete(ptr, 32u);
+
+    uint64_t live_after {0u};
+    (void)get_total_sampled_allocations(live_after);
+
+    REQUIRE(live_after == live_before - 1u);
+}
+
+TEST_CASE("sampling - rate - samples roughly one in rate allocations", "[shared/memory]") {
+    auto rate = 10u;
+    auto number_of_allocations = 10000u;
+
+    std::vector<int*> allocations;
+    allocations.reserve(number_of_allocations);
+
+    uint64_t live_before {0u};
+    auto sampled_before = get_total_sampled_allocations(live_before);
+
+    REQUIRE(enable_allocation_sampling(rate));
+
+    for (auto i {0u}; i < number_of_allocations; ++i) {
+        allocations.push_back(new int(0));
+    }
+
+    disable_allocation_sampling();
+
+    for (auto allocation : allocations) {
+        delete allocation;
+    }
+
+    uint64_t live_after {0u};
+    auto sampled_after = get_total_sampled_allocations(live_after);
+
+    auto result = sampled_after - sampled_before;
+    auto expected = number_of_allocations / rate;
+
+    REQUIRE(result > expected / 2u);
+    REQUIRE(result < expected * 2u);
+}
+
+TEST_CASE("sampling - disabled - does not sample", "[shared/memory]") {
+    disable_allocation_sampling();
+
+    uint64_t live_before {0u};
+    auto sampled_before = get_total_sampled_allocations(live_before);
+
+    auto volatile ptr = new int;
+    delete ptr;
+
+    uint64_t live_after {0u};
+    auto sampled_after = get_total_sampled_allocations(live_after);
+
+    REQUIRE(sampled_after == sampled_before);
+}
+
+//////////
+/// get_allocation_sampling_report
+//////////
+
+TEST_CASE("get_allocation_sampling_report - returns report", "[shared/memory]") {
+    REQUIRE(enable_allocation_sampling(1u));
+
+    auto volatile ptr = new char[128];
+
+    disable_allocation_sampling();
+
+    auto result = get_allocation_sampling_report(5u);
+
+    delete[] ptr;
+
+    REQUIRE(result.find("Top sites by bytes:") != std::string::npos);
+    REQUIRE(result.find("Top sites by allocations:") != std::string::npos);
+    REQUIRE(result.find("Top sites by live bytes") != std::string::npos);
+    REQUIRE(result.find("#1") != std::string::npos);
+}
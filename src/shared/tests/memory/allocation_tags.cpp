@@ -0,0 +1,223 @@
+#include <thread>
+#include <vector>
+#include "catch2/catch.hpp"
+#include "shared/memory/allocation_tags.h"
+#include "shared/memory/basic_allocators.h"
+
+using namespace pbr::shared::memory;
+
+//////////
+/// scoped_allocation_tag
+//////////
+
+TEST_CASE("scoped_allocation_tag - sets current tag", "[shared/memory]") {
+    scoped_allocation_tag tag(allocation_tag::graphics);
+
+    auto result = scoped_allocation_tag::get_current_tag();
+
+    REQUIRE(result == allocation_tag::graphics);
+}
+
+TEST_CASE("scoped_allocation_tag - destroyed - restores previous tag", "[shared/memory]") {
+    scoped_allocation_tag outer(allocation_tag::scene);
+
+    {
+        scoped_allocation_tag inner(allocation_tag::world);
+
+        REQUIRE(scoped_allocation_tag::get_current_tag() == allocation_tag::world);
+    }
+
+    auto result = scoped_allocation_tag::get_current_tag();
+
+    REQUIRE(result == allocation_tag::scene);
+}
+
+TEST_CASE("scoped_allocation_tag - other thread - does not change tag", "[shared/memory]") {
+    scoped_allocation_tag tag(allocation_tag::graphics);
+
+    auto result = allocation_tag::graphics;
+
+    std::thread thread([&result]() {
+        result = scoped_allocation_tag::get_current_tag();
+    });
+    thread.join();
+
+    REQUIRE(result == allocation_tag::untagged);
+}
+
+//////////
+/// get_allocation_tag_statistics
+//////////
+
+TEST_CASE("get_allocation_tag_statistics - tagged allocation - increases live bytes", "[shared/memory]") {
+    auto before = get_allocation_tag_statistics(allocation_tag::resource);
+
+    int* volatile ptr {nullptr};
+    {
+        scoped_allocation_tag tag(allocation_tag::resource);
+        ptr = new int;
+    }
+
+    auto after = get_allocation_tag_statistics(allocation_tag::resource);
+
+    auto result = after.live_bytes - before.live_bytes;
+    auto expected = bytes(get_allocated_block_size(sizeof(int)));
+
+    REQUIRE(result == expected);
+    REQUIRE(after.number_of_allocations == before.number_of_allocations + 1u);
+
+    delete ptr;
+}
+
+TEST_CASE("get_allocation_tag_statistics - freed on untagged thread - decreases live bytes", "[shared/memory]") {
+    auto before = get_allocation_tag_statistics(allocation_tag::resource);
+
+    char* volatile ptr {nullptr};
+    {
+        scoped_allocation_tag tag(allocation_tag::resource);
+        ptr = new char[100];
+    }
+
+    std::thread thread([&ptr]() {
+        delete[] ptr;
+    });
+    thread.join();
+
+    auto result = get_allocation_tag_statistics(allocation_tag::resource);
+
+    REQUIRE(result.live_bytes == before.live_bytes);
+}
+
+TEST_CASE("get_allocation_tag_statistics - sized delete - decreases live bytes", "[shared/memory]") {
+    auto before = get_allocation_tag_statistics(allocation_tag::resource);
+
+    void* ptr {nullptr};
+    {
+        scoped_allocation_tag tag(allocation_tag::resource);
+        ptr = ::operator new(64u);
+    }
+
+    ::operator delete(ptr, 64u);
+
+    auto result = get_allocation_tag_statistics(allocation_tag::resource);
+
+    REQUIRE(result.live_bytes == before.live_bytes);
+}
+
+TEST_CASE("get_allocation_tag_statistics - allocations freed - keeps peak bytes", "[shared/memory]") {
+    auto size = 1024u * 1024u;
+
+    char* volatile ptr {nullptr};
+    {
+        scoped_allocation_tag tag(allocation_tag::resource);
+        ptr = new char[size];
+    }
+
+    delete[] ptr;
+
+    auto result = get_allocation_tag_statistics(allocation_tag::resource);
+
+    REQUIRE(result.peak_bytes >= bytes(size));
+}
+
+TEST_CASE("get_allocation_tag_statistics - untagged allocation - does not change tagged bytes", "[shared/memory]") {
+    auto before = get_allocation_tag_statistics(allocation_tag::resource);
+
+    auto volatile ptr = new int;
+
+    auto after = get_allocation_tag_statistics(allocation_tag::resource);
+
+    REQUIRE(after.live_bytes == before.live_bytes);
+    REQUIRE(after.number_of_allocations == before.number_of_allocations);
+
+    delete ptr;
+}
+
+//////////
+/// set_allocation_budget
+//////////
+
+TEST_CASE("set_allocation_budget - sets budget", "[shared/memory]") {
+    set_allocation_budget(allocation_tag::network, megabytes(2.0));
+
+    auto result = get_allocation_budget(allocation_tag::network);
+
+    REQUIRE(result);
+    REQUIRE(result->get_value() == 2.0);
+
+    clear_allocation_budget(allocation_tag::network);
+
+    REQUIRE_FALSE(get_allocation_budget(allocation_tag::network));
+}
+
+//////////
+/// check_allocation_budgets
+//////////
+
+TEST_CASE("check_allocation_budgets - budget exceeded - calls callback once", "[shared/memory]") {
+    set_allocation_budget(allocation_tag::network, megabytes(1.0));
+
+    char* volatile ptr {nullptr};
+    {
+        scoped_allocation_tag tag(allocation_tag::network);
+        ptr = new char[2u * 1024u * 1024u];
+    }
+
+    std::vector<allocation_tag> exceeded_tags;
+    auto callback = [&exceeded_tags](allocation_tag tag, bytes live_bytes, megabytes budget) {
+        REQUIRE(live_bytes > bytes(budget));
+        exceeded_tags.push_back(tag);
+    };
+
+    check_allocation_budgets(callback);
+    check_allocation_budgets(callback);
+
+    delete[] ptr;
+    clear_allocation_budget(allocation_tag::network);
+
+    REQUIRE(exceeded_tags.size() == 1u);
+    REQUIRE(exceeded_tags[0] == allocation_tag::network);
+}
+
+TEST_CASE("check_allocation_budgets - budget not exceeded - does not call callback", "[shared/memory]") {
+    set_allocation_budget(allocation_tag::network, megabytes(4.0));
+
+    char* volatile ptr {nullptr};
+    {
+        scoped_allocation_tag tag(allocation_tag::network);
+        ptr = new char[1024u];
+    }
+
+    auto was_called {false};
+    check_allocation_budgets([&was_called](allocation_tag, bytes, megabytes) {
+        was_called = true;
+    });
+
+    delete[] ptr;
+    clear_allocation_budget(allocation_tag::network);
+
+    REQUIRE_FALSE(was_called);
+}
+
+//////////
+/// to_string
+//////////
+
+TEST_CASE("to_string - allocation tag - returns name", "[shared/memory]") {
+    REQUIRE(to_string(allocation_tag::graphics) == "graphics");
+    REQUIRE(to_string(allocation_tag::network) == "network");
+}
+
+//////////
+/// parse_allocation_tag
+//////////
+
+TEST_CASE("parse_allocation_tag - tag name - returns tag", "[shared/memory]") {
+    REQUIRE(parse_allocation_tag("scene") == allocation_tag::scene);
+    REQUIRE(parse_allocation_tag("network") == allocation_tag::network);
+}
+
+TEST_CASE("parse_allocation_tag - unknown name - returns empty", "[shared/memory]") {
+    REQUIRE_FALSE(parse_allocation_tag("unknown").has_value());
+    REQUIRE_FALSE(parse_allocation_tag("").has_value());
+}
@@ -1,5 +1,12 @@
+#include <atomic>
 #include <thread>
+#include <vector>
+#include <chrono>
+#include <string>
+#include <new>
+#include <cstdint>
 #include "catch2/catch.hpp"
+#include "shared/tests/allocation_guard.h"
 #include "shared/memory/basic_allocators.h"
 
 using namespace pbr::shared::memory;
@@ -19,7 +26,7 @@ TEST_CASE("new - does not return null", "[shared/memory]") {
 TEST_CASE("new - accumulates number of bytes allocated", "[shared/memory]") {
     auto before = get_number_of_allocated_bytes();
 
-    auto ptr = new int;
+    auto volatile ptr = new int;
 
     auto after = get_number_of_allocated_bytes();
 
@@ -31,6 +38,86 @@ TEST_CASE("new - accumulates number of bytes allocated", "[shared/memory]") {
     delete ptr;
 }
 
+TEST_CASE("new - array - accumulates number of bytes allocated", "[shared/memory]") {
+    auto before = get_number_of_allocated_bytes();
+
+    auto size = 10u;
+    auto volatile ptr = new int[size];
+
+    auto after = get_number_of_allocated_bytes();
+
+    auto result = after - before;
+    auto expected = bytes(sizeof(int) * size + sizeof(memory_block_header));
+
+    REQUIRE(result == expected);
+
+    delete[] ptr;
+}
+
+TEST_CASE("new - nothrow - accumulates number of bytes allocated", "[shared/memory]") {
+    auto before = get_number_of_allocated_bytes();
+
+    auto volatile ptr = new (std::nothrow) int;
+    REQUIRE(ptr);
+
+    auto after = get_number_of_allocated_bytes();
+
+    auto result = after - before;
+    auto expected = bytes(sizeof(int) + sizeof(memory_block_header));
+
+    REQUIRE(result == expected);
+
+    delete ptr;
+}
+
+TEST_CASE("new - over-aligned type - returns aligned memory", "[shared/memory]") {
+    struct alignas(64) aligned_type {
+        float values[4];
+    };
+
+    auto volatile ptr = new aligned_type;
+
+    auto result = reinterpret_cast<uintptr_t>(ptr) % alignof(aligned_type);
+
+    REQUIRE(result == 0u);
+
+    delete ptr;
+}
+
+TEST_CASE("new - over-aligned array - returns aligned memory", "[shared/memory]") {
+    struct alignas(128) aligned_type {
+        float values[4];
+    };
+
+    auto volatile ptr = new aligned_type[3];
+
+    auto result = reinterpret_cast<uintptr_t>(ptr) % alignof(aligned_type);
+
+    REQUIRE(result == 0u);
+
+    delete[] ptr;
+}
+
+TEST_CASE("new - over-aligned type - accumulates number of bytes allocated", "[shared/memory]") {
+    struct alignas(64) aligned_type {
+        float values[4];
+    };
+
+    auto before = get_number_of_allocated_bytes();
+
+    auto volatile ptr = new aligned_type;
+
+    auto after = get_number_of_allocated_bytes();
+
+    auto result = after - before;
+    auto expected = bytes(get_allocated_block_size(sizeof(aligned_type), alignof(aligned_type)));
+
+    REQUIRE(result == expected);
+    REQUIRE(result.get_value() >= sizeof(aligned_type) + sizeof(memory_block_header));
+
+    delete ptr;
+}
+
 //////////
 /// delete
 //////////
@@ -38,7 +125,7 @@ TEST_CASE("new - accumulates number of bytes allocated", "[shared/memory]") {
 TEST_CASE("delete - single element, decreases number of bytes allocated", "[shared/memory]") {
     auto expected = get_number_of_allocated_bytes();
 
-    auto ptr = new int;
+    auto volatile ptr = new int;
 
     auto after = get_number_of_allocated_bytes();
     REQUIRE(after > expected);
@@ -54,7 +141,7 @@ TEST_CASE("delete - array of elements, decreases number of bytes allocated", "[s
     auto expected = get_number_of_allocated_bytes();
 
     auto size = 100;
-    auto ptr = new int[size];
+    auto volatile ptr = new int[size];
 
     auto after = get_number_of_allocated_bytes();
     REQUIRE(after > expected);
@@ -66,6 +153,102 @@ TEST_CASE("delete - array of elements, decreases number of bytes allocated", "[s
     REQUIRE(result == expected);
 }
 
+TEST_CASE("delete - sized, decreases number of bytes allocated", "[shared/memory]") {
+    auto expected = get_number_of_allocated_bytes();
+
+    auto size = 24u;
+    auto ptr = ::operator new(size);
+
+    REQUIRE(get_number_of_allocated_bytes() > expected);
+
+    ::operator delete(ptr, size);
+
+    auto result = get_number_of_allocated_bytes();
+
+    REQUIRE(result == expected);
+}
+
+TEST_CASE("delete - nothrow, decreases number of bytes allocated", "[shared/memory]") {
+    auto expected = get_number_of_allocated_bytes();
+
+    auto ptr = ::operator new(8u, std::nothrow);
+
+    REQUIRE(get_number_of_allocated_bytes() > expected);
+
+    ::operator delete(ptr, std::nothrow);
+
+    auto result = get_number_of_allocated_bytes();
+
+    REQUIRE(result == expected);
+}
+
+TEST_CASE("delete - aligned, decreases number of bytes allocated", "[shared/memory]") {
+    auto expected = get_number_of_allocated_bytes();
+
+    auto alignment = std::align_val_t {256};
+    auto ptr = ::operator new(100u, alignment);
+
+    REQUIRE(get_number_of_allocated_bytes() > expected);
+
+    ::operator delete(ptr, alignment);
+
+    auto result = get_number_of_allocated_bytes();
+
+    REQUIRE(result == expected);
+}
+
+TEST_CASE("delete - sized and aligned, decreases number of bytes allocated", "[shared/memory]") {
+    auto expected = get_number_of_allocated_bytes();
+
+    auto size = 100u;
+    auto alignment = std::align_val_t {64};
+    auto ptr = ::operator new[](size, alignment);
+
+    REQUIRE(get_number_of_allocated_bytes() > expected);
+
+    ::operator delete[](ptr, size, alignment);
+
+    auto result = get_number_of_allocated_bytes();
+
+    REQUIRE(result == expected);
+}
+
+TEST_CASE("delete - nullptr - does nothing", "[shared/memory]") {
+    auto expected = get_number_of_allocated_bytes();
+
+    int* ptr {nullptr};
+    delete ptr;
+
+    ::operator delete(nullptr, 8u);
+    ::operator delete(nullptr, std::align_val_t {64});
+
+    auto result = get_number_of_allocated_bytes();
+
+    REQUIRE(result == expected);
+}
+
+//////////
+/// get_allocated_block_size
+//////////
+
+TEST_CASE("get_allocated_block_size - default alignment - returns size plus header", "[shared/memory]") {
+    auto size = 100u;
+
+    auto result = get_allocated_block_size(size);
+
+    REQUIRE(result == size + sizeof(memory_block_header));
+}
+
+TEST_CASE("get_allocated_block_size - over-aligned - returns multiple of alignment", "[shared/memory]") {
+    auto size = 100u;
+    auto alignment = 64u;
+
+    auto result = get_allocated_block_size(size, alignment);
+
+    REQUIRE(result % alignment == 0u);
+    REQUIRE(result >= size + alignment);
+}
+
 //////////
 /// get_number_of_allocated_bytes
 //////////
@@ -74,7 +257,7 @@ TEST_CASE("get_number_of_allocated_bytes - single thread - returns number of all
     auto start = get_number_of_allocated_bytes();
 
     auto array_size = 10;
-    auto ptr = new int[array_size];
+    auto volatile ptr = new int[array_size];
 
     auto end = get_number_of_allocated_bytes();
 
@@ -101,7 +284,7 @@ TEST_CASE("get_number_of_allocated_bytes - multiple threads - returns number of
         {
             std::thread t([array_size](){
                 // allocate and forget...
-                new int[array_size];
+                [[maybe_unused]] auto volatile ptr = new int[array_size];
             });
             threads[i] = std::move(t);
         }
@@ -121,3 +304,162 @@ TEST_CASE("get_number_of_allocated_bytes - multiple threads - returns number of
 
     REQUIRE(result == expected);
 }
+
+//////////
+/// get_thread_allocation_statistics
+//////////
+
+TEST_CASE("get_thread_allocation_statistics - allocate - increases allocated bytes and number of allocations", "[shared/memory]") {
+    auto before = get_thread_allocation_statistics();
+
+    auto volatile ptr = new int;
+
+    auto after = get_thread_allocation_statistics();
+
+    delete ptr;
+
+    auto expected_bytes = bytes(sizeof(int) + sizeof(memory_block_header));
+
+    REQUIRE(after.allocated_bytes - before.allocated_bytes == expected_bytes);
+    REQUIRE(after.number_of_allocations - before.number_of_allocations == 1u);
+    REQUIRE(after.freed_bytes == before.freed_bytes);
+    REQUIRE(after.number_of_frees == before.number_of_frees);
+}
+
+TEST_CASE("get_thread_allocation_statistics - free - increases freed bytes and number of frees", "[shared/memory]") {
+    auto volatile ptr = new int;
+
+    auto before = get_thread_allocation_statistics();
+
+    delete ptr;
+
+    auto after = get_thread_allocation_statistics();
+
+    auto expected_bytes = bytes(sizeof(int) + sizeof(memory_block_header));
+
+    REQUIRE(after.freed_bytes - before.freed_bytes == expected_bytes);
+    REQUIRE(after.number_of_frees - before.number_of_frees == 1u);
+    REQUIRE(after.allocated_bytes == before.allocated_bytes);
+}
+
+TEST_CASE("get_thread_allocation_statistics - allocate above peak - increases peak bytes", "[shared/memory]") {
+    auto before = get_thread_allocation_statistics();
+
+    auto size = before.peak_bytes.get_value() + 1024u;
+    auto volatile ptr = new char[size];
+
+    auto after = get_thread_allocation_statistics();
+
+    delete[] ptr;
+
+    REQUIRE(after.peak_bytes > before.peak_bytes);
+    REQUIRE(after.peak_bytes.get_value() >= size);
+
+    auto after_free = get_thread_allocation_statistics();
+
+    REQUIRE(after_free.peak_bytes == after.peak_bytes);
+}
+
+TEST_CASE("get_thread_allocation_statistics - allocate on other thread - does not change this thread", "[shared/memory]") {
+    auto size = 1024u * 1024u;
+
+    auto before = get_thread_allocation_statistics();
+
+    uint64_t other_thread_number_of_allocations {0u};
+
+    std::thread t([&other_thread_number_of_allocations, size]() {
+        auto other_before = get_thread_allocation_statistics();
+
+        auto volatile ptr = new char[size];
+
+        auto other_after = get_thread_allocation_statistics();
+
+        delete[] ptr;
+
+        other_thread_number_of_allocations = other_after.number_of_allocations - other_before.number_of_allocations;
+    });
+    t.join();
+
+    auto after = get_thread_allocation_statistics();
+
+    REQUIRE(other_thread_number_of_allocations == 1u);
+    REQUIRE((after.allocated_bytes - before.allocated_bytes).get_value() < size);
+}
+
+//////////
+/// allocation_guard
+//////////
+
+TEST_CASE("allocation_guard - allocate - counts allocations and bytes", "[shared/memory]") {
+    auto size = 100u;
+
+    auto counts = count_allocations([size]() {
+        auto volatile ptr = new char[size];
+        delete[] ptr;
+    });
+
+    REQUIRE(counts.number_of_allocations == 1u);
+    REQUIRE(counts.allocated_bytes == get_allocated_block_size(size));
+
+    REQUIRE_THAT(counts, makes_at_most_allocations(1u));
+    REQUIRE_THAT(counts, allocates_at_most_bytes(get_allocated_block_size(size)));
+    REQUIRE_THAT(counts, !makes_no_allocations());
+    REQUIRE_THAT(counts, !allocates_at_most_bytes(size - 1u));
+}
+
+TEST_CASE("allocation_guard - allocate on other thread - makes no allocations", "[shared/memory]") {
+    std::atomic_bool can_allocate {false};
+
+    // creating the thread allocates, so the thread waits until the guard is constructed
+    std::thread t([&can_allocate]() {
+        while (!can_allocate) {
+            std::this_thread::yield();
+        }
+
+        auto volatile ptr = new char[100];
+        delete[] ptr;
+    });
+
+    allocation_guard guard;
+
+    can_allocate = true;
+    t.join();
+
+    auto counts = guard.get_counts();
+
+    REQUIRE_THAT(counts, makes_no_allocations());
+}
+
+//////////
+/// benchmarks - run with the `[.benchmark]` tag
+//////////
+
+TEST_CASE("benchmark - new and delete - multiple threads", "[.benchmark][shared/memory]") {
+    auto number_of_iterations = 1'000'000;
+
+    for (auto number_of_threads : { 1, 2, 4, 8 }) {
+        std::vector<std::thread> threads;
+        threads.reserve(number_of_threads);
+
+        auto start = std::chrono::steady_clock::now();
+
+        for (auto i {0}; i < number_of_threads; ++i) {
+            threads.emplace_back([number_of_iterations]() {
+                for (auto j {0}; j < number_of_iterations; ++j) {
+                    auto volatile ptr = new int(j);
+                    delete ptr;
+                }
+            });
+        }
+
+        for (auto& t : threads) {
+            t.join();
+        }
+
+        auto duration = std::chrono::duration<double>(std::chrono::steady_clock::now() - start);
+        auto pairs_per_second = (number_of_iterations * number_of_threads) / duration.count();
+
+        WARN(std::to_string(number_of_threads) + " thread(s): " +
+             std::to_string(pairs_per_second / 1'000'000.0) + " million new/delete pairs per second");
+    }
+}
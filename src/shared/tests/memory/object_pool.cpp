@@ -0,0 +1,293 @@
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <stdexcept>
+#include "catch2/catch.hpp"
+#include "shared/memory/object_pool.h"
+#include "shared/memory/basic_allocators.h"
+#include "shared/diagnostics/counter_set.h"
+
+using namespace pbr::shared::memory;
+
+struct test_object {
+    test_object(int value_to_set) : value(value_to_set) {
+        ++number_alive;
+    }
+
+    ~test_object() {
+        --number_alive;
+    }
+
+    int value {0};
+    uint64_t padding[3] {};
+
+    static inline std::atomic_int number_alive {0};
+};
+
+struct throwing_object {
+    throwing_object() {
+        throw std::runtime_error("failed");
+    }
+};
+
+struct alignas(64) aligned_object {
+    int value {0};
+};
+
+//////////
+/// create
+//////////
+
+TEST_CASE("object_pool create - constructs object", "[shared/memory]") {
+    object_pool<test_object> pool;
+
+    auto result = pool.create(42);
+
+    REQUIRE(result->value == 42);
+    REQUIRE(test_object::number_alive == 1);
+
+    pool.destroy(result);
+}
+
+TEST_CASE("object_pool create - over-aligned type - returns aligned object", "[shared/memory]") {
+    object_pool<aligned_object> pool;
+
+    auto result = pool.create();
+
+    REQUIRE(reinterpret_cast<uintptr_t>(result) % alignof(aligned_object) == 0u);
+
+    pool.destroy(result);
+}
+
+TEST_CASE("object_pool create - constructor throws - returns slot", "[shared/memory]") {
+    object_pool<throwing_object> pool;
+
+    REQUIRE_THROWS(pool.create());
+
+    auto result = pool.get_statistics().live_slots;
+
+    REQUIRE(result == 0u);
+}
+
+TEST_CASE("object_pool create - after warm up - does not allocate from the heap", "[shared/memory]") {
+    object_pool<test_object> pool(16u);
+
+    std::vector<test_object*> objects;
+    objects.reserve(16u);
+
+    for (auto i {0}; i < 16; ++i) {
+        objects.push_back(pool.create(i));
+    }
+
+    for (auto object : objects) {
+        pool.destroy(object);
+    }
+
+    objects.clear();
+
+    auto before = get_thread_allocation_statistics();
+
+    for (auto i {0}; i < 16; ++i) {
+        objects.push_back(pool.create(i));
+    }
+
+    for (auto object : objects) {
+        pool.destroy(object);
+    }
+
+    auto after = get_thread_allocation_statistics();
+
+    REQUIRE(after.number_of_allocations == before.number_of_allocations);
+}
+
+//////////
+/// destroy
+//////////
+
+TEST_CASE("object_pool destroy - destructs object and reuses slot", "[shared/memory]") {
+    object_pool<test_object> pool;
+
+    auto first = pool.create(1);
+    pool.destroy(first);
+
+    auto result = pool.create(2);
+
+    REQUIRE(test_object::number_alive == 1);
+    REQUIRE(result == first);
+
+    pool.destroy(result);
+
+    REQUIRE(test_object::number_alive == 0);
+}
+
+TEST_CASE("object_pool destroy - nullptr - does nothing", "[shared/memory]") {
+    object_pool<test_object> pool;
+
+    pool.destroy(nullptr);
+
+    REQUIRE(pool.get_statistics().live_slots == 0u);
+}
+
+TEST_CASE("object_pool destroy - other thread - returns slot to owner", "[shared/memory]") {
+    object_pool<test_object> pool(4u);
+
+    std::vector<test_object*> objects;
+    for (auto i {0}; i < 4; ++i) {
+        objects.push_back(pool.create(i));
+    }
+
+    std::thread thread([&pool, &objects]() {
+        for (auto object : objects) {
+            pool.destroy(object);
+        }
+    });
+    thread.join();
+
+    REQUIRE(pool.get_statistics().live_slots == 0u);
+
+    // the slots freed by the other thread should be reused rather than a new slab allocated
+    for (auto i {0}; i < 4; ++i) {
+        objects[i] = pool.create(i);
+    }
+
+    REQUIRE(pool.get_statistics().number_of_slabs == 1u);
+
+    for (auto object : objects) {
+        pool.destroy(object);
+    }
+}
+
+TEST_CASE("object_pool create - multiple threads - creates unique objects", "[shared/memory]") {
+    object_pool<test_object> pool(8u);
+
+    auto number_of_threads = 4;
+    auto objects_per_thread = 100;
+
+    std::vector<std::vector<test_object*>> objects(number_of_threads);
+    std::vector<std::thread> threads;
+
+    for (auto i {0}; i < number_of_threads; ++i) {
+        threads.emplace_back([&pool, &objects, i, objects_per_thread]() {
+            for (auto j {0}; j < objects_per_thread; ++j) {
+                objects[i].push_back(pool.create(i * objects_per_thread + j));
+            }
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    std::vector<bool> seen(number_of_threads * objects_per_thread, false);
+    for (auto& thread_objects : objects) {
+        for (auto object : thread_objects) {
+            REQUIRE_FALSE(seen[object->value]);
+            seen[object->value] = true;
+        }
+    }
+
+    REQUIRE(pool.get_statistics().live_slots == static_cast<uint64_t>(number_of_threads * objects_per_thread));
+
+    for (auto& thread_objects : objects) {
+        for (auto object : thread_objects) {
+            pool.destroy(object);
+        }
+    }
+
+    REQUIRE(pool.get_statistics().live_slots == 0u);
+}
+
+//////////
+/// make_shared
+//////////
+
+TEST_CASE("object_pool make_shared - shared pool - allocates from pool", "[shared/memory]") {
+    shared_object_pool<test_object> pool;
+
+    {
+        auto result = pool.make_shared(42);
+
+        REQUIRE(result->value == 42);
+        REQUIRE(pool.get_statistics().live_slots == 1u);
+    }
+
+    REQUIRE(test_object::number_alive == 0);
+    REQUIRE(pool.get_statistics().live_slots == 0u);
+}
+
+TEST_CASE("object_pool make_shared - after warm up - does not allocate from the heap", "[shared/memory]") {
+    shared_object_pool<test_object> pool;
+
+    (void)pool.make_shared(1);
+
+    auto before = get_thread_allocation_statistics();
+
+    for (auto i {0}; i < 10; ++i) {
+        auto object = pool.make_shared(i);
+    }
+
+    auto after = get_thread_allocation_statistics();
+
+    REQUIRE(after.number_of_allocations == before.number_of_allocations);
+}
+
+TEST_CASE("object_pool make_shared - control block does not fit - falls back to heap", "[shared/memory]") {
+    object_pool<test_object> pool;
+
+    {
+        auto result = pool.make_shared(42);
+
+        REQUIRE(result->value == 42);
+        REQUIRE(pool.get_statistics().live_slots == 0u);
+    }
+
+    REQUIRE(test_object::number_alive == 0);
+}
+
+//////////
+/// reserve
+//////////
+
+TEST_CASE("object_pool reserve - increases capacity", "[shared/memory]") {
+    object_pool<test_object> pool(8u);
+
+    pool.reserve(20u);
+
+    auto result = pool.get_statistics();
+
+    REQUIRE(result.capacity >= 20u);
+    REQUIRE(result.number_of_slabs == 3u);
+}
+
+TEST_CASE("object_pool reserve - create - uses reserved slots", "[shared/memory]") {
+    object_pool<test_object> pool(8u);
+
+    pool.reserve(8u);
+
+    auto object = pool.create(1);
+
+    REQUIRE(pool.get_statistics().number_of_slabs == 1u);
+
+    pool.destroy(object);
+}
+
+//////////
+/// export_statistics
+//////////
+
+TEST_CASE("object_pool export_statistics - sets counters", "[shared/memory]") {
+    object_pool<test_object> pool(8u);
+    pbr::shared::diagnostics::counter_set counters;
+
+    auto object = pool.create(1);
+
+    pool.export_statistics(counters, "pool");
+
+    REQUIRE(counters.get_counter("pool.live_slots") == 1);
+    REQUIRE(counters.get_counter("pool.capacity") == 8);
+    REQUIRE(counters.get_counter("pool.slabs") == 1);
+
+    pool.destroy(object);
+}
@@ -0,0 +1,146 @@
+#include <cstdint>
+#include <cstring>
+#include "catch2/catch.hpp"
+#include "shared/memory/region_allocator.h"
+#include "shared/memory/kilobytes.h"
+
+using namespace pbr::shared::memory;
+
+//////////
+/// region_allocator
+//////////
+
+TEST_CASE("region_allocator - reserves address space - commits nothing", "[shared/memory]") {
+    region_allocator allocator(bytes(megabytes(256.0)));
+
+    REQUIRE(allocator.get_reserved_size() >= bytes(megabytes(256.0)));
+    REQUIRE(allocator.get_committed_size() == bytes(0u));
+    REQUIRE(allocator.get_used_bytes() == bytes(0u));
+}
+
+TEST_CASE("region_allocator - reserve size - rounded up to commit granularity", "[shared/memory]") {
+    region_allocator allocator(bytes(1u), false);
+
+    REQUIRE(allocator.get_reserved_size() == allocator.get_commit_granularity());
+}
+
+//////////
+/// allocate
+//////////
+
+TEST_CASE("allocate - commits lazily", "[shared/memory]") {
+    region_allocator allocator(bytes(megabytes(256.0)));
+
+    auto ptr = static_cast<std::byte*>(allocator.allocate(1000u));
+
+    REQUIRE(ptr);
+    REQUIRE(allocator.get_committed_size() == allocator.get_commit_granularity());
+
+    std::memset(ptr, 0xAB, 1000u);
+
+    auto granularity = static_cast<size_t>(allocator.get_commit_granularity().get_value());
+    auto large = static_cast<std::byte*>(allocator.allocate(granularity * 2u));
+
+    REQUIRE(large);
+    REQUIRE(allocator.get_committed_size() == bytes(granularity * 3u));
+
+    // touch the first and last bytes of the newly committed memory
+    large[0] = std::byte {1};
+    large[granularity * 2u - 1u] = std::byte {1};
+}
+
+TEST_CASE("allocate - returns aligned memory", "[shared/memory]") {
+    region_allocator allocator(bytes(megabytes(16.0)), false);
+
+    [[maybe_unused]] auto first = allocator.allocate(1u, 1u);
+    auto result = allocator.allocate(64u, 4096u);
+
+    REQUIRE(result);
+    REQUIRE(reinterpret_cast<uintptr_t>(result) % 4096u == 0u);
+}
+
+TEST_CASE("allocate - larger than reserved - returns null", "[shared/memory]") {
+    region_allocator allocator(bytes(megabytes(4.0)), false);
+
+    auto reserved = static_cast<size_t>(allocator.get_reserved_size().get_value());
+
+    auto result = allocator.allocate(reserved + 1u);
+
+    REQUIRE_FALSE(result);
+    REQUIRE(allocator.get_committed_size() == bytes(0u));
+
+    auto whole = allocator.allocate(reserved);
+
+    REQUIRE(whole);
+    REQUIRE(allocator.owns(whole));
+    REQUIRE(allocator.get_committed_size() == allocator.get_reserved_size());
+}
+
+//////////
+/// reset
+//////////
+
+TEST_CASE("reset - keeps committed memory", "[shared/memory]") {
+    region_allocator allocator(bytes(megabytes(16.0)), false);
+
+    auto first = allocator.allocate(1024u);
+    auto committed = allocator.get_committed_size();
+
+    allocator.reset();
+
+    auto result = allocator.allocate(1024u);
+
+    REQUIRE(result == first);
+    REQUIRE(allocator.get_used_bytes() == bytes(1024u));
+    REQUIRE(allocator.get_committed_size() == committed);
+}
+
+//////////
+/// decommit
+//////////
+
+TEST_CASE("decommit - returns committed memory", "[shared/memory]") {
+    region_allocator allocator(bytes(megabytes(64.0)));
+
+    auto ptr = static_cast<std::byte*>(allocator.allocate(static_cast<size_t>(bytes(megabytes(8.0)).get_value())));
+    REQUIRE(ptr);
+    std::memset(ptr, 0xAB, 1024u);
+
+    auto result = allocator.decommit();
+
+    REQUIRE(result);
+    REQUIRE(allocator.get_committed_size() == bytes(0u));
+    REQUIRE(allocator.get_used_bytes() == bytes(0u));
+}
+
+TEST_CASE("decommit - region can be refilled", "[shared/memory]") {
+    region_allocator allocator(bytes(megabytes(16.0)));
+
+    auto first = static_cast<std::byte*>(allocator.allocate(4096u));
+    std::memset(first, 0xAB, 4096u);
+
+    REQUIRE(allocator.decommit());
+
+    auto result = static_cast<std::byte*>(allocator.allocate(4096u));
+
+    REQUIRE(result == first);
+    REQUIRE(result[0] == std::byte {0});
+
+    result[4095] = std::byte {1};
+}
+
+//////////
+/// get_footprint
+//////////
+
+TEST_CASE("get_footprint - returns reserved, committed and used sizes", "[shared/memory]") {
+    region_allocator allocator(bytes(gigabytes(1.0)), false);
+
+    [[maybe_unused]] auto ptr = allocator.allocate(static_cast<size_t>(bytes(megabytes(1.0)).get_value()));
+
+    auto result = allocator.get_footprint();
+
+    REQUIRE(result.reserved == gigabytes(1.0));
+    REQUIRE(result.committed == megabytes(allocator.get_committed_size()));
+    REQUIRE(result.used == megabytes(1.0));
+}
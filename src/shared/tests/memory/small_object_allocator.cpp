@@ -0,0 +1,283 @@
+#include <thread>
+#include <vector>
+#include <chrono>
+#include <string>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include "catch2/catch.hpp"
+#include "shared/memory/small_object_allocator.h"
+
+using namespace pbr::shared::memory;
+
+//////////
+/// get_small_object_block_size
+//////////
+
+TEST_CASE("get_small_object_block_size - returns size class at least as large as size", "[shared/memory]") {
+    for (size_t size {1u}; size <= max_small_object_size; ++size) {
+        auto result = get_small_object_block_size(size);
+
+        REQUIRE(result >= size);
+        REQUIRE(result % __STDCPP_DEFAULT_NEW_ALIGNMENT__ == 0u);
+    }
+}
+
+TEST_CASE("get_small_object_block_size - wastes less than a quarter of size", "[shared/memory]") {
+    for (size_t size {129u}; size <= max_small_object_size; ++size) {
+        auto result = get_small_object_block_size(size);
+
+        REQUIRE(result - size < size / 4u);
+    }
+}
+
+//////////
+/// allocate_small_object
+//////////
+
+TEST_CASE("allocate_small_object - returns aligned memory", "[shared/memory]") {
+    for (size_t size {16u}; size <= max_small_object_size; size += 16u) {
+        auto result = allocate_small_object(size);
+
+        REQUIRE(result);
+        REQUIRE(reinterpret_cast<uintptr_t>(result) % __STDCPP_DEFAULT_NEW_ALIGNMENT__ == 0u);
+
+        std::memset(result, 0xAB, size);
+
+        free_small_object(result, size);
+    }
+}
+
+TEST_CASE("allocate_small_object - returns distinct blocks", "[shared/memory]") {
+    auto size = 48u;
+    std::vector<std::byte*> blocks;
+
+    for (auto i {0}; i < 1000; ++i) {
+        auto block = static_cast<std::byte*>(allocate_small_object(size));
+        std::memset(block, i & 0xFF, size);
+        blocks.push_back(block);
+    }
+
+    for (size_t i {0u}; i < blocks.size(); ++i) {
+        REQUIRE(blocks[i][0] == static_cast<std::byte>(i & 0xFF));
+        REQUIRE(blocks[i][size - 1u] == static_cast<std::byte>(i & 0xFF));
+    }
+
+    for (auto block : blocks) {
+        free_small_object(block, size);
+    }
+}
+
+TEST_CASE("allocate_small_object - reuses freed block", "[shared/memory]") {
+    auto size = 64u;
+
+    auto first = allocate_small_object(size);
+    free_small_object(first, size);
+
+    auto result = allocate_small_object(size);
+
+    REQUIRE(result == first);
+
+    free_small_object(result, size);
+}
+
+TEST_CASE("free_small_object - freed on other thread - is reused", "[shared/memory]") {
+    auto size = 256u;
+    auto number_of_blocks = 10'000u;
+
+    std::vector<void*> blocks;
+    blocks.reserve(number_of_blocks);
+
+    for (auto i {0u}; i < number_of_blocks; ++i) {
+        blocks.push_back(allocate_small_object(size));
+    }
+
+    std::thread thread([&blocks, size]() {
+        for (auto block : blocks) {
+            free_small_object(block, size);
+        }
+    });
+    thread.join();
+
+    auto before = get_small_object_allocator_statistics();
+
+    for (auto i {0u}; i < number_of_blocks; ++i) {
+        blocks[i] = allocate_small_object(size);
+    }
+
+    auto after = get_small_object_allocator_statistics();
+
+    REQUIRE(after.number_of_spans == before.number_of_spans);
+
+    for (auto block : blocks) {
+        free_small_object(block, size);
+    }
+}
+
+//////////
+/// flush_small_object_thread_cache
+//////////
+
+TEST_CASE("flush_small_object_thread_cache - returns blocks to central free lists", "[shared/memory]") {
+    auto size = 512u;
+
+    std::vector<void*> blocks;
+
+    for (auto i {0}; i < 100; ++i) {
+        blocks.push_back(allocate_small_object(size));
+    }
+
+    for (auto block : blocks) {
+        free_small_object(block, size);
+    }
+
+    auto before = get_small_object_allocator_statistics();
+
+    flush_small_object_thread_cache();
+
+    auto after = get_small_object_allocator_statistics();
+
+    REQUIRE(after.central_free_bytes > before.central_free_bytes);
+}
+
+//////////
+/// fragmentation
+//////////
+
+TEST_CASE("fragmentation - mixed sizes across threads - reserved memory is reused", "[shared/memory]") {
+    auto number_of_threads = 4;
+    auto number_of_live_blocks = 2'000u;
+    auto number_of_rounds = 20;
+
+    // each thread keeps a working set of mixed size blocks, replacing them in a different order
+    // to how they were allocated, and hands half of them to the next thread to free
+    auto run_round = [&]() {
+        std::vector<std::vector<std::pair<void*, size_t>>> handed_over(number_of_threads);
+        for (auto& blocks : handed_over) {
+            blocks.reserve(number_of_live_blocks);
+        }
+
+        std::vector<std::thread> threads;
+
+        for (auto t {0}; t < number_of_threads; ++t) {
+            threads.emplace_back([&, t]() {
+                std::vector<std::pair<void*, size_t>> blocks;
+                blocks.reserve(number_of_live_blocks);
+
+                uint32_t seed = 12345u + static_cast<uint32_t>(t);
+
+                for (auto i {0u}; i < number_of_live_blocks; ++i) {
+                    seed = seed * 1664525u + 1013904223u;
+                    auto size = 16u + (seed >> 8) % (max_small_object_size - 16u);
+                    blocks.emplace_back(allocate_small_object(size), size);
+                }
+
+                for (auto i {0u}; i < number_of_live_blocks * 4u; ++i) {
+                    seed = seed * 1664525u + 1013904223u;
+                    auto& block = blocks[(seed >> 8) % number_of_live_blocks];
+
+                    free_small_object(block.first, block.second);
+
+                    block.second = 16u + (seed >> 4) % (max_small_object_size - 16u);
+                    block.first = allocate_small_object(block.second);
+                }
+
+                for (auto i {0u}; i < number_of_live_blocks; ++i) {
+                    if (i % 2u == 0u) {
+                        free_small_object(blocks[i].first, blocks[i].second);
+                    } else {
+                        handed_over[(t + 1) % number_of_threads].push_back(blocks[i]);
+                    }
+                }
+            });
+        }
+
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        for (auto& blocks : handed_over) {
+            for (auto& block : blocks) {
+                free_small_object(block.first, block.second);
+            }
+        }
+
+        flush_small_object_thread_cache();
+    };
+
+    // the first rounds grow the spans to the working set size
+    for (auto i {0}; i < 4; ++i) {
+        run_round();
+    }
+
+    auto before = get_small_object_allocator_statistics();
+
+    for (auto i {0}; i < number_of_rounds; ++i) {
+        run_round();
+    }
+
+    auto after = get_small_object_allocator_statistics();
+
+    // how the threads interleave changes the peak of each size class a little between rounds,
+    // but freed blocks must be reused rather than new spans being allocated every round
+    auto growth = after.reserved_bytes.get_value() - before.reserved_bytes.get_value();
+
+    REQUIRE(growth <= before.reserved_bytes.get_value() / 4u);
+}
+
+//////////
+/// benchmarks - run with the `[.benchmark]` tag
+//////////
+
+TEST_CASE("benchmark - small object allocator against malloc - multiple threads", "[.benchmark][shared/memory]") {
+    auto number_of_iterations = 1'000'000;
+    auto number_of_live_blocks = 64u;
+
+    auto run = [&](int number_of_threads, auto allocate, auto free) {
+        std::vector<std::thread> threads;
+        threads.reserve(number_of_threads);
+
+        auto start = std::chrono::steady_clock::now();
+
+        for (auto i {0}; i < number_of_threads; ++i) {
+            threads.emplace_back([&]() {
+                std::vector<std::pair<void*, size_t>> blocks(number_of_live_blocks, { nullptr, 0u });
+
+                for (auto j {0}; j < number_of_iterations; ++j) {
+                    auto& block = blocks[static_cast<size_t>(j) % number_of_live_blocks];
+                    if (block.first) {
+                        free(block.first, block.second);
+                    }
+
+                    block.second = 16u + (static_cast<size_t>(j) * 40503u) % 496u;
+                    block.first = allocate(block.second);
+                }
+
+                for (auto& block : blocks) {
+                    free(block.first, block.second);
+                }
+            });
+        }
+
+        for (auto& t : threads) {
+            t.join();
+        }
+
+        auto duration = std::chrono::duration<double>(std::chrono::steady_clock::now() - start);
+        return (number_of_iterations * number_of_threads) / duration.count() / 1'000'000.0;
+    };
+
+    for (auto number_of_threads : { 1, 2, 4, 8 }) {
+        auto small_object = run(number_of_threads,
+                                [](size_t size) { return allocate_small_object(size); },
+                                [](void* ptr, size_t size) { free_small_object(ptr, size); });
+
+        auto system = run(number_of_threads,
+                          [](size_t size) { return std::malloc(size); },
+                          [](void* ptr, size_t) { std::free(ptr); });
+
+        WARN(std::to_string(number_of_threads) + " thread(s): " +
+             std::to_string(small_object) + " million small object allocator pairs per second, " +
+             std::to_string(system) + " million malloc pairs per second");
+    }
+}
@@ -0,0 +1,154 @@
+#include "catch2/catch.hpp"
+#include "shared/platform/platform.h"
+#include "shared/platform/thread.h"
+
+#include <array>
+#include <optional>
+#include <string>
+#include <thread>
+
+#ifdef PLATFORM_LINUX
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+using namespace pbr::shared::platform;
+
+/// Creates thread settings that only set the scheduling
+/// \param policy The scheduling policy
+/// \param priority The priority
+/// \returns The settings
+static thread_settings create_settings(std::optional<thread_scheduling_policy> policy, int32_t priority) {
+    thread_settings settings;
+    settings.policy = policy;
+    settings.priority = priority;
+
+    return settings;
+}
+
+//////////
+/// parse_cpu_list
+//////////
+
+TEST_CASE("parse_cpu_list - indices and ranges - returns sorted indices", "[shared/platform]") {
+    auto cpus = parse_cpu_list("6,0-2,1");
+
+    REQUIRE(cpus.has_value());
+    REQUIRE(*cpus == std::vector<uint32_t> { 0u, 1u, 2u, 6u });
+}
+
+TEST_CASE("parse_cpu_list - invalid list - returns empty", "[shared/platform]") {
+    REQUIRE_FALSE(parse_cpu_list("").has_value());
+    REQUIRE_FALSE(parse_cpu_list("3-1").has_value());
+    REQUIRE_FALSE(parse_cpu_list("0,,1").has_value());
+    REQUIRE_FALSE(parse_cpu_list("0,").has_value());
+    REQUIRE_FALSE(parse_cpu_list("-1").has_value());
+    REQUIRE_FALSE(parse_cpu_list("a").has_value());
+}
+
+TEST_CASE("parse_cpu_list - index too large - returns empty", "[shared/platform]") {
+    REQUIRE_FALSE(parse_cpu_list("1024").has_value());
+    REQUIRE_FALSE(parse_cpu_list("0-50000000").has_value());
+    REQUIRE_FALSE(parse_cpu_list("0-4294967295").has_value());
+    REQUIRE_FALSE(parse_cpu_list("4294967296").has_value());
+}
+
+//////////
+/// parse_thread_scheduling_policy
+//////////
+
+TEST_CASE("parse_thread_scheduling_policy - valid policy - returns policy", "[shared/platform]") {
+    REQUIRE(parse_thread_scheduling_policy("normal") == thread_scheduling_policy::normal);
+    REQUIRE(parse_thread_scheduling_policy("batch") == thread_scheduling_policy::batch);
+    REQUIRE(parse_thread_scheduling_policy("idle") == thread_scheduling_policy::idle);
+    REQUIRE(parse_thread_scheduling_policy("fifo") == thread_scheduling_policy::fifo);
+    REQUIRE(parse_thread_scheduling_policy("round_robin") == thread_scheduling_policy::round_robin);
+}
+
+TEST_CASE("parse_thread_scheduling_policy - invalid policy - returns empty", "[shared/platform]") {
+    REQUIRE_FALSE(parse_thread_scheduling_policy("realtime").has_value());
+}
+
+//////////
+/// are_thread_settings_valid
+//////////
+
+TEST_CASE("are_thread_settings_valid - priority in range - returns true", "[shared/platform]") {
+    REQUIRE(are_thread_settings_valid(create_settings({}, -20)));
+    REQUIRE(are_thread_settings_valid(create_settings(thread_scheduling_policy::fifo, 99)));
+}
+
+TEST_CASE("are_thread_settings_valid - priority out of range - returns false", "[shared/platform]") {
+    REQUIRE_FALSE(are_thread_settings_valid(create_settings({}, 20)));
+    REQUIRE_FALSE(are_thread_settings_valid(create_settings(thread_scheduling_policy::round_robin, 0)));
+}
+
+//////////
+/// to_string
+//////////
+
+TEST_CASE("to_string - settings - formats settings", "[shared/platform]") {
+    thread_settings settings { "Logic", { 0u, 1u, 2u, 5u }, thread_scheduling_policy::fifo, 10 };
+
+    REQUIRE(to_string(settings) == "name: Logic, cpus: 0-2,5, policy: fifo, priority: 10");
+    REQUIRE(to_string({}) == "name: inherited, cpus: inherited, policy: inherited, priority: inherited");
+}
+
+//////////
+/// apply_thread_settings
+//////////
+
+#ifdef PLATFORM_LINUX
+TEST_CASE("apply_thread_settings - name and affinity - applies settings", "[shared/platform]") {
+    auto is_applied {false};
+    std::string name;
+    auto number_of_cpus {0};
+
+    // the process may not be allowed to run on every CPU, so use the first it is allowed
+    cpu_set_t allowed_cpu_set;
+    CPU_ZERO(&allowed_cpu_set);
+    REQUIRE(sched_getaffinity(0, sizeof(allowed_cpu_set), &allowed_cpu_set) == 0);
+
+    uint32_t cpu {0u};
+    while (!CPU_ISSET(cpu, &allowed_cpu_set)) {
+        ++cpu;
+    }
+
+    // apply them to another thread, so the test runner's thread is unchanged
+    std::thread thread([&]() {
+        is_applied = apply_thread_settings({ "A Long Thread Name", { cpu }, {}, {} });
+
+        std::array<char, 16> buffer {};
+        pthread_getname_np(pthread_self(), buffer.data(), buffer.size());
+        name = buffer.data();
+
+        cpu_set_t cpu_set;
+        CPU_ZERO(&cpu_set);
+        pthread_getaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set);
+        number_of_cpus = CPU_ISSET(cpu, &cpu_set) ? CPU_COUNT(&cpu_set) : 0;
+    });
+
+    thread.join();
+
+    REQUIRE(is_applied);
+    REQUIRE(name == "A Long Thread N");
+    REQUIRE(number_of_cpus == 1);
+}
+
+TEST_CASE("apply_thread_settings - lower priority - applies settings", "[shared/platform]") {
+    auto is_applied {false};
+    auto policy {0};
+
+    std::thread thread([&]() {
+        is_applied = apply_thread_settings(create_settings(thread_scheduling_policy::batch, 10));
+
+        sched_param parameters {};
+        pthread_getschedparam(pthread_self(), &policy, &parameters);
+    });
+
+    thread.join();
+
+    REQUIRE(is_applied);
+    REQUIRE(policy == SCHED_BATCH);
+}
+#endif
@@ -150,11 +150,15 @@ TEST_CASE("run - unknown loading scene type - returns false", "[shared/scene]")
 TEST_CASE("run - after initialization - runs all scenes from scene factory", "[shared/scene]") {
     auto sm = create_scene_manager();
 
-    // we're expecting the loading scene, then test scenes 1, 2 then 3 to load and run
-    while (!g_have_all_scenes_loaded) {
-        REQUIRE(sm->run());
+    // we're expecting the loading scene, then test scenes 1, 2 then 3 to load and run. There are no
+    // scenes after test scene 3, so loading them fails, which is the only way running should fail
+    while (sm->run()) {
     }
 
+    // the factory marks every scene as loaded before returning no scenes, so this only holds if
+    // running failed because there were no scenes left
+    REQUIRE(g_have_all_scenes_loaded);
+
     // the 3 test scenes plus the 4 times the loading scene will have loaded
     auto expected_number_of_scenes {7u};
 
@@ -24,21 +24,30 @@ TEST_CASE("constructor - empty arguments - throws exception", "[shared/utils/pro
     FAIL("");
 }
 
-//TEST_CASE("constructor - invalid arguments - throws exception", "[shared/utils/program_arguments]") {
-//    std::vector<std::string> arguments {
-//        "file/path/executable.exe",
-//        "invalid",
-//    };
-//
-//    try {
-//        program_arguments pa(arguments);
-//    } catch (...) {
-//        SUCCEED();
-//        return;
-//    }
-//
-//    FAIL();
-//}
+TEST_CASE("constructor - invalid arguments - throws exception", "[shared/utils/program_arguments]") {
+    std::vector<std::string> arguments {
+        "file/path/executable.exe",
+        "invalid",
+    };
+
+    try {
+        program_arguments pa(arguments);
+    } catch (...) {
+        SUCCEED("");
+        return;
+    }
+
+    FAIL("");
+}
+
+TEST_CASE("constructor - argument without name - throws exception", "[shared/utils/program_arguments]") {
+    std::vector<std::string> arguments {
+        "file/path/executable.exe",
+        "-=value",
+    };
+
+    REQUIRE_THROWS(program_arguments(arguments));
+}
 
 /*********************************************
  * get_executable_path
@@ -58,3 +67,62 @@ TEST_CASE("get_executable_path - returns the executable's path", "[shared/utils/
 
     REQUIRE(result == arguments[0]);
 }
+
+/*********************************************
+ * get_argument
+ ********************************************/
+
+TEST_CASE("get_argument - argument with value - returns value", "[shared/utils/program_arguments]") {
+    std::vector<std::string> arguments {
+        "file/path/executable.exe",
+        "-arg1=value1",
+        "-arg2=value=2",
+    };
+
+    program_arguments pa(arguments);
+
+    REQUIRE(pa.get_argument("arg1") == "value1");
+    REQUIRE(pa.get_argument("arg2") == "value=2");
+}
+
+TEST_CASE("get_argument - flag - returns empty value", "[shared/utils/program_arguments]") {
+    std::vector<std::string> arguments {
+        "file/path/executable.exe",
+        "-flag",
+    };
+
+    program_arguments pa(arguments);
+
+    auto result = pa.get_argument("flag");
+
+    REQUIRE(result);
+    REQUIRE(result->empty());
+}
+
+TEST_CASE("get_argument - missing argument - returns empty", "[shared/utils/program_arguments]") {
+    std::vector<std::string> arguments {
+        "file/path/executable.exe",
+    };
+
+    program_arguments pa(arguments);
+
+    auto result = pa.get_argument("missing");
+
+    REQUIRE_FALSE(result);
+}
+
+/*********************************************
+ * has_argument
+ ********************************************/
+
+TEST_CASE("has_argument - passed argument - returns true", "[shared/utils/program_arguments]") {
+    std::vector<std::string> arguments {
+        "file/path/executable.exe",
+        "-flag",
+    };
+
+    program_arguments pa(arguments);
+
+    REQUIRE(pa.has_argument("flag"));
+    REQUIRE_FALSE(pa.has_argument("other"));
+}
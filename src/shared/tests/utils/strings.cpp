@@ -474,6 +474,9 @@ TEST_CASE("to_int - valid string - returns correct results", "[shared/utils/stri
         { "10", 10 },
         { "999", 999 },
         { "1234567890", 1234567890 },
+        { " 42", 42 },
+        { "+42", 42 },
+        { "42abc", 42 },
     };
 
     for (const auto& [value, expected] : values) {
@@ -484,6 +487,13 @@ TEST_CASE("to_int - valid string - returns correct results", "[shared/utils/stri
     }
 }
 
+TEST_CASE("to_int - out of range string - returns empty", "[shared/utils/strings]") {
+    auto s = "99999999999999999999";
+    auto result = to_int(s);
+
+    REQUIRE_FALSE(result);
+}
+
 /*********************************************
  * to_float
  ********************************************/
@@ -0,0 +1,134 @@
+#include "catch2/catch.hpp"
+#include "shared/utils/triple_buffer.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace pbr::shared::utils;
+
+/*********************************************
+ * update
+ ********************************************/
+
+TEST_CASE("update - nothing published - returns false", "[shared/utils/triple_buffer]") {
+    triple_buffer<int> buffer;
+
+    auto result = buffer.update();
+
+    REQUIRE_FALSE(result);
+    REQUIRE(buffer.get_front_buffer() == 0);
+}
+
+TEST_CASE("update - value published - picks up value", "[shared/utils/triple_buffer]") {
+    triple_buffer<int> buffer;
+
+    buffer.get_back_buffer() = 42;
+    buffer.publish();
+
+    auto result = buffer.update();
+
+    REQUIRE(result);
+    REQUIRE(buffer.get_front_buffer() == 42);
+
+    // the value is only picked up once
+    REQUIRE_FALSE(buffer.update());
+    REQUIRE(buffer.get_front_buffer() == 42);
+}
+
+TEST_CASE("update - several values published - picks up latest value", "[shared/utils/triple_buffer]") {
+    triple_buffer<int> buffer;
+
+    for (auto i {1}; i <= 3; ++i) {
+        buffer.get_back_buffer() = i;
+        buffer.publish();
+    }
+
+    REQUIRE(buffer.update());
+    REQUIRE(buffer.get_front_buffer() == 3);
+}
+
+/*********************************************
+ * publish
+ ********************************************/
+
+TEST_CASE("publish - value read by consumer - does not change front buffer", "[shared/utils/triple_buffer]") {
+    triple_buffer<int> buffer;
+
+    buffer.get_back_buffer() = 1;
+    buffer.publish();
+    REQUIRE(buffer.update());
+
+    buffer.get_back_buffer() = 2;
+    buffer.publish();
+    buffer.get_back_buffer() = 3;
+
+    REQUIRE(buffer.get_front_buffer() == 1);
+}
+
+TEST_CASE("publish - buffers reused - keep their capacity", "[shared/utils/triple_buffer]") {
+    triple_buffer<std::vector<int>> buffer;
+
+    for (auto i {0}; i < 3; ++i) {
+        buffer.get_back_buffer().resize(100u);
+        buffer.publish();
+        REQUIRE(buffer.update());
+    }
+
+    for (auto i {0}; i < 3; ++i) {
+        auto& back_buffer = buffer.get_back_buffer();
+
+        REQUIRE(back_buffer.capacity() >= 100u);
+
+        back_buffer.clear();
+        buffer.publish();
+        REQUIRE(buffer.update());
+    }
+}
+
+TEST_CASE("publish - separate threads - consumer reads complete values in order", "[shared/utils/triple_buffer]") {
+    triple_buffer<std::vector<int>> buffer;
+
+    constexpr auto number_of_values {20000};
+    std::atomic_bool has_finished {false};
+
+    std::thread producer([&buffer, &has_finished]() {
+        for (auto i {1}; i <= number_of_values; ++i) {
+            auto& values = buffer.get_back_buffer();
+            values.assign(16u, i);
+            buffer.publish();
+        }
+
+        has_finished = true;
+    });
+
+    auto last_value {0};
+    auto is_consistent {true};
+
+    while (last_value < number_of_values) {
+        // check if the producer has finished before updating, so its last value cannot be missed
+        auto has_producer_finished = has_finished.load();
+
+        if (!buffer.update()) {
+            if (has_producer_finished) {
+                break;
+            }
+
+            continue;
+        }
+
+        const auto& values = buffer.get_front_buffer();
+
+        for (auto value : values) {
+            is_consistent = is_consistent && value == values.front();
+        }
+
+        is_consistent = is_consistent && values.front() > last_value;
+        last_value = values.front();
+    }
+
+    producer.join();
+
+    REQUIRE(is_consistent);
+    REQUIRE(last_value == number_of_values);
+}
@@ -4,6 +4,27 @@ namespace pbr::shared::utils {
     bool program_arguments::setup_arguments(const std::vector<std::string>& arguments) noexcept {
         this->_executable_path = arguments[0];
 
+        for (size_t i {1u}; i < arguments.size(); ++i) {
+            std::string_view argument = arguments[i];
+
+            if (argument.size() < 2u || argument[0] != '-') {
+                return false;
+            }
+
+            argument.remove_prefix(1u);
+
+            auto separator = argument.find('=');
+            auto name = argument.substr(0u, separator);
+
+            if (name.empty()) {
+                return false;
+            }
+
+            auto value = separator == std::string_view::npos ? std::string_view() : argument.substr(separator + 1u);
+
+            this->_arguments[std::string(name)] = std::string(value);
+        }
+
         return true;
     }
 }
@@ -5,15 +5,15 @@
 #include <string>
 #include <unordered_map>
 #include <filesystem>
+#include <optional>
 
 namespace pbr::shared::utils {
     /// Helps extract and validate program arguments
-    /// Currently, we only support returning the executable's path
     class program_arguments {
     public:
         /// Constructs the program arguments
         /// The first argument is taken as the executable's path
-        /// Any further arguments should take the form: `-arg=value`
+        /// Any further arguments should take the form: `-arg=value`, or `-arg` for a flag
         /// \param arguments The program arguments
         program_arguments(std::vector<std::string> arguments) {
             if (arguments.empty()) {
@@ -31,6 +31,27 @@ namespace pbr::shared::utils {
             return this->_executable_path;
         }
 
+        /// Returns if an argument was passed
+        /// \param name The name of the argument, without the leading `-`
+        /// \returns `true` if the argument was passed, else `false`
+        [[nodiscard]]
+        bool has_argument(const std::string& name) const noexcept {
+            return this->_arguments.contains(name);
+        }
+
+        /// Returns the value of an argument
+        /// \param name The name of the argument, without the leading `-`
+        /// \returns The value of the argument, else empty if the argument was not passed. Flags
+        /// have an empty string as their value
+        [[nodiscard]]
+        std::optional<std::string> get_argument(const std::string& name) const noexcept {
+            if (auto it = this->_arguments.find(name); it != this->_arguments.end()) {
+                return it->second;
+            }
+
+            return {};
+        }
+
     private:
         /// Sets up the arguments
         /// \param arguments The program arguments
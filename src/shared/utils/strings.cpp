@@ -1,4 +1,5 @@
 #include <algorithm>
+#include <charconv>
 
 #include "strings.h"
 
@@ -123,11 +124,31 @@ namespace pbr::shared::utils {
     }
 
     std::optional<int> to_int(std::string_view s) noexcept {
-        try {
-            return std::stoi(std::string(s), nullptr, 10);
-        } catch (...) {
+        // parse in place, as `std::stoi` needs a copy of the string and throws on invalid input,
+        // but accept the leading whitespace and sign it does
+        auto start = s.find_first_not_of(" \n\t\v\f\r");
+        if (start == std::string_view::npos) {
             return {};
         }
+
+        s.remove_prefix(start);
+
+        if (s.starts_with('+')) {
+            s.remove_prefix(1u);
+
+            if (s.starts_with('-')) {
+                return {};
+            }
+        }
+
+        int value {0};
+        auto [end, error] = std::from_chars(s.data(), s.data() + s.size(), value, 10);
+
+        if (error != std::errc()) {
+            return {};
+        }
+
+        return value;
     }
 
     std::optional<float> to_float(std::string_view s) noexcept {
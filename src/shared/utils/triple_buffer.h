@@ -0,0 +1,85 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace pbr::shared::utils {
+    /// Hands values from one producer thread to one consumer thread without locks. There are three
+    /// buffers: the back buffer the producer writes to, the front buffer the consumer reads from,
+    /// and a middle buffer holding the latest published value. Publishing swaps the back buffer with
+    /// the middle buffer, and the consumer picks up a new value by swapping the front buffer with
+    /// the middle buffer, each with a single atomic exchange. Neither thread ever waits for the
+    /// other, and the consumer always reads the latest complete value, skipping any it was too slow
+    /// to read. Values are never copied, and the buffers are reused, so containers in them keep
+    /// their capacity
+    /// \tparam T The type of value. This must be default constructible
+    template <typename T>
+    class triple_buffer {
+    public:
+        /// Returns the back buffer, to write the next value to. It holds a value from an earlier
+        /// publish, which should be overwritten. This must only be used by the producer
+        /// \returns The back buffer
+        [[nodiscard]]
+        T& get_back_buffer() noexcept {
+            return this->_buffers[this->_back_index].value;
+        }
+
+        /// Publishes the back buffer, so the consumer can pick it up. The producer then gets a new
+        /// back buffer. This must only be called by the producer
+        void publish() noexcept {
+            // release the written value to the consumer, and acquire the buffer the consumer
+            // has finished with
+            auto previous_middle = this->_middle.exchange(this->_back_index | new_value_flag, std::memory_order_acq_rel);
+            this->_back_index = previous_middle & index_mask;
+        }
+
+        /// Picks up the latest published value, if there is one the consumer has not already picked
+        /// up. This must only be called by the consumer
+        /// \returns `true` if a new value was picked up, else `false` if the front buffer still
+        /// holds the latest value
+        bool update() noexcept {
+            if ((this->_middle.load(std::memory_order_relaxed) & new_value_flag) == 0u) {
+                return false;
+            }
+
+            auto previous_middle = this->_middle.exchange(this->_front_index, std::memory_order_acq_rel);
+            this->_front_index = previous_middle & index_mask;
+
+            return true;
+        }
+
+        /// Returns the front buffer, holding the value last picked up by `update`. This must only be
+        /// used by the consumer
+        /// \returns The front buffer
+        [[nodiscard]]
+        const T& get_front_buffer() const noexcept {
+            return this->_buffers[this->_front_index].value;
+        }
+
+    private:
+        /// Set in `_middle` when the middle buffer holds a value the consumer has not picked up
+        static constexpr uint32_t new_value_flag {0x4u};
+
+        /// Masks the index of a buffer in `_middle`
+        static constexpr uint32_t index_mask {0x3u};
+
+        /// A buffer, on its own cache line so the producer and consumer do not contend
+        struct alignas(64) buffer {
+            /// The value
+            T value {};
+        };
+
+        /// The buffers
+        std::array<buffer, 3u> _buffers;
+
+        /// The index of the middle buffer, combined with `new_value_flag`
+        alignas(64) std::atomic_uint32_t _middle {1u};
+
+        /// The index of the back buffer, only used by the producer
+        alignas(64) uint32_t _back_index {0u};
+
+        /// The index of the front buffer, only used by the consumer
+        alignas(64) uint32_t _front_index {2u};
+    };
+}